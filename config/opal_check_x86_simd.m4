@@ -0,0 +1,88 @@
+dnl -*- shell-script -*-
+dnl
+dnl $COPYRIGHT$
+dnl
+dnl Additional copyrights may follow
+dnl
+dnl $HEADER$
+dnl
+
+# OPAL_CHECK_X86_SIMD
+# --------------------------------------------------------
+# Check whether the compiler can build individual functions for the
+# SSSE3 and AVX2 instruction sets (via the target attribute) and pick
+# between them at run time (via __builtin_cpu_supports). This lets a
+# generic x86 build carry vectorized kernels without requiring any of
+# these instructions on the machine that runs it.
+#
+# Defines OPAL_HAVE_X86_SIMD to 1 if so, 0 otherwise. Also checks
+# the same for the AVX-512F gather/scatter instructions, and defines
+# OPAL_HAVE_X86_AVX512 accordingly.
+AC_DEFUN([OPAL_CHECK_X86_SIMD],[
+    OPAL_VAR_SCOPE_PUSH([opal_check_x86_simd_happy opal_check_x86_avx512_happy])
+
+    AC_ARG_ENABLE([x86-simd],
+        [AC_HELP_STRING([--disable-x86-simd],
+                        [Do not build the SSSE3/AVX2/AVX-512 kernels that are selected at run time on x86 (default: enabled if the compiler supports them)])])
+
+    AC_MSG_CHECKING([for run-time selectable SSSE3/AVX2 support])
+    opal_check_x86_simd_happy=no
+    AS_IF([test "$enable_x86_simd" != "no"],
+          [AC_LINK_IFELSE([AC_LANG_PROGRAM([[
+#include <immintrin.h>
+__attribute__((target("ssse3")))
+static void swap_ssse3(void *p)
+{
+    const __m128i s = _mm_set_epi8(12,13,14,15,8,9,10,11,4,5,6,7,0,1,2,3);
+    _mm_storeu_si128((__m128i*)p, _mm_shuffle_epi8(_mm_loadu_si128((__m128i*)p), s));
+}
+__attribute__((target("avx2")))
+static void swap_avx2(void *p)
+{
+    const __m256i s = _mm256_set_epi8(12,13,14,15,8,9,10,11,4,5,6,7,0,1,2,3,
+                                      12,13,14,15,8,9,10,11,4,5,6,7,0,1,2,3);
+    _mm256_storeu_si256((__m256i*)p, _mm256_shuffle_epi8(_mm256_loadu_si256((__m256i*)p), s));
+}]],
+                                           [[char buf[32];
+__builtin_cpu_init();
+if (__builtin_cpu_supports("avx2")) swap_avx2(buf);
+else if (__builtin_cpu_supports("ssse3")) swap_ssse3(buf);]])],
+                          [opal_check_x86_simd_happy=yes])])
+    AC_MSG_RESULT([$opal_check_x86_simd_happy])
+
+    AS_IF([test "$enable_x86_simd" = "yes" && test "$opal_check_x86_simd_happy" = "no"],
+          [AC_MSG_WARN([SSSE3/AVX2 kernels were requested but the compiler])
+           AC_MSG_WARN([cannot build them])
+           AC_MSG_ERROR([Cannot continue])])
+
+    AS_IF([test "$opal_check_x86_simd_happy" = "yes"],
+          [AC_DEFINE_UNQUOTED([OPAL_HAVE_X86_SIMD], [1],
+                              [Whether SSSE3/AVX2 kernels can be built and selected at run time])],
+          [AC_DEFINE_UNQUOTED([OPAL_HAVE_X86_SIMD], [0],
+                              [Whether SSSE3/AVX2 kernels can be built and selected at run time])])
+
+    AC_MSG_CHECKING([for run-time selectable AVX-512 support])
+    opal_check_x86_avx512_happy=no
+    AS_IF([test "$opal_check_x86_simd_happy" = "yes"],
+          [AC_LINK_IFELSE([AC_LANG_PROGRAM([[
+#include <immintrin.h>
+__attribute__((target("avx512f")))
+static void copy_avx512(int *dst, const int *src)
+{
+    const __m512i idx = _mm512_set_epi32(30,28,26,24,22,20,18,16,14,12,10,8,6,4,2,0);
+    _mm512_i32scatter_epi32(dst, idx, _mm512_i32gather_epi32(idx, src, 4), 4);
+}]],
+                                           [[int src[32], dst[32];
+__builtin_cpu_init();
+if (__builtin_cpu_supports("avx512f")) copy_avx512(dst, src);]])],
+                          [opal_check_x86_avx512_happy=yes])])
+    AC_MSG_RESULT([$opal_check_x86_avx512_happy])
+
+    AS_IF([test "$opal_check_x86_avx512_happy" = "yes"],
+          [AC_DEFINE_UNQUOTED([OPAL_HAVE_X86_AVX512], [1],
+                              [Whether AVX-512F kernels can be built and selected at run time])],
+          [AC_DEFINE_UNQUOTED([OPAL_HAVE_X86_AVX512], [0],
+                              [Whether AVX-512F kernels can be built and selected at run time])])
+
+    OPAL_VAR_SCOPE_POP
+])dnl
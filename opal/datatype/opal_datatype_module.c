@@ -32,6 +32,7 @@
 #include "opal/datatype/opal_datatype_internal.h"
 #include "opal/datatype/opal_datatype.h"
 #include "opal/datatype/opal_convertor_internal.h"
+#include "opal/datatype/opal_datatype_strided.h"
 #include "opal/mca/base/mca_base_var.h"
 
 /* by default the debuging is turned off */
@@ -40,6 +41,7 @@ bool opal_unpack_debug = false;
 bool opal_pack_debug = false;
 bool opal_position_debug = false;
 bool opal_copy_debug = false;
+bool opal_datatype_simd = true;
 
 extern int opal_cuda_verbose;
 
@@ -142,9 +144,21 @@ OPAL_DECLSPEC const opal_datatype_t* opal_datatype_basicDatatypes[OPAL_DATATYPE_
 
 int opal_datatype_register_params(void)
 {
-#if OPAL_ENABLE_DEBUG
+#if OPAL_HAVE_X86_SIMD || OPAL_ENABLE_DEBUG
     int ret;
+#endif
+
+#if OPAL_HAVE_X86_SIMD
+    ret = mca_base_var_register ("opal", "mpi", NULL, "ddt_simd",
+                                 "Use AVX2/AVX-512 kernels to pack and unpack strided data when the processor supports them",
+                                 MCA_BASE_VAR_TYPE_BOOL, NULL, 0, MCA_BASE_VAR_FLAG_SETTABLE, OPAL_INFO_LVL_9,
+                                 MCA_BASE_VAR_SCOPE_LOCAL, &opal_datatype_simd);
+    if (0 > ret) {
+	return ret;
+    }
+#endif  /* OPAL_HAVE_X86_SIMD */
 
+#if OPAL_ENABLE_DEBUG
     ret = mca_base_var_register ("opal", "mpi", NULL, "ddt_unpack_debug",
 				 "Whether to output debugging information in the ddt unpack functions (nonzero = enabled)",
 				 MCA_BASE_VAR_TYPE_BOOL, NULL, 0, MCA_BASE_VAR_FLAG_SETTABLE, OPAL_INFO_LVL_3,
@@ -226,6 +240,9 @@ int32_t opal_datatype_init( void )
         datatype->desc.desc[1].end_loop.size            = datatype->size;
     }
 
+    /* pick the fastest strided copy kernels this processor can run */
+    opal_datatype_strided_select( opal_datatype_simd );
+
     return OPAL_SUCCESS;
 }
 
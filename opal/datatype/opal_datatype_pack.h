@@ -17,6 +17,8 @@
 
 #include "opal_config.h"
 
+#include "opal/datatype/opal_datatype_strided.h"
+
 #include <stddef.h>
 
 #if !defined(CHECKSUM) && OPAL_CUDA_SUPPORT
@@ -55,6 +57,17 @@ static inline void pack_predefined_data( opal_convertor_t* CONVERTOR,
         _source        += _copy_blength;
         *(DESTINATION) += _copy_blength;
     } else {
+#if OPAL_DATATYPE_STRIDED_COPY
+        OPAL_DATATYPE_SAFEGUARD_POINTER( _source, _copy_blength, (CONVERTOR)->pBaseBuf,
+                                    (CONVERTOR)->pDesc, (CONVERTOR)->count );
+        OPAL_DATATYPE_SAFEGUARD_POINTER( _source + (_copy_count - 1) * _elem->extent, _copy_blength,
+                                    (CONVERTOR)->pBaseBuf, (CONVERTOR)->pDesc, (CONVERTOR)->count );
+        DO_DEBUG( opal_output( 0, "pack 2. gather( %p, %p, %lu x %lu ) => space %lu\n",
+                               *(DESTINATION), _source, (unsigned long)_copy_count, (unsigned long)_copy_blength, (unsigned long)(*(SPACE)) ); );
+        opal_datatype_gather( *(DESTINATION), _source, _copy_blength, _elem->extent, _copy_count );
+        *(DESTINATION) += _copy_count * _copy_blength;
+        _source        += _copy_count * _elem->extent;
+#else
         uint32_t _i;
         for( _i = 0; _i < _copy_count; _i++ ) {
             OPAL_DATATYPE_SAFEGUARD_POINTER( _source, _copy_blength, (CONVERTOR)->pBaseBuf,
@@ -65,6 +78,7 @@ static inline void pack_predefined_data( opal_convertor_t* CONVERTOR,
             *(DESTINATION) += _copy_blength;
             _source        += _elem->extent;
         }
+#endif  /* OPAL_DATATYPE_STRIDED_COPY */
         _copy_blength *= _copy_count;
     }
     *(SOURCE)  = _source - _elem->disp;
@@ -83,10 +97,25 @@ static inline void pack_contiguous_loop( opal_convertor_t* CONVERTOR,
     const ddt_endloop_desc_t* _end_loop = (ddt_endloop_desc_t*)((ELEM) + _loop->items);
     unsigned char* _source = (*SOURCE) + _end_loop->first_elem_disp;
     uint32_t _copy_loops = *(COUNT);
+#if !OPAL_DATATYPE_STRIDED_COPY
     uint32_t _i;
+#endif
 
     if( (_copy_loops * _end_loop->size) > *(SPACE) )
         _copy_loops = (uint32_t)(*(SPACE) / _end_loop->size);
+#if OPAL_DATATYPE_STRIDED_COPY
+    if( 0 != _copy_loops ) {
+        OPAL_DATATYPE_SAFEGUARD_POINTER( _source, _end_loop->size, (CONVERTOR)->pBaseBuf,
+                                    (CONVERTOR)->pDesc, (CONVERTOR)->count );
+        OPAL_DATATYPE_SAFEGUARD_POINTER( _source + (_copy_loops - 1) * _loop->extent, _end_loop->size,
+                                    (CONVERTOR)->pBaseBuf, (CONVERTOR)->pDesc, (CONVERTOR)->count );
+        DO_DEBUG( opal_output( 0, "pack 3. gather( %p, %p, %lu x %lu ) => space %lu\n",
+                               *(DESTINATION), _source, (unsigned long)_copy_loops, (unsigned long)_end_loop->size, (unsigned long)(*(SPACE)) ); );
+        opal_datatype_gather( *(DESTINATION), _source, _end_loop->size, _loop->extent, _copy_loops );
+        *(DESTINATION) += _copy_loops * _end_loop->size;
+        _source        += _copy_loops * _loop->extent;
+    }
+#else
     for( _i = 0; _i < _copy_loops; _i++ ) {
         OPAL_DATATYPE_SAFEGUARD_POINTER( _source, _end_loop->size, (CONVERTOR)->pBaseBuf,
                                     (CONVERTOR)->pDesc, (CONVERTOR)->count );
@@ -96,6 +125,7 @@ static inline void pack_contiguous_loop( opal_convertor_t* CONVERTOR,
         *(DESTINATION) += _end_loop->size;
         _source        += _loop->extent;
     }
+#endif  /* OPAL_DATATYPE_STRIDED_COPY */
     *(SOURCE) = _source - _end_loop->first_elem_disp;
     *(SPACE) -= _copy_loops * _end_loop->size;
     *(COUNT) -= _copy_loops;
@@ -0,0 +1,249 @@
+/* -*- Mode: C; c-basic-offset:4 ; -*- */
+/*
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "opal_config.h"
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "opal/datatype/opal_datatype_strided.h"
+
+#if OPAL_HAVE_X86_SIMD
+#include <immintrin.h>
+#endif
+
+typedef struct {
+    const char* name;
+    opal_datatype_strided_fn_t gather[OPAL_DATATYPE_STRIDED_SIZES];
+    opal_datatype_strided_fn_t scatter[OPAL_DATATYPE_STRIDED_SIZES];
+} opal_datatype_strided_kernels_t;
+
+/*
+ * Scalar kernels. The block size being a constant, each copy turns
+ * into a couple of moves instead of a call to memcpy. The vectorized
+ * kernels finish off with these whatever does not fill a full vector.
+ */
+#define STRIDED_SCALAR_KERNELS(N)                                              \
+static void gather##N##_scalar( unsigned char* dst, const unsigned char* src,  \
+                                OPAL_PTRDIFF_TYPE stride, size_t count )       \
+{                                                                              \
+    for( ; count > 0; count-- ) {                                              \
+        memcpy( dst, src, N );                                                 \
+        dst += N;                                                              \
+        src += stride;                                                         \
+    }                                                                          \
+}                                                                              \
+static void scatter##N##_scalar( unsigned char* dst, const unsigned char* src, \
+                                 OPAL_PTRDIFF_TYPE stride, size_t count )      \
+{                                                                              \
+    for( ; count > 0; count-- ) {                                              \
+        memcpy( dst, src, N );                                                 \
+        dst += stride;                                                         \
+        src += N;                                                              \
+    }                                                                          \
+}
+
+STRIDED_SCALAR_KERNELS(4)
+STRIDED_SCALAR_KERNELS(8)
+STRIDED_SCALAR_KERNELS(16)
+STRIDED_SCALAR_KERNELS(32)
+
+static const opal_datatype_strided_kernels_t scalar_kernels = {
+    "scalar",
+    { gather4_scalar, gather8_scalar, gather16_scalar, gather32_scalar },
+    { scatter4_scalar, scatter8_scalar, scatter16_scalar, scatter32_scalar }
+};
+
+#if OPAL_HAVE_X86_SIMD
+
+/*
+ * AVX2 kernels. Blocks of 4 and 8 bytes are fetched with the gather
+ * instructions, 8 and 4 at a time. The 32 bits offsets of the former
+ * limit the stride they can deal with. There are no scatter instructions
+ * before AVX-512, so unpacking stays scalar. Larger blocks are already
+ * one or two moves each, which the scalar kernels do just as well.
+ */
+__attribute__((target("avx2")))
+static void gather4_avx2( unsigned char* dst, const unsigned char* src,
+                          OPAL_PTRDIFF_TYPE stride, size_t count )
+{
+    if( (stride <= INT32_MAX / 8) && (stride >= -(INT32_MAX / 8)) ) {
+        const __m256i idx = _mm256_mullo_epi32( _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7),
+                                                _mm256_set1_epi32((int)stride) );
+        for( ; count >= 8; count -= 8 ) {
+            _mm256_storeu_si256( (__m256i*)dst, _mm256_i32gather_epi32((const int*)src, idx, 1) );
+            dst += 32;
+            src += 8 * stride;
+        }
+    }
+    gather4_scalar( dst, src, stride, count );
+}
+
+__attribute__((target("avx2")))
+static void gather8_avx2( unsigned char* dst, const unsigned char* src,
+                          OPAL_PTRDIFF_TYPE stride, size_t count )
+{
+    const __m256i idx = _mm256_setr_epi64x( 0, stride, 2 * stride, 3 * stride );
+
+    for( ; count >= 4; count -= 4 ) {
+        _mm256_storeu_si256( (__m256i*)dst, _mm256_i64gather_epi64((const long long*)src, idx, 1) );
+        dst += 32;
+        src += 4 * stride;
+    }
+    gather8_scalar( dst, src, stride, count );
+}
+
+static const opal_datatype_strided_kernels_t avx2_kernels = {
+    "avx2",
+    { gather4_avx2, gather8_avx2, gather16_scalar, gather32_scalar },
+    { scatter4_scalar, scatter8_scalar, scatter16_scalar, scatter32_scalar }
+};
+
+#if OPAL_HAVE_X86_AVX512
+
+/*
+ * AVX-512 kernels. A 512 bits register holds 16 blocks of 4 bytes, 8 of
+ * 8 bytes or 4 of 16 bytes (as pairs of 8 bytes lanes), moved with a
+ * single gather or scatter. Blocks of 32 bytes stay scalar.
+ * The lanes of a scatter are written in order, so overlapping blocks end
+ * up as if copied one after the other.
+ */
+__attribute__((target("avx512f")))
+static void gather4_avx512( unsigned char* dst, const unsigned char* src,
+                            OPAL_PTRDIFF_TYPE stride, size_t count )
+{
+    if( (stride <= INT32_MAX / 16) && (stride >= -(INT32_MAX / 16)) ) {
+        const __m512i idx = _mm512_mullo_epi32( _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9,
+                                                                   10, 11, 12, 13, 14, 15),
+                                                _mm512_set1_epi32((int)stride) );
+        for( ; count >= 16; count -= 16 ) {
+            _mm512_storeu_si512( dst, _mm512_i32gather_epi32(idx, src, 1) );
+            dst += 64;
+            src += 16 * stride;
+        }
+    }
+    gather4_scalar( dst, src, stride, count );
+}
+
+__attribute__((target("avx512f")))
+static void scatter4_avx512( unsigned char* dst, const unsigned char* src,
+                             OPAL_PTRDIFF_TYPE stride, size_t count )
+{
+    if( (stride <= INT32_MAX / 16) && (stride >= -(INT32_MAX / 16)) ) {
+        const __m512i idx = _mm512_mullo_epi32( _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9,
+                                                                   10, 11, 12, 13, 14, 15),
+                                                _mm512_set1_epi32((int)stride) );
+        for( ; count >= 16; count -= 16 ) {
+            _mm512_i32scatter_epi32( dst, idx, _mm512_loadu_si512(src), 1 );
+            dst += 16 * stride;
+            src += 64;
+        }
+    }
+    scatter4_scalar( dst, src, stride, count );
+}
+
+__attribute__((target("avx512f")))
+static void gather8_avx512( unsigned char* dst, const unsigned char* src,
+                            OPAL_PTRDIFF_TYPE stride, size_t count )
+{
+    const __m512i idx = _mm512_setr_epi64( 0, stride, 2 * stride, 3 * stride,
+                                           4 * stride, 5 * stride, 6 * stride, 7 * stride );
+
+    for( ; count >= 8; count -= 8 ) {
+        _mm512_storeu_si512( dst, _mm512_i64gather_epi64(idx, src, 1) );
+        dst += 64;
+        src += 8 * stride;
+    }
+    gather8_scalar( dst, src, stride, count );
+}
+
+__attribute__((target("avx512f")))
+static void scatter8_avx512( unsigned char* dst, const unsigned char* src,
+                             OPAL_PTRDIFF_TYPE stride, size_t count )
+{
+    const __m512i idx = _mm512_setr_epi64( 0, stride, 2 * stride, 3 * stride,
+                                           4 * stride, 5 * stride, 6 * stride, 7 * stride );
+
+    for( ; count >= 8; count -= 8 ) {
+        _mm512_i64scatter_epi64( dst, idx, _mm512_loadu_si512(src), 1 );
+        dst += 8 * stride;
+        src += 64;
+    }
+    scatter8_scalar( dst, src, stride, count );
+}
+
+__attribute__((target("avx512f")))
+static void gather16_avx512( unsigned char* dst, const unsigned char* src,
+                             OPAL_PTRDIFF_TYPE stride, size_t count )
+{
+    const __m512i idx = _mm512_setr_epi64( 0, 8, stride, stride + 8,
+                                           2 * stride, 2 * stride + 8, 3 * stride, 3 * stride + 8 );
+
+    for( ; count >= 4; count -= 4 ) {
+        _mm512_storeu_si512( dst, _mm512_i64gather_epi64(idx, src, 1) );
+        dst += 64;
+        src += 4 * stride;
+    }
+    gather16_scalar( dst, src, stride, count );
+}
+
+__attribute__((target("avx512f")))
+static void scatter16_avx512( unsigned char* dst, const unsigned char* src,
+                              OPAL_PTRDIFF_TYPE stride, size_t count )
+{
+    const __m512i idx = _mm512_setr_epi64( 0, 8, stride, stride + 8,
+                                           2 * stride, 2 * stride + 8, 3 * stride, 3 * stride + 8 );
+
+    for( ; count >= 4; count -= 4 ) {
+        _mm512_i64scatter_epi64( dst, idx, _mm512_loadu_si512(src), 1 );
+        dst += 4 * stride;
+        src += 64;
+    }
+    scatter16_scalar( dst, src, stride, count );
+}
+
+static const opal_datatype_strided_kernels_t avx512_kernels = {
+    "avx512",
+    { gather4_avx512, gather8_avx512, gather16_avx512, gather32_scalar },
+    { scatter4_avx512, scatter8_avx512, scatter16_avx512, scatter32_scalar }
+};
+
+#endif  /* OPAL_HAVE_X86_AVX512 */
+
+#endif  /* OPAL_HAVE_X86_SIMD */
+
+opal_datatype_strided_fn_t opal_datatype_gather_fns[OPAL_DATATYPE_STRIDED_SIZES] = {
+    gather4_scalar, gather8_scalar, gather16_scalar, gather32_scalar
+};
+opal_datatype_strided_fn_t opal_datatype_scatter_fns[OPAL_DATATYPE_STRIDED_SIZES] = {
+    scatter4_scalar, scatter8_scalar, scatter16_scalar, scatter32_scalar
+};
+
+const char* opal_datatype_strided_select( bool use_simd )
+{
+    const opal_datatype_strided_kernels_t* kernels = &scalar_kernels;
+
+#if OPAL_HAVE_X86_SIMD
+    if( use_simd ) {
+        __builtin_cpu_init();
+#if OPAL_HAVE_X86_AVX512
+        if( __builtin_cpu_supports("avx512f") ) {
+            kernels = &avx512_kernels;
+        } else
+#endif  /* OPAL_HAVE_X86_AVX512 */
+        if( __builtin_cpu_supports("avx2") ) {
+            kernels = &avx2_kernels;
+        }
+    }
+#endif  /* OPAL_HAVE_X86_SIMD */
+    memcpy( opal_datatype_gather_fns, kernels->gather, sizeof(opal_datatype_gather_fns) );
+    memcpy( opal_datatype_scatter_fns, kernels->scatter, sizeof(opal_datatype_scatter_fns) );
+    return kernels->name;
+}
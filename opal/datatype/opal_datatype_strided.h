@@ -0,0 +1,101 @@
+/* -*- Mode: C; c-basic-offset:4 ; -*- */
+/*
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#ifndef OPAL_DATATYPE_STRIDED_H_HAS_BEEN_INCLUDED
+#define OPAL_DATATYPE_STRIDED_H_HAS_BEEN_INCLUDED
+
+#include "opal_config.h"
+
+#include <stddef.h>
+#include <string.h>
+
+/*
+ * Copying of equally sized blocks at a constant stride, the innermost
+ * operation of packing and unpacking vectors and of contiguous types
+ * with gaps. A gather packs count blocks of blength bytes, stride bytes
+ * apart in the source, one after the other in the destination; a scatter
+ * does the opposite. The common block sizes have their own kernels,
+ * vectorized ones being picked at run time when the processor has them.
+ * Any other size is copied one block at a time.
+ */
+
+BEGIN_C_DECLS
+
+/* checksumming and CUDA builds have to do every copy through MEMCPY_CSUM */
+#if defined(CHECKSUM) || OPAL_CUDA_SUPPORT
+#define OPAL_DATATYPE_STRIDED_COPY 0
+#else
+#define OPAL_DATATYPE_STRIDED_COPY 1
+#endif
+
+/* the block sizes with a kernel of their own: 4, 8, 16 and 32 bytes */
+#define OPAL_DATATYPE_STRIDED_SIZES  4
+
+typedef void (*opal_datatype_strided_fn_t)( unsigned char* dst, const unsigned char* src,
+                                            OPAL_PTRDIFF_TYPE stride, size_t count );
+
+OPAL_DECLSPEC extern opal_datatype_strided_fn_t opal_datatype_gather_fns[OPAL_DATATYPE_STRIDED_SIZES];
+OPAL_DECLSPEC extern opal_datatype_strided_fn_t opal_datatype_scatter_fns[OPAL_DATATYPE_STRIDED_SIZES];
+
+/* whether to use the vectorized kernels, the mpi_ddt_simd parameter */
+extern bool opal_datatype_simd;
+
+/**
+ * Pick the kernels to use from now on, the vectorized ones only if
+ * use_simd is set and the processor supports them. Returns the name of
+ * the instruction set picked.
+ */
+OPAL_DECLSPEC const char* opal_datatype_strided_select( bool use_simd );
+
+static inline int opal_datatype_strided_index( size_t blength )
+{
+    switch( blength ) {
+    case 4:  return 0;
+    case 8:  return 1;
+    case 16: return 2;
+    case 32: return 3;
+    }
+    return -1;
+}
+
+static inline void opal_datatype_gather( unsigned char* dst, const unsigned char* src,
+                                         size_t blength, OPAL_PTRDIFF_TYPE stride, size_t count )
+{
+    int index = opal_datatype_strided_index( blength );
+
+    if( 0 <= index ) {
+        opal_datatype_gather_fns[index]( dst, src, stride, count );
+        return;
+    }
+    for( ; count > 0; count-- ) {
+        memcpy( dst, src, blength );
+        dst += blength;
+        src += stride;
+    }
+}
+
+static inline void opal_datatype_scatter( unsigned char* dst, const unsigned char* src,
+                                          size_t blength, OPAL_PTRDIFF_TYPE stride, size_t count )
+{
+    int index = opal_datatype_strided_index( blength );
+
+    if( 0 <= index ) {
+        opal_datatype_scatter_fns[index]( dst, src, stride, count );
+        return;
+    }
+    for( ; count > 0; count-- ) {
+        memcpy( dst, src, blength );
+        dst += stride;
+        src += blength;
+    }
+}
+
+END_C_DECLS
+
+#endif  /* OPAL_DATATYPE_STRIDED_H_HAS_BEEN_INCLUDED */
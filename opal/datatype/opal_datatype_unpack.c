@@ -127,6 +127,21 @@ opal_unpack_homogeneous_contig_function( opal_convertor_t* pConv,
                     }
                 }
             }
+#if OPAL_DATATYPE_STRIDED_COPY
+            i = (uint32_t)(remaining / pData->size);
+            if( 0 != i ) {
+                OPAL_DATATYPE_SAFEGUARD_POINTER( user_memory, pData->size, pConv->pBaseBuf,
+                                                 pData, pConv->count );
+                OPAL_DATATYPE_SAFEGUARD_POINTER( user_memory + (i - 1) * extent, pData->size,
+                                                 pConv->pBaseBuf, pData, pConv->count );
+                DO_DEBUG( opal_output( 0, "3. unpack dest %p src %p length %lu x %lu\n",
+                                       user_memory, packed_buffer, (unsigned long)i, (unsigned long)pData->size ); );
+                opal_datatype_scatter( user_memory, packed_buffer, pData->size, extent, i );
+                packed_buffer += i * pData->size;
+                user_memory   += i * extent;
+                remaining     -= i * pData->size;
+            }
+#else
             for( i = 0; pData->size <= remaining; i++ ) {
                 OPAL_DATATYPE_SAFEGUARD_POINTER( user_memory, pData->size, pConv->pBaseBuf,
                                                  pData, pConv->count );
@@ -137,6 +152,7 @@ opal_unpack_homogeneous_contig_function( opal_convertor_t* pConv,
                 user_memory   += extent;
                 remaining     -= pData->size;
             }
+#endif  /* OPAL_DATATYPE_STRIDED_COPY */
             stack[0].count -= i;
             stack[0].disp  += (i * extent);
             stack[1].disp  += remaining;
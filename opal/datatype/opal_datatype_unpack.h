@@ -17,6 +17,8 @@
 
 #include "opal_config.h"
 
+#include "opal/datatype/opal_datatype_strided.h"
+
 #if !defined(CHECKSUM) && OPAL_CUDA_SUPPORT
 /* Make use of existing macro to do CUDA style memcpy */
 #undef MEMCPY_CSUM
@@ -54,6 +56,17 @@ unpack_predefined_data( opal_convertor_t* CONVERTOR,  /* the convertor */
         *(SOURCE)    += _copy_blength;
         _destination += _copy_blength;
     } else {
+#if OPAL_DATATYPE_STRIDED_COPY
+        OPAL_DATATYPE_SAFEGUARD_POINTER( _destination, _copy_blength, (CONVERTOR)->pBaseBuf,
+                                    (CONVERTOR)->pDesc, (CONVERTOR)->count );
+        OPAL_DATATYPE_SAFEGUARD_POINTER( _destination + (_copy_count - 1) * _elem->extent, _copy_blength,
+                                    (CONVERTOR)->pBaseBuf, (CONVERTOR)->pDesc, (CONVERTOR)->count );
+        DO_DEBUG( opal_output( 0, "unpack 2. scatter( %p, %p, %lu x %lu ) => space %lu\n",
+                               _destination, *(SOURCE), (unsigned long)_copy_count, (unsigned long)_copy_blength, (unsigned long)(*(SPACE)) ); );
+        opal_datatype_scatter( _destination, *(SOURCE), _copy_blength, _elem->extent, _copy_count );
+        *(SOURCE)    += _copy_count * _copy_blength;
+        _destination += _copy_count * _elem->extent;
+#else
         uint32_t _i;
         for( _i = 0; _i < _copy_count; _i++ ) {
             OPAL_DATATYPE_SAFEGUARD_POINTER( _destination, _copy_blength, (CONVERTOR)->pBaseBuf,
@@ -64,6 +77,7 @@ unpack_predefined_data( opal_convertor_t* CONVERTOR,  /* the convertor */
             *(SOURCE)    += _copy_blength;
             _destination += _elem->extent;
         }
+#endif  /* OPAL_DATATYPE_STRIDED_COPY */
         _copy_blength *= _copy_count;
     }
     (*DESTINATION)  = _destination - _elem->disp;
@@ -82,10 +96,25 @@ static inline void unpack_contiguous_loop( opal_convertor_t* CONVERTOR,
     const ddt_endloop_desc_t* _end_loop = (ddt_endloop_desc_t*)((ELEM) + _loop->items);
     unsigned char* _destination = (*DESTINATION) + _end_loop->first_elem_disp;
     uint32_t _copy_loops = *(COUNT);
+#if !OPAL_DATATYPE_STRIDED_COPY
     uint32_t _i;
+#endif
 
     if( (_copy_loops * _end_loop->size) > *(SPACE) )
         _copy_loops = (uint32_t)(*(SPACE) / _end_loop->size);
+#if OPAL_DATATYPE_STRIDED_COPY
+    if( 0 != _copy_loops ) {
+        OPAL_DATATYPE_SAFEGUARD_POINTER( _destination, _end_loop->size, (CONVERTOR)->pBaseBuf,
+                                    (CONVERTOR)->pDesc, (CONVERTOR)->count );
+        OPAL_DATATYPE_SAFEGUARD_POINTER( _destination + (_copy_loops - 1) * _loop->extent, _end_loop->size,
+                                    (CONVERTOR)->pBaseBuf, (CONVERTOR)->pDesc, (CONVERTOR)->count );
+        DO_DEBUG( opal_output( 0, "unpack 3. scatter( %p, %p, %lu x %lu ) => space %lu\n",
+                               _destination, *(SOURCE), (unsigned long)_copy_loops, (unsigned long)_end_loop->size, (unsigned long)(*(SPACE)) ); );
+        opal_datatype_scatter( _destination, *(SOURCE), _end_loop->size, _loop->extent, _copy_loops );
+        *(SOURCE)    += _copy_loops * _end_loop->size;
+        _destination += _copy_loops * _loop->extent;
+    }
+#else
     for( _i = 0; _i < _copy_loops; _i++ ) {
         OPAL_DATATYPE_SAFEGUARD_POINTER( _destination, _end_loop->size, (CONVERTOR)->pBaseBuf,
                                     (CONVERTOR)->pDesc, (CONVERTOR)->count );
@@ -95,6 +124,7 @@ static inline void unpack_contiguous_loop( opal_convertor_t* CONVERTOR,
         *(SOURCE)    += _end_loop->size;
         _destination += _loop->extent;
     }
+#endif  /* OPAL_DATATYPE_STRIDED_COPY */
     *(DESTINATION) = _destination - _end_loop->first_elem_disp;
     *(SPACE)      -= _copy_loops * _end_loop->size;
     *(COUNT)      -= _copy_loops;
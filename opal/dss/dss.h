@@ -472,6 +472,26 @@ typedef void (*opal_dss_dump_data_types_fn_t)(int output);
 /* return true if the data type is structured */
 typedef bool (*opal_dss_structured_fn_t)(opal_data_type_t type);
 
+/**
+ * Get a new buffer sized for a known kind of message.
+ *
+ * Returns an empty buffer, just as OBJ_NEW(opal_buffer_t) would, but
+ * with room already allocated for a message as big as the recent ones
+ * built from the same lease. When the buffer is released, the size of
+ * what was packed into it is folded back into the lease.
+ *
+ * @code
+ * static opal_dss_lease_t lease = OPAL_DSS_LEASE_STATIC_INIT;
+ * opal_buffer_t *buf = opal_dss.lease(&lease);
+ * @endcode
+ *
+ * @param lease [IN] Sizing hint for this kind of message. A NULL
+ * lease gives a plain new buffer.
+ *
+ * @retval NULL The buffer could not be allocated.
+ */
+typedef opal_buffer_t* (*opal_dss_lease_fn_t)(opal_dss_lease_t *lease);
+
 /**
  * Base structure for the DSS
  *
@@ -493,6 +513,7 @@ struct opal_dss_t {
     opal_dss_lookup_data_type_fn_t  lookup_data_type;
     opal_dss_dump_data_types_fn_t   dump_data_types;
     opal_dss_dump_fn_t              dump;
+    opal_dss_lease_fn_t             lease;
 };
 typedef struct opal_dss_t opal_dss_t;
 
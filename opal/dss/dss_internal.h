@@ -50,9 +50,14 @@ BEGIN_C_DECLS
 #define OPAL_DSS_DEFAULT_INITIAL_SIZE  128
 /*
  * The default threshold size when we switch from doubling the
- * buffer size to addatively increasing it
+ * buffer size to growing it by half, in multiples of the threshold
  */
 #define OPAL_DSS_DEFAULT_THRESHOLD_SIZE 1024
+/*
+ * The default number of free blocks the buffer pool keeps
+ * of each size
+ */
+#define OPAL_DSS_DEFAULT_POOL_DEPTH  32
 
 /*
  * Internal type corresponding to size_t.  Do not use this in
@@ -206,6 +211,7 @@ extern bool opal_dss_debug;
 extern int opal_dss_verbose;
 extern int opal_dss_initial_size;
 extern int opal_dss_threshold_size;
+extern int opal_dss_pool_depth;
 extern opal_pointer_array_t opal_dss_types;
 extern opal_data_type_t opal_dss_num_reg_types;
 
@@ -254,6 +260,8 @@ char *opal_dss_lookup_data_type(opal_data_type_t type);
 
 void opal_dss_dump_data_types(int output);
 
+opal_buffer_t* opal_dss_lease(opal_dss_lease_t *lease);
+
 /*
  * Specialized functions
  */
@@ -560,6 +568,46 @@ int opal_dss_store_data_type(opal_buffer_t *buffer, opal_data_type_t type);
 
 int opal_dss_get_data_type(opal_buffer_t *buffer, opal_data_type_t *type);
 
+/*
+ * Varint encodings for compact buffers - integers of the given width,
+ * and 32-bit values every stride bytes sent as deltas
+ */
+int opal_dss_pack_varint(opal_buffer_t *buffer, uint64_t val);
+int opal_dss_unpack_varint(opal_buffer_t *buffer, uint64_t *val);
+int opal_dss_pack_varints(opal_buffer_t *buffer, const void *src,
+                          int32_t num_vals, size_t width);
+int opal_dss_unpack_varints(opal_buffer_t *buffer, void *dest,
+                            int32_t num_vals, size_t width);
+int opal_dss_pack_deltas(opal_buffer_t *buffer, const void *src,
+                         int32_t num_vals, size_t stride);
+int opal_dss_unpack_deltas(opal_buffer_t *buffer, void *dest,
+                           int32_t num_vals, size_t stride);
+
+/*
+ * Pool of buffer storage - alloc and realloc round the size up to
+ * what they actually allocated, free takes the size the block has
+ */
+void opal_dss_pool_init(void);
+void opal_dss_pool_finalize(void);
+void *opal_dss_pool_alloc(size_t *size);
+void opal_dss_pool_free(void *block, size_t size);
+void *opal_dss_pool_realloc(void *block, size_t size, size_t used, size_t *new_size);
+void opal_dss_lease_update(opal_dss_lease_t *lease, size_t used);
+
+/*
+ * Byte-swapping kernels - copy n values between host and network
+ * byte order. Neither pointer needs to be aligned. The split and
+ * merge kernels convert an array of pairs of 32-bit values (e.g.,
+ * process names) to and from two separate arrays.
+ */
+const char *opal_dss_swap_select(bool use_simd);
+
+void opal_dss_swap16(void *dst, const void *src, size_t n);
+void opal_dss_swap32(void *dst, const void *src, size_t n);
+void opal_dss_swap64(void *dst, const void *src, size_t n);
+void opal_dss_split32x2(void *dsta, void *dstb, const void *src, size_t n);
+void opal_dss_merge32x2(void *dst, const void *srca, const void *srcb, size_t n);
+
 END_C_DECLS
 
 #endif
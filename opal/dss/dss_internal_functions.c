@@ -44,7 +44,13 @@ char* opal_dss_buffer_extend(opal_buffer_t *buffer, size_t bytes_to_add)
 
     required = buffer->bytes_used + bytes_to_add;
     if(required >= (size_t)opal_dss_threshold_size) {
-        to_alloc = ((required + opal_dss_threshold_size - 1)
+        /* grow by half at least, so a buffer built up in many small
+         * packs is not copied over and over again */
+        to_alloc = buffer->bytes_allocated + buffer->bytes_allocated / 2;
+        if (to_alloc < required) {
+            to_alloc = required;
+        }
+        to_alloc = ((to_alloc + opal_dss_threshold_size - 1)
                     / opal_dss_threshold_size) * opal_dss_threshold_size;
     } else {
         to_alloc = buffer->bytes_allocated;
@@ -60,12 +66,14 @@ char* opal_dss_buffer_extend(opal_buffer_t *buffer, size_t bytes_to_add)
         pack_offset = ((char*) buffer->pack_ptr) - ((char*) buffer->base_ptr);
         unpack_offset = ((char*) buffer->unpack_ptr) -
             ((char*) buffer->base_ptr);
-        buffer->base_ptr = (char*)realloc(buffer->base_ptr, to_alloc);
+        buffer->base_ptr = (char*)opal_dss_pool_realloc(buffer->base_ptr,
+                                                         buffer->bytes_allocated,
+                                                         buffer->bytes_used, &to_alloc);
     } else {
         pack_offset = 0;
         unpack_offset = 0;
         buffer->bytes_used = 0;
-        buffer->base_ptr = (char*)malloc(to_alloc);
+        buffer->base_ptr = (char*)opal_dss_pool_alloc(&to_alloc);
     }
 
     if (NULL == buffer->base_ptr) {
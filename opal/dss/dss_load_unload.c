@@ -89,7 +89,7 @@ int opal_dss_load(opal_buffer_t *buffer, void *payload,
 
     /* check if buffer already has payload - free it if so */
     if (NULL != buffer->base_ptr) {
-        free(buffer->base_ptr);
+        opal_dss_pool_free(buffer->base_ptr, buffer->bytes_allocated);
     }
 
     /* if it's a NULL payload, just set things and return */
@@ -39,6 +39,7 @@ int opal_dss_threshold_size = -1;
 opal_pointer_array_t opal_dss_types = {{0}};
 opal_data_type_t opal_dss_num_reg_types = {0};
 static opal_dss_buffer_type_t default_buf_type = OPAL_DSS_BUFFER_NON_DESC;
+static bool use_simd = true;
 
 /* variable group id */
 static int opal_dss_group_id = -1;
@@ -46,6 +47,7 @@ static int opal_dss_group_id = -1;
 mca_base_var_enum_value_t buffer_type_values[] = {
     {OPAL_DSS_BUFFER_NON_DESC, "non-described"},
     {OPAL_DSS_BUFFER_FULLY_DESC, "described"},
+    {OPAL_DSS_BUFFER_COMPACT, "compact"},
     {0, NULL}
 };
 
@@ -63,7 +65,8 @@ opal_dss_t opal_dss = {
     opal_dss_register,
     opal_dss_lookup_data_type,
     opal_dss_dump_data_types,
-    opal_dss_dump
+    opal_dss_dump,
+    opal_dss_lease
 };
 
 /**
@@ -105,12 +108,16 @@ static void opal_buffer_construct (opal_buffer_t* buffer)
 
     buffer->base_ptr = buffer->pack_ptr = buffer->unpack_ptr = NULL;
     buffer->bytes_allocated = buffer->bytes_used = 0;
+    buffer->lease = NULL;
 }
 
 static void opal_buffer_destruct (opal_buffer_t* buffer)
 {
     if (NULL != buffer->base_ptr) {
-        free (buffer->base_ptr);
+        if (NULL != buffer->lease && 0 < buffer->bytes_used) {
+            opal_dss_lease_update(buffer->lease, buffer->bytes_used);
+        }
+        opal_dss_pool_free(buffer->base_ptr, buffer->bytes_allocated);
     }
 }
 
@@ -260,7 +267,7 @@ int opal_dss_register_vars (void)
     }
 
     ret = mca_base_var_register ("opal", "dss", NULL, "buffer_type",
-                                 "Set the default mode for OpenRTE buffers (0=non-described, 1=described)",
+                                 "Set the default mode for OpenRTE buffers (0=non-described, 1=described, 2=compact - varint integers, delta-encoded vpids)",
                                  MCA_BASE_VAR_TYPE_INT, new_enum, 0, MCA_BASE_VAR_FLAG_SETTABLE,
                                  OPAL_INFO_LVL_8, MCA_BASE_VAR_SCOPE_ALL_EQ,
                                  &default_buf_type);
@@ -280,12 +287,35 @@ int opal_dss_register_vars (void)
     }
 
     /* the threshold as to where to stop doubling the size of the buffer
-     * allocated memory and start doing additive increases */
+     * allocated memory and start growing it by half at a time */
     opal_dss_threshold_size = OPAL_DSS_DEFAULT_THRESHOLD_SIZE;
     ret = mca_base_var_register ("opal", "dss", NULL, "buffer_threshold_size", NULL,
                                  MCA_BASE_VAR_TYPE_INT, NULL, 0, MCA_BASE_VAR_FLAG_SETTABLE,
                                  OPAL_INFO_LVL_8, MCA_BASE_VAR_SCOPE_ALL_EQ,
                                  &opal_dss_threshold_size);
+    if (0 > ret) {
+        return ret;
+    }
+
+    /* how many free blocks of each size to keep for reuse */
+    opal_dss_pool_depth = OPAL_DSS_DEFAULT_POOL_DEPTH;
+    ret = mca_base_var_register ("opal", "dss", NULL, "buffer_pool_depth",
+                                 "Number of released buffer allocations of each size to keep for reuse (0 = always return them to malloc)",
+                                 MCA_BASE_VAR_TYPE_INT, NULL, 0, MCA_BASE_VAR_FLAG_SETTABLE,
+                                 OPAL_INFO_LVL_8, MCA_BASE_VAR_SCOPE_LOCAL,
+                                 &opal_dss_pool_depth);
+    if (0 > ret) {
+        return ret;
+    }
+
+#if OPAL_HAVE_X86_SIMD
+    /* let the vectorized byte-swapping kernels be turned off */
+    ret = mca_base_var_register ("opal", "dss", NULL, "simd",
+                                 "Use SSSE3/AVX2 kernels to byte-swap arrays when the processor supports them",
+                                 MCA_BASE_VAR_TYPE_BOOL, NULL, 0, MCA_BASE_VAR_FLAG_SETTABLE,
+                                 OPAL_INFO_LVL_9, MCA_BASE_VAR_SCOPE_ALL_EQ,
+                                 &use_simd);
+#endif
 
     return (0 > ret) ? ret : OPAL_SUCCESS;
 }
@@ -294,6 +324,7 @@ int opal_dss_open(void)
 {
     int rc;
     opal_data_type_t tmp;
+    const char *kernels;
 
     if (opal_dss_initialized) {
         return OPAL_SUCCESS;
@@ -312,6 +343,12 @@ int opal_dss_open(void)
     }
     opal_dss_num_reg_types = 0;
 
+    /* pick the fastest byte-swapping kernels this processor can run */
+    kernels = opal_dss_swap_select(use_simd);
+    opal_output_verbose(0, opal_dss_verbose, "opal_dss: byte-swapping with %s kernels", kernels);
+
+    opal_dss_pool_init();
+
     /* Register all the intrinsic types */
 
     tmp = OPAL_NULL;
@@ -648,6 +685,8 @@ int opal_dss_close(void)
 
     OBJ_DESTRUCT(&opal_dss_types);
 
+    opal_dss_pool_finalize();
+
     return OPAL_SUCCESS;
 }
 
@@ -44,7 +44,12 @@ int opal_dss_pack(opal_buffer_t *buffer,
             return rc;
         }
     }
-    if (OPAL_SUCCESS != (rc = opal_dss_pack_int32(buffer, &num_vals, 1, OPAL_INT32))) {
+    if (OPAL_DSS_BUFFER_COMPACT == buffer->type) {
+        rc = opal_dss_pack_varint(buffer, (uint32_t)num_vals);
+    } else {
+        rc = opal_dss_pack_int32(buffer, &num_vals, 1, OPAL_INT32);
+    }
+    if (OPAL_SUCCESS != rc) {
         return rc;
     }
 
@@ -222,23 +227,22 @@ int opal_dss_pack_byte(opal_buffer_t *buffer, const void *src,
 int opal_dss_pack_int16(opal_buffer_t *buffer, const void *src,
                         int32_t num_vals, opal_data_type_t type)
 {
-    int32_t i;
-    uint16_t tmp, *srctmp = (uint16_t*) src;
     char *dst;
+    size_t bytes_packed = num_vals * sizeof(uint16_t);
 
     OPAL_OUTPUT( ( opal_dss_verbose, "opal_dss_pack_int16 * %d\n", num_vals ) );
+    if (OPAL_DSS_BUFFER_COMPACT == buffer->type) {
+        return opal_dss_pack_varints(buffer, src, num_vals, sizeof(uint16_t));
+    }
+
     /* check to see if buffer needs extending */
-    if (NULL == (dst = opal_dss_buffer_extend(buffer, num_vals*sizeof(tmp)))) {
+    if (NULL == (dst = opal_dss_buffer_extend(buffer, bytes_packed))) {
         return OPAL_ERR_OUT_OF_RESOURCE;
     }
 
-    for (i = 0; i < num_vals; ++i) {
-        tmp = htons(srctmp[i]);
-        memcpy(dst, &tmp, sizeof(tmp));
-        dst += sizeof(tmp);
-    }
-    buffer->pack_ptr += num_vals * sizeof(tmp);
-    buffer->bytes_used += num_vals * sizeof(tmp);
+    opal_dss_swap16(dst, src, num_vals);
+    buffer->pack_ptr += bytes_packed;
+    buffer->bytes_used += bytes_packed;
 
     return OPAL_SUCCESS;
 }
@@ -249,23 +253,22 @@ int opal_dss_pack_int16(opal_buffer_t *buffer, const void *src,
 int opal_dss_pack_int32(opal_buffer_t *buffer, const void *src,
                         int32_t num_vals, opal_data_type_t type)
 {
-    int32_t i;
-    uint32_t tmp, *srctmp = (uint32_t*) src;
     char *dst;
+    size_t bytes_packed = num_vals * sizeof(uint32_t);
 
     OPAL_OUTPUT( ( opal_dss_verbose, "opal_dss_pack_int32 * %d\n", num_vals ) );
+    if (OPAL_DSS_BUFFER_COMPACT == buffer->type) {
+        return opal_dss_pack_varints(buffer, src, num_vals, sizeof(uint32_t));
+    }
+
     /* check to see if buffer needs extending */
-    if (NULL == (dst = opal_dss_buffer_extend(buffer, num_vals*sizeof(tmp)))) {
+    if (NULL == (dst = opal_dss_buffer_extend(buffer, bytes_packed))) {
         return OPAL_ERR_OUT_OF_RESOURCE;
     }
 
-    for (i = 0; i < num_vals; ++i) {
-        tmp = htonl(srctmp[i]);
-        memcpy(dst, &tmp, sizeof(tmp));
-        dst += sizeof(tmp);
-    }
-    buffer->pack_ptr += num_vals * sizeof(tmp);
-    buffer->bytes_used += num_vals * sizeof(tmp);
+    opal_dss_swap32(dst, src, num_vals);
+    buffer->pack_ptr += bytes_packed;
+    buffer->bytes_used += bytes_packed;
 
     return OPAL_SUCCESS;
 }
@@ -276,22 +279,20 @@ int opal_dss_pack_int32(opal_buffer_t *buffer, const void *src,
 int opal_dss_pack_int64(opal_buffer_t *buffer, const void *src,
                         int32_t num_vals, opal_data_type_t type)
 {
-    int32_t i;
-    uint64_t tmp, *srctmp = (uint64_t*) src;
     char *dst;
-    size_t bytes_packed = num_vals * sizeof(tmp);
+    size_t bytes_packed = num_vals * sizeof(uint64_t);
 
     OPAL_OUTPUT( ( opal_dss_verbose, "opal_dss_pack_int64 * %d\n", num_vals ) );
+    if (OPAL_DSS_BUFFER_COMPACT == buffer->type) {
+        return opal_dss_pack_varints(buffer, src, num_vals, sizeof(uint64_t));
+    }
+
     /* check to see if buffer needs extending */
     if (NULL == (dst = opal_dss_buffer_extend(buffer, bytes_packed))) {
         return OPAL_ERR_OUT_OF_RESOURCE;
     }
 
-    for (i = 0; i < num_vals; ++i) {
-        tmp = hton64(srctmp[i]);
-        memcpy(dst, &tmp, sizeof(tmp));
-        dst += sizeof(tmp);
-    }
+    opal_dss_swap64(dst, src, num_vals);
     buffer->pack_ptr += bytes_packed;
     buffer->bytes_used += bytes_packed;
 
@@ -1154,54 +1155,57 @@ int opal_dss_pack_buffer_contents(opal_buffer_t *buffer, const void *src,
 /*
  * NAME
  */
-int opal_dss_pack_name(opal_buffer_t *buffer, const void *src,
-                           int32_t num_vals, opal_data_type_t type)
+static int reserve_array(opal_buffer_t *buffer, opal_data_type_t type,
+                         size_t nbytes, size_t *offset)
 {
     int rc;
-    int32_t i;
-    opal_process_name_t* proc;
-    opal_jobid_t *jobid;
-    opal_vpid_t *vpid;
-
-    /* collect all the jobids in a contiguous array */
-    jobid = (opal_jobid_t*)malloc(num_vals * sizeof(opal_jobid_t));
-    if (NULL == jobid) {
-        OPAL_ERROR_LOG(OPAL_ERR_OUT_OF_RESOURCE);
-        return OPAL_ERR_OUT_OF_RESOURCE;
+
+    if (OPAL_DSS_BUFFER_FULLY_DESC == buffer->type) {
+        if (OPAL_SUCCESS != (rc = opal_dss_store_data_type(buffer, type))) {
+            return rc;
+        }
     }
-    proc = (opal_process_name_t*)src;
-    for (i=0; i < num_vals; i++) {
-        jobid[i] = proc->jobid;
-        proc++;
+    if (NULL == opal_dss_buffer_extend(buffer, nbytes)) {
+        return OPAL_ERR_OUT_OF_RESOURCE;
     }
-    /* now pack them in one shot */
-    if (OPAL_SUCCESS != (rc =
-                         opal_dss_pack_jobid(buffer, jobid, num_vals, OPAL_JOBID))) {
-        OPAL_ERROR_LOG(rc);
-        free(jobid);
+    /* the buffer may move while the next array is reserved */
+    *offset = buffer->pack_ptr - buffer->base_ptr;
+    buffer->pack_ptr += nbytes;
+    buffer->bytes_used += nbytes;
+
+    return OPAL_SUCCESS;
+}
+
+int opal_dss_pack_name(opal_buffer_t *buffer, const void *src,
+                           int32_t num_vals, opal_data_type_t type)
+{
+    int rc;
+    size_t jobids, vpids;
+
+    if (OPAL_DSS_BUFFER_COMPACT == buffer->type) {
+        /* the names in a job are mostly in order, so both
+         * arrays come out at a byte or so per entry */
+        if (OPAL_SUCCESS != (rc = opal_dss_pack_deltas(buffer, src, num_vals,
+                                                       sizeof(opal_process_name_t))) ||
+            OPAL_SUCCESS != (rc = opal_dss_pack_deltas(buffer, (const char*)src + sizeof(opal_jobid_t),
+                                                       num_vals, sizeof(opal_process_name_t)))) {
+            OPAL_ERROR_LOG(rc);
+        }
         return rc;
     }
-    free(jobid);
 
-    /* collect all the vpids in a contiguous array */
-    vpid = (opal_vpid_t*)malloc(num_vals * sizeof(opal_vpid_t));
-    if (NULL == vpid) {
-        OPAL_ERROR_LOG(OPAL_ERR_OUT_OF_RESOURCE);
-        return OPAL_ERR_OUT_OF_RESOURCE;
-    }
-    proc = (opal_process_name_t*)src;
-    for (i=0; i < num_vals; i++) {
-        vpid[i] = proc->vpid;
-        proc++;
-    }
-    /* now pack them in one shot */
-    if (OPAL_SUCCESS != (rc =
-                         opal_dss_pack_vpid(buffer, vpid, num_vals, OPAL_VPID))) {
+    /* the names go out as an array of jobids followed by an array
+     * of vpids, each laid out as if packed on its own - make room
+     * for both, then fill them in one pass over the names */
+    if (OPAL_SUCCESS != (rc = reserve_array(buffer, OPAL_JOBID_T,
+                                            num_vals * sizeof(opal_jobid_t), &jobids)) ||
+        OPAL_SUCCESS != (rc = reserve_array(buffer, OPAL_VPID_T,
+                                            num_vals * sizeof(opal_vpid_t), &vpids))) {
         OPAL_ERROR_LOG(rc);
-        free(vpid);
         return rc;
     }
-    free(vpid);
+    opal_dss_split32x2(buffer->base_ptr + jobids, buffer->base_ptr + vpids,
+                       src, num_vals);
 
     return OPAL_SUCCESS;
 }
@@ -1231,6 +1235,15 @@ int opal_dss_pack_vpid(opal_buffer_t *buffer, const void *src,
 {
     int ret;
 
+    /* arrays of vpids are usually sorted - send the gaps */
+    if (OPAL_DSS_BUFFER_COMPACT == buffer->type) {
+        if (OPAL_SUCCESS != (ret = opal_dss_pack_deltas(buffer, src, num_vals,
+                                                        sizeof(opal_vpid_t)))) {
+            OPAL_ERROR_LOG(ret);
+        }
+        return ret;
+    }
+
     /* Turn around and pack the real type */
     if (OPAL_SUCCESS != (
                          ret = opal_dss_pack_buffer(buffer, src, num_vals, OPAL_VPID_T))) {
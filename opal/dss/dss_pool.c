@@ -0,0 +1,195 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+/*
+ * Pool of buffer storage. Most buffers live for a single message, so
+ * rather than going back to malloc every time, the storage released
+ * by one buffer is kept for the next. Blocks are grouped in classes
+ * of power-of-two multiples of the initial buffer size, each a short
+ * stack of free blocks linked through their first word.
+ *
+ * The blocks are plain malloc'd memory - the payload of a buffer can
+ * be unloaded and later free'd by whoever took it, and anything free'd
+ * that way simply never comes back to the pool.
+ */
+
+#include "opal_config.h"
+
+#include <string.h>
+
+#include "opal/sys/atomic.h"
+
+#include "opal/dss/dss_internal.h"
+
+#define OPAL_DSS_POOL_CLASSES   10
+
+typedef struct {
+    opal_atomic_lock_t lock;
+    void *head;
+    int depth;
+} opal_dss_pool_class_t;
+
+static opal_dss_pool_class_t pool[OPAL_DSS_POOL_CLASSES];
+static size_t min_size;
+static bool pool_active = false;
+
+/* blocks kept per class - zero turns the pool off */
+int opal_dss_pool_depth = -1;
+
+void opal_dss_pool_init(void)
+{
+    int i;
+
+    for (i = 0; i < OPAL_DSS_POOL_CLASSES; i++) {
+        opal_atomic_init(&pool[i].lock, OPAL_ATOMIC_UNLOCKED);
+        pool[i].head = NULL;
+        pool[i].depth = 0;
+    }
+    /* each block has to hold the link to the next */
+    min_size = (sizeof(void*) < (size_t)opal_dss_initial_size) ?
+        (size_t)opal_dss_initial_size : sizeof(void*);
+    pool_active = (0 < opal_dss_pool_depth);
+}
+
+void opal_dss_pool_finalize(void)
+{
+    void *block;
+    int i;
+
+    /* anything released from here on goes straight back to malloc */
+    pool_active = false;
+    for (i = 0; i < OPAL_DSS_POOL_CLASSES; i++) {
+        while (NULL != (block = pool[i].head)) {
+            pool[i].head = *(void**)block;
+            free(block);
+        }
+        pool[i].depth = 0;
+    }
+}
+
+void *opal_dss_pool_alloc(size_t *size)
+{
+    size_t csize = min_size;
+    void *block = NULL;
+    int i;
+
+    if (!pool_active) {
+        return malloc(*size);
+    }
+    /* find the smallest class the request fits in */
+    for (i = 0; i < OPAL_DSS_POOL_CLASSES && csize < *size; i++) {
+        csize <<= 1;
+    }
+    if (OPAL_DSS_POOL_CLASSES == i) {
+        return malloc(*size);
+    }
+    *size = csize;
+
+    opal_atomic_lock(&pool[i].lock);
+    if (NULL != (block = pool[i].head)) {
+        pool[i].head = *(void**)block;
+        pool[i].depth--;
+    }
+    opal_atomic_unlock(&pool[i].lock);
+    if (NULL == block) {
+        block = malloc(csize);
+    }
+    return block;
+}
+
+void opal_dss_pool_free(void *block, size_t size)
+{
+    size_t csize = min_size;
+    int i;
+
+    if (NULL == block) {
+        return;
+    }
+    /* the block goes in the largest class it can hold - a
+     * loaded payload need not be a class size itself */
+    if (pool_active && csize <= size) {
+        for (i = 0; i < OPAL_DSS_POOL_CLASSES - 1 && (csize << 1) <= size; i++) {
+            csize <<= 1;
+        }
+        if (size < (csize << 1)) {
+            opal_atomic_lock(&pool[i].lock);
+            if (pool[i].depth < opal_dss_pool_depth) {
+                *(void**)block = pool[i].head;
+                pool[i].head = block;
+                pool[i].depth++;
+                block = NULL;
+            }
+            opal_atomic_unlock(&pool[i].lock);
+        }
+    }
+    if (NULL != block) {
+        free(block);
+    }
+}
+
+void *opal_dss_pool_realloc(void *block, size_t size, size_t used, size_t *new_size)
+{
+    void *nblock;
+
+    if (!pool_active) {
+        return realloc(block, *new_size);
+    }
+    /* big blocks are better left to realloc, which may
+     * be able to grow them in place */
+    if (*new_size >= (min_size << (OPAL_DSS_POOL_CLASSES - 1))) {
+        return realloc(block, *new_size);
+    }
+    if (NULL == (nblock = opal_dss_pool_alloc(new_size))) {
+        return NULL;
+    }
+    memcpy(nblock, block, used);
+    opal_dss_pool_free(block, size);
+    return nblock;
+}
+
+/*
+ * A lease remembers how big the messages built from it have been, so
+ * the next buffer can start out with enough room for the whole thing.
+ * The size follows the largest message at once and drifts back down
+ * slowly when they get smaller. Nobody locks the lease - at worst a
+ * racing update is lost, and the size is only ever a hint.
+ */
+opal_buffer_t *opal_dss_lease(opal_dss_lease_t *lease)
+{
+    opal_buffer_t *buffer;
+    size_t size;
+
+    if (NULL == (buffer = OBJ_NEW(opal_buffer_t))) {
+        return NULL;
+    }
+    if (NULL == lease) {
+        return buffer;
+    }
+    buffer->lease = lease;
+
+    if (0 < (size = lease->size)) {
+        /* if this fails, the buffer just grows as usual */
+        if (NULL != (buffer->base_ptr = (char*)opal_dss_pool_alloc(&size))) {
+            buffer->pack_ptr = buffer->unpack_ptr = buffer->base_ptr;
+            buffer->bytes_allocated = size;
+        }
+    }
+    return buffer;
+}
+
+void opal_dss_lease_update(opal_dss_lease_t *lease, size_t used)
+{
+    size_t size = lease->size;
+
+    if (used > size) {
+        lease->size = used;
+    } else {
+        lease->size = size - (size - used) / 8;
+    }
+}
@@ -0,0 +1,320 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "opal_config.h"
+
+#include <string.h>
+
+#include "opal/types.h"
+#include "opal/dss/dss_internal.h"
+
+#if OPAL_HAVE_X86_SIMD && defined(HAVE_UNIX_BYTESWAP) && !defined(WORDS_BIGENDIAN)
+#define OPAL_DSS_SWAP_SIMD 1
+#include <immintrin.h>
+#else
+#define OPAL_DSS_SWAP_SIMD 0
+#endif
+
+/*
+ * Scalar kernels - these also finish off whatever
+ * is left over by the vectorized ones
+ */
+static void swap16_scalar(void *dst, const void *src, size_t n)
+{
+    const char *s = (const char*)src;
+    char *d = (char*)dst;
+    uint16_t tmp;
+    size_t i;
+
+    for (i = 0; i < n; ++i) {
+        memcpy(&tmp, s, sizeof(tmp));
+        tmp = htons(tmp);
+        memcpy(d, &tmp, sizeof(tmp));
+        s += sizeof(tmp);
+        d += sizeof(tmp);
+    }
+}
+
+static void swap32_scalar(void *dst, const void *src, size_t n)
+{
+    const char *s = (const char*)src;
+    char *d = (char*)dst;
+    uint32_t tmp;
+    size_t i;
+
+    for (i = 0; i < n; ++i) {
+        memcpy(&tmp, s, sizeof(tmp));
+        tmp = htonl(tmp);
+        memcpy(d, &tmp, sizeof(tmp));
+        s += sizeof(tmp);
+        d += sizeof(tmp);
+    }
+}
+
+static void swap64_scalar(void *dst, const void *src, size_t n)
+{
+    const char *s = (const char*)src;
+    char *d = (char*)dst;
+    uint64_t tmp;
+    size_t i;
+
+    for (i = 0; i < n; ++i) {
+        memcpy(&tmp, s, sizeof(tmp));
+        tmp = hton64(tmp);
+        memcpy(d, &tmp, sizeof(tmp));
+        s += sizeof(tmp);
+        d += sizeof(tmp);
+    }
+}
+
+static void split32x2_scalar(void *dsta, void *dstb, const void *src, size_t n)
+{
+    const char *s = (const char*)src;
+    char *a = (char*)dsta, *b = (char*)dstb;
+    uint32_t tmp;
+    size_t i;
+
+    for (i = 0; i < n; ++i) {
+        memcpy(&tmp, s, sizeof(tmp));
+        tmp = htonl(tmp);
+        memcpy(a, &tmp, sizeof(tmp));
+        memcpy(&tmp, s + sizeof(tmp), sizeof(tmp));
+        tmp = htonl(tmp);
+        memcpy(b, &tmp, sizeof(tmp));
+        s += 2 * sizeof(tmp);
+        a += sizeof(tmp);
+        b += sizeof(tmp);
+    }
+}
+
+static void merge32x2_scalar(void *dst, const void *srca, const void *srcb, size_t n)
+{
+    const char *a = (const char*)srca, *b = (const char*)srcb;
+    char *d = (char*)dst;
+    uint32_t tmp;
+    size_t i;
+
+    for (i = 0; i < n; ++i) {
+        memcpy(&tmp, a, sizeof(tmp));
+        tmp = ntohl(tmp);
+        memcpy(d, &tmp, sizeof(tmp));
+        memcpy(&tmp, b, sizeof(tmp));
+        tmp = ntohl(tmp);
+        memcpy(d + sizeof(tmp), &tmp, sizeof(tmp));
+        a += sizeof(tmp);
+        b += sizeof(tmp);
+        d += 2 * sizeof(tmp);
+    }
+}
+
+/* byte shuffles for a 128-bit lane - the AVX2 kernels use
+ * the same pattern in both of their lanes */
+static const char swap16_mask[32] = {
+    1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14,
+    1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14
+};
+static const char swap32_mask[32] = {
+    3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12,
+    3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12
+};
+static const char swap64_mask[32] = {
+    7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8,
+    7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8
+};
+
+/* the vectorized kernels only do whole vectors, and return
+ * how much they did - the scalar ones do nothing at all */
+typedef struct {
+    const char *name;
+    size_t (*shuffle)(char *d, const char *s, size_t nbytes, const char *pattern);
+    size_t (*split32x2)(char *a, char *b, const char *s, size_t n);
+    size_t (*merge32x2)(char *d, const char *a, const char *b, size_t n);
+} opal_dss_swap_kernels_t;
+
+static size_t shuffle_none(char *d, const char *s, size_t nbytes, const char *pattern)
+{
+    return 0;
+}
+
+static size_t split32x2_none(char *a, char *b, const char *s, size_t n)
+{
+    return 0;
+}
+
+static size_t merge32x2_none(char *d, const char *a, const char *b, size_t n)
+{
+    return 0;
+}
+
+static const opal_dss_swap_kernels_t scalar_kernels = {
+    "scalar", shuffle_none, split32x2_none, merge32x2_none
+};
+
+#if OPAL_DSS_SWAP_SIMD
+
+/* (a0 b0 a1 b1) <-> (a0 a1 b0 b1), swapping each 32-bit value
+ * on the way - the same shuffle works in both directions */
+static const char pair32_mask[32] = {
+    3, 2, 1, 0, 11, 10, 9, 8, 7, 6, 5, 4, 15, 14, 13, 12,
+    3, 2, 1, 0, 11, 10, 9, 8, 7, 6, 5, 4, 15, 14, 13, 12
+};
+
+__attribute__((target("ssse3")))
+static size_t shuffle_ssse3(char *d, const char *s, size_t nbytes, const char *pattern)
+{
+    const __m128i mask = _mm_loadu_si128((const __m128i*)pattern);
+    size_t i;
+
+    for (i = 0; i + 16 <= nbytes; i += 16) {
+        __m128i v = _mm_loadu_si128((const __m128i*)(s + i));
+        _mm_storeu_si128((__m128i*)(d + i), _mm_shuffle_epi8(v, mask));
+    }
+    return i;
+}
+
+__attribute__((target("ssse3")))
+static size_t split32x2_ssse3(char *a, char *b, const char *s, size_t n)
+{
+    const __m128i mask = _mm_loadu_si128((const __m128i*)pair32_mask);
+    size_t i;
+
+    for (i = 0; i + 2 <= n; i += 2) {
+        __m128i v = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(s + 8*i)), mask);
+        _mm_storel_epi64((__m128i*)(a + 4*i), v);
+        _mm_storel_epi64((__m128i*)(b + 4*i), _mm_unpackhi_epi64(v, v));
+    }
+    return i;
+}
+
+__attribute__((target("ssse3")))
+static size_t merge32x2_ssse3(char *d, const char *a, const char *b, size_t n)
+{
+    const __m128i mask = _mm_loadu_si128((const __m128i*)pair32_mask);
+    size_t i;
+
+    for (i = 0; i + 2 <= n; i += 2) {
+        __m128i v = _mm_unpacklo_epi64(_mm_loadl_epi64((const __m128i*)(a + 4*i)),
+                                       _mm_loadl_epi64((const __m128i*)(b + 4*i)));
+        _mm_storeu_si128((__m128i*)(d + 8*i), _mm_shuffle_epi8(v, mask));
+    }
+    return i;
+}
+
+__attribute__((target("avx2")))
+static size_t shuffle_avx2(char *d, const char *s, size_t nbytes, const char *pattern)
+{
+    const __m256i mask = _mm256_loadu_si256((const __m256i*)pattern);
+    size_t i;
+
+    for (i = 0; i + 32 <= nbytes; i += 32) {
+        __m256i v = _mm256_loadu_si256((const __m256i*)(s + i));
+        _mm256_storeu_si256((__m256i*)(d + i), _mm256_shuffle_epi8(v, mask));
+    }
+    return i;
+}
+
+__attribute__((target("avx2")))
+static size_t split32x2_avx2(char *a, char *b, const char *s, size_t n)
+{
+    const __m256i mask = _mm256_loadu_si256((const __m256i*)pair32_mask);
+    size_t i;
+
+    for (i = 0; i + 4 <= n; i += 4) {
+        __m256i v = _mm256_shuffle_epi8(_mm256_loadu_si256((const __m256i*)(s + 8*i)), mask);
+        /* (a0 a1 b0 b1 | a2 a3 b2 b3) -> (a0 a1 a2 a3 | b0 b1 b2 b3) */
+        v = _mm256_permute4x64_epi64(v, _MM_SHUFFLE(3, 1, 2, 0));
+        _mm_storeu_si128((__m128i*)(a + 4*i), _mm256_castsi256_si128(v));
+        _mm_storeu_si128((__m128i*)(b + 4*i), _mm256_extracti128_si256(v, 1));
+    }
+    return i;
+}
+
+__attribute__((target("avx2")))
+static size_t merge32x2_avx2(char *d, const char *a, const char *b, size_t n)
+{
+    const __m256i mask = _mm256_loadu_si256((const __m256i*)pair32_mask);
+    size_t i;
+
+    for (i = 0; i + 4 <= n; i += 4) {
+        __m256i v = _mm256_castsi128_si256(_mm_loadu_si128((const __m128i*)(a + 4*i)));
+        v = _mm256_inserti128_si256(v, _mm_loadu_si128((const __m128i*)(b + 4*i)), 1);
+        /* (a0 a1 a2 a3 | b0 b1 b2 b3) -> (a0 a1 b0 b1 | a2 a3 b2 b3) */
+        v = _mm256_permute4x64_epi64(v, _MM_SHUFFLE(3, 1, 2, 0));
+        _mm256_storeu_si256((__m256i*)(d + 8*i), _mm256_shuffle_epi8(v, mask));
+    }
+    return i;
+}
+
+static const opal_dss_swap_kernels_t ssse3_kernels = {
+    "ssse3", shuffle_ssse3, split32x2_ssse3, merge32x2_ssse3
+};
+
+static const opal_dss_swap_kernels_t avx2_kernels = {
+    "avx2", shuffle_avx2, split32x2_avx2, merge32x2_avx2
+};
+
+#endif  /* OPAL_DSS_SWAP_SIMD */
+
+static const opal_dss_swap_kernels_t *kernels = &scalar_kernels;
+
+const char *opal_dss_swap_select(bool use_simd)
+{
+    kernels = &scalar_kernels;
+#if OPAL_DSS_SWAP_SIMD
+    if (use_simd) {
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2")) {
+            kernels = &avx2_kernels;
+        } else if (__builtin_cpu_supports("ssse3")) {
+            kernels = &ssse3_kernels;
+        }
+    }
+#endif
+    return kernels->name;
+}
+
+void opal_dss_swap16(void *dst, const void *src, size_t n)
+{
+    size_t done = kernels->shuffle((char*)dst, (const char*)src,
+                                   n * sizeof(uint16_t), swap16_mask);
+    swap16_scalar((char*)dst + done, (const char*)src + done,
+                  n - done / sizeof(uint16_t));
+}
+
+void opal_dss_swap32(void *dst, const void *src, size_t n)
+{
+    size_t done = kernels->shuffle((char*)dst, (const char*)src,
+                                   n * sizeof(uint32_t), swap32_mask);
+    swap32_scalar((char*)dst + done, (const char*)src + done,
+                  n - done / sizeof(uint32_t));
+}
+
+void opal_dss_swap64(void *dst, const void *src, size_t n)
+{
+    size_t done = kernels->shuffle((char*)dst, (const char*)src,
+                                   n * sizeof(uint64_t), swap64_mask);
+    swap64_scalar((char*)dst + done, (const char*)src + done,
+                  n - done / sizeof(uint64_t));
+}
+
+void opal_dss_split32x2(void *dsta, void *dstb, const void *src, size_t n)
+{
+    size_t done = kernels->split32x2((char*)dsta, (char*)dstb, (const char*)src, n);
+    split32x2_scalar((char*)dsta + done * sizeof(uint32_t),
+                     (char*)dstb + done * sizeof(uint32_t),
+                     (const char*)src + done * 2 * sizeof(uint32_t), n - done);
+}
+
+void opal_dss_merge32x2(void *dst, const void *srca, const void *srcb, size_t n)
+{
+    size_t done = kernels->merge32x2((char*)dst, (const char*)srca, (const char*)srcb, n);
+    merge32x2_scalar((char*)dst + done * 2 * sizeof(uint32_t),
+                     (const char*)srca + done * sizeof(uint32_t),
+                     (const char*)srcb + done * sizeof(uint32_t), n - done);
+}
@@ -357,7 +357,11 @@ OPAL_DECLSPEC OBJ_CLASS_DECLARATION(opal_node_stats_t);
  */
 enum opal_dss_buffer_type_t {
     OPAL_DSS_BUFFER_NON_DESC   = 0x00,
-    OPAL_DSS_BUFFER_FULLY_DESC = 0x01
+    OPAL_DSS_BUFFER_FULLY_DESC = 0x01,
+    /* integers and counts as varints, vpids as deltas - the
+     * values must be unpacked with the types they were packed
+     * with, except that signedness may differ */
+    OPAL_DSS_BUFFER_COMPACT    = 0x02
 };
 
 typedef enum opal_dss_buffer_type_t opal_dss_buffer_type_t;
@@ -365,6 +369,19 @@ typedef enum opal_dss_buffer_type_t opal_dss_buffer_type_t;
 #define OPAL_DSS_BUFFER_TYPE_HTON(h);
 #define OPAL_DSS_BUFFER_TYPE_NTOH(h);
 
+/**
+ * Sizing hint for buffers that carry one kind of message - see
+ * opal_dss.lease(). Declare one per message type with
+ * OPAL_DSS_LEASE_STATIC_INIT and leave the rest to the DSS.
+ */
+struct opal_dss_lease_t {
+    /** Bytes the next buffer should start out with */
+    size_t size;
+};
+typedef struct opal_dss_lease_t opal_dss_lease_t;
+
+#define OPAL_DSS_LEASE_STATIC_INIT  {0}
+
 /**
  * Structure for holding a buffer to be used with the RML or OOB
  * subsystems.
@@ -388,6 +405,8 @@ struct opal_buffer_t {
     /** Number of bytes used by the buffer (i.e., amount of data --
         including overhead -- packed in the buffer) */
     size_t bytes_used;
+    /** Lease this buffer was taken from, if any */
+    opal_dss_lease_t *lease;
 };
 /**
  * Convenience typedef
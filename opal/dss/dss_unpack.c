@@ -70,7 +70,17 @@ int opal_dss_unpack(opal_buffer_t *buffer, void *dst, int32_t *num_vals,
     }
 
     n=1;
-    if (OPAL_SUCCESS != (rc = opal_dss_unpack_int32(buffer, &local_num, &n, OPAL_INT32))) {
+    if (OPAL_DSS_BUFFER_COMPACT == buffer->type) {
+        uint64_t count;
+        if (OPAL_SUCCESS == (rc = opal_dss_unpack_varint(buffer, &count)) &&
+            INT32_MAX < count) {
+            rc = OPAL_ERR_UNPACK_FAILURE;
+        }
+        local_num = (int32_t)count;
+    } else {
+        rc = opal_dss_unpack_int32(buffer, &local_num, &n, OPAL_INT32);
+    }
+    if (OPAL_SUCCESS != rc) {
         *num_vals = 0;
         return rc;
     }
@@ -312,22 +322,21 @@ int opal_dss_unpack_byte(opal_buffer_t *buffer, void *dest,
 int opal_dss_unpack_int16(opal_buffer_t *buffer, void *dest,
                           int32_t *num_vals, opal_data_type_t type)
 {
-    int32_t i;
-    uint16_t tmp, *desttmp = (uint16_t*) dest;
+    size_t bytes_unpacked = (*num_vals) * sizeof(uint16_t);
 
    OPAL_OUTPUT( ( opal_dss_verbose, "opal_dss_unpack_int16 * %d\n", (int)*num_vals ) );
+    if (OPAL_DSS_BUFFER_COMPACT == buffer->type) {
+        return opal_dss_unpack_varints(buffer, dest, *num_vals, sizeof(uint16_t));
+    }
+
     /* check to see if there's enough data in buffer */
-    if (opal_dss_too_small(buffer, (*num_vals)*sizeof(tmp))) {
+    if (opal_dss_too_small(buffer, bytes_unpacked)) {
         return OPAL_ERR_UNPACK_READ_PAST_END_OF_BUFFER;
     }
 
     /* unpack the data */
-    for (i = 0; i < (*num_vals); ++i) {
-        memcpy( &(tmp), buffer->unpack_ptr, sizeof(tmp) );
-        tmp = ntohs(tmp);
-        memcpy(&desttmp[i], &tmp, sizeof(tmp));
-        buffer->unpack_ptr += sizeof(tmp);
-    }
+    opal_dss_swap16(dest, buffer->unpack_ptr, *num_vals);
+    buffer->unpack_ptr += bytes_unpacked;
 
     return OPAL_SUCCESS;
 }
@@ -335,22 +344,21 @@ int opal_dss_unpack_int16(opal_buffer_t *buffer, void *dest,
 int opal_dss_unpack_int32(opal_buffer_t *buffer, void *dest,
                           int32_t *num_vals, opal_data_type_t type)
 {
-    int32_t i;
-    uint32_t tmp, *desttmp = (uint32_t*) dest;
+    size_t bytes_unpacked = (*num_vals) * sizeof(uint32_t);
 
    OPAL_OUTPUT( ( opal_dss_verbose, "opal_dss_unpack_int32 * %d\n", (int)*num_vals ) );
+    if (OPAL_DSS_BUFFER_COMPACT == buffer->type) {
+        return opal_dss_unpack_varints(buffer, dest, *num_vals, sizeof(uint32_t));
+    }
+
     /* check to see if there's enough data in buffer */
-    if (opal_dss_too_small(buffer, (*num_vals)*sizeof(tmp))) {
+    if (opal_dss_too_small(buffer, bytes_unpacked)) {
         return OPAL_ERR_UNPACK_READ_PAST_END_OF_BUFFER;
     }
 
     /* unpack the data */
-    for (i = 0; i < (*num_vals); ++i) {
-        memcpy( &(tmp), buffer->unpack_ptr, sizeof(tmp) );
-        tmp = ntohl(tmp);
-        memcpy(&desttmp[i], &tmp, sizeof(tmp));
-        buffer->unpack_ptr += sizeof(tmp);
-    }
+    opal_dss_swap32(dest, buffer->unpack_ptr, *num_vals);
+    buffer->unpack_ptr += bytes_unpacked;
 
     return OPAL_SUCCESS;
 }
@@ -358,22 +366,21 @@ int opal_dss_unpack_int32(opal_buffer_t *buffer, void *dest,
 int opal_dss_unpack_int64(opal_buffer_t *buffer, void *dest,
                           int32_t *num_vals, opal_data_type_t type)
 {
-    int32_t i;
-    uint64_t tmp, *desttmp = (uint64_t*) dest;
+    size_t bytes_unpacked = (*num_vals) * sizeof(uint64_t);
 
    OPAL_OUTPUT( ( opal_dss_verbose, "opal_dss_unpack_int64 * %d\n", (int)*num_vals ) );
+    if (OPAL_DSS_BUFFER_COMPACT == buffer->type) {
+        return opal_dss_unpack_varints(buffer, dest, *num_vals, sizeof(uint64_t));
+    }
+
     /* check to see if there's enough data in buffer */
-    if (opal_dss_too_small(buffer, (*num_vals)*sizeof(tmp))) {
+    if (opal_dss_too_small(buffer, bytes_unpacked)) {
         return OPAL_ERR_UNPACK_READ_PAST_END_OF_BUFFER;
     }
 
     /* unpack the data */
-    for (i = 0; i < (*num_vals); ++i) {
-        memcpy( &(tmp), buffer->unpack_ptr, sizeof(tmp) );
-        tmp = ntoh64(tmp);
-        memcpy(&desttmp[i], &tmp, sizeof(tmp));
-        buffer->unpack_ptr += sizeof(tmp);
-    }
+    opal_dss_swap64(dest, buffer->unpack_ptr, *num_vals);
+    buffer->unpack_ptr += bytes_unpacked;
 
     return OPAL_SUCCESS;
 }
@@ -1428,62 +1435,59 @@ int opal_dss_unpack_buffer_contents(opal_buffer_t *buffer, void *dest,
 /*
  * NAME
  */
-int opal_dss_unpack_name(opal_buffer_t *buffer, void *dest,
-                        int32_t *num_vals, opal_data_type_t type)
+static int locate_array(opal_buffer_t *buffer, opal_data_type_t type,
+                        size_t nbytes, char **ptr)
 {
     int rc;
-    int32_t i, num;
-    opal_process_name_t* proc;
-    opal_jobid_t *jobid;
-    opal_vpid_t *vpid;
-
-    num = *num_vals;
+    opal_data_type_t local_type;
 
-    /* allocate space for all the jobids in a contiguous array */
-    jobid = (opal_jobid_t*)malloc(num * sizeof(opal_jobid_t));
-    if (NULL == jobid) {
-        OPAL_ERROR_LOG(OPAL_ERR_OUT_OF_RESOURCE);
-        *num_vals = 0;
-        return OPAL_ERR_OUT_OF_RESOURCE;
+    if (OPAL_DSS_BUFFER_FULLY_DESC == buffer->type) {
+        if (OPAL_SUCCESS != (rc = opal_dss_get_data_type(buffer, &local_type))) {
+            return rc;
+        }
+        /* if the data types don't match, then return an error */
+        if (type != local_type) {
+            opal_output(0, "OPAL dss:unpack: got type %d when expecting type %d", local_type, type);
+            return OPAL_ERR_PACK_MISMATCH;
+        }
     }
-    /* now unpack them in one shot */
-    if (OPAL_SUCCESS != (rc =
-                         opal_dss_unpack_jobid(buffer, jobid, num_vals, OPAL_JOBID))) {
-        OPAL_ERROR_LOG(rc);
-        *num_vals = 0;
-        free(jobid);
-        return rc;
+    if (opal_dss_too_small(buffer, nbytes)) {
+        return OPAL_ERR_UNPACK_READ_PAST_END_OF_BUFFER;
     }
+    *ptr = buffer->unpack_ptr;
+    buffer->unpack_ptr += nbytes;
 
-    /* collect all the vpids in a contiguous array */
-    vpid = (opal_vpid_t*)malloc(num * sizeof(opal_vpid_t));
-    if (NULL == vpid) {
-        OPAL_ERROR_LOG(OPAL_ERR_OUT_OF_RESOURCE);
-        *num_vals = 0;
-        free(jobid);
-        return OPAL_ERR_OUT_OF_RESOURCE;
+    return OPAL_SUCCESS;
+}
+
+int opal_dss_unpack_name(opal_buffer_t *buffer, void *dest,
+                        int32_t *num_vals, opal_data_type_t type)
+{
+    int rc;
+    char *jobids, *vpids;
+
+    if (OPAL_DSS_BUFFER_COMPACT == buffer->type) {
+        if (OPAL_SUCCESS != (rc = opal_dss_unpack_deltas(buffer, dest, *num_vals,
+                                                         sizeof(opal_process_name_t))) ||
+            OPAL_SUCCESS != (rc = opal_dss_unpack_deltas(buffer, (char*)dest + sizeof(opal_jobid_t),
+                                                         *num_vals, sizeof(opal_process_name_t)))) {
+            OPAL_ERROR_LOG(rc);
+            *num_vals = 0;
+        }
+        return rc;
     }
-    /* now unpack them in one shot */
-    if (OPAL_SUCCESS != (rc =
-                         opal_dss_unpack_vpid(buffer, vpid, num_vals, OPAL_VPID))) {
+
+    /* the jobids and vpids arrive as two arrays - build
+     * the names straight from the buffer */
+    if (OPAL_SUCCESS != (rc = locate_array(buffer, OPAL_JOBID_T,
+                                           (*num_vals) * sizeof(opal_jobid_t), &jobids)) ||
+        OPAL_SUCCESS != (rc = locate_array(buffer, OPAL_VPID_T,
+                                           (*num_vals) * sizeof(opal_vpid_t), &vpids))) {
         OPAL_ERROR_LOG(rc);
         *num_vals = 0;
-        free(vpid);
-        free(jobid);
         return rc;
     }
-
-    /* build the names from the jobid/vpid arrays */
-    proc = (opal_process_name_t*)dest;
-    for (i=0; i < num; i++) {
-        proc->jobid = jobid[i];
-        proc->vpid = vpid[i];
-        proc++;
-    }
-
-    /* cleanup */
-    free(vpid);
-    free(jobid);
+    opal_dss_merge32x2(dest, jobids, vpids, *num_vals);
 
     return OPAL_SUCCESS;
 }
@@ -1512,6 +1516,14 @@ int opal_dss_unpack_vpid(opal_buffer_t *buffer, void *dest,
 {
     int ret;
 
+    if (OPAL_DSS_BUFFER_COMPACT == buffer->type) {
+        if (OPAL_SUCCESS != (ret = opal_dss_unpack_deltas(buffer, dest, *num_vals,
+                                                          sizeof(opal_vpid_t)))) {
+            OPAL_ERROR_LOG(ret);
+        }
+        return ret;
+    }
+
     /* Turn around and unpack the real type */
     if (OPAL_SUCCESS != (ret = opal_dss_unpack_buffer(buffer, dest, num_vals, OPAL_VPID_T))) {
         OPAL_ERROR_LOG(ret);
@@ -0,0 +1,231 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+/*
+ * Encodings used by OPAL_DSS_BUFFER_COMPACT buffers. Integers go out
+ * as little-endian base-128 varints - seven bits per byte, with the
+ * top bit set on every byte but the last. Signed values are zigzag
+ * encoded first so small negative numbers stay short, and arrays of
+ * vpids are sent as the (zigzagged) difference from the previous
+ * value, so a sorted array costs about a byte per entry.
+ */
+
+#include "opal_config.h"
+
+#include <string.h>
+
+#include "opal/dss/dss_internal.h"
+
+/* the most bytes a 64-bit value can take */
+#define OPAL_DSS_VARINT_MAX  10
+
+static inline uint64_t zigzag(int64_t val)
+{
+    return ((uint64_t)val << 1) ^ (uint64_t)(val >> 63);
+}
+
+static inline int64_t unzigzag(uint64_t val)
+{
+    return (int64_t)(val >> 1) ^ -(int64_t)(val & 1);
+}
+
+static inline char *put_varint(char *dst, uint64_t val)
+{
+    while (0x80 <= val) {
+        *dst++ = (char)(val | 0x80);
+        val >>= 7;
+    }
+    *dst++ = (char)val;
+    return dst;
+}
+
+static inline int get_varint(opal_buffer_t *buffer, uint64_t *val)
+{
+    const unsigned char *src = (const unsigned char*)buffer->unpack_ptr;
+    const unsigned char *end = (const unsigned char*)buffer->base_ptr + buffer->bytes_used;
+    uint64_t v = 0;
+    int shift;
+
+    for (shift = 0; shift < 7 * OPAL_DSS_VARINT_MAX; shift += 7) {
+        if (src >= end) {
+            return OPAL_ERR_UNPACK_READ_PAST_END_OF_BUFFER;
+        }
+        /* only the top bit of a 64-bit value is left for the last byte */
+        if (63 == shift && 1 < (*src & 0x7f)) {
+            return OPAL_ERR_UNPACK_FAILURE;
+        }
+        v |= (uint64_t)(*src & 0x7f) << shift;
+        if (0 == (*src++ & 0x80)) {
+            buffer->unpack_ptr = (char*)src;
+            *val = v;
+            return OPAL_SUCCESS;
+        }
+    }
+    /* nobody would have packed that */
+    return OPAL_ERR_UNPACK_FAILURE;
+}
+
+/* room for the worst case - only what is used gets counted */
+static inline char *reserve(opal_buffer_t *buffer, int32_t num_vals, size_t maxlen)
+{
+    return opal_dss_buffer_extend(buffer, (size_t)num_vals * maxlen);
+}
+
+static inline void commit(opal_buffer_t *buffer, char *end)
+{
+    buffer->bytes_used += end - buffer->pack_ptr;
+    buffer->pack_ptr = end;
+}
+
+int opal_dss_pack_varint(opal_buffer_t *buffer, uint64_t val)
+{
+    char *dst;
+
+    if (NULL == (dst = reserve(buffer, 1, OPAL_DSS_VARINT_MAX))) {
+        return OPAL_ERR_OUT_OF_RESOURCE;
+    }
+    commit(buffer, put_varint(dst, val));
+
+    return OPAL_SUCCESS;
+}
+
+int opal_dss_unpack_varint(opal_buffer_t *buffer, uint64_t *val)
+{
+    return get_varint(buffer, val);
+}
+
+/*
+ * Fixed-width integers are zigzagged as signed values of their width,
+ * whatever their declared type - the DSS lets an OPAL_UINT32 be
+ * unpacked as an OPAL_INT32, so both have to come out the same.
+ */
+int opal_dss_pack_varints(opal_buffer_t *buffer, const void *src,
+                          int32_t num_vals, size_t width)
+{
+    const char *s = (const char*)src;
+    char *dst;
+    int32_t i;
+    int16_t v16;
+    int32_t v32;
+    int64_t v64;
+
+    if (NULL == (dst = reserve(buffer, num_vals, (8 * width + 6) / 7))) {
+        return OPAL_ERR_OUT_OF_RESOURCE;
+    }
+    for (i = 0; i < num_vals; ++i, s += width) {
+        switch (width) {
+        case sizeof(int16_t):
+            memcpy(&v16, s, sizeof(v16));
+            v64 = v16;
+            break;
+        case sizeof(int32_t):
+            memcpy(&v32, s, sizeof(v32));
+            v64 = v32;
+            break;
+        default:
+            memcpy(&v64, s, sizeof(v64));
+            break;
+        }
+        dst = put_varint(dst, zigzag(v64));
+    }
+    commit(buffer, dst);
+
+    return OPAL_SUCCESS;
+}
+
+int opal_dss_unpack_varints(opal_buffer_t *buffer, void *dest,
+                            int32_t num_vals, size_t width)
+{
+    char *d = (char*)dest;
+    int32_t i;
+    int16_t v16;
+    int32_t v32;
+    int64_t v64;
+    uint64_t val;
+    int rc;
+
+    for (i = 0; i < num_vals; ++i, d += width) {
+        if (OPAL_SUCCESS != (rc = get_varint(buffer, &val))) {
+            return rc;
+        }
+        v64 = unzigzag(val);
+        switch (width) {
+        case sizeof(int16_t):
+            if (v64 < INT16_MIN || INT16_MAX < v64) {
+                return OPAL_ERR_UNPACK_FAILURE;
+            }
+            v16 = (int16_t)v64;
+            memcpy(d, &v16, sizeof(v16));
+            break;
+        case sizeof(int32_t):
+            if (v64 < INT32_MIN || INT32_MAX < v64) {
+                return OPAL_ERR_UNPACK_FAILURE;
+            }
+            v32 = (int32_t)v64;
+            memcpy(d, &v32, sizeof(v32));
+            break;
+        default:
+            memcpy(d, &v64, sizeof(v64));
+            break;
+        }
+    }
+
+    return OPAL_SUCCESS;
+}
+
+/*
+ * 32-bit values found every stride bytes - e.g., an array of vpids,
+ * or the vpids of an array of names - each sent as the difference
+ * from the one before it
+ */
+int opal_dss_pack_deltas(opal_buffer_t *buffer, const void *src,
+                         int32_t num_vals, size_t stride)
+{
+    const char *s = (const char*)src;
+    char *dst;
+    int32_t i;
+    uint32_t val, prev = 0;
+
+    if (NULL == (dst = reserve(buffer, num_vals, 5))) {
+        return OPAL_ERR_OUT_OF_RESOURCE;
+    }
+    for (i = 0; i < num_vals; ++i, s += stride) {
+        memcpy(&val, s, sizeof(val));
+        dst = put_varint(dst, zigzag((int64_t)val - (int64_t)prev));
+        prev = val;
+    }
+    commit(buffer, dst);
+
+    return OPAL_SUCCESS;
+}
+
+int opal_dss_unpack_deltas(opal_buffer_t *buffer, void *dest,
+                           int32_t num_vals, size_t stride)
+{
+    char *d = (char*)dest;
+    int32_t i;
+    int64_t val;
+    uint32_t prev = 0;
+    uint64_t delta;
+    int rc;
+
+    for (i = 0; i < num_vals; ++i, d += stride) {
+        if (OPAL_SUCCESS != (rc = get_varint(buffer, &delta))) {
+            return rc;
+        }
+        val = (int64_t)prev + unzigzag(delta);
+        if (val < 0 || UINT32_MAX < val) {
+            return OPAL_ERR_UNPACK_FAILURE;
+        }
+        prev = (uint32_t)val;
+        memcpy(d, &prev, sizeof(prev));
+    }
+
+    return OPAL_SUCCESS;
+}
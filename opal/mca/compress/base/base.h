@@ -57,9 +57,18 @@ extern "C" {
      */
     OPAL_DECLSPEC int opal_compress_base_close(void);
 
+    /**
+     * Framework-level settings
+     */
+    typedef struct {
+        /** Blocks smaller than this are not worth compressing */
+        size_t compress_limit;
+    } opal_compress_base_t;
+
     /**
      * Globals
      */
+    OPAL_DECLSPEC extern opal_compress_base_t opal_compress_base;
     OPAL_DECLSPEC extern mca_base_framework_t opal_compress_base_framework;
     OPAL_DECLSPEC extern opal_compress_base_component_t opal_compress_base_selected_component;
     OPAL_DECLSPEC extern opal_compress_base_module_t opal_compress;
@@ -70,6 +79,19 @@ extern "C" {
     OPAL_DECLSPEC int opal_compress_base_tar_create(char ** target);
     OPAL_DECLSPEC int opal_compress_base_tar_extract(char ** target);
 
+    /**
+     * Default in-memory functions for modules that do not
+     * support it - the data is never compressed
+     */
+    OPAL_DECLSPEC bool opal_compress_base_compress_block(uint8_t *inbytes,
+                                                         size_t inlen,
+                                                         uint8_t **outbytes,
+                                                         size_t *olen);
+    OPAL_DECLSPEC bool opal_compress_base_decompress_block(uint8_t **outbytes,
+                                                           size_t olen,
+                                                           uint8_t *inbytes,
+                                                           size_t len);
+
 #if defined(c_plusplus) || defined(__cplusplus)
 }
 #endif
@@ -19,13 +19,6 @@
 
 int opal_compress_base_close(void)
 {
-    /* Compression currently only used with C/R */
-    if( !opal_cr_is_enabled ) {
-        opal_output_verbose(10, opal_compress_base_framework.framework_output,
-                            "compress:open: FT is not enabled, skipping!");
-        return OPAL_SUCCESS;
-    }
-
     /* Call the component's finalize routine */
     if( NULL != opal_compress.finalize ) {
         opal_compress.finalize();
@@ -29,9 +29,13 @@ opal_compress_base_module_t opal_compress = {
     NULL, /* compress         */
     NULL, /* compress_nb      */
     NULL, /* decompress       */
-    NULL  /* decompress_nb    */
+    NULL, /* decompress_nb    */
+    opal_compress_base_compress_block,   /* compress_block   */
+    opal_compress_base_decompress_block  /* decompress_block */
 };
 
+opal_compress_base_t opal_compress_base = {0};
+
 opal_compress_base_component_t opal_compress_base_selected_component = {{0}};
 
 static int opal_compress_base_register(mca_base_register_flag_t flags);
@@ -42,6 +46,14 @@ MCA_BASE_FRAMEWORK_DECLARE(opal, compress, "COMPRESS MCA",
 
 static int opal_compress_base_register(mca_base_register_flag_t flags)
 {
+    opal_compress_base.compress_limit = 4096;
+    (void) mca_base_var_register("opal", "compress", "base", "limit",
+                                 "Minimum size in bytes of a block of memory for it "
+                                 "to be compressed [default: 4096]",
+                                 MCA_BASE_VAR_TYPE_SIZE_T, NULL, 0, 0,
+                                 OPAL_INFO_LVL_9,
+                                 MCA_BASE_VAR_SCOPE_READONLY,
+                                 &opal_compress_base.compress_limit);
     return OPAL_SUCCESS;
 }
 
@@ -51,13 +63,7 @@ static int opal_compress_base_register(mca_base_register_flag_t flags)
  */
 int opal_compress_base_open(mca_base_open_flag_t flags)
 {
-    /* Compression currently only used with C/R */
-    if(!opal_cr_is_enabled) {
-        opal_output_verbose(10, opal_compress_base_framework.framework_output,
-                            "compress:open: FT is not enabled, skipping!");
-        return OPAL_SUCCESS;
-    }
-
-    /* Open up all available components */
+    /* Open up all available components - they are needed for
+     * in-memory compression even if C/R is not enabled */
     return mca_base_framework_components_open(&opal_compress_base_framework, flags);
 }
@@ -33,13 +33,6 @@ int opal_compress_base_select(void)
     opal_compress_base_component_t *best_component = NULL;
     opal_compress_base_module_t *best_module = NULL;
 
-    /* Compression currently only used with C/R */
-    if( !opal_cr_is_enabled ) {
-        opal_output_verbose(10, opal_compress_base_framework.framework_output,
-                            "compress:open: FT is not enabled, skipping!");
-        return OPAL_SUCCESS;
-    }
-
     /*
      * Select the best component
      */
@@ -47,8 +40,12 @@ int opal_compress_base_select(void)
                                         &opal_compress_base_framework.framework_components,
                                         (mca_base_module_t **) &best_module,
                                         (mca_base_component_t **) &best_component, NULL) ) {
-        /* This will only happen if no component was selected */
-        exit_status = OPAL_ERROR;
+        /* This will only happen if no component was selected. That
+         * is only an error if C/R needs to compress its files - blocks
+         * of memory will just be sent uncompressed */
+        if (opal_cr_is_enabled) {
+            exit_status = OPAL_ERROR;
+        }
         goto cleanup;
     }
 
@@ -62,6 +59,13 @@ int opal_compress_base_select(void)
             goto cleanup;
         }
         opal_compress = *best_module;
+        /* not all modules can compress in memory */
+        if (NULL == opal_compress.compress_block) {
+            opal_compress.compress_block = opal_compress_base_compress_block;
+        }
+        if (NULL == opal_compress.decompress_block) {
+            opal_compress.decompress_block = opal_compress_base_decompress_block;
+        }
     }
 
  cleanup:
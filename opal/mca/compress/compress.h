@@ -24,6 +24,10 @@
  * when distributing files that can be compressed before sending to dimish the
  * load on the network.
  *
+ * The framework also provides in-memory compression of blocks of data,
+ * which is used to shrink large messages such as the launch message
+ * before they are passed around the system.
+ *
  */
 
 #ifndef MCA_COMPRESS_H
@@ -82,6 +86,37 @@ typedef int (*opal_compress_base_module_decompress_fn_t)
 typedef int (*opal_compress_base_module_decompress_nb_fn_t)
     (char * cname, char **fname, pid_t *child_pid);
 
+/**
+ * Compress a block of memory
+ *
+ * Arguments:
+ *   inbytes  = Data to compress
+ *   inlen    = Number of bytes to compress
+ *   outbytes = Compressed data (malloc'd, caller must free)
+ *   olen     = Number of compressed bytes
+ * Returns:
+ *   true if the data was compressed, false if it was not - e.g., because
+ *   it is smaller than the compress_base_limit, in-memory compression
+ *   is not supported, or compression would not reduce its size. The
+ *   caller must then send the data as-is.
+ */
+typedef bool (*opal_compress_base_module_compress_block_fn_t)
+    (uint8_t *inbytes, size_t inlen, uint8_t **outbytes, size_t *olen);
+
+/**
+ * Decompress a block of memory
+ *
+ * Arguments:
+ *   outbytes = Decompressed data (malloc'd, caller must free)
+ *   olen     = Size of the original data as given to compress_block
+ *   inbytes  = Compressed data
+ *   len      = Number of compressed bytes
+ * Returns:
+ *   true on success, ow false
+ */
+typedef bool (*opal_compress_base_module_decompress_block_fn_t)
+    (uint8_t **outbytes, size_t olen, uint8_t *inbytes, size_t len);
+
 /**
  * Structure for COMPRESS components.
  */
@@ -117,6 +152,10 @@ struct opal_compress_base_module_1_0_0_t {
     /** Decompress Interface */
     opal_compress_base_module_decompress_fn_t     decompress;
     opal_compress_base_module_decompress_nb_fn_t  decompress_nb;
+
+    /** In-memory interface */
+    opal_compress_base_module_compress_block_fn_t    compress_block;
+    opal_compress_base_module_decompress_block_fn_t  decompress_block;
 };
 typedef struct opal_compress_base_module_1_0_0_t opal_compress_base_module_1_0_0_t;
 typedef struct opal_compress_base_module_1_0_0_t opal_compress_base_module_t;
@@ -36,6 +36,9 @@ extern "C" {
     struct opal_compress_gzip_component_t {
         opal_compress_base_component_t super;  /** Base COMPRESS component */
 
+        /** Compression level used for blocks of memory */
+        int level;
+
     };
     typedef struct opal_compress_gzip_component_t opal_compress_gzip_component_t;
     OPAL_MODULE_DECLSPEC extern opal_compress_gzip_component_t mca_compress_gzip_component;
@@ -55,6 +58,10 @@ extern "C" {
     int opal_compress_gzip_compress_nb(char *fname, char **cname, char **postfix, pid_t *child_pid);
     int opal_compress_gzip_decompress(char *cname, char **fname);
     int opal_compress_gzip_decompress_nb(char *cname, char **fname, pid_t *child_pid);
+    bool opal_compress_gzip_compress_block(uint8_t *inbytes, size_t inlen,
+                                           uint8_t **outbytes, size_t *olen);
+    bool opal_compress_gzip_decompress_block(uint8_t **outbytes, size_t olen,
+                                             uint8_t *inbytes, size_t len);
 
 #if defined(c_plusplus) || defined(__cplusplus)
 }
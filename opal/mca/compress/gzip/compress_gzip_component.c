@@ -62,7 +62,8 @@ opal_compress_gzip_component_t mca_compress_gzip_component = {
 
         .verbose = 0,
         .output_handle = -1,
-    }
+    },
+    .level = 1
 };
 
 /*
@@ -80,7 +81,11 @@ static opal_compress_base_module_t loc_module = {
 
     /** Decompress Function */
     opal_compress_gzip_decompress,
-    opal_compress_gzip_decompress_nb
+    opal_compress_gzip_decompress_nb,
+
+    /** In-memory Functions */
+    opal_compress_gzip_compress_block,
+    opal_compress_gzip_decompress_block
 };
 
 static int compress_gzip_register (void)
@@ -105,6 +110,19 @@ static int compress_gzip_register (void)
                                            MCA_BASE_VAR_TYPE_INT, NULL, 0, MCA_BASE_VAR_FLAG_SETTABLE,
                                            OPAL_INFO_LVL_9, MCA_BASE_VAR_SCOPE_LOCAL,
                                            &mca_compress_gzip_component.super.verbose);
+    if (0 > ret) {
+        return ret;
+    }
+
+    /* messages are compressed on the critical path, so favor speed */
+    mca_compress_gzip_component.level = 1;
+    ret = mca_base_component_var_register (&mca_compress_gzip_component.super.base_version,
+                                           "level",
+                                           "Compression level (1-9) used when compressing blocks of memory "
+                                           "(default: 1)",
+                                           MCA_BASE_VAR_TYPE_INT, NULL, 0, MCA_BASE_VAR_FLAG_SETTABLE,
+                                           OPAL_INFO_LVL_9, MCA_BASE_VAR_SCOPE_LOCAL,
+                                           &mca_compress_gzip_component.level);
     return (0 > ret) ? ret : OPAL_SUCCESS;
 }
 
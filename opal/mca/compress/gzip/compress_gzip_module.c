@@ -16,12 +16,17 @@
 #include "opal_config.h"
 
 #include <string.h>
+#include <stdlib.h>
+#include <limits.h>
 #include <sys/types.h>
 #include <sys/wait.h>
 #include <sys/stat.h>
 #if HAVE_UNISTD_H
 #include <unistd.h>
 #endif  /* HAVE_UNISTD_H */
+#if OPAL_COMPRESS_GZIP_HAVE_ZLIB
+#include <zlib.h>
+#endif
 
 #include "opal/util/opal_environ.h"
 #include "opal/util/output.h"
@@ -227,6 +232,110 @@ int opal_compress_gzip_decompress_nb(char * cname, char **fname, pid_t *child_pi
     return OPAL_SUCCESS;
 }
 
+bool opal_compress_gzip_compress_block(uint8_t *inbytes,
+                                       size_t inlen,
+                                       uint8_t **outbytes,
+                                       size_t *olen)
+{
+#if OPAL_COMPRESS_GZIP_HAVE_ZLIB
+    z_stream strm;
+    uint8_t *tmp;
+    size_t len;
+    int rc;
+
+    *outbytes = NULL;
+    *olen = 0;
+
+    /* small blocks aren't worth the trouble, and zlib
+     * can only take 32-bit lengths */
+    if (inlen < opal_compress_base.compress_limit || UINT_MAX < inlen) {
+        return false;
+    }
+
+    memset(&strm, 0, sizeof(strm));
+    if (Z_OK != deflateInit(&strm, mca_compress_gzip_component.level)) {
+        return false;
+    }
+
+    /* we only want the result if it is smaller than the input */
+    len = deflateBound(&strm, inlen);
+    if (inlen < len) {
+        len = inlen;
+    }
+    if (NULL == (tmp = (uint8_t*)malloc(len))) {
+        deflateEnd(&strm);
+        return false;
+    }
+    strm.next_in = inbytes;
+    strm.avail_in = inlen;
+    strm.next_out = tmp;
+    strm.avail_out = len;
+
+    /* a full output means the data did not compress */
+    rc = deflate(&strm, Z_FINISH);
+    deflateEnd(&strm);
+    if (Z_STREAM_END != rc || inlen <= strm.total_out) {
+        free(tmp);
+        return false;
+    }
+
+    opal_output_verbose(10, mca_compress_gzip_component.super.output_handle,
+                        "compress:gzip: compress_block(%lu -> %lu bytes)",
+                        (unsigned long)inlen, (unsigned long)strm.total_out);
+
+    *outbytes = tmp;
+    *olen = strm.total_out;
+    return true;
+#else
+    return opal_compress_base_compress_block(inbytes, inlen, outbytes, olen);
+#endif
+}
+
+bool opal_compress_gzip_decompress_block(uint8_t **outbytes,
+                                         size_t olen,
+                                         uint8_t *inbytes,
+                                         size_t len)
+{
+#if OPAL_COMPRESS_GZIP_HAVE_ZLIB
+    z_stream strm;
+    uint8_t *tmp;
+    int rc;
+
+    *outbytes = NULL;
+
+    if (UINT_MAX < olen || UINT_MAX < len) {
+        return false;
+    }
+
+    memset(&strm, 0, sizeof(strm));
+    if (Z_OK != inflateInit(&strm)) {
+        return false;
+    }
+    if (NULL == (tmp = (uint8_t*)malloc(olen))) {
+        inflateEnd(&strm);
+        return false;
+    }
+    strm.next_in = inbytes;
+    strm.avail_in = len;
+    strm.next_out = tmp;
+    strm.avail_out = olen;
+
+    rc = inflate(&strm, Z_FINISH);
+    inflateEnd(&strm);
+    if (Z_STREAM_END != rc || olen != strm.total_out) {
+        opal_output(0, "compress:gzip: decompress_block: failed to inflate %lu bytes (rc = %d)",
+                    (unsigned long)len, rc);
+        free(tmp);
+        return false;
+    }
+
+    *outbytes = tmp;
+    return true;
+#else
+    return opal_compress_base_decompress_block(outbytes, olen, inbytes, len);
+#endif
+}
+
 static bool is_directory(char *fname ) {
     struct stat file_status;
     int rc;
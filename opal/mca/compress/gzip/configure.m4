@@ -0,0 +1,63 @@
+# -*- shell-script -*-
+#
+# $COPYRIGHT$
+#
+# Additional copyrights may follow
+#
+# $HEADER$
+#
+
+# MCA_opal_compress_gzip_CONFIG([action-if-can-compile],
+#                               [action-if-cant-compile])
+# ------------------------------------------------------
+# The file compression only needs the gzip and tar executables, so
+# the component is always built. Compressing blocks of memory needs
+# zlib, which is used if it can be found.
+AC_DEFUN([MCA_opal_compress_gzip_CONFIG],[
+    OPAL_VAR_SCOPE_PUSH([compress_gzip_have_zlib compress_gzip_dir compress_gzip_libdir])
+    AC_CONFIG_FILES([opal/mca/compress/gzip/Makefile])
+
+    AC_ARG_WITH([zlib],
+                [AC_HELP_STRING([--with-zlib(=DIR)],
+                                [Compress large messages in memory using zlib, optionally found in DIR])])
+    OPAL_CHECK_WITHDIR([zlib], [$with_zlib], [include/zlib.h])
+    AC_ARG_WITH([zlib-libdir],
+                [AC_HELP_STRING([--with-zlib-libdir=DIR],
+                                [Search for zlib libraries in DIR])])
+    OPAL_CHECK_WITHDIR([zlib-libdir], [$with_zlib_libdir], [libz.*])
+
+    compress_gzip_have_zlib=0
+    compress_gzip_dir=
+    compress_gzip_libdir=
+    AS_IF([test ! -z "$with_zlib" && test "$with_zlib" != "yes"],
+          [compress_gzip_dir="$with_zlib"])
+    AS_IF([test ! -z "$with_zlib_libdir" && test "$with_zlib_libdir" != "yes"],
+          [compress_gzip_libdir="$with_zlib_libdir"])
+
+    AS_IF([test "$with_zlib" != "no"],
+          [OPAL_CHECK_PACKAGE([compress_gzip],
+                              [zlib.h],
+                              [z],
+                              [deflate],
+                              [],
+                              [$compress_gzip_dir],
+                              [$compress_gzip_libdir],
+                              [compress_gzip_have_zlib=1
+                               compress_gzip_WRAPPER_EXTRA_LDFLAGS="$compress_gzip_LDFLAGS"
+                               compress_gzip_WRAPPER_EXTRA_LIBS="$compress_gzip_LIBS"],
+                              [compress_gzip_have_zlib=0])])
+
+    AS_IF([test "$compress_gzip_have_zlib" = "0" && test ! -z "$with_zlib" && test "$with_zlib" != "no"],
+          [AC_MSG_WARN([zlib support requested but not found.])
+           AC_MSG_ERROR([Aborting.])])
+
+    AC_DEFINE_UNQUOTED([OPAL_COMPRESS_GZIP_HAVE_ZLIB], [$compress_gzip_have_zlib],
+                       [Whether the gzip compress component can compress blocks of memory])
+
+    AC_SUBST([compress_gzip_CPPFLAGS])
+    AC_SUBST([compress_gzip_LDFLAGS])
+    AC_SUBST([compress_gzip_LIBS])
+
+    $1
+    OPAL_VAR_SCOPE_POP
+])dnl
@@ -47,9 +47,7 @@
 #include "opal/mca/event/base/base.h"
 #include "opal/runtime/opal_progress.h"
 #include "opal/mca/shmem/base/base.h"
-#if OPAL_ENABLE_FT_CR    == 1
 #include "opal/mca/compress/base/base.h"
-#endif
 
 #include "opal/runtime/opal_cr.h"
 #include "opal/mca/crs/base/base.h"
@@ -141,9 +139,7 @@ opal_finalize(void)
     /* close the security framework */
     (void) mca_base_framework_close(&opal_sec_base_framework);
 
-#if OPAL_ENABLE_FT_CR    == 1
     (void) mca_base_framework_close(&opal_compress_base_framework);
-#endif
 
     (void) mca_base_framework_close(&opal_event_base_framework);
 
@@ -54,9 +54,7 @@
 #include "opal/mca/memchecker/base/base.h"
 #include "opal/dss/dss.h"
 #include "opal/mca/shmem/base/base.h"
-#if OPAL_ENABLE_FT_CR    == 1
 #include "opal/mca/compress/base/base.h"
-#endif
 #include "opal/threads/threads.h"
 
 #include "opal/runtime/opal_cr.h"
@@ -501,12 +499,8 @@ opal_init(int* pargc, char*** pargv)
         goto return_error;
     }
 
-#if OPAL_ENABLE_FT_CR    == 1
     /*
      * Initialize the compression framework
-     * Note: Currently only used in C/R so it has been marked to only
-     *       initialize when C/R is enabled. If other places in the code
-     *       wish to use this framework, it is safe to remove the protection.
      */
     if( OPAL_SUCCESS != (ret = mca_base_framework_open(&opal_compress_base_framework, 0)) ) {
         error = "opal_compress_base_open";
@@ -516,7 +510,6 @@ opal_init(int* pargc, char*** pargv)
         error = "opal_compress_base_select";
         goto return_error;
     }
-#endif
 
     /*
      * Initalize the checkpoint/restart functionality
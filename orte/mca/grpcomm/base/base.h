@@ -65,10 +65,27 @@ typedef struct {
 } orte_grpcomm_base_active_t;
 OBJ_CLASS_DECLARATION(orte_grpcomm_base_active_t);
 
+/* an entry in the allgather tuning table - the named
+ * component is preferred for collectives spanning at
+ * least min_dmns daemons */
+typedef struct {
+    size_t min_dmns;
+    char *component;
+} orte_grpcomm_base_rule_t;
+
 typedef struct {
     opal_list_t actives;
     opal_list_t ongoing;
     opal_hash_table_t sig_table;
+    /* allgather cost model inputs */
+    double latency;
+    double bandwidth;
+    size_t bucket_size;
+    int tree_radix;
+    /* allgather tuning table, sorted by min_dmns */
+    orte_grpcomm_base_rule_t *rules;
+    int nrules;
+    bool dump_table;
 } orte_grpcomm_base_t;
 
 ORTE_DECLSPEC extern orte_grpcomm_base_t orte_grpcomm_base;
@@ -83,6 +100,13 @@ ORTE_DECLSPEC int orte_grpcomm_API_allgather(orte_grpcomm_signature_t *sig,
                                              orte_grpcomm_cbfunc_t cbfunc,
                                              void *cbdata);
 
+ORTE_DECLSPEC int orte_grpcomm_base_pack_xcast(orte_grpcomm_signature_t *sig,
+                                               opal_buffer_t *buffer,
+                                               opal_buffer_t *message,
+                                               orte_rml_tag_t tag);
+ORTE_DECLSPEC orte_grpcomm_base_active_t* orte_grpcomm_base_select_allgather(size_t ndmns);
+ORTE_DECLSPEC void orte_grpcomm_base_dump_allgather_table(void);
+
 ORTE_DECLSPEC orte_grpcomm_coll_t* orte_grpcomm_base_get_tracker(orte_grpcomm_signature_t *sig, bool create);
 ORTE_DECLSPEC void orte_grpcomm_base_mark_distance_recv(orte_grpcomm_coll_t *coll, uint32_t distance);
 ORTE_DECLSPEC unsigned int orte_grpcomm_base_check_distance_recv(orte_grpcomm_coll_t *coll, uint32_t distance);
@@ -26,7 +26,11 @@
 #include "orte_config.h"
 #include "orte/constants.h"
 
+#include <stdlib.h>
+#include <string.h>
+
 #include "orte/mca/mca.h"
+#include "opal/util/argv.h"
 #include "opal/util/output.h"
 #include "opal/mca/base/base.h"
 
@@ -55,6 +59,137 @@ orte_grpcomm_API_module_t orte_grpcomm = {
 };
 
 static bool recv_issued = false;
+static char *allgather_table = NULL;
+
+static int orte_grpcomm_base_register(mca_base_register_flag_t flags)
+{
+    /* the allgather cost model - all daemons must select the same
+     * algorithm for a given collective, so these are the same
+     * everywhere rather than locally measured */
+    orte_grpcomm_base.latency = 50.0;
+    (void) mca_base_var_register("orte", "grpcomm", "base", "latency",
+                                 "Per-hop message latency (in usec) assumed when estimating the cost of allgather algorithms [default: 50]",
+                                 MCA_BASE_VAR_TYPE_DOUBLE, NULL, 0, 0,
+                                 OPAL_INFO_LVL_9,
+                                 MCA_BASE_VAR_SCOPE_ALL_EQ,
+                                 &orte_grpcomm_base.latency);
+
+    orte_grpcomm_base.bandwidth = 1000.0;
+    (void) mca_base_var_register("orte", "grpcomm", "base", "bandwidth",
+                                 "Per-link bandwidth (in bytes/usec) assumed when estimating the cost of allgather algorithms [default: 1000]",
+                                 MCA_BASE_VAR_TYPE_DOUBLE, NULL, 0, 0,
+                                 OPAL_INFO_LVL_9,
+                                 MCA_BASE_VAR_SCOPE_ALL_EQ,
+                                 &orte_grpcomm_base.bandwidth);
+
+    orte_grpcomm_base.bucket_size = 1024;
+    (void) mca_base_var_register("orte", "grpcomm", "base", "bucket_size",
+                                 "Typical number of bytes each daemon contributes to an allgather, used when estimating the cost of allgather algorithms [default: 1024]",
+                                 MCA_BASE_VAR_TYPE_SIZE_T, NULL, 0, 0,
+                                 OPAL_INFO_LVL_9,
+                                 MCA_BASE_VAR_SCOPE_ALL_EQ,
+                                 &orte_grpcomm_base.bucket_size);
+
+    orte_grpcomm_base.tree_radix = 64;
+    (void) mca_base_var_register("orte", "grpcomm", "base", "tree_radix",
+                                 "Fanout of the daemon routing tree assumed when estimating the cost of allgather algorithms - should match the radix of the routing tree in use [default: 64]",
+                                 MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                                 OPAL_INFO_LVL_9,
+                                 MCA_BASE_VAR_SCOPE_ALL_EQ,
+                                 &orte_grpcomm_base.tree_radix);
+
+    allgather_table = NULL;
+    (void) mca_base_var_register("orte", "grpcomm", "base", "allgather_table",
+                                 "Comma-separated list of ndmns:component entries overriding the allgather cost model - the named "
+                                 "component is preferred for collectives spanning at least ndmns daemons (e.g., \"0:direct,64:brucks\")",
+                                 MCA_BASE_VAR_TYPE_STRING, NULL, 0, 0,
+                                 OPAL_INFO_LVL_9,
+                                 MCA_BASE_VAR_SCOPE_ALL_EQ,
+                                 &allgather_table);
+
+    orte_grpcomm_base.dump_table = false;
+    (void) mca_base_var_register("orte", "grpcomm", "base", "dump_allgather_table",
+                                 "Print the allgather algorithm selected for each collective size, along with the estimated cost of each option [default: false]",
+                                 MCA_BASE_VAR_TYPE_BOOL, NULL, 0, 0,
+                                 OPAL_INFO_LVL_9,
+                                 MCA_BASE_VAR_SCOPE_READONLY,
+                                 &orte_grpcomm_base.dump_table);
+
+    return ORTE_SUCCESS;
+}
+
+static int rule_cmp(const void *a, const void *b)
+{
+    const orte_grpcomm_base_rule_t *ra = (const orte_grpcomm_base_rule_t*)a;
+    const orte_grpcomm_base_rule_t *rb = (const orte_grpcomm_base_rule_t*)b;
+
+    if (ra->min_dmns < rb->min_dmns) {
+        return -1;
+    }
+    if (ra->min_dmns > rb->min_dmns) {
+        return 1;
+    }
+    return 0;
+}
+
+static void free_allgather_table(void)
+{
+    int i;
+
+    for (i=0; i < orte_grpcomm_base.nrules; i++) {
+        free(orte_grpcomm_base.rules[i].component);
+    }
+    free(orte_grpcomm_base.rules);
+    orte_grpcomm_base.rules = NULL;
+    orte_grpcomm_base.nrules = 0;
+}
+
+static int parse_allgather_table(void)
+{
+    char **entries, *ptr, *end;
+    int i, n, rc = ORTE_SUCCESS;
+
+    orte_grpcomm_base.rules = NULL;
+    orte_grpcomm_base.nrules = 0;
+    if (NULL == allgather_table || 0 == strlen(allgather_table)) {
+        return ORTE_SUCCESS;
+    }
+
+    entries = opal_argv_split(allgather_table, ',');
+    n = opal_argv_count(entries);
+    orte_grpcomm_base.rules = (orte_grpcomm_base_rule_t*)calloc(n, sizeof(orte_grpcomm_base_rule_t));
+    if (NULL == orte_grpcomm_base.rules) {
+        opal_argv_free(entries);
+        return ORTE_ERR_OUT_OF_RESOURCE;
+    }
+    for (i=0; i < n; i++) {
+        if (NULL == (ptr = strchr(entries[i], ':')) || ptr == entries[i] || '\0' == ptr[1]) {
+            opal_output(0, "grpcomm:base: invalid allgather_table entry \"%s\" - must be ndmns:component", entries[i]);
+            rc = ORTE_ERR_BAD_PARAM;
+            break;
+        }
+        *ptr = '\0';
+        orte_grpcomm_base.rules[i].min_dmns = strtoul(entries[i], &end, 10);
+        if ('\0' != *end) {
+            opal_output(0, "grpcomm:base: invalid allgather_table size \"%s\"", entries[i]);
+            rc = ORTE_ERR_BAD_PARAM;
+            break;
+        }
+        if (NULL == (orte_grpcomm_base.rules[i].component = strdup(ptr + 1))) {
+            rc = ORTE_ERR_OUT_OF_RESOURCE;
+            break;
+        }
+        orte_grpcomm_base.nrules++;
+    }
+    opal_argv_free(entries);
+    if (ORTE_SUCCESS != rc) {
+        free_allgather_table();
+        return rc;
+    }
+    qsort(orte_grpcomm_base.rules, orte_grpcomm_base.nrules,
+          sizeof(orte_grpcomm_base_rule_t), rule_cmp);
+    return ORTE_SUCCESS;
+}
 
 static int orte_grpcomm_base_close(void)
 {
@@ -74,6 +209,7 @@ static int orte_grpcomm_base_close(void)
     OPAL_LIST_DESTRUCT(&orte_grpcomm_base.actives);
     OPAL_LIST_DESTRUCT(&orte_grpcomm_base.ongoing);
     OBJ_DESTRUCT(&orte_grpcomm_base.sig_table);
+    free_allgather_table();
 
     return mca_base_framework_components_close(&orte_grpcomm_base_framework, NULL);
 }
@@ -84,6 +220,11 @@ static int orte_grpcomm_base_close(void)
  */
 static int orte_grpcomm_base_open(mca_base_open_flag_t flags)
 {
+    int rc;
+
+    if (ORTE_SUCCESS != (rc = parse_allgather_table())) {
+        return rc;
+    }
     OBJ_CONSTRUCT(&orte_grpcomm_base.actives, opal_list_t);
     OBJ_CONSTRUCT(&orte_grpcomm_base.ongoing, opal_list_t);
     OBJ_CONSTRUCT(&orte_grpcomm_base.sig_table, opal_hash_table_t);
@@ -92,7 +233,7 @@ static int orte_grpcomm_base_open(mca_base_open_flag_t flags)
     return mca_base_framework_components_open(&orte_grpcomm_base_framework, flags);
 }
 
-MCA_BASE_FRAMEWORK_DECLARE(orte, grpcomm, NULL, NULL, orte_grpcomm_base_open, orte_grpcomm_base_close,
+MCA_BASE_FRAMEWORK_DECLARE(orte, grpcomm, NULL, orte_grpcomm_base_register, orte_grpcomm_base_open, orte_grpcomm_base_close,
                            mca_grpcomm_base_static_components, 0);
 
 OBJ_CLASS_INSTANCE(orte_grpcomm_base_active_t,
@@ -22,6 +22,10 @@
 
 #include "orte_config.h"
 
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
 #include "orte/mca/mca.h"
 #include "opal/mca/base/base.h"
 
@@ -117,5 +121,95 @@ int orte_grpcomm_base_select(void)
             opal_output(0, "\tComponent: %s Priority: %d", mod->component->mca_component_name, mod->pri);
         }
     }
+
+    if (orte_grpcomm_base.dump_table && ORTE_PROC_IS_HNP) {
+        orte_grpcomm_base_dump_allgather_table();
+    }
     return ORTE_SUCCESS;
 }
+
+/* find the active module an allgather across ndmns daemons
+ * should be attempted with first. An entry in the tuning
+ * table takes precedence - otherwise, pick the module with
+ * the lowest estimated cost. Returns NULL if no preference
+ * can be determined, in which case the actives are simply
+ * tried in priority order */
+orte_grpcomm_base_active_t* orte_grpcomm_base_select_allgather(size_t ndmns)
+{
+    orte_grpcomm_base_active_t *active, *best = NULL;
+    char *name = NULL;
+    double cost, bestcost = 0.0;
+    int i;
+
+    /* the last entry whose threshold we meet wins */
+    for (i=0; i < orte_grpcomm_base.nrules; i++) {
+        if (ndmns < orte_grpcomm_base.rules[i].min_dmns) {
+            break;
+        }
+        name = orte_grpcomm_base.rules[i].component;
+    }
+    OPAL_LIST_FOREACH(active, &orte_grpcomm_base.actives, orte_grpcomm_base_active_t) {
+        if (NULL == active->module->allgather) {
+            continue;
+        }
+        if (NULL != name) {
+            if (0 == strcmp(name, active->component->mca_component_name)) {
+                return active;
+            }
+            continue;
+        }
+        if (NULL == active->module->allgather_cost) {
+            continue;
+        }
+        cost = active->module->allgather_cost(ndmns, orte_grpcomm_base.bucket_size,
+                                              orte_grpcomm_base.latency,
+                                              orte_grpcomm_base.bandwidth);
+        /* ties go to the higher priority module, which we saw first */
+        if (0.0 <= cost && (NULL == best || cost < bestcost)) {
+            best = active;
+            bestcost = cost;
+        }
+    }
+    return best;
+}
+
+void orte_grpcomm_base_dump_allgather_table(void)
+{
+    orte_grpcomm_base_active_t *active, *best;
+    size_t ndmns;
+    double cost;
+    char *line, *tmp;
+    int rc;
+
+    opal_output(0, "%s grpcomm:base: allgather table (latency %g usec, bandwidth %g bytes/usec, bucket %lu bytes, tree radix %d)",
+                ORTE_NAME_PRINT(ORTE_PROC_MY_NAME), orte_grpcomm_base.latency,
+                orte_grpcomm_base.bandwidth, (unsigned long)orte_grpcomm_base.bucket_size,
+                orte_grpcomm_base.tree_radix);
+    for (ndmns=2; ndmns <= 65536; ndmns *= 2) {
+        best = orte_grpcomm_base_select_allgather(ndmns);
+        if (0 > asprintf(&line, "\t%6lu daemons: %-8s", (unsigned long)ndmns,
+                         (NULL == best) ? "default" : best->component->mca_component_name)) {
+            return;
+        }
+        OPAL_LIST_FOREACH(active, &orte_grpcomm_base.actives, orte_grpcomm_base_active_t) {
+            if (NULL == active->module->allgather || NULL == active->module->allgather_cost) {
+                continue;
+            }
+            cost = active->module->allgather_cost(ndmns, orte_grpcomm_base.bucket_size,
+                                                  orte_grpcomm_base.latency,
+                                                  orte_grpcomm_base.bandwidth);
+            if (cost < 0.0) {
+                rc = asprintf(&tmp, "%s %s=n/a", line, active->component->mca_component_name);
+            } else {
+                rc = asprintf(&tmp, "%s %s=%.1f", line, active->component->mca_component_name, cost);
+            }
+            free(line);
+            if (0 > rc) {
+                return;
+            }
+            line = tmp;
+        }
+        opal_output(0, "%s", line);
+        free(line);
+    }
+}
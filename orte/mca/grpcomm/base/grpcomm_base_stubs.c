@@ -29,6 +29,7 @@
 
 
 #include "opal/dss/dss.h"
+#include "opal/mca/compress/compress.h"
 
 #include "orte/util/proc_info.h"
 #include "orte/util/error_strings.h"
@@ -45,11 +46,6 @@
 #include "orte/mca/grpcomm/grpcomm.h"
 #include "orte/mca/grpcomm/base/base.h"
 
-static int pack_xcast(orte_grpcomm_signature_t *sig,
-                      opal_buffer_t *buffer,
-                      opal_buffer_t *message,
-                      orte_rml_tag_t tag);
-
 static int create_dmns(orte_grpcomm_signature_t *sig,
                        orte_vpid_t **dmns, size_t *ndmns);
 
@@ -72,6 +68,9 @@ static OBJ_CLASS_INSTANCE(orte_grpcomm_caddy_t,
                           opal_object_t,
                           gccon, NULL);
 
+/* sizing hint for the xcast messages we build */
+static opal_dss_lease_t xcast_lease = OPAL_DSS_LEASE_STATIC_INIT;
+
 int orte_grpcomm_API_xcast(orte_grpcomm_signature_t *sig,
                            orte_rml_tag_t tag,
                            opal_buffer_t *msg)
@@ -91,7 +90,7 @@ int orte_grpcomm_API_xcast(orte_grpcomm_signature_t *sig,
      * so it does not require us to push it into the event library */
 
     /* prep the output buffer */
-    buf = OBJ_NEW(opal_buffer_t);
+    buf = opal_dss.lease(&xcast_lease);
 
     /* create the array of participating daemons */
     if (ORTE_SUCCESS != (rc = create_dmns(sig, &dmns, &ndmns))) {
@@ -101,7 +100,7 @@ int orte_grpcomm_API_xcast(orte_grpcomm_signature_t *sig,
     }
 
     /* setup the payload */
-    if (ORTE_SUCCESS != (rc = pack_xcast(sig, buf, msg, tag))) {
+    if (ORTE_SUCCESS != (rc = orte_grpcomm_base_pack_xcast(sig, buf, msg, tag))) {
         ORTE_ERROR_LOG(rc);
         OBJ_RELEASE(buf);
         if (NULL != dmns) {
@@ -130,7 +129,7 @@ static void allgather_stub(int fd, short args, void *cbdata)
     orte_grpcomm_caddy_t *cd = (orte_grpcomm_caddy_t*)cbdata;
     int ret = OPAL_SUCCESS;
     int rc;
-    orte_grpcomm_base_active_t *active;
+    orte_grpcomm_base_active_t *active, *best;
     orte_grpcomm_coll_t *coll;
     void *seq_number;
 
@@ -167,8 +166,26 @@ static void allgather_stub(int fd, short args, void *cbdata)
     coll->cbfunc = cd->cbfunc;
     coll->cbdata = cd->cbdata;
 
+    /* start with the module expected to be fastest for this
+     * many daemons - every participant reaches the same choice */
+    best = orte_grpcomm_base_select_allgather(coll->ndmns);
+    if (NULL != best) {
+        OPAL_OUTPUT_VERBOSE((5, orte_grpcomm_base_framework.framework_output,
+                             "%s grpcomm:base:allgather selected %s for %lu daemons",
+                             ORTE_NAME_PRINT(ORTE_PROC_MY_NAME),
+                             best->component->mca_component_name,
+                             (unsigned long)coll->ndmns));
+        if (ORTE_SUCCESS == best->module->allgather(coll, cd->buf)) {
+            OBJ_RELEASE(cd);
+            return;
+        }
+    }
+
     /* cycle thru the actives and see who can process it */
     OPAL_LIST_FOREACH(active, &orte_grpcomm_base.actives, orte_grpcomm_base_active_t) {
+        if (active == best) {
+            continue;
+        }
         if (NULL != active->module->allgather) {
             if (ORTE_SUCCESS == (rc = active->module->allgather(coll, cd->buf))) {
                 break;
@@ -434,12 +451,16 @@ static int create_dmns(orte_grpcomm_signature_t *sig,
     return ORTE_SUCCESS;
 }
 
-static int pack_xcast(orte_grpcomm_signature_t *sig,
-                      opal_buffer_t *buffer,
-                      opal_buffer_t *message,
-                      orte_rml_tag_t tag)
+int orte_grpcomm_base_pack_xcast(orte_grpcomm_signature_t *sig,
+                                 opal_buffer_t *buffer,
+                                 opal_buffer_t *message,
+                                 orte_rml_tag_t tag)
 {
     int rc;
+    int8_t flag;
+    size_t inlen, cmplen;
+    uint8_t *cmpdata;
+    opal_byte_object_t bo, *boptr;
 
     /* pass along the signature */
     if (ORTE_SUCCESS != (rc = opal_dss.pack(buffer, &sig, 1, ORTE_SIGNATURE))) {
@@ -452,6 +473,36 @@ static int pack_xcast(orte_grpcomm_signature_t *sig,
         goto CLEANUP;
     }
 
+    /* large payloads, such as the launch msg, are worth compressing
+     * as they will cross every level of the routing tree */
+    if (NULL != message && orte_compress_xcast &&
+        0 < (inlen = message->bytes_used - (message->unpack_ptr - message->base_ptr)) &&
+        opal_compress.compress_block((uint8_t*)message->unpack_ptr, inlen,
+                                     &cmpdata, &cmplen)) {
+        OPAL_OUTPUT_VERBOSE((2, orte_grpcomm_base_framework.framework_output,
+                             "%s grpcomm:base:xcast compressed %lu bytes to %lu",
+                             ORTE_NAME_PRINT(ORTE_PROC_MY_NAME),
+                             (unsigned long)inlen, (unsigned long)cmplen));
+        flag = 1;
+        bo.bytes = cmpdata;
+        bo.size = cmplen;
+        boptr = &bo;
+        if (ORTE_SUCCESS != (rc = opal_dss.pack(buffer, &flag, 1, OPAL_INT8)) ||
+            ORTE_SUCCESS != (rc = opal_dss.pack(buffer, &inlen, 1, OPAL_SIZE)) ||
+            ORTE_SUCCESS != (rc = opal_dss.pack(buffer, &boptr, 1, OPAL_BYTE_OBJECT))) {
+            ORTE_ERROR_LOG(rc);
+        }
+        free(cmpdata);
+        goto CLEANUP;
+    }
+
+    /* flag that the payload is not compressed */
+    flag = 0;
+    if (ORTE_SUCCESS != (rc = opal_dss.pack(buffer, &flag, 1, OPAL_INT8))) {
+        ORTE_ERROR_LOG(rc);
+        goto CLEANUP;
+    }
+
     /* copy the payload into the new buffer - this is non-destructive, so our
      * caller is still responsible for releasing any memory in the buffer they
      * gave to us
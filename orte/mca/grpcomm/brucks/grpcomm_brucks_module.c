@@ -39,6 +39,8 @@ static int init(void);
 static void finalize(void);
 static int allgather(orte_grpcomm_coll_t *coll,
                      opal_buffer_t *buf);
+static double allgather_cost(size_t ndmns, size_t bucket,
+                             double latency, double bandwidth);
 static void brucks_allgather_process_data(orte_grpcomm_coll_t *coll, uint32_t distance);
 static int brucks_allgather_send_dist(orte_grpcomm_coll_t *coll, orte_process_name_t *peer, uint32_t distance);
 static void brucks_allgather_recv_dist(int status, orte_process_name_t* sender,
@@ -51,7 +53,8 @@ orte_grpcomm_base_module_t orte_grpcomm_brucks_module = {
     init,
     finalize,
     NULL,
-    allgather
+    allgather,
+    allgather_cost
 };
 
 /**
@@ -82,6 +85,17 @@ static int allgather(orte_grpcomm_coll_t *coll,
     OPAL_OUTPUT_VERBOSE((5, orte_grpcomm_base_framework.framework_output,
                          "%s grpcomm:coll:brucks algo employed for %d processes",
                          ORTE_NAME_PRINT(ORTE_PROC_MY_NAME), (int)coll->ndmns));
+    /* a NULL array means that all daemons are participating */
+    if (NULL == coll->dmns) {
+        coll->dmns = (orte_vpid_t*)malloc(coll->ndmns * sizeof(orte_vpid_t));
+        if (NULL == coll->dmns) {
+            return ORTE_ERR_OUT_OF_RESOURCE;
+        }
+        for (orte_vpid_t nv = 0; nv < coll->ndmns; nv++) {
+            coll->dmns[nv] = nv;
+        }
+    }
+
     /* get my own rank */
     coll->my_rank = ORTE_VPID_INVALID;
     for (orte_vpid_t nv = 0; nv < coll->ndmns; nv++) {
@@ -117,6 +131,17 @@ static int allgather(orte_grpcomm_coll_t *coll,
     return ORTE_SUCCESS;
 }
 
+/* ceil(log2(ndmns)) rounds for any number of daemons, every
+ * daemon receiving (ndmns-1) buckets in total */
+static double allgather_cost(size_t ndmns, size_t bucket,
+                             double latency, double bandwidth)
+{
+    if (0 == ndmns) {
+        return -1.0;
+    }
+    return ceil(log2(ndmns)) * latency + (double)((ndmns - 1) * bucket) / bandwidth;
+}
+
 static int brucks_allgather_send_dist(orte_grpcomm_coll_t *coll, orte_process_name_t *peer, uint32_t distance) {
     opal_buffer_t *send_buf;
     int rc;
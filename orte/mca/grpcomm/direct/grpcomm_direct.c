@@ -22,10 +22,13 @@
 #include <string.h>
 
 #include "opal/dss/dss.h"
+#include "opal/class/opal_bitmap.h"
 #include "opal/class/opal_list.h"
+#include "opal/mca/compress/compress.h"
 
 #include "orte/mca/errmgr/errmgr.h"
 #include "orte/mca/rml/rml.h"
+#include "orte/mca/rml/base/base.h"
 #include "orte/mca/routed/routed.h"
 #include "orte/mca/state/state.h"
 #include "orte/util/name_fns.h"
@@ -44,19 +47,31 @@ static int xcast(orte_vpid_t *vpids,
                  opal_buffer_t *buf);
 static int allgather(orte_grpcomm_coll_t *coll,
                      opal_buffer_t *buf);
+static double allgather_cost(size_t ndmns, size_t bucket,
+                             double latency, double bandwidth);
 
 /* Module def */
 orte_grpcomm_base_module_t orte_grpcomm_direct_module = {
     init,
     finalize,
     xcast,
-    allgather
+    allgather,
+    allgather_cost
 };
 
+/* sizing hints for the messages we build here */
+static opal_dss_lease_t allgather_lease = OPAL_DSS_LEASE_STATIC_INIT;
+static opal_dss_lease_t release_lease = OPAL_DSS_LEASE_STATIC_INIT;
+static opal_dss_lease_t rollup_lease = OPAL_DSS_LEASE_STATIC_INIT;
+
 /* internal functions */
 static void xcast_recv(int status, orte_process_name_t* sender,
                        opal_buffer_t* buffer, orte_rml_tag_t tag,
                        void* cbdata);
+static void xcast_chunk_recv(int status, orte_process_name_t* sender,
+                             opal_buffer_t* buffer, orte_rml_tag_t tag,
+                             void* cbdata);
+static void process_xcast(opal_buffer_t *rly, opal_list_t *sent);
 static void allgather_recv(int status, orte_process_name_t* sender,
                            opal_buffer_t* buffer, orte_rml_tag_t tag,
                            void* cbdata);
@@ -64,8 +79,41 @@ static void barrier_release(int status, orte_process_name_t* sender,
                             opal_buffer_t* buffer, orte_rml_tag_t tag,
                             void* cbdata);
 
+/* an xcast being received in chunks */
+typedef struct {
+    opal_list_item_t super;
+    orte_vpid_t origin;     // daemon that split the message
+    uint32_t id;            // origin's id for the message
+    char *data;             // the message being reassembled
+    size_t total;
+    size_t received;
+    opal_bitmap_t seen;     // chunks received so far
+    opal_list_t children;   // who we forwarded the chunks to
+} orte_grpcomm_direct_chunked_t;
+static void chcon(orte_grpcomm_direct_chunked_t *p)
+{
+    p->data = NULL;
+    p->total = 0;
+    p->received = 0;
+    OBJ_CONSTRUCT(&p->seen, opal_bitmap_t);
+    OBJ_CONSTRUCT(&p->children, opal_list_t);
+}
+static void chdes(orte_grpcomm_direct_chunked_t *p)
+{
+    if (NULL != p->data) {
+        free(p->data);
+    }
+    OBJ_DESTRUCT(&p->seen);
+    OPAL_LIST_DESTRUCT(&p->children);
+}
+static OBJ_CLASS_INSTANCE(orte_grpcomm_direct_chunked_t,
+                          opal_list_item_t,
+                          chcon, chdes);
+
 /* internal variables */
 static opal_list_t tracker;
+static opal_list_t chunked;
+static uint32_t chunk_id = 0;
 
 /**
  * Initialize the module
@@ -73,12 +121,17 @@ static opal_list_t tracker;
 static int init(void)
 {
     OBJ_CONSTRUCT(&tracker, opal_list_t);
+    OBJ_CONSTRUCT(&chunked, opal_list_t);
 
     /* post the receives */
     orte_rml.recv_buffer_nb(ORTE_NAME_WILDCARD,
                             ORTE_RML_TAG_XCAST,
                             ORTE_RML_PERSISTENT,
                             xcast_recv, NULL);
+    orte_rml.recv_buffer_nb(ORTE_NAME_WILDCARD,
+                            ORTE_RML_TAG_XCAST_CHUNK,
+                            ORTE_RML_PERSISTENT,
+                            xcast_chunk_recv, NULL);
     orte_rml.recv_buffer_nb(ORTE_NAME_WILDCARD,
                             ORTE_RML_TAG_ALLGATHER_DIRECT,
                             ORTE_RML_PERSISTENT,
@@ -99,8 +152,10 @@ static void finalize(void)
 {
     /* cancel the recv */
     orte_rml.recv_cancel(ORTE_NAME_WILDCARD, ORTE_RML_TAG_XCAST);
+    orte_rml.recv_cancel(ORTE_NAME_WILDCARD, ORTE_RML_TAG_XCAST_CHUNK);
 
     OPAL_LIST_DESTRUCT(&tracker);
+    OPAL_LIST_DESTRUCT(&chunked);
     return;
 }
 
@@ -135,7 +190,7 @@ static int allgather(orte_grpcomm_coll_t *coll,
      * before calling us, so we can safely access global data
      * at this point */
 
-    relay = OBJ_NEW(opal_buffer_t);
+    relay = opal_dss.lease(&allgather_lease);
     /* pack the signature */
     if (OPAL_SUCCESS != (rc = opal_dss.pack(relay, &coll->sig, 1, ORTE_SIGNATURE))) {
         ORTE_ERROR_LOG(rc);
@@ -158,6 +213,29 @@ static int allgather(orte_grpcomm_coll_t *coll,
     return rc;
 }
 
+/* the contributions roll up the routing tree to the HNP, which
+ * then xcasts the collected data back down - each parent sending
+ * its own copy of everything to each of its children. The fanout
+ * of our own position in the tree differs from one daemon to the
+ * next, so use the job-wide radix instead */
+static double allgather_cost(size_t ndmns, size_t bucket,
+                             double latency, double bandwidth)
+{
+    size_t radix, depth = 0, span = 1, level = 1, fanout;
+    double total;
+
+    radix = (0 < orte_grpcomm_base.tree_radix) ? (size_t)orte_grpcomm_base.tree_radix : 1;
+    while (span < ndmns) {
+        level *= radix;
+        span += level;
+        depth++;
+    }
+    fanout = (radix < ndmns) ? radix : ndmns - 1;
+    total = (double)(ndmns * bucket) / bandwidth;
+
+    return 2.0 * depth * latency + total * (1.0 + depth * fanout);
+}
+
 static void allgather_recv(int status, orte_process_name_t* sender,
                            opal_buffer_t* buffer, orte_rml_tag_t tag,
                            void* cbdata)
@@ -204,7 +282,7 @@ static void allgather_recv(int status, orte_process_name_t* sender,
                                  "%s grpcomm:direct allgather HNP reports complete",
                                  ORTE_NAME_PRINT(ORTE_PROC_MY_NAME)));
             /* the allgather is complete - send the xcast */
-            reply = OBJ_NEW(opal_buffer_t);
+            reply = opal_dss.lease(&release_lease);
             /* pack the signature */
             if (OPAL_SUCCESS != (rc = opal_dss.pack(reply, &sig, 1, ORTE_SIGNATURE))) {
                 ORTE_ERROR_LOG(rc);
@@ -232,7 +310,7 @@ static void allgather_recv(int status, orte_process_name_t* sender,
                                  ORTE_NAME_PRINT(ORTE_PROC_MY_NAME),
                                  ORTE_NAME_PRINT(ORTE_PROC_MY_PARENT)));
             /* relay the bucket upward */
-            reply = OBJ_NEW(opal_buffer_t);
+            reply = opal_dss.lease(&rollup_lease);
             /* pack the signature */
             if (OPAL_SUCCESS != (rc = opal_dss.pack(reply, &sig, 1, ORTE_SIGNATURE))) {
                 ORTE_ERROR_LOG(rc);
@@ -251,37 +329,266 @@ static void allgather_recv(int status, orte_process_name_t* sender,
     OBJ_RELEASE(sig);
 }
 
+/* check the state of a relay recipient - no point
+ * sending to someone not alive */
+static bool relay_ok(orte_process_name_t *name)
+{
+    orte_job_t *jdata;
+    orte_proc_t *rec;
+
+    jdata = orte_get_job_data_object(name->jobid);
+    if (NULL == (rec = (orte_proc_t*)opal_pointer_array_get_item(jdata->procs, name->vpid))) {
+        opal_output(0, "%s grpcomm:direct:send_relay proc %s not found - cannot relay",
+                    ORTE_NAME_PRINT(ORTE_PROC_MY_NAME), ORTE_NAME_PRINT(name));
+        return false;
+    }
+    if (ORTE_PROC_STATE_RUNNING < rec->state) {
+        opal_output(0, "%s grpcomm:direct:send_relay proc %s not running - cannot relay",
+                    ORTE_NAME_PRINT(ORTE_PROC_MY_NAME), ORTE_NAME_PRINT(name));
+        return false;
+    }
+    return true;
+}
+
+/* split an xcast message into chunks for pipelined relay. Each
+ * chunk carries enough to place it in the reassembled message */
+static opal_buffer_t** make_chunks(opal_buffer_t *rly, int *nchunks)
+{
+    opal_buffer_t **chunks;
+    size_t offset, total, len;
+    int32_t n;
+    int rc;
+    uint32_t id;
+
+    total = rly->bytes_used;
+    *nchunks = (total + orte_grpcomm_direct_xcast_chunk_size - 1) / orte_grpcomm_direct_xcast_chunk_size;
+    if (NULL == (chunks = (opal_buffer_t**)malloc(*nchunks * sizeof(opal_buffer_t*)))) {
+        ORTE_ERROR_LOG(ORTE_ERR_OUT_OF_RESOURCE);
+        return NULL;
+    }
+    id = chunk_id++;
+
+    for (n=0, offset=0; n < *nchunks; n++, offset += len) {
+        len = total - offset;
+        if (orte_grpcomm_direct_xcast_chunk_size < len) {
+            len = orte_grpcomm_direct_xcast_chunk_size;
+        }
+        chunks[n] = OBJ_NEW(opal_buffer_t);
+        if (OPAL_SUCCESS != (rc = opal_dss.pack(chunks[n], &ORTE_PROC_MY_NAME->vpid, 1, ORTE_VPID)) ||
+            OPAL_SUCCESS != (rc = opal_dss.pack(chunks[n], &id, 1, OPAL_UINT32)) ||
+            OPAL_SUCCESS != (rc = opal_dss.pack(chunks[n], &total, 1, OPAL_SIZE)) ||
+            OPAL_SUCCESS != (rc = opal_dss.pack(chunks[n], nchunks, 1, OPAL_INT32)) ||
+            OPAL_SUCCESS != (rc = opal_dss.pack(chunks[n], &n, 1, OPAL_INT32)) ||
+            OPAL_SUCCESS != (rc = opal_dss.pack(chunks[n], &offset, 1, OPAL_SIZE)) ||
+            OPAL_SUCCESS != (rc = opal_dss.pack(chunks[n], &len, 1, OPAL_SIZE)) ||
+            OPAL_SUCCESS != (rc = opal_dss.pack(chunks[n], rly->base_ptr + offset, len, OPAL_BYTE))) {
+            ORTE_ERROR_LOG(rc);
+            for (; 0 <= n; n--) {
+                OBJ_RELEASE(chunks[n]);
+            }
+            free(chunks);
+            return NULL;
+        }
+    }
+
+    OPAL_OUTPUT_VERBOSE((5, orte_grpcomm_base_framework.framework_output,
+                         "%s grpcomm:direct:xcast split %lu bytes into %d chunks",
+                         ORTE_NAME_PRINT(ORTE_PROC_MY_NAME),
+                         (unsigned long)total, *nchunks));
+    return chunks;
+}
+
 static void xcast_recv(int status, orte_process_name_t* sender,
                        opal_buffer_t* buffer, orte_rml_tag_t tg,
                        void* cbdata)
 {
-    opal_list_item_t *item;
+    opal_buffer_t *rly;
+    void *payload;
+    int32_t sz;
+
+    OPAL_OUTPUT_VERBOSE((1, orte_grpcomm_base_framework.framework_output,
+                         "%s grpcomm:direct:xcast:recv: with %d bytes",
+                         ORTE_NAME_PRINT(ORTE_PROC_MY_NAME),
+                         (int)buffer->bytes_used));
+
+    /* take over the incoming data - nothing has been unpacked yet,
+     * so this just transfers ownership of the bytes. The resulting
+     * buffer is relayed as-is to all of our children and shared
+     * with our own delivery, so the payload is never copied */
+    rly = OBJ_NEW(opal_buffer_t);
+    opal_dss.unload(buffer, &payload, &sz);
+    opal_dss.load(rly, payload, sz);
+
+    process_xcast(rly, NULL);
+}
+
+static void xcast_chunk_recv(int status, orte_process_name_t* sender,
+                             opal_buffer_t* buffer, orte_rml_tag_t tg,
+                             void* cbdata)
+{
+    opal_buffer_t *fwd, *rly;
+    void *payload;
+    int32_t sz, count, index;
+    int cnt, ret;
+    orte_vpid_t origin;
+    uint32_t id;
+    size_t total, offset, len;
+    orte_grpcomm_direct_chunked_t *ch, *cptr;
     orte_namelist_t *nm;
-    int ret, cnt;
-    opal_buffer_t *relay, *rly;
+
+    /* take over the incoming data so the chunk can be
+     * passed along to our children as-is */
+    fwd = OBJ_NEW(opal_buffer_t);
+    opal_dss.unload(buffer, &payload, &sz);
+    opal_dss.load(fwd, payload, sz);
+
+    cnt=1;
+    if (OPAL_SUCCESS != (ret = opal_dss.unpack(fwd, &origin, &cnt, ORTE_VPID)) ||
+        OPAL_SUCCESS != (ret = opal_dss.unpack(fwd, &id, &cnt, OPAL_UINT32)) ||
+        OPAL_SUCCESS != (ret = opal_dss.unpack(fwd, &total, &cnt, OPAL_SIZE)) ||
+        OPAL_SUCCESS != (ret = opal_dss.unpack(fwd, &count, &cnt, OPAL_INT32)) ||
+        OPAL_SUCCESS != (ret = opal_dss.unpack(fwd, &index, &cnt, OPAL_INT32)) ||
+        OPAL_SUCCESS != (ret = opal_dss.unpack(fwd, &offset, &cnt, OPAL_SIZE)) ||
+        OPAL_SUCCESS != (ret = opal_dss.unpack(fwd, &len, &cnt, OPAL_SIZE))) {
+        ORTE_ERROR_LOG(ret);
+        OBJ_RELEASE(fwd);
+        ORTE_FORCED_TERMINATE(ret);
+        return;
+    }
+    /* a chunk that does not fit in its message is not passed on */
+    if (0 == len || total < len || total - len < offset ||
+        count <= 0 || (size_t)count > total || index < 0 || index >= count ||
+        (size_t)(fwd->bytes_used - (fwd->unpack_ptr - fwd->base_ptr)) < len) {
+        ORTE_ERROR_LOG(ORTE_ERR_BAD_PARAM);
+        OBJ_RELEASE(fwd);
+        ORTE_FORCED_TERMINATE(ORTE_ERR_BAD_PARAM);
+        return;
+    }
+
+    /* find the message this chunk belongs to */
+    ch = NULL;
+    OPAL_LIST_FOREACH(cptr, &chunked, orte_grpcomm_direct_chunked_t) {
+        if (cptr->origin == origin && cptr->id == id) {
+            ch = cptr;
+            break;
+        }
+    }
+    if (NULL == ch) {
+        ch = OBJ_NEW(orte_grpcomm_direct_chunked_t);
+        ch->origin = origin;
+        ch->id = id;
+        ch->total = total;
+        if (NULL == (ch->data = (char*)malloc(total)) ||
+            OPAL_SUCCESS != opal_bitmap_init(&ch->seen, count)) {
+            ORTE_ERROR_LOG(ORTE_ERR_OUT_OF_RESOURCE);
+            OBJ_RELEASE(ch);
+            OBJ_RELEASE(fwd);
+            ORTE_FORCED_TERMINATE(ORTE_ERR_OUT_OF_RESOURCE);
+            return;
+        }
+        /* all chunks go to the children we have now - the routing
+         * plan can only change once the message is complete */
+        orte_routed.get_routing_list(&ch->children);
+        opal_list_append(&chunked, &ch->super);
+    } else if (total != ch->total) {
+        ORTE_ERROR_LOG(ORTE_ERR_BAD_PARAM);
+        OBJ_RELEASE(fwd);
+        ORTE_FORCED_TERMINATE(ORTE_ERR_BAD_PARAM);
+        return;
+    }
+
+    /* a chunk we already have was relayed and placed the first time */
+    if (opal_bitmap_is_set_bit(&ch->seen, index)) {
+        OPAL_OUTPUT_VERBOSE((5, orte_grpcomm_base_framework.framework_output,
+                             "%s grpcomm:direct:xcast:chunk dropping duplicate chunk %d of msg %u",
+                             ORTE_NAME_PRINT(ORTE_PROC_MY_NAME), (int)index, id));
+        OBJ_RELEASE(fwd);
+        return;
+    }
+    if (OPAL_SUCCESS != (ret = opal_bitmap_set_bit(&ch->seen, index))) {
+        ORTE_ERROR_LOG(ret);
+        OBJ_RELEASE(fwd);
+        ORTE_FORCED_TERMINATE(ret);
+        return;
+    }
+
+    /* pass the chunk along before we copy it out */
+    OPAL_LIST_FOREACH(nm, &ch->children, orte_namelist_t) {
+        if (!relay_ok(&nm->name)) {
+            continue;
+        }
+        OBJ_RETAIN(fwd);
+        if (ORTE_SUCCESS != (ret = orte_rml.send_buffer_nb(&nm->name, fwd, ORTE_RML_TAG_XCAST_CHUNK,
+                                                           orte_rml_send_callback, NULL))) {
+            ORTE_ERROR_LOG(ret);
+            OBJ_RELEASE(fwd);
+        }
+    }
+
+    /* place the chunk in the message */
+    cnt = (int)len;
+    if (OPAL_SUCCESS != (ret = opal_dss.unpack(fwd, ch->data + offset, &cnt, OPAL_BYTE))) {
+        ORTE_ERROR_LOG(ret);
+        OBJ_RELEASE(fwd);
+        ORTE_FORCED_TERMINATE(ret);
+        return;
+    }
+    OBJ_RELEASE(fwd);
+    ch->received += len;
+
+    OPAL_OUTPUT_VERBOSE((5, orte_grpcomm_base_framework.framework_output,
+                         "%s grpcomm:direct:xcast:chunk recvd %lu of %lu bytes of msg %u from %s",
+                         ORTE_NAME_PRINT(ORTE_PROC_MY_NAME),
+                         (unsigned long)ch->received, (unsigned long)ch->total,
+                         id, ORTE_NAME_PRINT(sender)));
+
+    if (ch->received < ch->total) {
+        return;
+    }
+
+    /* the message is complete - process it, relaying it only
+     * to those who weren't already sent the chunks */
+    opal_list_remove_item(&chunked, &ch->super);
+    rly = OBJ_NEW(opal_buffer_t);
+    opal_dss.load(rly, ch->data, ch->total);
+    ch->data = NULL;
+    process_xcast(rly, &ch->children);
+    OBJ_RELEASE(ch);
+}
+
+/* process a complete xcast message, relaying it to our children
+ * that are not on the sent list. Consumes the caller's reference
+ * to the buffer */
+static void process_xcast(opal_buffer_t *rly, opal_list_t *sent)
+{
+    opal_list_item_t *item;
+    orte_namelist_t *nm, *nm2;
+    int ret, cnt, n, nchunks = 0;
+    int32_t sz;
+    opal_buffer_t *relay = NULL, *data, *buffer, **chunks = NULL;
+    void *payload;
+    bool found;
+    char *start = NULL;
+    int8_t compressed;
+    size_t inlen;
+    uint8_t *cmpdata;
     orte_daemon_cmd_flag_t command = ORTE_DAEMON_NULL_CMD;
     opal_buffer_t wireup;
     opal_byte_object_t *bo;
     int8_t flag;
-    orte_job_t *jdata;
-    orte_proc_t *rec;
     opal_list_t coll;
     orte_grpcomm_signature_t *sig;
     orte_rml_tag_t tag;
 
-    OPAL_OUTPUT_VERBOSE((1, orte_grpcomm_base_framework.framework_output,
-                         "%s grpcomm:direct:xcast:recv: with %d bytes",
-                         ORTE_NAME_PRINT(ORTE_PROC_MY_NAME),
-                         (int)buffer->bytes_used));
-
-    /* we need a passthru buffer to send to our children */
-    rly = OBJ_NEW(opal_buffer_t);
-    opal_dss.copy_payload(rly, buffer);
+    /* unpacking only moves the read position - the sends
+     * always transmit the buffer from its start */
+    buffer = rly;
 
     /* get the signature that we do not need */
     cnt=1;
     if (ORTE_SUCCESS != (ret = opal_dss.unpack(buffer, &sig, &cnt, ORTE_SIGNATURE))) {
         ORTE_ERROR_LOG(ret);
+        OBJ_RELEASE(rly);
         ORTE_FORCED_TERMINATE(ret);
         return;
     }
@@ -291,14 +598,56 @@ static void xcast_recv(int status, orte_process_name_t* sender,
     cnt=1;
     if (ORTE_SUCCESS != (ret = opal_dss.unpack(buffer, &tag, &cnt, ORTE_RML_TAG))) {
         ORTE_ERROR_LOG(ret);
+        OBJ_RELEASE(rly);
         ORTE_FORCED_TERMINATE(ret);
         return;
     }
 
-    /* setup a buffer we can pass to ourselves - this just contains
-     * the initial message, minus the headers inserted by xcast itself */
-    relay = OBJ_NEW(opal_buffer_t);
-    opal_dss.copy_payload(relay, buffer);
+    /* see if the payload was compressed */
+    cnt=1;
+    if (ORTE_SUCCESS != (ret = opal_dss.unpack(buffer, &compressed, &cnt, OPAL_INT8))) {
+        ORTE_ERROR_LOG(ret);
+        OBJ_RELEASE(rly);
+        ORTE_FORCED_TERMINATE(ret);
+        return;
+    }
+    if (compressed) {
+        /* children get the compressed form - we only need to
+         * expand it for ourselves */
+        cnt=1;
+        if (ORTE_SUCCESS != (ret = opal_dss.unpack(buffer, &inlen, &cnt, OPAL_SIZE))) {
+            ORTE_ERROR_LOG(ret);
+            OBJ_RELEASE(rly);
+            ORTE_FORCED_TERMINATE(ret);
+            return;
+        }
+        cnt=1;
+        if (ORTE_SUCCESS != (ret = opal_dss.unpack(buffer, &bo, &cnt, OPAL_BYTE_OBJECT))) {
+            ORTE_ERROR_LOG(ret);
+            OBJ_RELEASE(rly);
+            ORTE_FORCED_TERMINATE(ret);
+            return;
+        }
+        if (!opal_compress.decompress_block(&cmpdata, inlen, bo->bytes, bo->size)) {
+            ORTE_ERROR_LOG(ORTE_ERR_UNPACK_FAILURE);
+            free(bo->bytes);
+            free(bo);
+            OBJ_RELEASE(rly);
+            ORTE_FORCED_TERMINATE(ORTE_ERR_UNPACK_FAILURE);
+            return;
+        }
+        free(bo->bytes);
+        free(bo);
+        data = OBJ_NEW(opal_buffer_t);
+        opal_dss.load(data, cmpdata, inlen);
+    } else {
+        /* what we deliver to ourselves is the initial message, minus
+         * the headers inserted by xcast itself */
+        data = rly;
+        OBJ_RETAIN(data);
+        start = data->unpack_ptr;
+    }
+    buffer = data;
     /* setup the relay list */
     OBJ_CONSTRUCT(&coll, opal_list_t);
 
@@ -352,7 +701,8 @@ static void xcast_recv(int status, orte_process_name_t* sender,
                 }
 
                 if (ORTE_DAEMON_ADD_LOCAL_PROCS == command) {
-                    OBJ_RELEASE(relay);
+                    /* the local copy must not include the maps we
+                     * just consumed, so it has to be rebuilt */
                     relay = OBJ_NEW(opal_buffer_t);
                     /* repack the command */
                     if (OPAL_SUCCESS != (ret = opal_dss.pack(relay, &command, 1, ORTE_DAEMON_CMD))) {
@@ -408,37 +758,54 @@ static void xcast_recv(int status, orte_process_name_t* sender,
         OPAL_OUTPUT_VERBOSE((5, orte_grpcomm_base_framework.framework_output,
                              "%s grpcomm:direct:send_relay - recipient list is empty!",
                              ORTE_NAME_PRINT(ORTE_PROC_MY_NAME)));
-        OBJ_RELEASE(rly);
         goto CLEANUP;
     }
 
+    /* large messages are relayed in chunks so our children
+     * can start passing them along before they have it all */
+    if (0 < orte_grpcomm_direct_xcast_chunk_size &&
+        orte_grpcomm_direct_xcast_chunk_size < rly->bytes_used) {
+        chunks = make_chunks(rly, &nchunks);
+    }
+
     /* send the message to each recipient on list, deconstructing it as we go */
     while (NULL != (item = opal_list_remove_first(&coll))) {
         nm = (orte_namelist_t*)item;
 
+        /* skip those that were already sent the message */
+        found = false;
+        if (NULL != sent) {
+            OPAL_LIST_FOREACH(nm2, sent, orte_namelist_t) {
+                if (OPAL_EQUAL == orte_util_compare_name_fields(ORTE_NS_CMP_ALL, &nm->name, &nm2->name)) {
+                    found = true;
+                    break;
+                }
+            }
+        }
+        if (found || !relay_ok(&nm->name)) {
+            OBJ_RELEASE(item);
+            continue;
+        }
+
         OPAL_OUTPUT_VERBOSE((5, orte_grpcomm_base_framework.framework_output,
                              "%s grpcomm:direct:send_relay sending relay msg of %d bytes to %s",
                              ORTE_NAME_PRINT(ORTE_PROC_MY_NAME), (int)rly->bytes_used,
                              ORTE_NAME_PRINT(&nm->name)));
-        OBJ_RETAIN(rly);
-        /* check the state of the recipient - no point
-         * sending to someone not alive
-         */
-        jdata = orte_get_job_data_object(nm->name.jobid);
-        if (NULL == (rec = (orte_proc_t*)opal_pointer_array_get_item(jdata->procs, nm->name.vpid))) {
-            opal_output(0, "%s grpcomm:direct:send_relay proc %s not found - cannot relay",
-                        ORTE_NAME_PRINT(ORTE_PROC_MY_NAME), ORTE_NAME_PRINT(&nm->name));
-            OBJ_RELEASE(rly);
-            OBJ_RELEASE(item);
-            continue;
-        }
-        if (ORTE_PROC_STATE_RUNNING < rec->state) {
-            opal_output(0, "%s grpcomm:direct:send_relay proc %s not running - cannot relay",
-                        ORTE_NAME_PRINT(ORTE_PROC_MY_NAME), ORTE_NAME_PRINT(&nm->name));
-            OBJ_RELEASE(rly);
+        if (NULL != chunks) {
+            for (n=0; n < nchunks; n++) {
+                OBJ_RETAIN(chunks[n]);
+                if (ORTE_SUCCESS != (ret = orte_rml.send_buffer_nb(&nm->name, chunks[n],
+                                                                   ORTE_RML_TAG_XCAST_CHUNK,
+                                                                   orte_rml_send_callback, NULL))) {
+                    ORTE_ERROR_LOG(ret);
+                    OBJ_RELEASE(chunks[n]);
+                    break;
+                }
+            }
             OBJ_RELEASE(item);
             continue;
         }
+        OBJ_RETAIN(rly);
         if (ORTE_SUCCESS != (ret = orte_rml.send_buffer_nb(&nm->name, rly, ORTE_RML_TAG_XCAST,
                                                            orte_rml_send_callback, NULL))) {
             ORTE_ERROR_LOG(ret);
@@ -448,20 +815,40 @@ static void xcast_recv(int status, orte_process_name_t* sender,
         }
         OBJ_RELEASE(item);
     }
-    OBJ_RELEASE(rly);  // retain accounting
+    if (NULL != chunks) {
+        for (n=0; n < nchunks; n++) {
+            OBJ_RELEASE(chunks[n]);
+        }
+        free(chunks);
+    }
 
  CLEANUP:
     /* cleanup */
     OBJ_DESTRUCT(&coll);
 
-    /* now send the relay buffer to myself for processing */
+    /* now deliver the message to myself for processing - we post it
+     * directly rather than sending it to ourselves, which would
+     * cost yet another copy of the data */
     if (ORTE_DAEMON_DVM_NIDMAP_CMD != command) {
-        if (ORTE_SUCCESS != (ret = orte_rml.send_buffer_nb(ORTE_PROC_MY_NAME, relay, tag,
-                                                           orte_rml_send_callback, NULL))) {
-            ORTE_ERROR_LOG(ret);
-            OBJ_RELEASE(relay);
+        if (NULL != relay) {
+            /* nothing has been unpacked, so this doesn't copy */
+            opal_dss.unload(relay, &payload, &sz);
+            ORTE_RML_POST_MESSAGE(ORTE_PROC_MY_NAME, tag, 0, payload, sz);
+        } else if (data != rly) {
+            /* the expanded payload is ours alone - rewind it
+             * so it can be handed over without a copy */
+            data->unpack_ptr = data->base_ptr;
+            opal_dss.unload(data, &payload, &sz);
+            ORTE_RML_POST_MESSAGE(ORTE_PROC_MY_NAME, tag, 0, payload, sz);
+        } else {
+            ORTE_RML_POST_SHARED_MESSAGE(ORTE_PROC_MY_NAME, tag, 0, rly, start);
         }
     }
+    if (NULL != relay) {
+        OBJ_RELEASE(relay);
+    }
+    OBJ_RELEASE(data);
+    OBJ_RELEASE(rly);  // retain accounting
 }
 
 static void barrier_release(int status, orte_process_name_t* sender,
@@ -26,6 +26,10 @@ BEGIN_C_DECLS
 ORTE_MODULE_DECLSPEC extern orte_grpcomm_base_component_t mca_grpcomm_direct_component;
 extern orte_grpcomm_base_module_t orte_grpcomm_direct_module;
 
+/* xcast payloads larger than this are relayed in chunks
+ * of this size - zero disables pipelining */
+extern size_t orte_grpcomm_direct_xcast_chunk_size;
+
 END_C_DECLS
 
 #endif
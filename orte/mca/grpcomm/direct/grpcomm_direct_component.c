@@ -22,6 +22,7 @@
 #include "grpcomm_direct.h"
 
 static int my_priority=5;  /* must be below "bad" module */
+size_t orte_grpcomm_direct_xcast_chunk_size = 0;
 static int direct_open(void);
 static int direct_close(void);
 static int direct_query(mca_base_module_t **module, int *priority);
@@ -62,6 +63,16 @@ static int direct_register(void)
                                            OPAL_INFO_LVL_9,
                                            MCA_BASE_VAR_SCOPE_READONLY,
                                            &my_priority);
+
+    orte_grpcomm_direct_xcast_chunk_size = 0;
+    (void) mca_base_component_var_register(c, "xcast_chunk_size",
+                                           "Relay xcast messages larger than this many bytes in "
+                                           "chunks of this size, so that each daemon can forward "
+                                           "a chunk while still receiving the next (0 = never)",
+                                           MCA_BASE_VAR_TYPE_SIZE_T, NULL, 0, 0,
+                                           OPAL_INFO_LVL_9,
+                                           MCA_BASE_VAR_SCOPE_READONLY,
+                                           &orte_grpcomm_direct_xcast_chunk_size);
     return ORTE_SUCCESS;
 }
 
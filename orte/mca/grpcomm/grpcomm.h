@@ -121,6 +121,20 @@ typedef int (*orte_grpcomm_base_module_xcast_fn_t)(orte_vpid_t *vpids,
 typedef int (*orte_grpcomm_base_module_allgather_fn_t)(orte_grpcomm_coll_t *coll,
                                                        opal_buffer_t *buf);
 
+/* allgather cost - estimate the time (in usec) this module would need to
+ * complete an allgather across ndmns daemons, each contributing a bucket
+ * of the given size (in bytes), over links with the given per-hop latency
+ * (in usec) and bandwidth (in bytes/usec). Return a negative value if the
+ * module cannot perform an allgather of that shape.
+ *
+ * NOTE: every daemon participating in a collective must arrive at the
+ * same answer, so the estimate may only depend on its arguments and
+ * on job-wide settings */
+typedef double (*orte_grpcomm_base_module_allgather_cost_fn_t)(size_t ndmns,
+                                                               size_t bucket,
+                                                               double latency,
+                                                               double bandwidth);
+
 /*
  * Ver 3.0 - internal modules
  */
@@ -130,6 +144,8 @@ typedef struct {
     /* collective operations */
     orte_grpcomm_base_module_xcast_fn_t          xcast;
     orte_grpcomm_base_module_allgather_fn_t      allgather;
+    /* optional - modules without a cost model are tried in priority order */
+    orte_grpcomm_base_module_allgather_cost_fn_t allgather_cost;
 } orte_grpcomm_base_module_t;
 
 /* the Public APIs */
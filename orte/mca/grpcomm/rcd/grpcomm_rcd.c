@@ -41,6 +41,8 @@ static int init(void);
 static void finalize(void);
 static int allgather(orte_grpcomm_coll_t *coll,
                      opal_buffer_t *buf);
+static double allgather_cost(size_t ndmns, size_t bucket,
+                             double latency, double bandwidth);
 static void rcd_allgather_process_data(orte_grpcomm_coll_t *coll, uint32_t distance);
 static int rcd_allgather_send_dist(orte_grpcomm_coll_t *coll, orte_process_name_t *peer, uint32_t distance);
 static void rcd_allgather_recv_dist(int status, orte_process_name_t* sender,
@@ -53,7 +55,8 @@ orte_grpcomm_base_module_t orte_grpcomm_rcd_module = {
     init,
     finalize,
     NULL,
-    allgather
+    allgather,
+    allgather_cost
 };
 
 /**
@@ -100,6 +103,17 @@ static int allgather(orte_grpcomm_coll_t *coll,
         opal_bitmap_init (&coll->distance_mask_recv, log2ndmns);
     }
 
+    /* a NULL array means that all daemons are participating */
+    if (NULL == coll->dmns) {
+        coll->dmns = (orte_vpid_t*)malloc(coll->ndmns * sizeof(orte_vpid_t));
+        if (NULL == coll->dmns) {
+            return ORTE_ERR_OUT_OF_RESOURCE;
+        }
+        for (orte_vpid_t nv = 0; nv < coll->ndmns; nv++) {
+            coll->dmns[nv] = nv;
+        }
+    }
+
     /* get my own rank */
     coll->my_rank = ORTE_VPID_INVALID;
     for (orte_vpid_t nv = 0 ; nv < coll->ndmns ; ++nv) {
@@ -129,6 +143,18 @@ static int allgather(orte_grpcomm_coll_t *coll,
     return ORTE_SUCCESS;
 }
 
+/* log2(ndmns) exchanges, each doubling the data held, so every
+ * daemon ends up receiving (ndmns-1) buckets in total */
+static double allgather_cost(size_t ndmns, size_t bucket,
+                             double latency, double bandwidth)
+{
+    /* only defined for a power of two */
+    if (0 == ndmns || 0 != (ndmns & (ndmns - 1))) {
+        return -1.0;
+    }
+    return log2(ndmns) * latency + (double)((ndmns - 1) * bucket) / bandwidth;
+}
+
 static int rcd_allgather_send_dist(orte_grpcomm_coll_t *coll, orte_process_name_t *peer, uint32_t distance) {
     opal_buffer_t *send_buf;
     int rc;
@@ -76,6 +76,7 @@ ORTE_DECLSPEC OBJ_CLASS_DECLARATION(orte_iof_job_t);
 #define ORTE_IOF_BASE_MSG_MAX           4096
 #define ORTE_IOF_BASE_TAG_MAX             50
 #define ORTE_IOF_BASE_TAGGED_OUT_MAX    8192
+#define ORTE_IOF_BASE_WRITEV_MAX        64
 #define ORTE_IOF_MAX_INPUT_BUFFERS        50
 
 typedef struct {
@@ -84,6 +85,14 @@ typedef struct {
     opal_event_t *ev;
     int fd;
     opal_list_t outputs;
+    /* #bytes held in outputs */
+    size_t numbytes;
+    /* output that arrived beyond the memory limit, held in
+     * an unlinked file until the outputs drain */
+    int spill;
+    off_t spill_rd;
+    off_t spill_wr;
+    bool spill_close;
 } orte_iof_write_event_t;
 ORTE_DECLSPEC OBJ_CLASS_DECLARATION(orte_iof_write_event_t);
 
@@ -132,6 +141,7 @@ ORTE_DECLSPEC OBJ_CLASS_DECLARATION(orte_iof_write_output_t);
 /* the iof globals struct */
 struct orte_iof_base_t {
     size_t                  output_limit;
+    size_t                  buffer_limit;
     char                    *input_files;
     orte_iof_sink_t         *iof_write_stdout;
     orte_iof_sink_t         *iof_write_stderr;
@@ -203,6 +213,7 @@ ORTE_DECLSPEC int orte_iof_base_write_output(orte_process_name_t *name, orte_iof
                                              unsigned char *data, int numbytes,
                                              orte_iof_write_event_t *channel);
 ORTE_DECLSPEC void orte_iof_base_static_dump_output(orte_iof_read_event_t *rev);
+ORTE_DECLSPEC size_t orte_iof_base_backlog(orte_iof_write_event_t *channel);
 ORTE_DECLSPEC void orte_iof_base_write_handler(int fd, short event, void *cbdata);
 
 END_C_DECLS
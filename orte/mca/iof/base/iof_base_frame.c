@@ -166,10 +166,18 @@ static void orte_iof_base_write_event_construct(orte_iof_write_event_t* wev)
     wev->fd = -1;
     OBJ_CONSTRUCT(&wev->outputs, opal_list_t);
     wev->ev = opal_event_alloc();
+    wev->numbytes = 0;
+    wev->spill = -1;
+    wev->spill_rd = 0;
+    wev->spill_wr = 0;
+    wev->spill_close = false;
 }
 static void orte_iof_base_write_event_destruct(orte_iof_write_event_t* wev)
 {
     opal_event_free(wev->ev);
+    if (0 <= wev->spill) {
+        close(wev->spill);
+    }
     if (ORTE_PROC_IS_HNP && NULL != orte_xml_fp) {
         int xmlfd = fileno(orte_xml_fp);
         if (xmlfd == wev->fd) {
@@ -213,6 +221,17 @@ static int orte_iof_base_register(mca_base_register_flag_t flags)
                                  MCA_BASE_VAR_SCOPE_READONLY,
                                  &orte_iof_base.output_limit);
 
+    /* check for maximum number of bytes of output to hold in memory */
+    orte_iof_base.buffer_limit = 64 * 1024 * 1024;
+    (void) mca_base_var_register("orte", "iof", "base", "buffer_limit",
+                                 "Maximum #bytes of output to hold in memory for a single output channel - output "
+                                 "beyond this is held in a spill file and the daemons are told to stop reading "
+                                 "until it drains [default: 64MB, 0: unlimited]",
+                                 MCA_BASE_VAR_TYPE_SIZE_T, NULL, 0, 0,
+                                 OPAL_INFO_LVL_9,
+                                 MCA_BASE_VAR_SCOPE_READONLY,
+                                 &orte_iof_base.buffer_limit);
+
     /* check for files to be sent to stdin of procs */
     orte_iof_base.input_files = NULL;
     (void) mca_base_var_register("orte", "iof","base", "input_files",
@@ -31,21 +31,136 @@
 #ifdef HAVE_UNISTD_H
 #include <unistd.h>
 #endif
+#ifdef HAVE_SYS_UIO_H
+#include <sys/uio.h>
+#endif
 #include <time.h>
 #include <errno.h>
 
+#include "opal/util/opal_environ.h"
+#include "opal/util/os_path.h"
 #include "opal/util/output.h"
 
 #include "orte/util/name_fns.h"
+#include "orte/util/proc_info.h"
 #include "orte/runtime/orte_globals.h"
 #include "orte/mca/errmgr/errmgr.h"
 #include "orte/mca/state/state.h"
 
 #include "orte/mca/iof/base/base.h"
 
-int orte_iof_base_write_output(orte_process_name_t *name, orte_iof_tag_t stream,
-                                unsigned char *data, int numbytes,
-                               orte_iof_write_event_t *channel)
+static int spill_output(orte_iof_write_event_t *channel,
+                        orte_iof_write_output_t *output)
+{
+    char *path;
+
+    if (0 == output->numbytes) {
+        /* the close marker has to follow the spilled output */
+        if (0 > channel->spill) {
+            return ORTE_ERR_NOT_FOUND;
+        }
+        channel->spill_close = true;
+        return ORTE_SUCCESS;
+    }
+
+    if (0 > channel->spill) {
+        path = opal_os_path(false, (NULL != orte_process_info.proc_session_dir) ?
+                            orte_process_info.proc_session_dir : opal_tmp_directory(),
+                            "iof_spill.XXXXXX", NULL);
+        if (NULL == path) {
+            return ORTE_ERR_OUT_OF_RESOURCE;
+        }
+        if (0 > (channel->spill = mkstemp(path))) {
+            OPAL_OUTPUT_VERBOSE((1, orte_iof_base_framework.framework_output,
+                                 "%s write:output could not create spill file %s",
+                                 ORTE_NAME_PRINT(ORTE_PROC_MY_NAME), path));
+            free(path);
+            return ORTE_ERR_FILE_OPEN_FAILURE;
+        }
+        /* nobody else needs to see it */
+        unlink(path);
+        free(path);
+        channel->spill_rd = 0;
+        channel->spill_wr = 0;
+        OPAL_OUTPUT_VERBOSE((1, orte_iof_base_framework.framework_output,
+                             "%s write:output holding %lu bytes - spilling output for fd %d",
+                             ORTE_NAME_PRINT(ORTE_PROC_MY_NAME),
+                             (unsigned long)channel->numbytes, channel->fd));
+    }
+
+    if (output->numbytes != pwrite(channel->spill, output->data,
+                                   output->numbytes, channel->spill_wr)) {
+        if (channel->spill_rd == channel->spill_wr) {
+            /* nothing is waiting in the file, so we can
+             * keep this one in memory without reordering */
+            close(channel->spill);
+            channel->spill = -1;
+        }
+        return ORTE_ERR_FILE_WRITE_FAILURE;
+    }
+    channel->spill_wr += output->numbytes;
+    return ORTE_SUCCESS;
+}
+
+/* move spilled output back onto the write list - returns false
+ * if there was nothing left to move */
+static bool unspill_output(orte_iof_write_event_t *channel)
+{
+    orte_iof_write_output_t *output;
+    ssize_t n;
+    int cnt = 0;
+
+    if (0 > channel->spill) {
+        return false;
+    }
+    while (channel->spill_rd < channel->spill_wr && cnt < ORTE_IOF_BASE_WRITEV_MAX) {
+        output = OBJ_NEW(orte_iof_write_output_t);
+        n = channel->spill_wr - channel->spill_rd;
+        if (ORTE_IOF_BASE_TAGGED_OUT_MAX < n) {
+            n = ORTE_IOF_BASE_TAGGED_OUT_MAX;
+        }
+        n = pread(channel->spill, output->data, n, channel->spill_rd);
+        if (n <= 0) {
+            /* the spilled output is lost - nothing we can do */
+            ORTE_ERROR_LOG(ORTE_ERR_FILE_READ_FAILURE);
+            OBJ_RELEASE(output);
+            channel->spill_rd = channel->spill_wr;
+            break;
+        }
+        output->numbytes = n;
+        channel->spill_rd += n;
+        opal_list_append(&channel->outputs, &output->super);
+        channel->numbytes += n;
+        ++cnt;
+    }
+    if (channel->spill_rd == channel->spill_wr) {
+        /* drained - go back to holding output in memory */
+        close(channel->spill);
+        channel->spill = -1;
+        if (channel->spill_close) {
+            output = OBJ_NEW(orte_iof_write_output_t);
+            output->numbytes = 0;
+            opal_list_append(&channel->outputs, &output->super);
+            channel->spill_close = false;
+            ++cnt;
+        }
+    }
+    return (0 < cnt);
+}
+
+size_t orte_iof_base_backlog(orte_iof_write_event_t *channel)
+{
+    size_t backlog = channel->numbytes;
+
+    if (0 <= channel->spill) {
+        backlog += channel->spill_wr - channel->spill_rd;
+    }
+    return backlog;
+}
+
+static int write_fragment(orte_process_name_t *name, orte_iof_tag_t stream,
+                          unsigned char *data, int numbytes,
+                          orte_iof_write_event_t *channel)
 {
     char starttag[ORTE_IOF_BASE_TAG_MAX], endtag[ORTE_IOF_BASE_TAG_MAX], *suffix;
     orte_iof_write_output_t *output;
@@ -249,8 +364,18 @@ construct:
     output->numbytes = k;
 
 process:
-    /* add this data to the write list for this fd */
-    opal_list_append(&channel->outputs, &output->super);
+    /* once we are holding more output than allowed, it goes to the
+     * spill file until everything ahead of it has been written */
+    if (!(ORTE_IOF_STDIN & stream) && 0 < orte_iof_base.buffer_limit &&
+        (0 <= channel->spill ||
+         orte_iof_base.buffer_limit < channel->numbytes + output->numbytes) &&
+        ORTE_SUCCESS == spill_output(channel, output)) {
+        OBJ_RELEASE(output);
+    } else {
+        /* add this data to the write list for this fd */
+        opal_list_append(&channel->outputs, &output->super);
+        channel->numbytes += output->numbytes;
+    }
 
     /* record how big the buffer is */
     num_buffered = opal_list_get_size(&channel->outputs);
@@ -268,6 +393,30 @@ process:
     return num_buffered;
 }
 
+int orte_iof_base_write_output(orte_process_name_t *name, orte_iof_tag_t stream,
+                                unsigned char *data, int numbytes,
+                               orte_iof_write_event_t *channel)
+{
+    int n, chunk, rc;
+
+    if (numbytes <= ORTE_IOF_BASE_MSG_MAX) {
+        return write_fragment(name, stream, data, numbytes, channel);
+    }
+
+    /* daemons may hand us more than fits in a single output - queue
+     * it in fragments so any tagging still fits the output buffer */
+    for (n=0; n < numbytes; n += chunk) {
+        chunk = numbytes - n;
+        if (ORTE_IOF_BASE_MSG_MAX < chunk) {
+            chunk = ORTE_IOF_BASE_MSG_MAX;
+        }
+        if (0 > (rc = write_fragment(name, stream, data + n, chunk, channel))) {
+            return rc;
+        }
+    }
+    return rc;
+}
+
 void orte_iof_base_static_dump_output(orte_iof_read_event_t *rev)
 {
     bool dump;
@@ -277,19 +426,22 @@ void orte_iof_base_static_dump_output(orte_iof_read_event_t *rev)
 
     if (NULL != rev->sink) {
         wev = rev->sink->wev;
-        if (NULL != wev && !opal_list_is_empty(&wev->outputs)) {
+        if (NULL != wev && (!opal_list_is_empty(&wev->outputs) || 0 <= wev->spill)) {
             dump = false;
             /* make one last attempt to write this out */
-            while (NULL != (output = (orte_iof_write_output_t*)opal_list_remove_first(&wev->outputs))) {
-                if (!dump) {
-                    num_written = write(wev->fd, output->data, output->numbytes);
-                    if (num_written < output->numbytes) {
-                        /* don't retry - just cleanout the list and dump it */
-                        dump = true;
+            do {
+                while (NULL != (output = (orte_iof_write_output_t*)opal_list_remove_first(&wev->outputs))) {
+                    if (!dump) {
+                        num_written = write(wev->fd, output->data, output->numbytes);
+                        if (num_written < output->numbytes) {
+                            /* don't retry - just cleanout the list and dump it */
+                            dump = true;
+                        }
                     }
+                    wev->numbytes -= output->numbytes;
+                    OBJ_RELEASE(output);
                 }
-                OBJ_RELEASE(output);
-            }
+            } while (!dump && unspill_output(wev));
         }
     }
 }
@@ -300,25 +452,38 @@ void orte_iof_base_write_handler(int fd, short event, void *cbdata)
     orte_iof_write_event_t *wev = sink->wev;
     opal_list_item_t *item;
     orte_iof_write_output_t *output;
-    int num_written;
+    struct iovec iov[ORTE_IOF_BASE_WRITEV_MAX];
+    int num_written, niov, i;
 
     OPAL_OUTPUT_VERBOSE((1, orte_iof_base_framework.framework_output,
                          "%s write:handler writing data to %d",
                          ORTE_NAME_PRINT(ORTE_PROC_MY_NAME),
                          wev->fd));
 
-    while (NULL != (item = opal_list_remove_first(&wev->outputs))) {
+    while (!opal_list_is_empty(&wev->outputs) || unspill_output(wev)) {
+        item = opal_list_get_first(&wev->outputs);
         output = (orte_iof_write_output_t*)item;
         if (0 == output->numbytes) {
             /* indicates we are to close this stream */
+            opal_list_remove_item(&wev->outputs, item);
+            OBJ_RELEASE(output);
             OBJ_RELEASE(sink);
             return;
         }
-        num_written = write(wev->fd, output->data, output->numbytes);
+        /* gather everything queued up to the next close marker
+         * so it goes out in a single call */
+        niov = 0;
+        OPAL_LIST_FOREACH(output, &wev->outputs, orte_iof_write_output_t) {
+            if (0 == output->numbytes || ORTE_IOF_BASE_WRITEV_MAX == niov) {
+                break;
+            }
+            iov[niov].iov_base = (void*)output->data;
+            iov[niov].iov_len = output->numbytes;
+            ++niov;
+        }
+        num_written = writev(wev->fd, iov, niov);
         if (num_written < 0) {
             if (EAGAIN == errno || EINTR == errno) {
-                /* push this item back on the front of the list */
-                opal_list_prepend(&wev->outputs, item);
                 /* if the list is getting too large, abort */
                 if (orte_iof_base.output_limit < opal_list_get_size(&wev->outputs)) {
                     opal_output(0, "IO Forwarding is running too far behind - something is blocking us from writing");
@@ -333,15 +498,28 @@ void orte_iof_base_write_handler(int fd, short event, void *cbdata)
             /* otherwise, something bad happened so all we can do is abort
              * this attempt
              */
+            output = (orte_iof_write_output_t*)opal_list_remove_first(&wev->outputs);
+            wev->numbytes -= output->numbytes;
             OBJ_RELEASE(output);
             goto ABORT;
-        } else if (num_written < output->numbytes) {
+        }
+        /* release the outputs that were written in full */
+        for (i=0; i < niov; i++) {
+            output = (orte_iof_write_output_t*)opal_list_get_first(&wev->outputs);
+            if (num_written < output->numbytes) {
+                break;
+            }
+            num_written -= output->numbytes;
+            wev->numbytes -= output->numbytes;
+            opal_list_remove_first(&wev->outputs);
+            OBJ_RELEASE(output);
+        }
+        if (i < niov) {
             /* incomplete write - adjust data to avoid duplicate output */
             memmove(output->data, &output->data[num_written], output->numbytes - num_written);
             /* adjust the number of bytes remaining to be written */
             output->numbytes -= num_written;
-            /* push this item back on the front of the list */
-            opal_list_prepend(&wev->outputs, item);
+            wev->numbytes -= num_written;
             /* if the list is getting too large, abort */
             if (orte_iof_base.output_limit < opal_list_get_size(&wev->outputs)) {
                 opal_output(0, "IO Forwarding is running too far behind - something is blocking us from writing");
@@ -353,7 +531,6 @@ void orte_iof_base_write_handler(int fd, short event, void *cbdata)
              */
             return;
         }
-        OBJ_RELEASE(output);
     }
 ABORT:
     opal_event_del(wev->ev);
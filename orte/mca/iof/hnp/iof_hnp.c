@@ -113,6 +113,7 @@ static int init(void)
 
     OBJ_CONSTRUCT(&mca_iof_hnp_component.procs, opal_list_t);
     mca_iof_hnp_component.stdinev = NULL;
+    mca_iof_hnp_component.output_xoff = false;
 
     return ORTE_SUCCESS;
 }
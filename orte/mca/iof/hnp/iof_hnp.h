@@ -64,6 +64,8 @@ struct orte_iof_hnp_component_t {
     opal_list_t procs;
     orte_iof_read_event_t *stdinev;
     opal_event_t stdinsig;
+    /* output from the procs is paused until our backlog drains */
+    bool output_xoff;
 };
 typedef struct orte_iof_hnp_component_t orte_iof_hnp_component_t;
 
@@ -82,6 +84,7 @@ int orte_iof_hnp_send_data_to_endpoint(orte_process_name_t *host,
                                        orte_process_name_t *target,
                                        orte_iof_tag_t tag,
                                        unsigned char *data, int numbytes);
+void orte_iof_hnp_check_backlog(void);
 
 END_C_DECLS
 
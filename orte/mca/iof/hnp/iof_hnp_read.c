@@ -294,6 +294,13 @@ void orte_iof_hnp_read_local_handler(int fd, short event, void *cbdata)
         orte_iof_base_write_output(&proct->name, rev->tag, data, numbytes, rev->sink->wev);
     }
 
+    /* if we are holding too much output, stop reading until it drains */
+    orte_iof_hnp_check_backlog();
+    if (mca_iof_hnp_component.output_xoff) {
+        rev->active = false;
+        return;
+    }
+
     /* re-add the event */
     opal_event_add(rev->ev, 0);
 
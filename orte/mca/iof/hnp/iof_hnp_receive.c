@@ -28,6 +28,7 @@
 #include <unistd.h>
 #endif  /* HAVE_UNISTD_H */
 #include <string.h>
+#include <stdlib.h>
 #ifdef HAVE_FCNTL_H
 #include <fcntl.h>
 #else
@@ -49,6 +50,121 @@
 #include "iof_hnp.h"
 
 
+/* deliver output from a proc to any subscribed tools and to our own output */
+static void process_output(orte_process_name_t *origin, orte_iof_tag_t stream,
+                           unsigned char *data, int32_t numbytes)
+{
+    orte_iof_sink_t *sink;
+    orte_iof_proc_t *proct;
+    bool exclusive;
+    int32_t n, chunk;
+    orte_ns_cmp_bitmask_t mask=ORTE_NS_CMP_ALL | ORTE_NS_CMP_WILD;
+
+    /* do we already have this process in our list? */
+    OPAL_LIST_FOREACH(proct, &mca_iof_hnp_component.procs, orte_iof_proc_t) {
+        if (OPAL_EQUAL == orte_util_compare_name_fields(mask, &proct->name, origin)) {
+            /* found it */
+            goto NSTEP;
+        }
+    }
+    /* if we get here, then we don't yet have this proc in our list */
+    proct = OBJ_NEW(orte_iof_proc_t);
+    proct->name.jobid = origin->jobid;
+    proct->name.vpid = origin->vpid;
+    opal_list_append(&mca_iof_hnp_component.procs, &proct->super);
+
+  NSTEP:
+    /* cycle through the endpoints to see if someone else wants a copy */
+    exclusive = false;
+    if (NULL != proct->subscribers) {
+        OPAL_LIST_FOREACH(sink, proct->subscribers, orte_iof_sink_t) {
+            /* if the target isn't set, then this sink is for another purpose - ignore it */
+            if (ORTE_JOBID_INVALID == sink->daemon.jobid) {
+                continue;
+            }
+            if ((stream & sink->tag) &&
+                sink->name.jobid == origin->jobid &&
+                (ORTE_VPID_WILDCARD == sink->name.vpid ||
+                 ORTE_VPID_WILDCARD == origin->vpid ||
+                 sink->name.vpid == origin->vpid)) {
+                /* send the data to the tool - tools take it in
+                 * fragments of at most ORTE_IOF_BASE_MSG_MAX bytes */
+                for (n=0; n < numbytes; n += chunk) {
+                    chunk = numbytes - n;
+                    if (ORTE_IOF_BASE_MSG_MAX < chunk) {
+                        chunk = ORTE_IOF_BASE_MSG_MAX;
+                    }
+                    orte_iof_hnp_send_data_to_endpoint(&sink->daemon, origin, stream, data + n, chunk);
+                }
+                if (sink->exclusive) {
+                    exclusive = true;
+                }
+            }
+        }
+    }
+    /* if the user doesn't want a copy written to the screen, then we are done */
+    if (!proct->copy) {
+        return;
+    }
+
+    /* output this to our local output unless one of the sinks was exclusive */
+    if (!exclusive) {
+        if (ORTE_IOF_STDOUT & stream || orte_xml_output) {
+            orte_iof_base_write_output(origin, stream, data, numbytes, orte_iof_base.iof_write_stdout->wev);
+        } else {
+            orte_iof_base_write_output(origin, stream, data, numbytes, orte_iof_base.iof_write_stderr->wev);
+        }
+        orte_iof_hnp_check_backlog();
+    }
+}
+
+/* unpack and deliver a batch of output records forwarded by a daemon */
+static void process_batch(opal_buffer_t *buffer)
+{
+    orte_process_name_t origin;
+    orte_iof_tag_t stream;
+    unsigned char *data = NULL, *tmp;
+    int32_t count, numbytes, size = 0;
+    int rc;
+
+    count = 1;
+    while (OPAL_SUCCESS == (rc = opal_dss.unpack(buffer, &stream, &count, ORTE_IOF_TAG))) {
+        count = 1;
+        if (ORTE_SUCCESS != (rc = opal_dss.unpack(buffer, &origin, &count, ORTE_NAME))) {
+            break;
+        }
+        count = 1;
+        if (ORTE_SUCCESS != (rc = opal_dss.unpack(buffer, &numbytes, &count, OPAL_INT32))) {
+            break;
+        }
+        if (size < numbytes) {
+            if (NULL == (tmp = (unsigned char*)realloc(data, numbytes))) {
+                rc = ORTE_ERR_OUT_OF_RESOURCE;
+                break;
+            }
+            data = tmp;
+            size = numbytes;
+        }
+        if (ORTE_SUCCESS != (rc = opal_dss.unpack(buffer, data, &numbytes, OPAL_BYTE))) {
+            break;
+        }
+
+        OPAL_OUTPUT_VERBOSE((1, orte_iof_base_framework.framework_output,
+                             "%s unpacked %d batched bytes from remote proc %s",
+                             ORTE_NAME_PRINT(ORTE_PROC_MY_NAME), numbytes,
+                             ORTE_NAME_PRINT(&origin)));
+
+        process_output(&origin, stream, data, numbytes);
+        count = 1;
+    }
+    if (OPAL_ERR_UNPACK_READ_PAST_END_OF_BUFFER != rc) {
+        ORTE_ERROR_LOG(rc);
+    }
+    if (NULL != data) {
+        free(data);
+    }
+}
+
 void orte_iof_hnp_recv(int status, orte_process_name_t* sender,
                        opal_buffer_t* buffer, orte_rml_tag_t tag,
                        void* cbdata)
@@ -92,6 +208,10 @@ void orte_iof_hnp_recv(int status, orte_process_name_t* sender,
             mca_iof_hnp_component.stdinev->active = false;
         }
         goto CLEAN_RETURN;
+    } else if (ORTE_IOF_BATCH & stream) {
+        /* output collected from the daemon's local procs */
+        process_batch(buffer);
+        goto CLEAN_RETURN;
     }
 
     /* get name of the process whose io we are discussing */
@@ -219,54 +339,7 @@ void orte_iof_hnp_recv(int status, orte_process_name_t* sender,
                          ORTE_NAME_PRINT(ORTE_PROC_MY_NAME), numbytes,
                          ORTE_NAME_PRINT(&origin)));
 
-    /* do we already have this process in our list? */
-    OPAL_LIST_FOREACH(proct, &mca_iof_hnp_component.procs, orte_iof_proc_t) {
-        if (OPAL_EQUAL == orte_util_compare_name_fields(mask, &proct->name, &origin)) {
-            /* found it */
-            goto NSTEP;
-        }
-    }
-    /* if we get here, then we don't yet have this proc in our list */
-    proct = OBJ_NEW(orte_iof_proc_t);
-    proct->name.jobid = origin.jobid;
-    proct->name.vpid = origin.vpid;
-    opal_list_append(&mca_iof_hnp_component.procs, &proct->super);
-
-  NSTEP:
-    /* cycle through the endpoints to see if someone else wants a copy */
-    exclusive = false;
-    if (NULL != proct->subscribers) {
-        OPAL_LIST_FOREACH(sink, proct->subscribers, orte_iof_sink_t) {
-            /* if the target isn't set, then this sink is for another purpose - ignore it */
-            if (ORTE_JOBID_INVALID == sink->daemon.jobid) {
-                continue;
-            }
-            if ((stream & sink->tag) &&
-                sink->name.jobid == origin.jobid &&
-                (ORTE_VPID_WILDCARD == sink->name.vpid ||
-                 ORTE_VPID_WILDCARD == origin.vpid ||
-                 sink->name.vpid == origin.vpid)) {
-                /* send the data to the tool */
-                orte_iof_hnp_send_data_to_endpoint(&sink->daemon, &origin, stream, data, numbytes);
-                if (sink->exclusive) {
-                    exclusive = true;
-                }
-            }
-        }
-    }
-    /* if the user doesn't want a copy written to the screen, then we are done */
-    if (!proct->copy) {
-        return;
-    }
-
-    /* output this to our local output unless one of the sinks was exclusive */
-    if (!exclusive) {
-        if (ORTE_IOF_STDOUT & stream || orte_xml_output) {
-            orte_iof_base_write_output(&origin, stream, data, numbytes, orte_iof_base.iof_write_stdout->wev);
-        } else {
-            orte_iof_base_write_output(&origin, stream, data, numbytes, orte_iof_base.iof_write_stderr->wev);
-        }
-    }
+    process_output(&origin, stream, data, numbytes);
 
  CLEAN_RETURN:
     return;
@@ -35,6 +35,7 @@
 #include "orte/mca/rml/rml_types.h"
 #include "orte/mca/errmgr/errmgr.h"
 #include "orte/runtime/orte_globals.h"
+#include "orte/runtime/orte_wait.h"
 #include "orte/mca/grpcomm/grpcomm.h"
 #include "orte/util/name_fns.h"
 
@@ -117,3 +118,81 @@ int orte_iof_hnp_send_data_to_endpoint(orte_process_name_t *host,
 
     return ORTE_SUCCESS;
 }
+
+static size_t output_backlog(void)
+{
+    size_t backlog = 0;
+
+    if (NULL != orte_iof_base.iof_write_stdout) {
+        backlog += orte_iof_base_backlog(orte_iof_base.iof_write_stdout->wev);
+    }
+    if (NULL != orte_iof_base.iof_write_stderr) {
+        backlog += orte_iof_base_backlog(orte_iof_base.iof_write_stderr->wev);
+    }
+    return backlog;
+}
+
+static void resume_rev(orte_iof_read_event_t *rev)
+{
+    if (NULL != rev && !rev->active) {
+        rev->active = true;
+        opal_event_add(rev->ev, 0);
+    }
+}
+
+static void check_drained(int fd, short args, void *cbdata)
+{
+    orte_timer_t *tm = (orte_timer_t*)cbdata;
+    orte_process_name_t daemons;
+    orte_iof_proc_t *proct;
+
+    if (orte_iof_base.buffer_limit / 2 < output_backlog() && !orte_job_term_ordered) {
+        /* still catching up - check again later */
+        opal_event_evtimer_add(tm->ev, &tm->tv);
+        return;
+    }
+    OBJ_RELEASE(tm);
+
+    OPAL_OUTPUT_VERBOSE((1, orte_iof_base_framework.framework_output,
+                         "%s iof:hnp output backlog drained - resuming output",
+                         ORTE_NAME_PRINT(ORTE_PROC_MY_NAME)));
+
+    mca_iof_hnp_component.output_xoff = false;
+    daemons.jobid = ORTE_PROC_MY_NAME->jobid;
+    daemons.vpid = ORTE_VPID_WILDCARD;
+    orte_iof_hnp_send_data_to_endpoint(&daemons, ORTE_NAME_WILDCARD, ORTE_IOF_XON, NULL, 0);
+
+    /* restart reading from our own local procs */
+    OPAL_LIST_FOREACH(proct, &mca_iof_hnp_component.procs, orte_iof_proc_t) {
+        resume_rev(proct->revstdout);
+        resume_rev(proct->revstderr);
+        resume_rev(proct->revstddiag);
+    }
+}
+
+/* if we are holding more output than we are allowed, tell the daemons
+ * to stop reading from their procs until we have written it out - the
+ * procs will then block on their full pipes */
+void orte_iof_hnp_check_backlog(void)
+{
+    orte_process_name_t daemons;
+
+    if (0 == orte_iof_base.buffer_limit ||
+        mca_iof_hnp_component.output_xoff ||
+        output_backlog() < orte_iof_base.buffer_limit) {
+        return;
+    }
+
+    OPAL_OUTPUT_VERBOSE((1, orte_iof_base_framework.framework_output,
+                         "%s iof:hnp output backlog of %lu bytes - pausing output",
+                         ORTE_NAME_PRINT(ORTE_PROC_MY_NAME),
+                         (unsigned long)output_backlog()));
+
+    mca_iof_hnp_component.output_xoff = true;
+    daemons.jobid = ORTE_PROC_MY_NAME->jobid;
+    daemons.vpid = ORTE_VPID_WILDCARD;
+    orte_iof_hnp_send_data_to_endpoint(&daemons, ORTE_NAME_WILDCARD, ORTE_IOF_XOFF, NULL, 0);
+
+    /* check back periodically to see if we have caught up */
+    ORTE_TIMER_EVENT(0, 10000, check_drained, ORTE_INFO_PRI);
+}
@@ -48,6 +48,8 @@ typedef uint16_t orte_iof_tag_t;
 /* tool requests */
 #define ORTE_IOF_PULL       0x4000
 #define ORTE_IOF_CLOSE      0x8000
+/* daemon output batch - a series of (stream, name, size, data) records */
+#define ORTE_IOF_BATCH      0x0800
 
 END_C_DECLS
 
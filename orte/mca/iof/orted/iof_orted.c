@@ -29,6 +29,7 @@
 #include <unistd.h>
 #endif  /* HAVE_UNISTD_H */
 #include <string.h>
+#include <stdlib.h>
 
 #ifdef HAVE_FCNTL_H
 #include <fcntl.h>
@@ -104,6 +105,15 @@ static int init(void)
     /* setup the local global variables */
     OBJ_CONSTRUCT(&mca_iof_orted_component.procs, opal_list_t);
     mca_iof_orted_component.xoff = false;
+    mca_iof_orted_component.output_xoff = false;
+    mca_iof_orted_component.rdsize = ORTE_IOF_BASE_MSG_MAX;
+    mca_iof_orted_component.rdbuf = (unsigned char*)malloc(mca_iof_orted_component.rdsize);
+    if (NULL == mca_iof_orted_component.rdbuf) {
+        return ORTE_ERR_OUT_OF_RESOURCE;
+    }
+    mca_iof_orted_component.batch = NULL;
+    mca_iof_orted_component.batch_bytes = 0;
+    mca_iof_orted_component.flush_pending = false;
 
     return ORTE_SUCCESS;
 }
@@ -312,6 +322,17 @@ static int finalize(void)
 {
     orte_iof_proc_t *proct;
 
+    /* send along anything still waiting to go to the HNP */
+    if (mca_iof_orted_component.flush_pending) {
+        opal_event_del(&mca_iof_orted_component.flush_ev);
+        mca_iof_orted_component.flush_pending = false;
+    }
+    orte_iof_orted_flush();
+    if (NULL != mca_iof_orted_component.rdbuf) {
+        free(mca_iof_orted_component.rdbuf);
+        mca_iof_orted_component.rdbuf = NULL;
+    }
+
     /* cycle thru the procs and ensure all their output was delivered
      * if they were writing to files */
     while (NULL != (proct = (orte_iof_proc_t*)opal_list_remove_first(&mca_iof_orted_component.procs))) {
@@ -50,6 +50,8 @@
 #include "orte_config.h"
 
 #include "opal/class/opal_list.h"
+#include "opal/dss/dss_types.h"
+#include "opal/mca/event/event.h"
 
 #include "orte/mca/rml/rml_types.h"
 
@@ -64,6 +66,19 @@ struct orte_iof_orted_component_t {
     orte_iof_base_component_t super;
     opal_list_t procs;
     bool xoff;
+    /* the HNP asked us to stop reading output from our procs */
+    bool output_xoff;
+    /* shared read buffer - grows towards max_read when reads fill it */
+    unsigned char *rdbuf;
+    int rdsize;
+    int max_read;
+    /* output from all local procs pending delivery to the HNP */
+    opal_buffer_t *batch;
+    int batch_bytes;
+    int aggregate_size;
+    int aggregate_time;
+    opal_event_t flush_ev;
+    bool flush_pending;
 };
 typedef struct orte_iof_orted_component_t orte_iof_orted_component_t;
 
@@ -76,6 +91,7 @@ void orte_iof_orted_recv(int status, orte_process_name_t* sender,
 
 void orte_iof_orted_read_handler(int fd, short event, void *data);
 void orte_iof_orted_send_xonxoff(orte_iof_tag_t tag);
+void orte_iof_orted_flush(void);
 
 END_C_DECLS
 
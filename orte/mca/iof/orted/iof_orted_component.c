@@ -25,6 +25,7 @@
 #include "opal/mca/base/base.h"
 
 #include "orte/util/proc_info.h"
+#include "orte/mca/iof/base/base.h"
 
 #include "iof_orted.h"
 
@@ -33,6 +34,7 @@
  */
 static int orte_iof_orted_open(void);
 static int orte_iof_orted_close(void);
+static int orte_iof_orted_register(void);
 static int orte_iof_orted_query(mca_base_module_t **module, int *priority);
 
 
@@ -56,6 +58,7 @@ orte_iof_orted_component_t mca_iof_orted_component = {
             .mca_open_component = orte_iof_orted_open,
             .mca_close_component = orte_iof_orted_close,
             .mca_query_component = orte_iof_orted_query,
+            .mca_register_component_params = orte_iof_orted_register,
         },
         .iof_data = {
             /* The component is checkpoint ready */
@@ -64,6 +67,46 @@ orte_iof_orted_component_t mca_iof_orted_component = {
     }
 };
 
+static int orte_iof_orted_register(void)
+{
+    mca_base_component_t *c = &mca_iof_orted_component.super.iof_version;
+
+    mca_iof_orted_component.max_read = 65536;
+    (void) mca_base_component_var_register(c, "max_read",
+                                           "Largest read (in bytes) taken from a local proc's output in one go - the "
+                                           "read size starts small and grows towards this as reads fill it",
+                                           MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                                           OPAL_INFO_LVL_9,
+                                           MCA_BASE_VAR_SCOPE_READONLY,
+                                           &mca_iof_orted_component.max_read);
+    if (mca_iof_orted_component.max_read < ORTE_IOF_BASE_MSG_MAX) {
+        mca_iof_orted_component.max_read = ORTE_IOF_BASE_MSG_MAX;
+    }
+
+    mca_iof_orted_component.aggregate_size = 65536;
+    (void) mca_base_component_var_register(c, "aggregate_size",
+                                           "Number of bytes of output from local procs to collect before sending them "
+                                           "to the HNP in one message",
+                                           MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                                           OPAL_INFO_LVL_9,
+                                           MCA_BASE_VAR_SCOPE_READONLY,
+                                           &mca_iof_orted_component.aggregate_size);
+
+    mca_iof_orted_component.aggregate_time = 0;
+    (void) mca_base_component_var_register(c, "aggregate_time",
+                                           "Time (in microseconds) to hold output from local procs while collecting more "
+                                           "[default: 0 - send once the current pass of the event loop completes]",
+                                           MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                                           OPAL_INFO_LVL_9,
+                                           MCA_BASE_VAR_SCOPE_READONLY,
+                                           &mca_iof_orted_component.aggregate_time);
+    if (mca_iof_orted_component.aggregate_time < 0) {
+        mca_iof_orted_component.aggregate_time = 0;
+    }
+
+    return ORTE_SUCCESS;
+}
+
 /**
   * component open/close/init function
   */
@@ -28,6 +28,7 @@
 #include <unistd.h>
 #endif  /* HAVE_UNISTD_H */
 #include <string.h>
+#include <stdlib.h>
 
 #include "opal/dss/dss.h"
 
@@ -54,24 +55,106 @@ static void send_cb(int status, orte_process_name_t *peer,
     OBJ_RELEASE(buf);
 }
 
+static void flush_timeout(int fd, short args, void *cbdata)
+{
+    mca_iof_orted_component.flush_pending = false;
+    orte_iof_orted_flush();
+}
+
+/* send everything collected so far to the HNP in one message */
+void orte_iof_orted_flush(void)
+{
+    opal_buffer_t *buf;
+
+    if (NULL == (buf = mca_iof_orted_component.batch)) {
+        return;
+    }
+    mca_iof_orted_component.batch = NULL;
+
+    OPAL_OUTPUT_VERBOSE((1, orte_iof_base_framework.framework_output,
+                         "%s iof:orted:flush sending %d bytes to HNP",
+                         ORTE_NAME_PRINT(ORTE_PROC_MY_NAME),
+                         mca_iof_orted_component.batch_bytes));
+    mca_iof_orted_component.batch_bytes = 0;
+
+    orte_rml.send_buffer_nb(ORTE_PROC_MY_HNP, buf, ORTE_RML_TAG_IOF_HNP,
+                            send_cb, NULL);
+}
+
+/* add a chunk of output to the batch bound for the HNP */
+static int batch_output(orte_process_name_t *name, orte_iof_tag_t stream,
+                        unsigned char *data, int32_t numbytes)
+{
+    opal_buffer_t *buf;
+    orte_iof_tag_t batch = ORTE_IOF_BATCH;
+    struct timeval tv;
+    int rc;
+
+    if (NULL == (buf = mca_iof_orted_component.batch)) {
+        buf = OBJ_NEW(opal_buffer_t);
+        /* the stream goes first so the HNP can tell a batch apart
+         * from flow control and tool requests */
+        if (ORTE_SUCCESS != (rc = opal_dss.pack(buf, &batch, 1, ORTE_IOF_TAG))) {
+            ORTE_ERROR_LOG(rc);
+            OBJ_RELEASE(buf);
+            return rc;
+        }
+        mca_iof_orted_component.batch = buf;
+    }
+
+    /* each record is the stream, the name of the process that gave us
+     * this data, and the #bytes we read followed by the bytes */
+    if (ORTE_SUCCESS != (rc = opal_dss.pack(buf, &stream, 1, ORTE_IOF_TAG))) {
+        ORTE_ERROR_LOG(rc);
+        return rc;
+    }
+    if (ORTE_SUCCESS != (rc = opal_dss.pack(buf, name, 1, ORTE_NAME))) {
+        ORTE_ERROR_LOG(rc);
+        return rc;
+    }
+    if (ORTE_SUCCESS != (rc = opal_dss.pack(buf, &numbytes, 1, OPAL_INT32))) {
+        ORTE_ERROR_LOG(rc);
+        return rc;
+    }
+    if (ORTE_SUCCESS != (rc = opal_dss.pack(buf, data, numbytes, OPAL_BYTE))) {
+        ORTE_ERROR_LOG(rc);
+        return rc;
+    }
+    mca_iof_orted_component.batch_bytes += numbytes;
+
+    if (mca_iof_orted_component.aggregate_size <= mca_iof_orted_component.batch_bytes) {
+        orte_iof_orted_flush();
+        return ORTE_SUCCESS;
+    }
+
+    /* otherwise, hold it a little while in case more output arrives */
+    if (!mca_iof_orted_component.flush_pending) {
+        tv.tv_sec = mca_iof_orted_component.aggregate_time / 1000000;
+        tv.tv_usec = mca_iof_orted_component.aggregate_time % 1000000;
+        opal_event_evtimer_set(orte_event_base, &mca_iof_orted_component.flush_ev,
+                               flush_timeout, NULL);
+        opal_event_evtimer_add(&mca_iof_orted_component.flush_ev, &tv);
+        mca_iof_orted_component.flush_pending = true;
+    }
+    return ORTE_SUCCESS;
+}
 
 void orte_iof_orted_read_handler(int fd, short event, void *cbdata)
 {
     orte_iof_read_event_t *rev = (orte_iof_read_event_t*)cbdata;
-    unsigned char data[ORTE_IOF_BASE_MSG_MAX];
-    opal_buffer_t *buf=NULL;
-    int rc;
-    int32_t numbytes;
+    unsigned char *data = mca_iof_orted_component.rdbuf;
+    int32_t numbytes, rdsize = mca_iof_orted_component.rdsize;
+    unsigned char *tmp;
     orte_iof_proc_t *proct = (orte_iof_proc_t*)rev->proc;
 
-    /* read up to the fragment size */
+    /* read up to the current read size */
 #if !defined(__WINDOWS__)
-    numbytes = read(fd, data, sizeof(data));
+    numbytes = read(fd, data, rdsize);
 #else
     {
         DWORD readed;
         HANDLE handle = (HANDLE)_get_osfhandle(fd);
-        ReadFile(handle, data, sizeof(data), &readed, NULL);
+        ReadFile(handle, data, rdsize, &readed, NULL);
         numbytes = (int)readed;
     }
 #endif  /* !defined(__WINDOWS__) */
@@ -110,43 +193,32 @@ void orte_iof_orted_read_handler(int fd, short event, void *cbdata)
         /* output to the corresponding file */
         orte_iof_base_write_output(&proct->name, rev->tag, data, numbytes, rev->sink->wev);
     }
-    if (!proct->copy) {
-        /* re-add the event */
-        opal_event_add(rev->ev, 0);
-        return;
-    }
-
-    /* prep the buffer */
-    buf = OBJ_NEW(opal_buffer_t);
-
-    /* pack the stream first - we do this so that flow control messages can
-     * consist solely of the tag
-     */
-    if (ORTE_SUCCESS != (rc = opal_dss.pack(buf, &rev->tag, 1, ORTE_IOF_TAG))) {
-        ORTE_ERROR_LOG(rc);
-        goto CLEAN_RETURN;
+    if (proct->copy) {
+        /* queue it for the HNP along with output from the other local procs */
+        if (ORTE_SUCCESS != batch_output(&proct->name, rev->tag, data, numbytes)) {
+            goto CLEAN_RETURN;
+        }
     }
 
-    /* pack name of process that gave us this data */
-    if (ORTE_SUCCESS != (rc = opal_dss.pack(buf, &proct->name, 1, ORTE_NAME))) {
-        ORTE_ERROR_LOG(rc);
-        goto CLEAN_RETURN;
+    /* if the proc filled the buffer, it is probably producing output
+     * faster than we are taking it - read more at a time */
+    if (numbytes == rdsize && rdsize < mca_iof_orted_component.max_read) {
+        rdsize *= 2;
+        if (mca_iof_orted_component.max_read < rdsize) {
+            rdsize = mca_iof_orted_component.max_read;
+        }
+        if (NULL != (tmp = (unsigned char*)realloc(data, rdsize))) {
+            mca_iof_orted_component.rdbuf = tmp;
+            mca_iof_orted_component.rdsize = rdsize;
+        }
     }
 
-    /* pack the data - only pack the #bytes we read! */
-    if (ORTE_SUCCESS != (rc = opal_dss.pack(buf, &data, numbytes, OPAL_BYTE))) {
-        ORTE_ERROR_LOG(rc);
-        goto CLEAN_RETURN;
+    /* if the HNP is behind on output, leave the rest in the pipe */
+    if (mca_iof_orted_component.output_xoff) {
+        rev->active = false;
+        return;
     }
 
-    /* start non-blocking RML call to forward received data */
-    OPAL_OUTPUT_VERBOSE((1, orte_iof_base_framework.framework_output,
-                         "%s iof:orted:read handler sending %d bytes to HNP",
-                         ORTE_NAME_PRINT(ORTE_PROC_MY_NAME), numbytes));
-
-    orte_rml.send_buffer_nb(ORTE_PROC_MY_HNP, buf, ORTE_RML_TAG_IOF_HNP,
-                            send_cb, NULL);
-
     /* re-add the event */
     opal_event_add(rev->ev, 0);
 
@@ -177,13 +249,13 @@ void orte_iof_orted_read_handler(int fd, short event, void *cbdata)
     if (NULL == proct->revstdout &&
         NULL == proct->revstderr &&
         NULL == proct->revstddiag) {
+        /* make sure the HNP has all of its output before we
+         * declare this proc's iof complete */
+        orte_iof_orted_flush();
         /* this proc's iof is complete */
         opal_list_remove_item(&mca_iof_orted_component.procs, &proct->super);
         ORTE_ACTIVATE_PROC_STATE(&proct->name, ORTE_PROC_STATE_IOF_COMPLETE);
         OBJ_RELEASE(proct);
     }
-    if (NULL != buf) {
-        OBJ_RELEASE(buf);
-    }
     return;
 }
@@ -78,6 +78,14 @@ void orte_iof_orted_send_xonxoff(orte_iof_tag_t tag)
     }
 }
 
+static void resume_rev(orte_iof_read_event_t *rev)
+{
+    if (NULL != rev && !rev->active) {
+        rev->active = true;
+        opal_event_add(rev->ev, 0);
+    }
+}
+
 /*
  * The only messages coming to an orted are either:
  *
@@ -104,6 +112,29 @@ void orte_iof_orted_recv(int status, orte_process_name_t* sender,
         return;
     }
 
+    /* the HNP is holding too much output - stop reading
+     * from our procs until it tells us it has caught up */
+    if (ORTE_IOF_XOFF & stream) {
+        OPAL_OUTPUT_VERBOSE((1, orte_iof_base_framework.framework_output,
+                             "%s iof:orted pausing output",
+                             ORTE_NAME_PRINT(ORTE_PROC_MY_NAME)));
+        mca_iof_orted_component.output_xoff = true;
+        /* get anything we already read on its way */
+        orte_iof_orted_flush();
+        return;
+    } else if (ORTE_IOF_XON & stream) {
+        OPAL_OUTPUT_VERBOSE((1, orte_iof_base_framework.framework_output,
+                             "%s iof:orted resuming output",
+                             ORTE_NAME_PRINT(ORTE_PROC_MY_NAME)));
+        mca_iof_orted_component.output_xoff = false;
+        OPAL_LIST_FOREACH(proct, &mca_iof_orted_component.procs, orte_iof_proc_t) {
+            resume_rev(proct->revstdout);
+            resume_rev(proct->revstderr);
+            resume_rev(proct->revstddiag);
+        }
+        return;
+    }
+
     /* if this isn't stdin, then we have an error */
     if (ORTE_IOF_STDIN != stream) {
         ORTE_ERROR_LOG(ORTE_ERR_COMM_FAILURE);
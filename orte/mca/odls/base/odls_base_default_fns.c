@@ -40,6 +40,9 @@
 #include <sys/param.h>
 #endif
 #include <time.h>
+#ifdef HAVE_SYS_TIME_H
+#include <sys/time.h>
+#endif
 
 #include <signal.h>
 
@@ -650,6 +653,9 @@ void orte_odls_base_default_launch_local(int fd, short sd, void *cbdata)
     orte_jobid_t job = caddy->job;
     orte_odls_base_fork_local_proc_fn_t fork_local = caddy->fork_local;
     bool index_argv;
+    struct timeval start, stop;
+    long usec, total_usec = 0, max_usec = 0;
+    int nlaunched = 0;
 
     /* establish our baseline working directory - we will be potentially
      * bouncing around as we execute various apps, but we will always return
@@ -1044,10 +1050,22 @@ void orte_odls_base_default_launch_local(int fd, short sd, void *cbdata)
                 }
             }
 
+            gettimeofday(&start, NULL);
             if (ORTE_SUCCESS != (rc = fork_local(app, child, app->env, jobdat))) {
                 child->exit_code = rc; /* error message already output */
                 ORTE_ACTIVATE_PROC_STATE(&child->name, ORTE_PROC_STATE_FAILED_TO_START);
             }
+            gettimeofday(&stop, NULL);
+            usec = (stop.tv_sec - start.tv_sec) * 1000000 + (stop.tv_usec - start.tv_usec);
+            total_usec += usec;
+            if (max_usec < usec) {
+                max_usec = usec;
+            }
+            ++nlaunched;
+            opal_output_verbose(2, orte_odls_base_framework.framework_output,
+                                "%s odls:launch child %s pid %d took %ld usec",
+                                ORTE_NAME_PRINT(ORTE_PROC_MY_NAME),
+                                ORTE_NAME_PRINT(&child->name), (int)child->pid, usec);
             orte_wait_cb(child, odls_base_default_wait_local_proc, NULL);
             /* if we indexed the argv, we need to restore it to
              * its original form
@@ -1095,6 +1113,14 @@ void orte_odls_base_default_launch_local(int fd, short sd, void *cbdata)
         chdir(basedir);
     }
 
+    if (0 < nlaunched) {
+        opal_output_verbose(1, orte_odls_base_framework.framework_output,
+                            "%s odls:launch started %d procs for job %s in %ld usec (avg %ld max %ld)",
+                            ORTE_NAME_PRINT(ORTE_PROC_MY_NAME), nlaunched,
+                            ORTE_JOBID_PRINT(jobdat->jobid), total_usec,
+                            total_usec / nlaunched, max_usec);
+    }
+
  GETOUT:
     /* tell the state machine that all local procs for this job
      * were launched so that it can do whatever it needs to do,
@@ -37,6 +37,9 @@ int orte_odls_default_component_open(void);
 int orte_odls_default_component_close(void);
 int orte_odls_default_component_query(mca_base_module_t **module, int *priority);
 
+/* launch eligible procs with posix_spawn instead of fork/exec */
+extern bool orte_odls_default_use_spawn;
+
 /*
  * ODLS Default module
  */
@@ -41,6 +41,10 @@
 #include "orte/mca/odls/base/odls_private.h"
 #include "orte/mca/odls/default/odls_default.h"
 
+static int orte_odls_default_component_register(void);
+
+bool orte_odls_default_use_spawn = false;
+
 /*
  * Instantiate the public struct with all of our public information
  * and pointers to our public functions in it
@@ -60,6 +64,7 @@ orte_odls_base_component_t mca_odls_default_component = {
         .mca_open_component = orte_odls_default_component_open,
         .mca_close_component = orte_odls_default_component_close,
         .mca_query_component = orte_odls_default_component_query,
+        .mca_register_component_params = orte_odls_default_component_register,
     },
     .base_data = {
         /* The component is checkpoint ready */
@@ -69,6 +74,24 @@ orte_odls_base_component_t mca_odls_default_component = {
 
 
 
+static int orte_odls_default_component_register(void)
+{
+    orte_odls_default_use_spawn = false;
+    (void) mca_base_component_var_register(&mca_odls_default_component.version, "spawn",
+                                           "Launch procs with posix_spawn when they need no setup in the child "
+                                           "(no cpu binding, frequency controls, or resource limits) - this "
+                                           "avoids duplicating the daemon's address space for each proc",
+                                           MCA_BASE_VAR_TYPE_BOOL, NULL, 0, 0,
+                                           OPAL_INFO_LVL_9,
+                                           MCA_BASE_VAR_SCOPE_READONLY,
+                                           &orte_odls_default_use_spawn);
+#if !defined(HAVE_POSIX_SPAWN) || !defined(HAVE_POSIX_SPAWN_FILE_ACTIONS_ADDCLOSEFROM_NP)
+    /* we cannot guarantee the daemon's descriptors get closed */
+    orte_odls_default_use_spawn = false;
+#endif
+    return ORTE_SUCCESS;
+}
+
 int orte_odls_default_component_open(void)
 {
     return ORTE_SUCCESS;
@@ -104,15 +104,23 @@
 #ifdef HAVE_DIRENT_H
 #include <dirent.h>
 #endif
+#ifdef HAVE_SPAWN_H
+#include <spawn.h>
+#endif
+#ifdef HAVE_TERMIOS_H
+#include <termios.h>
+#endif
 #include <ctype.h>
 
 #include "opal/mca/hwloc/hwloc.h"
 #include "opal/mca/hwloc/base/base.h"
 #include "opal/class/opal_pointer_array.h"
+#include "opal/util/argv.h"
 #include "opal/util/opal_environ.h"
 #include "opal/util/show_help.h"
 #include "opal/util/sys_limits.h"
 #include "opal/util/fd.h"
+#include "opal/runtime/opal_params.h"
 
 #include "orte/util/show_help.h"
 #include "orte/runtime/orte_wait.h"
@@ -123,6 +131,7 @@
 #include "orte/mca/plm/plm.h"
 #include "orte/mca/rtc/rtc.h"
 #include "orte/util/name_fns.h"
+#include "orte/util/attr.h"
 
 #include "orte/mca/odls/base/base.h"
 #include "orte/mca/odls/base/odls_private.h"
@@ -340,11 +349,43 @@ static void send_error_show_help(int fd, int exit_status,
     exit(exit_status);
 }
 
+#ifdef HAVE_CLOSE_RANGE
+/* close everything above stderr except the descriptors we keep with
+ * a few calls rather than one per open descriptor */
+static int close_file_descriptor_ranges(int write_fd,
+                                        orte_iof_base_io_conf_t opts)
+{
+    int lo = 3, keep[2];
+    int i;
+
+    keep[0] = (opts.p_internal[1] < write_fd) ? opts.p_internal[1] : write_fd;
+    keep[1] = (opts.p_internal[1] < write_fd) ? write_fd : opts.p_internal[1];
+    for (i=0; i < 2; i++) {
+        if (keep[i] < lo) {
+            continue;
+        }
+        if (lo < keep[i] && 0 != close_range(lo, keep[i] - 1, 0)) {
+            return ORTE_ERR_NOT_SUPPORTED;
+        }
+        lo = keep[i] + 1;
+    }
+    if (0 != close_range(lo, ~0U, 0)) {
+        return ORTE_ERR_NOT_SUPPORTED;
+    }
+    return ORTE_SUCCESS;
+}
+#endif
+
 /* close all open file descriptors w/ exception of stdin/stdout/stderr,
    the pipe used for the IOF INTERNAL messages, and the pipe up to
    the parent. */
 static int close_open_file_descriptors(int write_fd,
                                       orte_iof_base_io_conf_t opts) {
+#ifdef HAVE_CLOSE_RANGE
+    if (ORTE_SUCCESS == close_file_descriptor_ranges(write_fd, opts)) {
+        return ORTE_SUCCESS;
+    }
+#endif
     DIR *dir = opendir("/proc/self/fd");
     if (NULL == dir) {
         return ORTE_ERR_FILE_OPEN_FAILURE;
@@ -620,6 +661,156 @@ static int do_parent(orte_app_context_t* context,
 }
 
 
+#if defined(HAVE_POSIX_SPAWN) && defined(HAVE_POSIX_SPAWN_FILE_ACTIONS_ADDCLOSEFROM_NP)
+/* can this proc be started without running any of our code in the child? */
+static bool spawn_eligible(orte_proc_t *child, orte_job_t *jobdat,
+                           orte_iof_base_io_conf_t *opts)
+{
+    orte_attribute_t *kv;
+    char *cpu_bitmap = NULL;
+    bool bound;
+
+    if (!orte_odls_default_use_spawn || NULL == child ||
+        !ORTE_FLAG_TEST(jobdat, ORTE_JOB_FLAG_FORWARD_OUTPUT)) {
+        return false;
+    }
+    /* binding and resource limits have to be applied by the child itself */
+    if (NULL != orte_daemon_cores || NULL != opal_set_max_sys_limits) {
+        return false;
+    }
+    if (orte_get_attribute(&child->attributes, ORTE_PROC_CPU_BITMAP, (void**)&cpu_bitmap, OPAL_STRING) &&
+        NULL != cpu_bitmap) {
+        bound = (0 < strlen(cpu_bitmap));
+        free(cpu_bitmap);
+        if (bound) {
+            return false;
+        }
+    }
+    /* as do frequency controls */
+    OPAL_LIST_FOREACH(kv, &jobdat->attributes, orte_attribute_t) {
+        if (ORTE_JOB_GOVERNOR == kv->key ||
+            ORTE_JOB_MAX_FREQ == kv->key ||
+            ORTE_JOB_MIN_FREQ == kv->key) {
+            return false;
+        }
+    }
+    /* the child's ends of the pipes get moved to 0-3, so they
+     * must not already be sitting there */
+    if (opts->p_stdin[0] <= 3 || opts->p_stdout[1] <= 3 ||
+        opts->p_stderr[1] <= 3 || opts->p_internal[1] <= 3) {
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Start the specified process with posix_spawn - everything do_child
+ * would have done is described to posix_spawn up front, so the daemon's
+ * address space is never duplicated and exec failures are reported
+ * directly to us
+ */
+static int odls_default_spawn_local_proc(orte_app_context_t* context,
+                                         orte_proc_t *child,
+                                         char **environ_copy,
+                                         orte_job_t *jobdat,
+                                         orte_iof_base_io_conf_t *opts)
+{
+    posix_spawn_file_actions_t factions;
+    posix_spawnattr_t attr;
+    sigset_t sigs;
+    char **env, *param;
+    pid_t pid;
+    int rc;
+
+    env = opal_argv_copy(environ_copy);
+
+    if (opts->usepty) {
+        /* disable echo */
+        struct termios term_attrs;
+        if (tcgetattr(opts->p_stdout[1], &term_attrs) == 0) {
+            term_attrs.c_lflag &= ~ (ECHO | ECHOE | ECHOK |
+                                     ECHOCTL | ECHOKE | ECHONL);
+            term_attrs.c_iflag &= ~ (ICRNL | INLCR | ISTRIP | INPCK | IXON);
+            term_attrs.c_oflag &= ~ (
+#ifdef OCRNL
+                                     OCRNL |
+#endif
+                                     ONLCR);
+            (void) tcsetattr(opts->p_stdout[1], TCSANOW, &term_attrs);
+        }
+    }
+
+    /* wire up stdin/out/err, move the internal IOF pipe to 3,
+     * and close everything else */
+    posix_spawn_file_actions_init(&factions);
+    posix_spawn_file_actions_adddup2(&factions, opts->p_stdout[1], 1);
+    posix_spawn_file_actions_adddup2(&factions, opts->p_stderr[1], 2);
+    if (opts->connect_stdin) {
+        posix_spawn_file_actions_adddup2(&factions, opts->p_stdin[0], 0);
+    } else {
+        posix_spawn_file_actions_addopen(&factions, 0, "/dev/null", O_RDONLY, 0);
+    }
+    posix_spawn_file_actions_adddup2(&factions, opts->p_internal[1], 3);
+    posix_spawn_file_actions_addclosefrom_np(&factions, 4);
+    if (!orte_map_stddiag_to_stderr) {
+        opal_setenv("OPAL_OUTPUT_STDERR_FD", "3", true, &env);
+    }
+    (void) mca_base_var_env_name("opal_set_max_sys_limits", &param);
+    opal_unsetenv(param, &env);
+    free(param);
+
+    /* restore default signal handling and unblock everything */
+    posix_spawnattr_init(&attr);
+    sigemptyset(&sigs);
+    posix_spawnattr_setsigmask(&attr, &sigs);
+    sigaddset(&sigs, SIGTERM);
+    sigaddset(&sigs, SIGINT);
+    sigaddset(&sigs, SIGHUP);
+    sigaddset(&sigs, SIGPIPE);
+    sigaddset(&sigs, SIGCHLD);
+    posix_spawnattr_setsigdefault(&attr, &sigs);
+    posix_spawnattr_setflags(&attr, POSIX_SPAWN_SETSIGMASK | POSIX_SPAWN_SETSIGDEF);
+
+    if (context->argv == NULL) {
+        context->argv = malloc(sizeof(char*)*2);
+        context->argv[0] = strdup(context->app);
+        context->argv[1] = NULL;
+    }
+
+    rc = posix_spawn(&pid, context->app, &factions, &attr, context->argv, env);
+    posix_spawnattr_destroy(&attr);
+    posix_spawn_file_actions_destroy(&factions);
+    opal_argv_free(env);
+
+    if (0 != rc) {
+        orte_show_help("help-orte-odls-default.txt", "execve error", true,
+                       orte_process_info.nodename, context->app, strerror(rc));
+        close(opts->p_stdin[0]);
+        close(opts->p_stdin[1]);
+        close(opts->p_stdout[0]);
+        close(opts->p_stdout[1]);
+        close(opts->p_stderr[0]);
+        close(opts->p_stderr[1]);
+        close(opts->p_internal[0]);
+        close(opts->p_internal[1]);
+        child->state = ORTE_PROC_STATE_FAILED_TO_START;
+        ORTE_FLAG_UNSET(child, ORTE_PROC_FLAG_ALIVE);
+        return ORTE_ERR_FAILED_TO_START;
+    }
+    child->pid = pid;
+
+    /* connect endpoints IOF */
+    if (ORTE_SUCCESS != (rc = orte_iof_base_setup_parent(&child->name, opts))) {
+        ORTE_ERROR_LOG(rc);
+        child->state = ORTE_PROC_STATE_UNDEF;
+        return rc;
+    }
+    child->state = ORTE_PROC_STATE_RUNNING;
+    ORTE_FLAG_SET(child, ORTE_PROC_FLAG_ALIVE);
+    return ORTE_SUCCESS;
+}
+#endif
+
 /**
  *  Fork/exec the specified processes
  */
@@ -656,6 +847,12 @@ static int odls_default_fork_local_proc(orte_app_context_t* context,
         }
     }
 
+#if defined(HAVE_POSIX_SPAWN) && defined(HAVE_POSIX_SPAWN_FILE_ACTIONS_ADDCLOSEFROM_NP)
+    if (spawn_eligible(child, jobdat, &opts)) {
+        return odls_default_spawn_local_proc(context, child, environ_copy, jobdat, &opts);
+    }
+#endif
+
     /* A pipe is used to communicate between the parent and child to
        indicate whether the exec ultimately succeeded or failed.  The
        child sets the pipe to be close-on-exec; the child only ever
@@ -0,0 +1,29 @@
+# -*- shell-script -*-
+#
+# $COPYRIGHT$
+#
+# Additional copyrights may follow
+#
+# $HEADER$
+#
+
+# MCA_oob_sm_CONFIG([action-if-found], [action-if-not-found])
+# -----------------------------------------------------------
+# The rings live in opal shmem segments, which are always available;
+# the connection and doorbell need Unix domain sockets.
+AC_DEFUN([MCA_orte_oob_sm_CONFIG],[
+    AC_CONFIG_FILES([orte/mca/oob/sm/Makefile])
+
+    AC_CHECK_TYPES([struct sockaddr_un],
+                   [oob_sm_happy="yes"],
+                   [oob_sm_happy="no"],
+                   [AC_INCLUDES_DEFAULT
+#ifdef HAVE_SYS_SOCKET_H
+#include <sys/socket.h>
+#endif
+#ifdef HAVE_SYS_UN_H
+#include <sys/un.h>
+#endif])
+
+    AS_IF([test "$oob_sm_happy" = "yes"], [$1], [$2])
+])dnl
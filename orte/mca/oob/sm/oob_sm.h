@@ -0,0 +1,155 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#ifndef _MCA_OOB_SM_H_
+#define _MCA_OOB_SM_H_
+
+#include "orte_config.h"
+
+#ifdef HAVE_SYS_SOCKET_H
+#include <sys/socket.h>
+#endif
+#ifdef HAVE_SYS_UN_H
+#include <sys/un.h>
+#endif
+
+#include "opal/class/opal_hash_table.h"
+#include "opal/class/opal_list.h"
+#include "opal/mca/event/event.h"
+#include "opal/mca/shmem/shmem_types.h"
+
+#include "orte/mca/oob/oob.h"
+#include "orte/mca/oob/base/base.h"
+
+BEGIN_C_DECLS
+
+/* Messages between two procs on the same host are carried in a
+ * shared memory segment holding a pair of single-producer,
+ * single-consumer byte rings - one for each direction. The proc that
+ * opens the connection creates the segment and uses ring 0 to send,
+ * the proc that accepts it uses ring 1. A unix domain socket between
+ * the two carries the connection request and serves as a doorbell:
+ * a byte is written to it only when the other side has gone to sleep
+ * waiting for data, or for space in its ring. It also tells us when
+ * the peer goes away. */
+
+#define MCA_OOB_SM_CACHELINE    64
+
+typedef struct {
+    /* written by the producer */
+    volatile uint32_t head;             // total bytes written
+    volatile int32_t writer_waiting;    // producer wants to hear when space frees up
+    char pad0[MCA_OOB_SM_CACHELINE - 2 * sizeof(int32_t)];
+    /* written by the consumer */
+    volatile uint32_t tail;             // total bytes consumed
+    volatile int32_t reader_waiting;    // consumer wants to hear when data arrives
+    char pad1[MCA_OOB_SM_CACHELINE - 2 * sizeof(int32_t)];
+} mca_oob_sm_ring_t;
+
+typedef struct {
+    mca_oob_sm_ring_t rings[2];
+} mca_oob_sm_seg_hdr_t;
+
+/* framing for each message in the ring - both ends are on
+ * the same host, so no byte-swapping is needed */
+typedef struct {
+    orte_process_name_t origin;
+    orte_process_name_t dst;
+    uint32_t seq_num;
+    orte_rml_tag_t tag;
+    uint32_t nbytes;
+} mca_oob_sm_hdr_t;
+
+/* sent over the socket by the proc opening a connection,
+ * followed by the used part of its opal_shmem_ds_t */
+typedef struct {
+    orte_process_name_t name;
+    uint32_t ring_size;
+    uint32_t dslen;
+} mca_oob_sm_connect_t;
+
+typedef enum {
+    MCA_OOB_SM_ACCEPTING,
+    MCA_OOB_SM_CONNECTING,
+    MCA_OOB_SM_CONNECTED,
+    MCA_OOB_SM_CLOSED
+} mca_oob_sm_state_t;
+
+struct mca_oob_sm_peer_t;
+
+typedef struct {
+    opal_list_item_t super;
+    struct mca_oob_sm_peer_t *peer;
+    mca_oob_sm_state_t state;
+    bool creator;
+    int sd;
+    opal_event_t ev;
+    bool ev_active;
+    /* connection request being received */
+    mca_oob_sm_connect_t req;
+    uint32_t reqbytes;
+    opal_shmem_ds_t ds;
+    unsigned char *base;
+    uint32_t size;              // bytes in each ring - a power of two
+    mca_oob_sm_ring_t *tx;
+    char *txbuf;
+    mca_oob_sm_ring_t *rx;
+    char *rxbuf;
+    /* message being received */
+    mca_oob_sm_hdr_t rxhdr;
+    bool rxhdr_recvd;
+    char *rxdata;
+    uint32_t rxbytes;
+} mca_oob_sm_conn_t;
+OBJ_CLASS_DECLARATION(mca_oob_sm_conn_t);
+
+typedef struct mca_oob_sm_peer_t {
+    opal_object_t super;
+    orte_process_name_t name;
+    char *path;                 // peer's rendezvous point, if it has one
+    bool failed;
+    mca_oob_sm_conn_t *conn;    // connection we send on
+    opal_list_t conns;          // all connections to this peer
+    opal_list_t send_queue;
+} mca_oob_sm_peer_t;
+OBJ_CLASS_DECLARATION(mca_oob_sm_peer_t);
+
+typedef struct {
+    opal_list_item_t super;
+    orte_rml_send_t *msg;
+    mca_oob_sm_hdr_t hdr;
+    bool hdr_sent;
+    int iovnum;
+    char *sdptr;
+    size_t sdbytes;
+} mca_oob_sm_send_t;
+OBJ_CLASS_DECLARATION(mca_oob_sm_send_t);
+
+typedef struct {
+    mca_oob_base_component_t super;
+    int ring_size;
+    char *hostname;
+    struct sockaddr_un address;
+    opal_hash_table_t peers;
+    opal_list_t accepting;      // connections still sending their request
+} mca_oob_sm_component_t;
+
+ORTE_MODULE_DECLSPEC extern mca_oob_sm_component_t mca_oob_sm_component;
+
+ORTE_MODULE_DECLSPEC mca_oob_sm_peer_t* mca_oob_sm_peer_lookup(const orte_process_name_t *name);
+ORTE_MODULE_DECLSPEC int mca_oob_sm_peer_connect(mca_oob_sm_peer_t *peer);
+ORTE_MODULE_DECLSPEC void mca_oob_sm_accept_connection(int sd);
+ORTE_MODULE_DECLSPEC void mca_oob_sm_conn_close(mca_oob_sm_conn_t *conn);
+ORTE_MODULE_DECLSPEC void mca_oob_sm_send_progress(mca_oob_sm_peer_t *peer);
+ORTE_MODULE_DECLSPEC void mca_oob_sm_send_complete(mca_oob_sm_send_t *snd, int status);
+ORTE_MODULE_DECLSPEC void mca_oob_sm_recv_progress(mca_oob_sm_conn_t *conn);
+
+END_C_DECLS
+
+#endif /* _MCA_OOB_SM_H_ */
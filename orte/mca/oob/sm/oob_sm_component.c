@@ -0,0 +1,452 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "orte_config.h"
+#include "orte/types.h"
+#include "opal/types.h"
+
+#ifdef HAVE_UNISTD_H
+#include <unistd.h>
+#endif
+#include <string.h>
+
+#include "opal/util/output.h"
+#include "opal/util/opal_environ.h"
+#include "opal/util/os_path.h"
+#include "opal/class/opal_hash_table.h"
+#include "opal/class/opal_list.h"
+
+#include "orte/mca/errmgr/errmgr.h"
+#include "orte/mca/routed/routed.h"
+#include "orte/util/listener.h"
+#include "orte/util/name_fns.h"
+#include "orte/runtime/orte_globals.h"
+
+#include "orte/mca/oob/sm/oob_sm.h"
+
+static int sm_component_register(void);
+static int sm_component_open(void);
+static int sm_component_close(void);
+
+static int component_available(void);
+static int component_startup(void);
+static void component_shutdown(void);
+static int component_send(orte_rml_send_t *msg);
+static char* component_get_addr(void);
+static int component_set_addr(orte_process_name_t *peer,
+                              char **uris);
+static bool component_is_reachable(orte_process_name_t *peer);
+
+/*
+ * Struct of function pointers and all that to let us be initialized
+ */
+mca_oob_sm_component_t mca_oob_sm_component = {
+    {
+        .oob_base = {
+            MCA_OOB_BASE_VERSION_2_0_0,
+            .mca_component_name = "sm",
+            MCA_BASE_MAKE_VERSION(component, ORTE_MAJOR_VERSION, ORTE_MINOR_VERSION,
+                                  ORTE_RELEASE_VERSION),
+            .mca_open_component = sm_component_open,
+            .mca_close_component = sm_component_close,
+            .mca_register_component_params = sm_component_register,
+        },
+        .oob_data = {
+            /* The component is checkpoint ready */
+            MCA_BASE_METADATA_PARAM_CHECKPOINT
+        },
+        .priority = 50, // ahead of tcp, which we fall back to
+        .available = component_available,
+        .startup = component_startup,
+        .shutdown = component_shutdown,
+        .send_nb = component_send,
+        .get_addr = component_get_addr,
+        .set_addr = component_set_addr,
+        .is_reachable = component_is_reachable,
+    },
+};
+
+static int sm_component_register(void)
+{
+    mca_base_component_t *component = &mca_oob_sm_component.super.oob_base;
+
+    mca_oob_sm_component.ring_size = 256 * 1024;
+    (void)mca_base_component_var_register(component, "ring_size",
+                                          "Size in bytes of the ring carrying messages in each direction "
+                                          "between two procs on the same host (rounded up to a power of two)",
+                                          MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                                          OPAL_INFO_LVL_9,
+                                          MCA_BASE_VAR_SCOPE_LOCAL,
+                                          &mca_oob_sm_component.ring_size);
+
+    return ORTE_SUCCESS;
+}
+
+static int sm_component_open(void)
+{
+    uint32_t size;
+
+    mca_oob_sm_component.hostname = NULL;
+    memset(&mca_oob_sm_component.address, 0, sizeof(struct sockaddr_un));
+    OBJ_CONSTRUCT(&mca_oob_sm_component.peers, opal_hash_table_t);
+    opal_hash_table_init(&mca_oob_sm_component.peers, 32);
+    OBJ_CONSTRUCT(&mca_oob_sm_component.accepting, opal_list_t);
+
+    /* the rings are indexed with a mask */
+    for (size = 4096; size < (uint32_t)mca_oob_sm_component.ring_size && size < (1u << 30); size <<= 1);
+    mca_oob_sm_component.ring_size = size;
+
+    return ORTE_SUCCESS;
+}
+
+static int sm_component_close(void)
+{
+    if (NULL != mca_oob_sm_component.hostname) {
+        free(mca_oob_sm_component.hostname);
+    }
+    OBJ_DESTRUCT(&mca_oob_sm_component.peers);
+    OBJ_DESTRUCT(&mca_oob_sm_component.accepting);
+    return ORTE_SUCCESS;
+}
+
+static int component_available(void)
+{
+    char hostname[OPAL_MAXHOSTNAMELEN];
+
+    opal_output_verbose(5, orte_oob_base_framework.framework_output,
+                        "oob:sm: component_available called");
+
+    /* apps only ever talk to their daemon, and usock
+     * already covers that */
+    if (ORTE_PROC_IS_APP) {
+        return ORTE_ERR_NOT_AVAILABLE;
+    }
+
+    /* we identify the host by its name, not whatever name
+     * we were given for the node */
+    if (0 != gethostname(hostname, sizeof(hostname))) {
+        return ORTE_ERR_NOT_AVAILABLE;
+    }
+    hostname[sizeof(hostname)-1] = '\0';
+    mca_oob_sm_component.hostname = strdup(hostname);
+
+    return ORTE_SUCCESS;
+}
+
+/*
+ * Handler for accepting connections from the event library
+ */
+static void connection_event_handler(int incoming_sd, short flags, void* cbdata)
+{
+    orte_pending_connection_t *pending = (orte_pending_connection_t*)cbdata;
+    int sd;
+
+    sd = pending->fd;
+    pending->fd = -1;
+    OBJ_RELEASE(pending);
+
+    mca_oob_sm_accept_connection(sd);
+}
+
+static int component_startup(void)
+{
+    int rc;
+    char *path, *tmp;
+
+    opal_output_verbose(2, orte_oob_base_framework.framework_output,
+                        "%s SM STARTUP",
+                        ORTE_NAME_PRINT(ORTE_PROC_MY_NAME));
+
+    /* tools connect out to a daemon but have nothing
+     * to listen on - the daemon answers on the same
+     * connection */
+    if (!ORTE_PROC_IS_DAEMON && !ORTE_PROC_IS_HNP) {
+        return ORTE_SUCCESS;
+    }
+
+    /* anyone on this host can find our rendezvous point from the
+     * uri alone, so it can live in our session directory - where it
+     * is scrubbed along with everything else, even if we never get
+     * to shut down cleanly */
+    asprintf(&tmp, "sm.%lu", (unsigned long)getpid());
+    if (orte_create_session_dirs &&
+        NULL != orte_process_info.tmpdir_base &&
+        NULL != orte_process_info.top_session_dir) {
+        path = opal_os_path(false, orte_process_info.tmpdir_base,
+                            orte_process_info.top_session_dir,
+                            ORTE_JOB_FAMILY_PRINT(ORTE_PROC_MY_NAME->jobid),
+                            "0", tmp, NULL);
+    } else {
+        path = opal_os_path(false, opal_tmp_directory(), tmp, NULL);
+    }
+    free(tmp);
+    if (sizeof(mca_oob_sm_component.address.sun_path) <= strlen(path)) {
+        opal_output_verbose(2, orte_oob_base_framework.framework_output,
+                            "%s oob:sm: rendezvous path %s too long",
+                            ORTE_NAME_PRINT(ORTE_PROC_MY_NAME), path);
+        free(path);
+        return ORTE_ERR_NOT_AVAILABLE;
+    }
+    mca_oob_sm_component.address.sun_family = AF_UNIX;
+    strncpy(mca_oob_sm_component.address.sun_path, path,
+            sizeof(mca_oob_sm_component.address.sun_path)-1);
+    free(path);
+    /* a stale one from a recycled pid would block the bind */
+    unlink(mca_oob_sm_component.address.sun_path);
+
+    if (ORTE_SUCCESS != (rc = orte_register_listener((struct sockaddr*)&mca_oob_sm_component.address,
+                                                     sizeof(struct sockaddr_un),
+                                                     orte_event_base, connection_event_handler))) {
+        ORTE_ERROR_LOG(rc);
+        mca_oob_sm_component.address.sun_path[0] = '\0';
+        return rc;
+    }
+    return ORTE_SUCCESS;
+}
+
+static void component_shutdown(void)
+{
+    mca_oob_sm_peer_t *peer;
+    mca_oob_sm_conn_t *conn;
+    mca_oob_sm_send_t *snd;
+    uint64_t key;
+    void *node;
+    int rc;
+
+    opal_output_verbose(2, orte_oob_base_framework.framework_output,
+                        "%s SM SHUTDOWN",
+                        ORTE_NAME_PRINT(ORTE_PROC_MY_NAME));
+
+    if ('\0' != mca_oob_sm_component.address.sun_path[0]) {
+        unlink(mca_oob_sm_component.address.sun_path);
+    }
+
+    while (NULL != (conn = (mca_oob_sm_conn_t*)opal_list_remove_first(&mca_oob_sm_component.accepting))) {
+        mca_oob_sm_conn_close(conn);
+    }
+
+    rc = opal_hash_table_get_first_key_uint64(&mca_oob_sm_component.peers, &key,
+                                              (void**)&peer, &node);
+    while (OPAL_SUCCESS == rc) {
+        if (NULL != peer) {
+            while (NULL != (conn = (mca_oob_sm_conn_t*)opal_list_get_first(&peer->conns)) &&
+                   conn != (mca_oob_sm_conn_t*)opal_list_get_end(&peer->conns)) {
+                mca_oob_sm_conn_close(conn);
+            }
+            /* whoever is waiting on what never went out has to hear about it */
+            while (NULL != (snd = (mca_oob_sm_send_t*)opal_list_remove_first(&peer->send_queue))) {
+                mca_oob_sm_send_complete(snd, ORTE_ERR_UNREACH);
+            }
+            OBJ_RELEASE(peer);
+        }
+        rc = opal_hash_table_get_next_key_uint64(&mca_oob_sm_component.peers, &key,
+                                                 (void**)&peer, node, &node);
+    }
+    opal_hash_table_remove_all(&mca_oob_sm_component.peers);
+}
+
+static int component_send(orte_rml_send_t *msg)
+{
+    orte_process_name_t hop;
+    mca_oob_sm_peer_t *peer;
+    mca_oob_sm_send_t *snd;
+    int i, rc;
+
+    opal_output_verbose(5, orte_oob_base_framework.framework_output,
+                        "%s oob:sm:send_nb to peer %s:%d seq_num = %d",
+                        ORTE_NAME_PRINT(ORTE_PROC_MY_NAME),
+                        ORTE_NAME_PRINT(&msg->dst), msg->tag, msg->seq_num);
+
+    /* we can only carry it if the next hop is on our host */
+    hop = orte_routed.get_route(&msg->dst);
+    if (NULL == (peer = mca_oob_sm_peer_lookup(&hop)) || peer->failed) {
+        return ORTE_ERR_TAKE_NEXT_OPTION;
+    }
+    if (NULL == peer->conn) {
+        /* an accepted connection may have gone away, and
+         * we cannot open one to a peer that doesn't listen */
+        if (NULL == peer->path) {
+            return ORTE_ERR_TAKE_NEXT_OPTION;
+        }
+        if (ORTE_SUCCESS != (rc = mca_oob_sm_peer_connect(peer))) {
+            peer->failed = true;
+            return ORTE_ERR_TAKE_NEXT_OPTION;
+        }
+    }
+
+    snd = OBJ_NEW(mca_oob_sm_send_t);
+    snd->msg = msg;
+    snd->hdr.origin = msg->origin;
+    snd->hdr.dst = msg->dst;
+    snd->hdr.seq_num = msg->seq_num;
+    snd->hdr.tag = msg->tag;
+    if (NULL != msg->buffer) {
+        snd->hdr.nbytes = msg->buffer->bytes_used;
+    } else if (NULL != msg->iov) {
+        snd->hdr.nbytes = 0;
+        for (i=0; i < msg->count; i++) {
+            snd->hdr.nbytes += msg->iov[i].iov_len;
+        }
+    } else {
+        snd->hdr.nbytes = msg->count;
+    }
+    opal_list_append(&peer->send_queue, &snd->super);
+
+    if (MCA_OOB_SM_CONNECTED == peer->conn->state) {
+        mca_oob_sm_send_progress(peer);
+    }
+    return ORTE_SUCCESS;
+}
+
+static char* component_get_addr(void)
+{
+    char *uri;
+
+    if ('\0' == mca_oob_sm_component.address.sun_path[0]) {
+        return NULL;
+    }
+    asprintf(&uri, "sm://%s:%s", mca_oob_sm_component.hostname,
+             mca_oob_sm_component.address.sun_path);
+    return uri;
+}
+
+static int component_set_addr(orte_process_name_t *peer,
+                              char **uris)
+{
+    mca_oob_sm_peer_t *pr;
+    char *host, *path;
+    uint64_t ui64;
+    int i;
+
+    for (i=0; NULL != uris[i]; i++) {
+        if (0 != strncmp(uris[i], "sm://", 5)) {
+            continue;
+        }
+        host = uris[i] + 5;
+        if (NULL == (path = strchr(host, ':'))) {
+            continue;
+        }
+        /* only peers on our own host can be reached */
+        if ((size_t)(path - host) != strlen(mca_oob_sm_component.hostname) ||
+            0 != strncmp(host, mca_oob_sm_component.hostname, path - host)) {
+            continue;
+        }
+        path++;
+        if (0 != access(path, W_OK)) {
+            continue;
+        }
+        opal_output_verbose(5, orte_oob_base_framework.framework_output,
+                            "%s oob:sm: peer %s is local at %s",
+                            ORTE_NAME_PRINT(ORTE_PROC_MY_NAME),
+                            ORTE_NAME_PRINT(peer), path);
+        if (NULL == (pr = mca_oob_sm_peer_lookup(peer))) {
+            pr = OBJ_NEW(mca_oob_sm_peer_t);
+            pr->name = *peer;
+            memcpy(&ui64, (char*)peer, sizeof(uint64_t));
+            opal_hash_table_set_value_uint64(&mca_oob_sm_component.peers, ui64, pr);
+        }
+        if (NULL != pr->path) {
+            free(pr->path);
+        }
+        pr->path = strdup(path);
+        /* the peer may have restarted */
+        pr->failed = false;
+        return ORTE_SUCCESS;
+    }
+    return ORTE_ERR_TAKE_NEXT_OPTION;
+}
+
+static bool component_is_reachable(orte_process_name_t *peer)
+{
+    orte_process_name_t hop;
+    mca_oob_sm_peer_t *pr;
+
+    hop = orte_routed.get_route(peer);
+    if (NULL == (pr = mca_oob_sm_peer_lookup(&hop)) || pr->failed) {
+        return false;
+    }
+    return (NULL != pr->conn || NULL != pr->path);
+}
+
+mca_oob_sm_peer_t* mca_oob_sm_peer_lookup(const orte_process_name_t *name)
+{
+    mca_oob_sm_peer_t *peer;
+    uint64_t ui64;
+
+    memcpy(&ui64, (char*)name, sizeof(uint64_t));
+    if (OPAL_SUCCESS != opal_hash_table_get_value_uint64(&mca_oob_sm_component.peers,
+                                                         ui64, (void**)&peer)) {
+        return NULL;
+    }
+    return peer;
+}
+
+/* OOB SM class instances */
+
+static void conn_cons(mca_oob_sm_conn_t *conn)
+{
+    conn->peer = NULL;
+    conn->state = MCA_OOB_SM_CONNECTING;
+    conn->creator = false;
+    conn->sd = -1;
+    conn->ev_active = false;
+    memset(&conn->req, 0, sizeof(mca_oob_sm_connect_t));
+    conn->reqbytes = 0;
+    memset(&conn->ds, 0, sizeof(opal_shmem_ds_t));
+    conn->base = NULL;
+    conn->size = 0;
+    conn->tx = NULL;
+    conn->txbuf = NULL;
+    conn->rx = NULL;
+    conn->rxbuf = NULL;
+    conn->rxhdr_recvd = false;
+    conn->rxdata = NULL;
+    conn->rxbytes = 0;
+}
+static void conn_des(mca_oob_sm_conn_t *conn)
+{
+    if (NULL != conn->rxdata) {
+        free(conn->rxdata);
+    }
+}
+OBJ_CLASS_INSTANCE(mca_oob_sm_conn_t,
+                   opal_list_item_t,
+                   conn_cons, conn_des);
+
+static void peer_cons(mca_oob_sm_peer_t *peer)
+{
+    peer->path = NULL;
+    peer->failed = false;
+    peer->conn = NULL;
+    OBJ_CONSTRUCT(&peer->conns, opal_list_t);
+    OBJ_CONSTRUCT(&peer->send_queue, opal_list_t);
+}
+static void peer_des(mca_oob_sm_peer_t *peer)
+{
+    if (NULL != peer->path) {
+        free(peer->path);
+    }
+    OPAL_LIST_DESTRUCT(&peer->conns);
+    OPAL_LIST_DESTRUCT(&peer->send_queue);
+}
+OBJ_CLASS_INSTANCE(mca_oob_sm_peer_t,
+                   opal_object_t,
+                   peer_cons, peer_des);
+
+static void snd_cons(mca_oob_sm_send_t *ptr)
+{
+    ptr->msg = NULL;
+    ptr->hdr_sent = false;
+    ptr->iovnum = 0;
+    ptr->sdptr = NULL;
+    ptr->sdbytes = 0;
+}
+OBJ_CLASS_INSTANCE(mca_oob_sm_send_t,
+                   opal_list_item_t,
+                   snd_cons, NULL);
@@ -0,0 +1,434 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "orte_config.h"
+#include "orte/types.h"
+#include "opal/types.h"
+
+#ifdef HAVE_UNISTD_H
+#include <unistd.h>
+#endif
+#include <errno.h>
+#include <fcntl.h>
+#include <stddef.h>
+#include <string.h>
+
+#include "opal/opal_socket_errno.h"
+#include "opal/util/fd.h"
+#include "opal/util/output.h"
+#include "opal/mca/shmem/base/base.h"
+
+#include "orte/mca/errmgr/errmgr.h"
+#include "orte/mca/routed/routed.h"
+#include "orte/mca/state/state.h"
+#include "orte/util/name_fns.h"
+#include "orte/runtime/orte_globals.h"
+
+#include "orte/mca/oob/sm/oob_sm.h"
+
+static void recv_handler(int sd, short flags, void *cbdata);
+
+/* lay the two rings out in the segment - the creator
+ * sends on ring 0 and the acceptor on ring 1 */
+static void setup_rings(mca_oob_sm_conn_t *conn)
+{
+    mca_oob_sm_seg_hdr_t *hdr = (mca_oob_sm_seg_hdr_t*)conn->base;
+    char *data = (char*)conn->base + sizeof(mca_oob_sm_seg_hdr_t);
+    int me = conn->creator ? 0 : 1;
+
+    conn->tx = &hdr->rings[me];
+    conn->txbuf = data + me * conn->size;
+    conn->rx = &hdr->rings[1 - me];
+    conn->rxbuf = data + (1 - me) * conn->size;
+}
+
+static int start_events(mca_oob_sm_conn_t *conn, opal_event_cbfunc_t cbfunc)
+{
+    int flags;
+
+    if ((flags = fcntl(conn->sd, F_GETFL, 0)) < 0 ||
+        fcntl(conn->sd, F_SETFL, flags | O_NONBLOCK) < 0) {
+        return ORTE_ERR_IN_ERRNO;
+    }
+    opal_event_set(orte_event_base, &conn->ev, conn->sd,
+                   OPAL_EV_READ | OPAL_EV_PERSIST, cbfunc, conn);
+    opal_event_set_priority(&conn->ev, ORTE_MSG_PRI);
+    opal_event_add(&conn->ev, 0);
+    conn->ev_active = true;
+    return ORTE_SUCCESS;
+}
+
+int mca_oob_sm_peer_connect(mca_oob_sm_peer_t *peer)
+{
+    mca_oob_sm_conn_t *conn;
+    mca_oob_sm_connect_t req;
+    struct sockaddr_un addr;
+    char *file;
+    int rc;
+
+    opal_output_verbose(5, orte_oob_base_framework.framework_output,
+                        "%s oob:sm: connecting to %s at %s",
+                        ORTE_NAME_PRINT(ORTE_PROC_MY_NAME),
+                        ORTE_NAME_PRINT(&peer->name), peer->path);
+
+    conn = OBJ_NEW(mca_oob_sm_conn_t);
+    conn->peer = peer;
+    conn->creator = true;
+    conn->size = mca_oob_sm_component.ring_size;
+
+    /* the backing file only has to live until the
+     * peer has attached */
+    asprintf(&file, "%s.%s", peer->path, ORTE_NAME_PRINT(ORTE_PROC_MY_NAME));
+    rc = opal_shmem_segment_create(&conn->ds, file,
+                                   sizeof(mca_oob_sm_seg_hdr_t) + 2 * (size_t)conn->size);
+    free(file);
+    if (OPAL_SUCCESS != rc) {
+        OBJ_RELEASE(conn);
+        return rc;
+    }
+    if (NULL == (conn->base = opal_shmem_segment_attach(&conn->ds))) {
+        opal_shmem_unlink(&conn->ds);
+        OBJ_RELEASE(conn);
+        return ORTE_ERR_OUT_OF_RESOURCE;
+    }
+    memset(conn->base, 0, sizeof(mca_oob_sm_seg_hdr_t));
+    setup_rings(conn);
+    /* nobody is reading yet - ring the bell for the first message */
+    conn->tx->reader_waiting = 1;
+    conn->rx->reader_waiting = 1;
+
+    if (0 > (conn->sd = socket(PF_UNIX, SOCK_STREAM, 0))) {
+        rc = ORTE_ERR_IN_ERRNO;
+        goto error;
+    }
+    opal_fd_set_cloexec(conn->sd);
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    strncpy(addr.sun_path, peer->path, sizeof(addr.sun_path)-1);
+    /* a local connect either completes or fails right away */
+    if (0 > connect(conn->sd, (struct sockaddr*)&addr, sizeof(addr))) {
+        opal_output_verbose(2, orte_oob_base_framework.framework_output,
+                            "%s oob:sm: connect to %s failed: %s (%d)",
+                            ORTE_NAME_PRINT(ORTE_PROC_MY_NAME),
+                            ORTE_NAME_PRINT(&peer->name),
+                            strerror(opal_socket_errno), opal_socket_errno);
+        rc = ORTE_ERR_UNREACH;
+        goto error;
+    }
+
+    req.name = *ORTE_PROC_MY_NAME;
+    req.ring_size = conn->size;
+    req.dslen = opal_shmem_sizeof_shmem_ds(&conn->ds);
+    if (OPAL_SUCCESS != (rc = opal_fd_write(conn->sd, sizeof(req), &req)) ||
+        OPAL_SUCCESS != (rc = opal_fd_write(conn->sd, req.dslen, &conn->ds))) {
+        goto error;
+    }
+    if (ORTE_SUCCESS != (rc = start_events(conn, recv_handler))) {
+        goto error;
+    }
+
+    /* sends queue up until the peer acks */
+    conn->state = MCA_OOB_SM_CONNECTING;
+    opal_list_append(&peer->conns, &conn->super);
+    peer->conn = conn;
+    return ORTE_SUCCESS;
+
+  error:
+    if (0 <= conn->sd) {
+        close(conn->sd);
+    }
+    opal_shmem_segment_detach(&conn->ds);
+    opal_shmem_unlink(&conn->ds);
+    OBJ_RELEASE(conn);
+    return rc;
+}
+
+/* the whole request is in - check it describes rings we can
+ * use, attach and let the peer know */
+static void accept_complete(mca_oob_sm_conn_t *conn)
+{
+    mca_oob_sm_connect_t *req = &conn->req;
+    mca_oob_sm_peer_t *peer;
+    orte_oob_base_peer_t *bpr;
+    uint64_t ui64;
+    uint8_t ack = 1;
+
+    if (0 == req->ring_size || 0 != (req->ring_size & (req->ring_size - 1)) ||
+        conn->ds.seg_size < sizeof(mca_oob_sm_seg_hdr_t) ||
+        (conn->ds.seg_size - sizeof(mca_oob_sm_seg_hdr_t)) / 2 < req->ring_size ||
+        '\0' != ((char*)&conn->ds)[req->dslen - 1]) {
+        opal_output_verbose(2, orte_oob_base_framework.framework_output,
+                            "%s oob:sm: bad connection request from %s",
+                            ORTE_NAME_PRINT(ORTE_PROC_MY_NAME),
+                            ORTE_NAME_PRINT(&req->name));
+        mca_oob_sm_conn_close(conn);
+        return;
+    }
+    conn->size = req->ring_size;
+    if (NULL == (conn->base = opal_shmem_segment_attach(&conn->ds))) {
+        opal_output_verbose(2, orte_oob_base_framework.framework_output,
+                            "%s oob:sm: cannot attach segment from %s",
+                            ORTE_NAME_PRINT(ORTE_PROC_MY_NAME),
+                            ORTE_NAME_PRINT(&req->name));
+        mca_oob_sm_conn_close(conn);
+        return;
+    }
+    setup_rings(conn);
+    /* a single byte always fits in an empty socket */
+    if (OPAL_SUCCESS != opal_fd_write(conn->sd, 1, &ack)) {
+        mca_oob_sm_conn_close(conn);
+        return;
+    }
+    conn->state = MCA_OOB_SM_CONNECTED;
+
+    opal_output_verbose(5, orte_oob_base_framework.framework_output,
+                        "%s oob:sm: accepted connection from %s",
+                        ORTE_NAME_PRINT(ORTE_PROC_MY_NAME),
+                        ORTE_NAME_PRINT(&req->name));
+
+    if (NULL == (peer = mca_oob_sm_peer_lookup(&req->name))) {
+        peer = OBJ_NEW(mca_oob_sm_peer_t);
+        peer->name = req->name;
+        memcpy(&ui64, (char*)&req->name, sizeof(uint64_t));
+        opal_hash_table_set_value_uint64(&mca_oob_sm_component.peers, ui64, peer);
+    }
+    peer->failed = false;
+    conn->peer = peer;
+    opal_list_append(&peer->conns, &conn->super);
+    /* answer on this connection unless we already opened
+     * our own - each side keeps sending on the one it
+     * started with, so ordering is preserved */
+    if (NULL == peer->conn) {
+        peer->conn = conn;
+    }
+    /* a tool is only reachable the way it came in */
+    orte_routed.update_route(&peer->name, &peer->name);
+
+    /* let the OOB know we can reach this peer - it may
+     * be a tool we have no other way of addressing */
+    memcpy(&ui64, (char*)&req->name, sizeof(uint64_t));
+    if (OPAL_SUCCESS != opal_hash_table_get_value_uint64(&orte_oob_base.peers,
+                                                         ui64, (void**)&bpr) || NULL == bpr) {
+        bpr = OBJ_NEW(orte_oob_base_peer_t);
+        opal_hash_table_set_value_uint64(&orte_oob_base.peers, ui64, bpr);
+    }
+    opal_bitmap_set_bit(&bpr->addressable, mca_oob_sm_component.super.idx);
+
+    /* the peer may have started writing already */
+    mca_oob_sm_recv_progress(conn);
+}
+
+/* collect the request and the segment descriptor behind it
+ * as they come in, without holding up the event loop */
+static void accept_handler(int sd, short flags, void *cbdata)
+{
+    mca_oob_sm_conn_t *conn = (mca_oob_sm_conn_t*)cbdata;
+    const uint32_t hdrlen = sizeof(mca_oob_sm_connect_t);
+    char *ptr;
+    size_t len;
+    ssize_t rc;
+
+    while (1) {
+        if (conn->reqbytes < hdrlen) {
+            ptr = (char*)&conn->req + conn->reqbytes;
+            len = hdrlen - conn->reqbytes;
+        } else {
+            /* we need the segment size and a name */
+            if (sizeof(opal_shmem_ds_t) < conn->req.dslen ||
+                offsetof(opal_shmem_ds_t, seg_name) >= conn->req.dslen) {
+                opal_output_verbose(2, orte_oob_base_framework.framework_output,
+                                    "%s oob:sm: bad connection request",
+                                    ORTE_NAME_PRINT(ORTE_PROC_MY_NAME));
+                goto error;
+            }
+            ptr = (char*)&conn->ds + (conn->reqbytes - hdrlen);
+            len = hdrlen + conn->req.dslen - conn->reqbytes;
+            if (0 == len) {
+                break;
+            }
+        }
+        rc = read(sd, ptr, len);
+        if (0 > rc) {
+            if (EINTR == opal_socket_errno) {
+                continue;
+            }
+            if (EAGAIN == opal_socket_errno || EWOULDBLOCK == opal_socket_errno) {
+                return;
+            }
+            opal_output_verbose(2, orte_oob_base_framework.framework_output,
+                                "%s oob:sm: reading connection request failed: %s (%d)",
+                                ORTE_NAME_PRINT(ORTE_PROC_MY_NAME),
+                                strerror(opal_socket_errno), opal_socket_errno);
+            goto error;
+        }
+        if (0 == rc) {
+            /* the peer gave up before finishing its request */
+            goto error;
+        }
+        conn->reqbytes += rc;
+    }
+
+    opal_list_remove_item(&mca_oob_sm_component.accepting, &conn->super);
+    /* from here on the socket is just the doorbell */
+    opal_event_del(&conn->ev);
+    conn->ev_active = false;
+    if (ORTE_SUCCESS != start_events(conn, recv_handler)) {
+        mca_oob_sm_conn_close(conn);
+        return;
+    }
+    accept_complete(conn);
+    return;
+
+  error:
+    opal_list_remove_item(&mca_oob_sm_component.accepting, &conn->super);
+    mca_oob_sm_conn_close(conn);
+}
+
+void mca_oob_sm_accept_connection(int sd)
+{
+    mca_oob_sm_conn_t *conn;
+#if defined(SO_PEERCRED)
+    struct ucred cred;
+    opal_socklen_t crlen = sizeof(cred);
+#endif
+
+    opal_fd_set_cloexec(sd);
+#if defined(SO_PEERCRED)
+    /* only the same user gets into our memory */
+    if (0 != getsockopt(sd, SOL_SOCKET, SO_PEERCRED, &cred, &crlen) ||
+        cred.uid != geteuid()) {
+        opal_output_verbose(2, orte_oob_base_framework.framework_output,
+                            "%s oob:sm: rejecting connection from another user",
+                            ORTE_NAME_PRINT(ORTE_PROC_MY_NAME));
+        close(sd);
+        return;
+    }
+#endif
+
+    /* the peer writes its request right after connecting,
+     * but it may not all be there yet */
+    conn = OBJ_NEW(mca_oob_sm_conn_t);
+    conn->sd = sd;
+    conn->state = MCA_OOB_SM_ACCEPTING;
+    if (ORTE_SUCCESS != start_events(conn, accept_handler)) {
+        mca_oob_sm_conn_close(conn);
+        return;
+    }
+    opal_list_append(&mca_oob_sm_component.accepting, &conn->super);
+}
+
+void mca_oob_sm_conn_close(mca_oob_sm_conn_t *conn)
+{
+    mca_oob_sm_peer_t *peer = conn->peer;
+
+    if (conn->ev_active) {
+        opal_event_del(&conn->ev);
+        conn->ev_active = false;
+    }
+    if (0 <= conn->sd) {
+        close(conn->sd);
+        conn->sd = -1;
+    }
+    if (NULL != conn->base) {
+        if (conn->creator && MCA_OOB_SM_CONNECTING == conn->state) {
+            opal_shmem_unlink(&conn->ds);
+        }
+        opal_shmem_segment_detach(&conn->ds);
+        conn->base = NULL;
+    }
+    conn->state = MCA_OOB_SM_CLOSED;
+    if (NULL != peer) {
+        if (peer->conn == conn) {
+            peer->conn = NULL;
+        }
+        opal_list_remove_item(&peer->conns, &conn->super);
+    }
+    OBJ_RELEASE(conn);
+}
+
+/* the peer has gone away, or never answered - give anything
+ * still queued for it back to the OOB so another transport
+ * can take it, and let the state machine know */
+static void lost_connection(mca_oob_sm_conn_t *conn)
+{
+    mca_oob_sm_peer_t *peer = conn->peer;
+    orte_process_name_t name = peer->name;
+    mca_oob_sm_send_t *snd;
+    bool connecting = (MCA_OOB_SM_CONNECTING == conn->state);
+
+    opal_output_verbose(2, orte_oob_base_framework.framework_output,
+                        "%s oob:sm: lost connection to %s",
+                        ORTE_NAME_PRINT(ORTE_PROC_MY_NAME),
+                        ORTE_NAME_PRINT(&name));
+
+    mca_oob_sm_conn_close(conn);
+    if (peer->failed) {
+        return;
+    }
+    peer->failed = true;
+    while (NULL != (snd = (mca_oob_sm_send_t*)opal_list_remove_first(&peer->send_queue))) {
+        ORTE_OOB_SEND(snd->msg);
+        snd->msg = NULL;
+        OBJ_RELEASE(snd);
+    }
+
+    /* a peer that refused us may still be reachable another way */
+    if (connecting || orte_finalizing) {
+        return;
+    }
+    if (ORTE_SUCCESS != orte_routed.route_lost(&name)) {
+        ORTE_ACTIVATE_PROC_STATE(&name, ORTE_PROC_STATE_LIFELINE_LOST);
+    } else {
+        ORTE_ACTIVATE_PROC_STATE(&name, ORTE_PROC_STATE_COMM_FAILED);
+    }
+}
+
+static void recv_handler(int sd, short flags, void *cbdata)
+{
+    mca_oob_sm_conn_t *conn = (mca_oob_sm_conn_t*)cbdata;
+    mca_oob_sm_peer_t *peer = conn->peer;
+    char bell[64];
+    ssize_t rc;
+
+    /* drain the doorbell - how many times it was rung
+     * doesn't matter, we look at everything anyway */
+    while (0 > (rc = read(sd, bell, sizeof(bell))) || sizeof(bell) == rc) {
+        if (0 > rc) {
+            if (EINTR == opal_socket_errno) {
+                continue;
+            }
+            if (EAGAIN == opal_socket_errno || EWOULDBLOCK == opal_socket_errno) {
+                break;
+            }
+            lost_connection(conn);
+            return;
+        }
+    }
+    if (0 == rc) {
+        lost_connection(conn);
+        return;
+    }
+
+    if (MCA_OOB_SM_CONNECTING == conn->state) {
+        /* that was the ack - the peer has attached, so the
+         * backing file can go */
+        conn->state = MCA_OOB_SM_CONNECTED;
+        opal_shmem_unlink(&conn->ds);
+        orte_routed.update_route(&peer->name, &peer->name);
+        opal_output_verbose(5, orte_oob_base_framework.framework_output,
+                            "%s oob:sm: connected to %s",
+                            ORTE_NAME_PRINT(ORTE_PROC_MY_NAME),
+                            ORTE_NAME_PRINT(&peer->name));
+    }
+
+    mca_oob_sm_recv_progress(conn);
+    if (NULL != peer->conn && MCA_OOB_SM_CONNECTED == peer->conn->state) {
+        mca_oob_sm_send_progress(peer);
+    }
+}
@@ -0,0 +1,293 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "orte_config.h"
+#include "orte/types.h"
+#include "opal/types.h"
+
+#ifdef HAVE_UNISTD_H
+#include <unistd.h>
+#endif
+#include <string.h>
+
+#include "opal/sys/atomic.h"
+#include "opal/util/output.h"
+
+#include "orte/mca/errmgr/errmgr.h"
+#include "orte/mca/rml/base/base.h"
+#include "orte/util/name_fns.h"
+#include "orte/runtime/orte_globals.h"
+
+#include "orte/mca/oob/sm/oob_sm.h"
+
+/* Both sides only ever sleep in the event library, so a producer that
+ * publishes data checks afterwards whether the consumer said it was
+ * going to sleep, and the consumer checks for more data after saying
+ * so. Full barriers between the store and the load on each side mean
+ * at least one of them sees the other - and the compare-and-swap means
+ * only one byte is written per sleep. */
+static void ring_bell(mca_oob_sm_conn_t *conn, volatile int32_t *waiting)
+{
+    uint8_t bell = 1;
+
+    opal_atomic_mb();
+    if (*waiting && opal_atomic_cmpset_32(waiting, 1, 0)) {
+        /* if the socket is full, the peer has
+         * plenty of reasons to wake up already */
+        (void)write(conn->sd, &bell, 1);
+    }
+}
+
+static void ring_put(mca_oob_sm_conn_t *conn, uint32_t pos,
+                     const char *src, uint32_t len)
+{
+    uint32_t off = pos & (conn->size - 1);
+    uint32_t n = conn->size - off;
+
+    if (len <= n) {
+        memcpy(conn->txbuf + off, src, len);
+    } else {
+        memcpy(conn->txbuf + off, src, n);
+        memcpy(conn->txbuf, src + n, len - n);
+    }
+}
+
+static void ring_get(mca_oob_sm_conn_t *conn, uint32_t pos,
+                     char *dst, uint32_t len)
+{
+    uint32_t off = pos & (conn->size - 1);
+    uint32_t n = conn->size - off;
+
+    if (len <= n) {
+        memcpy(dst, conn->rxbuf + off, len);
+    } else {
+        memcpy(dst, conn->rxbuf + off, n);
+        memcpy(dst + n, conn->rxbuf, len - n);
+    }
+}
+
+void mca_oob_sm_send_complete(mca_oob_sm_send_t *snd, int status)
+{
+    orte_rml_send_t *msg = snd->msg;
+
+    opal_output_verbose(5, orte_oob_base_framework.framework_output,
+                        "%s oob:sm: send to %s of %u bytes %s",
+                        ORTE_NAME_PRINT(ORTE_PROC_MY_NAME),
+                        ORTE_NAME_PRINT(&snd->hdr.dst), snd->hdr.nbytes,
+                        (ORTE_SUCCESS == status) ? "complete" : ORTE_ERROR_NAME(status));
+
+    msg->status = status;
+    if (NULL == msg->buffer && NULL == msg->iov && NULL != msg->data) {
+        /* we were relaying it - the data is ours */
+        free(msg->data);
+        msg->data = NULL;
+    }
+    ORTE_RML_SEND_COMPLETE(msg);
+    snd->msg = NULL;
+    OBJ_RELEASE(snd);
+}
+
+/* point at the next block of the message body */
+static bool next_block(mca_oob_sm_send_t *snd)
+{
+    orte_rml_send_t *msg = snd->msg;
+
+    if (!snd->hdr_sent) {
+        snd->hdr_sent = true;
+        snd->iovnum = 0;
+        if (NULL != msg->buffer) {
+            snd->sdptr = msg->buffer->base_ptr;
+            snd->sdbytes = msg->buffer->bytes_used;
+        } else if (NULL != msg->iov) {
+            if (0 == msg->count) {
+                return false;
+            }
+            snd->sdptr = msg->iov[0].iov_base;
+            snd->sdbytes = msg->iov[0].iov_len;
+        } else {
+            snd->sdptr = msg->data;
+            snd->sdbytes = msg->count;
+        }
+        return true;
+    }
+    if (NULL != msg->iov && NULL == msg->buffer && ++snd->iovnum < msg->count) {
+        snd->sdptr = msg->iov[snd->iovnum].iov_base;
+        snd->sdbytes = msg->iov[snd->iovnum].iov_len;
+        return true;
+    }
+    return false;
+}
+
+void mca_oob_sm_send_progress(mca_oob_sm_peer_t *peer)
+{
+    mca_oob_sm_conn_t *conn = peer->conn;
+    mca_oob_sm_ring_t *ring = conn->tx;
+    mca_oob_sm_send_t *snd;
+    opal_list_t completed;
+    uint32_t head, space, need, n;
+    bool wrote;
+
+    /* completion callbacks may well send again, so they
+     * are only run once the ring is consistent */
+    OBJ_CONSTRUCT(&completed, opal_list_t);
+
+  again:
+    head = ring->head;
+    space = conn->size - (head - ring->tail);
+    need = 0;
+    wrote = false;
+    while (NULL != (snd = (mca_oob_sm_send_t*)opal_list_get_first(&peer->send_queue)) &&
+           snd != (mca_oob_sm_send_t*)opal_list_get_end(&peer->send_queue)) {
+        if (!snd->hdr_sent) {
+            /* the header goes in whole so the reader can
+             * always take it in one piece */
+            if (space < sizeof(mca_oob_sm_hdr_t)) {
+                need = sizeof(mca_oob_sm_hdr_t);
+                break;
+            }
+            ring_put(conn, head, (char*)&snd->hdr, sizeof(mca_oob_sm_hdr_t));
+            head += sizeof(mca_oob_sm_hdr_t);
+            space -= sizeof(mca_oob_sm_hdr_t);
+            wrote = true;
+            if (!next_block(snd)) {
+                snd->sdbytes = 0;
+            }
+        }
+        while (0 < snd->sdbytes || next_block(snd)) {
+            if (0 == snd->sdbytes) {
+                continue;
+            }
+            if (0 == space) {
+                need = 1;
+                break;
+            }
+            n = (snd->sdbytes < space) ? (uint32_t)snd->sdbytes : space;
+            ring_put(conn, head, snd->sdptr, n);
+            head += n;
+            space -= n;
+            snd->sdptr += n;
+            snd->sdbytes -= n;
+            wrote = true;
+        }
+        if (0 < need) {
+            break;
+        }
+        opal_list_remove_first(&peer->send_queue);
+        opal_list_append(&completed, &snd->super);
+    }
+    if (wrote) {
+        /* the data has to be there before the reader sees it */
+        opal_atomic_wmb();
+        ring->head = head;
+        ring_bell(conn, &ring->reader_waiting);
+    }
+    if (0 < need) {
+        /* ask to be woken when the reader frees some space,
+         * then make sure it didn't do so in the meantime */
+        ring->writer_waiting = 1;
+        opal_atomic_mb();
+        if (need <= conn->size - (head - ring->tail)) {
+            ring->writer_waiting = 0;
+            goto again;
+        }
+    }
+
+    while (NULL != (snd = (mca_oob_sm_send_t*)opal_list_remove_first(&completed))) {
+        mca_oob_sm_send_complete(snd, ORTE_SUCCESS);
+    }
+    OBJ_DESTRUCT(&completed);
+}
+
+static void deliver(mca_oob_sm_conn_t *conn)
+{
+    orte_rml_send_t *snd;
+
+    opal_output_verbose(5, orte_oob_base_framework.framework_output,
+                        "%s oob:sm: recvd message from %s (origin %s) of %u bytes for %s tag %d",
+                        ORTE_NAME_PRINT(ORTE_PROC_MY_NAME),
+                        ORTE_NAME_PRINT(&conn->peer->name),
+                        ORTE_NAME_PRINT(&conn->rxhdr.origin),
+                        conn->rxhdr.nbytes,
+                        ORTE_NAME_PRINT(&conn->rxhdr.dst),
+                        conn->rxhdr.tag);
+
+    if (conn->rxhdr.dst.jobid == ORTE_PROC_MY_NAME->jobid &&
+        conn->rxhdr.dst.vpid == ORTE_PROC_MY_NAME->vpid) {
+        ORTE_RML_POST_MESSAGE(&conn->rxhdr.origin, conn->rxhdr.tag,
+                              conn->rxhdr.seq_num,
+                              conn->rxdata, conn->rxhdr.nbytes);
+    } else {
+        /* promote this to the OOB as some other transport
+         * might be the next best hop */
+        snd = OBJ_NEW(orte_rml_send_t);
+        snd->dst = conn->rxhdr.dst;
+        snd->origin = conn->rxhdr.origin;
+        snd->tag = conn->rxhdr.tag;
+        snd->data = conn->rxdata;
+        snd->seq_num = conn->rxhdr.seq_num;
+        snd->count = conn->rxhdr.nbytes;
+        snd->cbfunc.iov = NULL;
+        snd->cbdata = NULL;
+        ORTE_OOB_SEND(snd);
+    }
+    conn->rxdata = NULL;
+    conn->rxhdr_recvd = false;
+}
+
+void mca_oob_sm_recv_progress(mca_oob_sm_conn_t *conn)
+{
+    mca_oob_sm_ring_t *ring = conn->rx;
+    uint32_t head, tail, avail, n;
+
+    tail = ring->tail;
+    for (;;) {
+        ring->reader_waiting = 0;
+        head = ring->head;
+        opal_atomic_rmb();
+        while (0 < (avail = head - tail)) {
+            if (!conn->rxhdr_recvd) {
+                if (avail < sizeof(mca_oob_sm_hdr_t)) {
+                    break;
+                }
+                ring_get(conn, tail, (char*)&conn->rxhdr, sizeof(mca_oob_sm_hdr_t));
+                tail += sizeof(mca_oob_sm_hdr_t);
+                avail -= sizeof(mca_oob_sm_hdr_t);
+                conn->rxhdr_recvd = true;
+                conn->rxbytes = 0;
+                conn->rxdata = NULL;
+                if (0 < conn->rxhdr.nbytes) {
+                    conn->rxdata = (char*)malloc(conn->rxhdr.nbytes);
+                }
+            }
+            n = conn->rxhdr.nbytes - conn->rxbytes;
+            if (avail < n) {
+                n = avail;
+            }
+            if (0 < n) {
+                ring_get(conn, tail, conn->rxdata + conn->rxbytes, n);
+                tail += n;
+                conn->rxbytes += n;
+            }
+            if (conn->rxbytes == conn->rxhdr.nbytes) {
+                deliver(conn);
+            }
+        }
+        /* done reading before handing the space back */
+        opal_atomic_mb();
+        ring->tail = tail;
+        ring_bell(conn, &ring->writer_waiting);
+
+        /* going to sleep - unless more arrived meanwhile */
+        ring->reader_waiting = 1;
+        opal_atomic_mb();
+        if (ring->head == tail) {
+            break;
+        }
+    }
+}
@@ -451,6 +451,25 @@ static int tcp_component_register(void)
                                           MCA_BASE_VAR_SCOPE_READONLY,
                                           &mca_oob_tcp_component.max_recon_attempts);
 
+    mca_oob_tcp_component.batch_size = 0;
+    (void)mca_base_component_var_register(component, "batch_size",
+                                          "Number of bytes to accumulate for an idle peer before sending them together (0 -> send each message immediately)",
+                                          MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                                          OPAL_INFO_LVL_5,
+                                          MCA_BASE_VAR_SCOPE_READONLY,
+                                          &mca_oob_tcp_component.batch_size);
+
+    mca_oob_tcp_component.batch_delay = 1000;
+    (void)mca_base_component_var_register(component, "batch_delay",
+                                          "Max time (in usec) to hold a partial batch before sending it (ignored if batch_size <= 0)",
+                                          MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                                          OPAL_INFO_LVL_5,
+                                          MCA_BASE_VAR_SCOPE_READONLY,
+                                          &mca_oob_tcp_component.batch_delay);
+    if (mca_oob_tcp_component.batch_delay < 0) {
+        mca_oob_tcp_component.batch_delay = 0;
+    }
+
     return ORTE_SUCCESS;
 }
 
@@ -1257,6 +1276,8 @@ static void peer_cons(mca_oob_tcp_peer_t *peer)
     peer->send_ev_active = false;
     peer->recv_ev_active = false;
     peer->timer_ev_active = false;
+    peer->batch_ev_active = false;
+    peer->batch_bytes = 0;
 }
 static void peer_des(mca_oob_tcp_peer_t *peer)
 {
@@ -1272,6 +1293,9 @@ static void peer_des(mca_oob_tcp_peer_t *peer)
     if (peer->timer_ev_active) {
         opal_event_del(&peer->timer_event);
     }
+    if (peer->batch_ev_active) {
+        opal_event_del(&peer->batch_event);
+    }
     if (0 <= peer->sd) {
         opal_output_verbose(2, orte_oob_base_framework.framework_output,
                             "%s CLOSING SOCKET %d",
@@ -82,6 +82,8 @@ typedef struct {
     int                keepalive_intvl;        /**< time between keepalives, in seconds */
     int                retry_delay;            /**< time to wait before retrying connection */
     int                max_recon_attempts;     /**< maximum number of times to attempt connect before giving up (-1 for never) */
+    int                batch_size;             /**< bytes to accumulate for an idle peer before sending (0 = no batching) */
+    int                batch_delay;            /**< max time in usec to hold a partial batch */
 } mca_oob_tcp_component_t;
 
 ORTE_MODULE_DECLSPEC extern mca_oob_tcp_component_t mca_oob_tcp_component;
@@ -945,6 +945,11 @@ void mca_oob_tcp_peer_close(mca_oob_tcp_peer_t *peer)
         opal_event_del(&peer->send_event);
         peer->send_ev_active = false;
     }
+    if (peer->batch_ev_active) {
+        opal_event_del(&peer->batch_event);
+        peer->batch_ev_active = false;
+    }
+    peer->batch_bytes = 0;
 
     /* inform the component-level that we have lost a connection so
      * it can decide what to do about it.
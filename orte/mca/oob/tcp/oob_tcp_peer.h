@@ -55,6 +55,9 @@ typedef struct {
     bool recv_ev_active;
     opal_event_t timer_event;   /**< timer for retrying connection failures */
     bool timer_ev_active;
+    opal_event_t batch_event;   /**< timer for flushing a partial batch of sends */
+    bool batch_ev_active;
+    size_t batch_bytes;         /**< bytes accumulated in the current batch */
     opal_list_t send_queue;      /**< list of messages to send */
     mca_oob_tcp_send_t *send_msg; /**< current send in progress */
     mca_oob_tcp_recv_t *recv_msg; /**< current recv in progress */
@@ -62,6 +65,18 @@ typedef struct {
 OBJ_CLASS_DECLARATION(mca_oob_tcp_peer_t);
 
 /* state machine for processing peer data */
+
+/* Arm the send event for a peer that has messages waiting. If
+ * batching is enabled, the event is held back until the queued
+ * messages reach the batch size or the batch timer expires, so
+ * that they go out together in a single write
+ *
+ * peer => pointer to mca_oob_tcp_peer_t
+ * nbytes => bytes added to the queue by the caller
+ */
+ORTE_MODULE_DECLSPEC void mca_oob_tcp_peer_activate_send(mca_oob_tcp_peer_t *peer,
+                                                         size_t nbytes);
+
 typedef struct {
     opal_object_t super;
     opal_event_t ev;
@@ -75,17 +75,190 @@
 #include "orte/mca/oob/tcp/oob_tcp_common.h"
 #include "orte/mca/oob/tcp/oob_tcp_connection.h"
 
+/* max number of iovecs handed to a single writev - enough to
+ * carry the header and payload of several queued messages */
+#define MCA_OOB_TCP_MAX_IOVS   64
+
+/* setup to send the payload of a message once its header
+ * has gone out. Returns false if there is no payload */
+static bool start_payload(mca_oob_tcp_send_t *msg)
+{
+    if (NULL != msg->data) {
+        /* relay msg - send that data */
+        msg->sdptr = msg->data;
+        msg->sdbytes = (int)ntohl(msg->hdr.nbytes);
+    } else if (NULL == msg->msg) {
+        /* this was a zero-byte relay - nothing more to do */
+        msg->sdptr = NULL;
+        msg->sdbytes = 0;
+        return false;
+    } else if (NULL != msg->msg->buffer) {
+        /* send the buffer data as a single block */
+        msg->sdptr = msg->msg->buffer->base_ptr;
+        msg->sdbytes = msg->msg->buffer->bytes_used;
+    } else if (NULL != msg->msg->iov) {
+        /* start with the first iovec */
+        msg->sdptr = msg->msg->iov[0].iov_base;
+        msg->sdbytes = msg->msg->iov[0].iov_len;
+        msg->iovnum = 0;
+    } else {
+        /* just send the data */
+        msg->sdptr = msg->msg->data;
+        msg->sdbytes = msg->msg->count;
+    }
+    return true;
+}
+
+static inline bool is_iov_msg(mca_oob_tcp_send_t *msg)
+{
+    return (NULL == msg->data && NULL != msg->msg &&
+            NULL == msg->msg->buffer && NULL != msg->msg->iov);
+}
+
+/* describe the unsent portion of a message in the given
+ * iovec array, returning the number of entries used */
+static int fill_iovs(mca_oob_tcp_send_t *msg, struct iovec *iov,
+                     int max, size_t *nbytes)
+{
+    int n = 0, i;
+
+#define MCA_OOB_TCP_ADD_IOV(b, l)                       \
+    do {                                                \
+        if (0 < (l) && n < max) {                       \
+            iov[n].iov_base = (void*)(b);               \
+            iov[n].iov_len = (l);                       \
+            *nbytes += (l);                             \
+            n++;                                        \
+        }                                               \
+    } while(0)
+
+    /* whatever remains of the current block */
+    MCA_OOB_TCP_ADD_IOV(msg->sdptr, msg->sdbytes);
+
+    if (!msg->hdr_sent) {
+        /* the entire payload follows the header */
+        if (NULL != msg->data) {
+            MCA_OOB_TCP_ADD_IOV(msg->data, (size_t)ntohl(msg->hdr.nbytes));
+        } else if (NULL == msg->msg) {
+            /* zero-byte relay */
+        } else if (NULL != msg->msg->buffer) {
+            MCA_OOB_TCP_ADD_IOV(msg->msg->buffer->base_ptr,
+                                (size_t)msg->msg->buffer->bytes_used);
+        } else if (NULL != msg->msg->iov) {
+            for (i=0; i < msg->msg->count && n < max; i++) {
+                MCA_OOB_TCP_ADD_IOV(msg->msg->iov[i].iov_base,
+                                    msg->msg->iov[i].iov_len);
+            }
+        } else {
+            MCA_OOB_TCP_ADD_IOV(msg->msg->data, (size_t)msg->msg->count);
+        }
+    } else if (is_iov_msg(msg)) {
+        /* the iovecs we haven't started yet */
+        for (i=msg->iovnum+1; i < msg->msg->count && n < max; i++) {
+            MCA_OOB_TCP_ADD_IOV(msg->msg->iov[i].iov_base,
+                                msg->msg->iov[i].iov_len);
+        }
+    }
+#undef MCA_OOB_TCP_ADD_IOV
+
+    return n;
+}
+
+/* account for nbytes having been written from the current
+ * position of the message. Returns true once the entire
+ * message has been sent, leaving any excess in nbytes */
+static bool advance(mca_oob_tcp_send_t *msg, size_t *nbytes)
+{
+    size_t n;
+
+    while (true) {
+        n = (*nbytes < msg->sdbytes) ? *nbytes : msg->sdbytes;
+        msg->sdptr += n;
+        msg->sdbytes -= n;
+        *nbytes -= n;
+        if (0 < msg->sdbytes) {
+            return false;
+        }
+        /* the current block is complete - move to the next one */
+        if (!msg->hdr_sent) {
+            msg->hdr_sent = true;
+            if (!start_payload(msg)) {
+                return true;
+            }
+            continue;
+        }
+        if (is_iov_msg(msg) && ++msg->iovnum < msg->msg->count) {
+            msg->sdptr = msg->msg->iov[msg->iovnum].iov_base;
+            msg->sdbytes = msg->msg->iov[msg->iovnum].iov_len;
+            continue;
+        }
+        return true;
+    }
+}
+
+/* a message has been completely sent - notify the RML if
+ * it originated here and release it */
+static void send_complete(mca_oob_tcp_peer_t *peer, mca_oob_tcp_send_t *msg)
+{
+    if (NULL != msg->data || NULL == msg->msg) {
+        /* the relay is complete - release the data */
+        opal_output_verbose(2, orte_oob_base_framework.framework_output,
+                            "%s MESSAGE RELAY COMPLETE TO %s OF %d BYTES ON SOCKET %d",
+                            ORTE_NAME_PRINT(ORTE_PROC_MY_NAME),
+                            ORTE_NAME_PRINT(&(peer->name)),
+                            (int)ntohl(msg->hdr.nbytes), peer->sd);
+    } else if (NULL == msg->msg->buffer && NULL == msg->msg->iov &&
+               NULL != msg->msg->data) {
+        /* this was a relay we have now completed - no need to
+         * notify the RML as the local proc didn't initiate
+         * the send
+         */
+        opal_output_verbose(2, orte_oob_base_framework.framework_output,
+                            "%s MESSAGE RELAY COMPLETE TO %s OF %d BYTES ON SOCKET %d",
+                            ORTE_NAME_PRINT(ORTE_PROC_MY_NAME),
+                            ORTE_NAME_PRINT(&(peer->name)),
+                            (int)ntohl(msg->hdr.nbytes), peer->sd);
+        msg->msg->status = ORTE_SUCCESS;
+    } else {
+        /* we are done - notify the RML */
+        opal_output_verbose(2, orte_oob_base_framework.framework_output,
+                            "%s MESSAGE SEND COMPLETE TO %s OF %d BYTES ON SOCKET %d",
+                            ORTE_NAME_PRINT(ORTE_PROC_MY_NAME),
+                            ORTE_NAME_PRINT(&(peer->name)),
+                            (int)ntohl(msg->hdr.nbytes), peer->sd);
+        msg->msg->status = ORTE_SUCCESS;
+        ORTE_RML_SEND_COMPLETE(msg->msg);
+    }
+    OBJ_RELEASE(msg);
+}
+
+/* Push as much of the on-deck message - plus as many of the messages
+ * queued behind it as will fit - into the socket with a single writev.
+ * Completed messages are retired and the next queued message moved
+ * on-deck */
 static int send_bytes(mca_oob_tcp_peer_t* peer)
 {
-    mca_oob_tcp_send_t* msg = peer->send_msg;
-    int rc;
+    struct iovec iov[MCA_OOB_TCP_MAX_IOVS];
+    mca_oob_tcp_send_t *msg;
+    size_t nbytes = 0, sent;
+    ssize_t rc;
+    int n;
+
+    /* the on-deck message may be partially sent */
+    n = fill_iovs(peer->send_msg, iov, MCA_OOB_TCP_MAX_IOVS, &nbytes);
+    /* anything in the queue hasn't been started yet */
+    OPAL_LIST_FOREACH(msg, &peer->send_queue, mca_oob_tcp_send_t) {
+        if (MCA_OOB_TCP_MAX_IOVS <= n) {
+            break;
+        }
+        n += fill_iovs(msg, &iov[n], MCA_OOB_TCP_MAX_IOVS - n, &nbytes);
+    }
 
     OPAL_TIMING_EVENT((&tm_oob, "to %s %d bytes",
-                       ORTE_NAME_PRINT(&(peer->name)), msg->sdbytes));
+                       ORTE_NAME_PRINT(&(peer->name)), (int)nbytes));
 
-    while (0 < msg->sdbytes) {
-        rc = write(peer->sd, msg->sdptr, msg->sdbytes);
-        if (rc < 0) {
+    if (0 < n) {
+        while (0 > (rc = writev(peer->sd, iov, n))) {
             if (opal_socket_errno == EINTR) {
                 continue;
             } else if (opal_socket_errno == EAGAIN) {
@@ -110,11 +283,18 @@ static int send_bytes(mca_oob_tcp_peer_t* peer)
                         peer->sd);
             return ORTE_ERR_COMM_FAILURE;
         }
-        /* update location */
-        msg->sdbytes -= rc;
-        msg->sdptr += rc;
+        sent = (size_t)rc;
+    } else {
+        /* nothing left but zero-length blocks */
+        sent = 0;
+    }
+
+    /* retire whatever messages were completed */
+    while (NULL != peer->send_msg && advance(peer->send_msg, &sent)) {
+        send_complete(peer, peer->send_msg);
+        peer->send_msg = (mca_oob_tcp_send_t*)
+            opal_list_remove_first(&peer->send_queue);
     }
-    /* we sent the full data block */
     return ORTE_SUCCESS;
 }
 
@@ -155,143 +335,47 @@ void mca_oob_tcp_send_handler(int sd, short flags, void *cbdata)
                             ORTE_NAME_PRINT(ORTE_PROC_MY_NAME),
                             (NULL == peer->send_msg) ? "NULL" : ORTE_NAME_PRINT(&peer->name));
         if (NULL != msg) {
-            /* if the header hasn't been completely sent, send it */
-            if (!msg->hdr_sent) {
-                if (ORTE_SUCCESS == (rc = send_bytes(peer))) {
-                    /* header is completely sent */
-                    msg->hdr_sent = true;
-                    /* setup to send the data */
-                    if (NULL != msg->data) {
-                        /* relay msg - send that data */
-                        msg->sdptr = msg->data;
-                        msg->sdbytes = (int)ntohl(msg->hdr.nbytes);
-                    } else if (NULL == msg->msg) {
-                        /* this was a zero-byte relay - nothing more to do */
-                        OBJ_RELEASE(msg);
-                        peer->send_msg = NULL;
-                        goto next;
-                    } else if (NULL != msg->msg->buffer) {
-                        /* send the buffer data as a single block */
-                        msg->sdptr = msg->msg->buffer->base_ptr;
-                        msg->sdbytes = msg->msg->buffer->bytes_used;
-                    } else if (NULL != msg->msg->iov) {
-                        /* start with the first iovec */
-                        msg->sdptr = msg->msg->iov[0].iov_base;
-                        msg->sdbytes = msg->msg->iov[0].iov_len;
-                        msg->iovnum = 0;
-                    } else {
-                        /* just send the data */
-                        msg->sdptr = msg->msg->data;
-                        msg->sdbytes = msg->msg->count;
-                    }
-                    /* fall thru and let the send progress */
-                } else if (ORTE_ERR_RESOURCE_BUSY == rc ||
-                           ORTE_ERR_WOULD_BLOCK == rc) {
-                    /* exit this event and let the event lib progress */
-                    return;
-                } else {
-                    // report the error
-                    opal_output(0, "%s-%s mca_oob_tcp_peer_send_handler: unable to send header",
-                                ORTE_NAME_PRINT(ORTE_PROC_MY_NAME),
-                                ORTE_NAME_PRINT(&(peer->name)));
-                    opal_event_del(&peer->send_event);
+            /* a single writev per event covers the header and
+             * payload of the on-deck message and of the messages
+             * queued behind it. Anything the socket couldn't take
+             * is picked up on the next send event, which gives us
+             * a chance to service any pending recvs in between
+             */
+            if (ORTE_SUCCESS == (rc = send_bytes(peer))) {
+                /* fall thru to check for more work */
+            } else if (ORTE_ERR_RESOURCE_BUSY == rc ||
+                       ORTE_ERR_WOULD_BLOCK == rc) {
+                /* exit this event and let the event lib progress */
+                return;
+            } else if (!msg->hdr_sent) {
+                // report the error
+                opal_output(0, "%s-%s mca_oob_tcp_peer_send_handler: unable to send header",
+                            ORTE_NAME_PRINT(ORTE_PROC_MY_NAME),
+                            ORTE_NAME_PRINT(&(peer->name)));
+                opal_event_del(&peer->send_event);
+                if (NULL != msg->msg) {
                     msg->msg->status = rc;
                     ORTE_RML_SEND_COMPLETE(msg->msg);
-                    OBJ_RELEASE(msg);
-                    peer->send_msg = NULL;
-                    goto next;
                 }
-            }
-            /* progress the data transmission */
-            if (msg->hdr_sent) {
-                if (ORTE_SUCCESS == (rc = send_bytes(peer))) {
-                    /* this block is complete */
-                    if (NULL != msg->data || NULL == msg->msg) {
-                        /* the relay is complete - release the data */
-                        opal_output_verbose(2, orte_oob_base_framework.framework_output,
-                                            "%s MESSAGE RELAY COMPLETE TO %s OF %d BYTES ON SOCKET %d",
-                                            ORTE_NAME_PRINT(ORTE_PROC_MY_NAME),
-                                            ORTE_NAME_PRINT(&(peer->name)),
-                                            (int)ntohl(msg->hdr.nbytes), peer->sd);
-                        OBJ_RELEASE(msg);
-                        peer->send_msg = NULL;
-                    } else if (NULL != msg->msg->buffer) {
-                        /* we are done - notify the RML */
-                        opal_output_verbose(2, orte_oob_base_framework.framework_output,
-                                            "%s MESSAGE SEND COMPLETE TO %s OF %d BYTES ON SOCKET %d",
-                                            ORTE_NAME_PRINT(ORTE_PROC_MY_NAME),
-                                            ORTE_NAME_PRINT(&(peer->name)),
-                                            (int)ntohl(msg->hdr.nbytes), peer->sd);
-                        msg->msg->status = ORTE_SUCCESS;
-                        ORTE_RML_SEND_COMPLETE(msg->msg);
-                        OBJ_RELEASE(msg);
-                        peer->send_msg = NULL;
-                    } else if (NULL != msg->msg->data) {
-                        /* this was a relay we have now completed - no need to
-                         * notify the RML as the local proc didn't initiate
-                         * the send
-                         */
-                        opal_output_verbose(2, orte_oob_base_framework.framework_output,
-                                            "%s MESSAGE RELAY COMPLETE TO %s OF %d BYTES ON SOCKET %d",
-                                            ORTE_NAME_PRINT(ORTE_PROC_MY_NAME),
-                                            ORTE_NAME_PRINT(&(peer->name)),
-                                            (int)ntohl(msg->hdr.nbytes), peer->sd);
-                        msg->msg->status = ORTE_SUCCESS;
-                        OBJ_RELEASE(msg);
-                        peer->send_msg = NULL;
-                    } else {
-                        /* rotate to the next iovec */
-                        msg->iovnum++;
-                        if (msg->iovnum < msg->msg->count) {
-                            msg->sdptr = msg->msg->iov[msg->iovnum].iov_base;
-                            msg->sdbytes = msg->msg->iov[msg->iovnum].iov_len;
-                            /* exit this event to give the event lib
-                             * a chance to progress any other pending
-                             * actions
-                             */
-                            return;
-                        } else {
-                            /* this message is complete - notify the RML */
-                            opal_output_verbose(2, orte_oob_base_framework.framework_output,
-                                                "%s MESSAGE SEND COMPLETE TO %s OF %d BYTES ON SOCKET %d",
-                                                ORTE_NAME_PRINT(ORTE_PROC_MY_NAME),
-                                                ORTE_NAME_PRINT(&(peer->name)),
-                                                (int)ntohl(msg->hdr.nbytes), peer->sd);
-                            msg->msg->status = ORTE_SUCCESS;
-                            ORTE_RML_SEND_COMPLETE(msg->msg);
-                            OBJ_RELEASE(msg);
-                            peer->send_msg = NULL;
-                        }
-                    }
-                    /* fall thru to queue the next message */
-                } else if (ORTE_ERR_RESOURCE_BUSY == rc ||
-                           ORTE_ERR_WOULD_BLOCK == rc) {
-                    /* exit this event and let the event lib progress */
-                    return;
-                } else {
-                    // report the error
-                    opal_output(0, "%s-%s mca_oob_tcp_peer_send_handler: unable to send message ON SOCKET %d",
-                                ORTE_NAME_PRINT(ORTE_PROC_MY_NAME),
-                                ORTE_NAME_PRINT(&(peer->name)), peer->sd);
-                    opal_event_del(&peer->send_event);
+                OBJ_RELEASE(msg);
+                /* move the next message in the queue on-deck */
+                peer->send_msg = (mca_oob_tcp_send_t*)
+                    opal_list_remove_first(&peer->send_queue);
+            } else {
+                // report the error
+                opal_output(0, "%s-%s mca_oob_tcp_peer_send_handler: unable to send message ON SOCKET %d",
+                            ORTE_NAME_PRINT(ORTE_PROC_MY_NAME),
+                            ORTE_NAME_PRINT(&(peer->name)), peer->sd);
+                opal_event_del(&peer->send_event);
+                if (NULL != msg->msg) {
                     msg->msg->status = rc;
                     ORTE_RML_SEND_COMPLETE(msg->msg);
-                    OBJ_RELEASE(msg);
-                    peer->send_msg = NULL;
-                    ORTE_FORCED_TERMINATE(1);
-                    return;
                 }
+                OBJ_RELEASE(msg);
+                peer->send_msg = NULL;
+                ORTE_FORCED_TERMINATE(1);
+                return;
             }
-
-        next:
-            /* if current message completed - progress any pending sends by
-             * moving the next in the queue into the "on-deck" position. Note
-             * that this doesn't mean we send the message right now - we will
-             * wait for another send_event to fire before doing so. This gives
-             * us a chance to service any pending recvs.
-             */
-            peer->send_msg = (mca_oob_tcp_send_t*)
-                opal_list_remove_first(&peer->send_queue);
         }
 
         /* if nothing else to do unregister for send event notifications */
@@ -313,6 +397,57 @@ void mca_oob_tcp_send_handler(int sd, short flags, void *cbdata)
     }
 }
 
+/* the batch timer expired - send whatever has accumulated */
+static void batch_flush(int fd, short args, void *cbdata)
+{
+    mca_oob_tcp_peer_t *peer = (mca_oob_tcp_peer_t*)cbdata;
+
+    peer->batch_ev_active = false;
+    peer->batch_bytes = 0;
+    if (MCA_OOB_TCP_CONNECTED == peer->state &&
+        NULL != peer->send_msg && !peer->send_ev_active) {
+        opal_output_verbose(OOB_TCP_DEBUG_CONNECT, orte_oob_base_framework.framework_output,
+                            "%s tcp:batch flushing %d queued msgs to %s",
+                            ORTE_NAME_PRINT(ORTE_PROC_MY_NAME),
+                            (int)opal_list_get_size(&peer->send_queue) + 1,
+                            ORTE_NAME_PRINT(&peer->name));
+        opal_event_add(&peer->send_event, 0);
+        peer->send_ev_active = true;
+    }
+}
+
+void mca_oob_tcp_peer_activate_send(mca_oob_tcp_peer_t *peer, size_t nbytes)
+{
+    struct timeval tv;
+
+    if (0 < mca_oob_tcp_component.batch_size) {
+        peer->batch_bytes += nbytes;
+        if (peer->batch_bytes < (size_t)mca_oob_tcp_component.batch_size) {
+            /* hold the messages until the batch fills or
+             * the timer expires */
+            if (!peer->batch_ev_active) {
+                tv.tv_sec = mca_oob_tcp_component.batch_delay / 1000000;
+                tv.tv_usec = mca_oob_tcp_component.batch_delay % 1000000;
+                opal_event_evtimer_set(mca_oob_tcp_module.ev_base, &peer->batch_event,
+                                       batch_flush, peer);
+                opal_event_evtimer_add(&peer->batch_event, &tv);
+                peer->batch_ev_active = true;
+            }
+            return;
+        }
+        /* the batch is full - send it now */
+        if (peer->batch_ev_active) {
+            opal_event_del(&peer->batch_event);
+            peer->batch_ev_active = false;
+        }
+        peer->batch_bytes = 0;
+    }
+    if (!peer->send_ev_active) {
+        opal_event_add(&peer->send_event, 0);
+        peer->send_ev_active = true;
+    }
+}
+
 static int read_bytes(mca_oob_tcp_peer_t* peer)
 {
     int rc;
@@ -405,7 +540,7 @@ static int read_bytes(mca_oob_tcp_peer_t* peer)
 void mca_oob_tcp_recv_handler(int sd, short flags, void *cbdata)
 {
     mca_oob_tcp_peer_t* peer = (mca_oob_tcp_peer_t*)cbdata;
-    int rc;
+    int rc, nmsgs = 0;
     orte_rml_send_t *snd;
 #if OPAL_ENABLE_TIMING
     bool timing_same_as_hdr = false;
@@ -458,6 +593,7 @@ void mca_oob_tcp_recv_handler(int sd, short flags, void *cbdata)
         opal_output_verbose(OOB_TCP_DEBUG_CONNECT, orte_oob_base_framework.framework_output,
                             "%s:tcp:recv:handler CONNECTED",
                             ORTE_NAME_PRINT(ORTE_PROC_MY_NAME));
+    nextmsg:
         /* allocate a new message and setup for recv */
         if (NULL == peer->recv_msg) {
             opal_output_verbose(OOB_TCP_DEBUG_CONNECT, orte_oob_base_framework.framework_output,
@@ -584,6 +720,16 @@ void mca_oob_tcp_recv_handler(int sd, short flags, void *cbdata)
                     OBJ_RELEASE(peer->recv_msg);
                 }
                 peer->recv_msg = NULL;
+                /* a batching peer typically leaves several messages
+                 * in the socket - split them out in this pass rather
+                 * than waking up once for each of them */
+                if (0 < mca_oob_tcp_component.batch_size &&
+                    ++nmsgs < MCA_OOB_TCP_MAX_IOVS) {
+#if OPAL_ENABLE_TIMING
+                    timing_same_as_hdr = false;
+#endif
+                    goto nextmsg;
+                }
                 return;
             } else if (ORTE_ERR_RESOURCE_BUSY == rc ||
                        ORTE_ERR_WOULD_BLOCK == rc) {
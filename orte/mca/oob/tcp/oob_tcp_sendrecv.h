@@ -89,8 +89,9 @@ OBJ_CLASS_DECLARATION(mca_oob_tcp_recv_t);
             } else {                                                    \
                 /* ensure the send event is active */                   \
                 if (!(p)->send_ev_active) {                             \
-                    opal_event_add(&(p)->send_event, 0);                \
-                    (p)->send_ev_active = true;                         \
+                    mca_oob_tcp_peer_activate_send((p),                 \
+                                sizeof(mca_oob_tcp_hdr_t) +             \
+                                ntohl((s)->hdr.nbytes));                \
                 }                                                       \
             }                                                           \
         }                                                               \
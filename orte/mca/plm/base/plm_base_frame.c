@@ -52,6 +52,19 @@ orte_plm_globals_t orte_plm_globals = {0};
 orte_plm_base_module_t orte_plm = {0};
 
 
+static int orte_plm_base_register(mca_base_register_flag_t flags)
+{
+    orte_plm_globals.profile = NULL;
+    (void) mca_base_var_register ("orte", "plm", "base", "profile",
+                                  "Append a JSON record of the time spent in, and bytes produced by, each "
+                                  "launch phase of every job to the named file (\"-\" for stdout)",
+                                  MCA_BASE_VAR_TYPE_STRING, NULL, 0, 0,
+                                  OPAL_INFO_LVL_9, MCA_BASE_VAR_SCOPE_READONLY,
+                                  &orte_plm_globals.profile);
+
+    return ORTE_SUCCESS;
+}
+
 static int orte_plm_base_close(void)
 {
     int rc;
@@ -88,5 +101,5 @@ static int orte_plm_base_open(mca_base_open_flag_t flags)
     return mca_base_framework_components_open(&orte_plm_base_framework, flags);
 }
 
-MCA_BASE_FRAMEWORK_DECLARE(orte, plm, NULL, NULL, orte_plm_base_open, orte_plm_base_close,
+MCA_BASE_FRAMEWORK_DECLARE(orte, plm, NULL, orte_plm_base_register, orte_plm_base_open, orte_plm_base_close,
                            mca_plm_base_static_components, 0);
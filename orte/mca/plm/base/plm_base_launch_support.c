@@ -34,6 +34,8 @@
 #include <sys/time.h>
 #endif  /* HAVE_SYS_TIME_H */
 #include <ctype.h>
+#include <errno.h>
+#include <string.h>
 
 #include "opal/hash_string.h"
 #include "opal/util/argv.h"
@@ -79,6 +81,136 @@
 #include "orte/mca/plm/base/plm_private.h"
 #include "orte/mca/plm/base/base.h"
 
+/* launch profiling - the phase boundaries are kept on each job
+ * so that jobs going thru the state machine at the same time
+ * don't mix up their timings */
+static void prof_mark(orte_job_t *jdata, orte_attribute_key_t key)
+{
+    struct timeval tv;
+
+    if (NULL == orte_plm_globals.profile) {
+        return;
+    }
+    gettimeofday(&tv, NULL);
+    orte_set_attribute(&jdata->attributes, key, ORTE_ATTR_LOCAL, &tv, OPAL_TIMEVAL);
+}
+
+/* a phase the job skipped ends where the previous one did */
+static void prof_get(orte_job_t *jdata, orte_attribute_key_t key,
+                     struct timeval *tv, struct timeval *prev)
+{
+    if (!orte_get_attribute(&jdata->attributes, key, (void**)&tv, OPAL_TIMEVAL)) {
+        *tv = *prev;
+    }
+}
+
+static double prof_usec(struct timeval *start, struct timeval *end)
+{
+    return (double)(end->tv_sec - start->tv_sec) * 1000000.0 +
+           (double)(end->tv_usec - start->tv_usec);
+}
+
+/* Time the construction of the messages the launch depends on -
+ * the nodemap, the launch msg itself, and the xcast packing of it -
+ * and append the result to the profile file. This works on copies
+ * so it can be run whether or not the job is actually launched */
+static void profile_launch(orte_job_t *jdata)
+{
+    orte_job_t *daemons;
+    orte_daemon_cmd_flag_t command;
+    opal_byte_object_t bo;
+    opal_buffer_t *buffer, *xbuf;
+    orte_grpcomm_signature_t *sig;
+    struct timeval prof_start, prof_alloc, prof_vm, prof_map;
+    struct timeval t0, t1, t2, t3, t4;
+    size_t nmbytes, lbytes, xbytes;
+    int rc;
+    FILE *fp;
+
+    if (NULL == orte_plm_globals.profile) {
+        return;
+    }
+    if (NULL == (daemons = orte_get_job_data_object(ORTE_PROC_MY_NAME->jobid))) {
+        ORTE_ERROR_LOG(ORTE_ERR_NOT_FOUND);
+        return;
+    }
+
+    gettimeofday(&t0, NULL);
+    prof_get(jdata, ORTE_JOB_PROF_START, &prof_start, &t0);
+    prof_get(jdata, ORTE_JOB_PROF_ALLOC, &prof_alloc, &prof_start);
+    prof_get(jdata, ORTE_JOB_PROF_VM, &prof_vm, &prof_alloc);
+    prof_get(jdata, ORTE_JOB_PROF_MAP, &prof_map, &prof_vm);
+    bo.bytes = NULL;
+    bo.size = 0;
+    if (ORTE_SUCCESS != (rc = orte_util_encode_nodemap(&bo, false))) {
+        ORTE_ERROR_LOG(rc);
+        return;
+    }
+    nmbytes = bo.size;
+    if (NULL != bo.bytes) {
+        free(bo.bytes);
+    }
+    gettimeofday(&t1, NULL);
+
+    buffer = OBJ_NEW(opal_buffer_t);
+    if (orte_get_attribute(&jdata->attributes, ORTE_JOB_FIXED_DVM, NULL, OPAL_BOOL)) {
+        command = ORTE_DAEMON_DVM_ADD_PROCS;
+    } else {
+        command = ORTE_DAEMON_ADD_LOCAL_PROCS;
+    }
+    if (ORTE_SUCCESS != (rc = opal_dss.pack(buffer, &command, 1, ORTE_DAEMON_CMD)) ||
+        ORTE_SUCCESS != (rc = orte_odls.get_add_procs_data(buffer, jdata->jobid))) {
+        ORTE_ERROR_LOG(rc);
+        OBJ_RELEASE(buffer);
+        return;
+    }
+    lbytes = buffer->bytes_used;
+    gettimeofday(&t2, NULL);
+
+    sig = OBJ_NEW(orte_grpcomm_signature_t);
+    sig->signature = (orte_process_name_t*)malloc(sizeof(orte_process_name_t));
+    sig->signature[0].jobid = ORTE_PROC_MY_NAME->jobid;
+    sig->signature[0].vpid = ORTE_VPID_WILDCARD;
+    sig->sz = 1;
+    xbuf = OBJ_NEW(opal_buffer_t);
+    if (ORTE_SUCCESS != (rc = orte_grpcomm_base_pack_xcast(sig, xbuf, buffer, ORTE_RML_TAG_DAEMON))) {
+        ORTE_ERROR_LOG(rc);
+    }
+    xbytes = xbuf->bytes_used;
+    OBJ_RELEASE(xbuf);
+    OBJ_RELEASE(sig);
+    OBJ_RELEASE(buffer);
+    gettimeofday(&t3, NULL);
+
+    if (0 == strcmp(orte_plm_globals.profile, "-")) {
+        fp = stdout;
+    } else if (NULL == (fp = fopen(orte_plm_globals.profile, "a"))) {
+        opal_output(0, "%s plm:base:profile could not open %s: %s",
+                    ORTE_NAME_PRINT(ORTE_PROC_MY_NAME),
+                    orte_plm_globals.profile, strerror(errno));
+        return;
+    }
+    gettimeofday(&t4, NULL);
+    fprintf(fp, "{\"jobid\": \"%s\", \"nodes\": %d, \"daemons\": %lu, \"procs\": %lu, "
+            "\"alloc_usec\": %.0f, \"vm_usec\": %.0f, \"map_usec\": %.0f, \"setup_usec\": %.0f, "
+            "\"nidmap_usec\": %.0f, \"nidmap_bytes\": %lu, "
+            "\"launch_msg_usec\": %.0f, \"launch_msg_bytes\": %lu, "
+            "\"xcast_pack_usec\": %.0f, \"xcast_bytes\": %lu, \"total_usec\": %.0f}\n",
+            ORTE_JOBID_PRINT(jdata->jobid), (int)jdata->map->num_nodes,
+            (unsigned long)daemons->num_procs, (unsigned long)jdata->num_procs,
+            prof_usec(&prof_start, &prof_alloc), prof_usec(&prof_alloc, &prof_vm),
+            prof_usec(&prof_vm, &prof_map), prof_usec(&prof_map, &t0),
+            prof_usec(&t0, &t1), (unsigned long)nmbytes,
+            prof_usec(&t1, &t2), (unsigned long)lbytes,
+            prof_usec(&t2, &t3), (unsigned long)xbytes,
+            prof_usec(&prof_start, &t4));
+    if (stdout == fp) {
+        fflush(fp);
+    } else {
+        fclose(fp);
+    }
+}
+
 void orte_plm_base_set_slots(orte_node_t *node)
 {
     if (0 == strncmp(orte_set_slots, "cores", strlen(orte_set_slots))) {
@@ -203,6 +335,8 @@ void orte_plm_base_allocation_complete(int fd, short args, void *cbdata)
 {
     orte_state_caddy_t *caddy = (orte_state_caddy_t*)cbdata;
 
+    prof_mark(caddy->jdata, ORTE_JOB_PROF_ALLOC);
+
     /* move the state machine along */
     caddy->jdata->state = ORTE_JOB_STATE_ALLOCATION_COMPLETE;
     ORTE_ACTIVATE_JOB_STATE(caddy->jdata, ORTE_JOB_STATE_LAUNCH_DAEMONS);
@@ -238,6 +372,8 @@ void orte_plm_base_vm_ready(int fd, short args, void *cbdata)
 {
     orte_state_caddy_t *caddy = (orte_state_caddy_t*)cbdata;
 
+    prof_mark(caddy->jdata, ORTE_JOB_PROF_VM);
+
     /* progress the job */
     caddy->jdata->state = ORTE_JOB_STATE_VM_READY;
 
@@ -254,6 +390,8 @@ void orte_plm_base_mapping_complete(int fd, short args, void *cbdata)
 {
     orte_state_caddy_t *caddy = (orte_state_caddy_t*)cbdata;
 
+    prof_mark(caddy->jdata, ORTE_JOB_PROF_MAP);
+
     /* move the state machine along */
     caddy->jdata->state = ORTE_JOB_STATE_MAP_COMPLETE;
     ORTE_ACTIVATE_JOB_STATE(caddy->jdata, ORTE_JOB_STATE_SYSTEM_PREP);
@@ -281,6 +419,7 @@ void orte_plm_base_setup_job(int fd, short args, void *cbdata)
     }
     /* update job state */
     caddy->jdata->state = caddy->job_state;
+    prof_mark(caddy->jdata, ORTE_JOB_PROF_START);
 
     /* start by getting a jobid */
     if (ORTE_JOBID_INVALID == caddy->jdata->jobid) {
@@ -348,6 +487,7 @@ void orte_plm_base_complete_setup(int fd, short args, void *cbdata)
 
     /* if we don't want to launch the apps, now is the time to leave */
     if (orte_do_not_launch) {
+        profile_launch(caddy->jdata);
         orte_never_launched = true;
         ORTE_FORCED_TERMINATE(0);
         OBJ_RELEASE(caddy);
@@ -491,6 +631,10 @@ static void timer_cb(int fd, short event, void *cbdata)
     }
 }
 
+/* sizing hint for the launch message - its size mostly follows
+ * the number of daemons, so it is about the same job to job */
+static opal_dss_lease_t launch_lease = OPAL_DSS_LEASE_STATIC_INIT;
+
 void orte_plm_base_launch_apps(int fd, short args, void *cbdata)
 {
     orte_job_t *jdata;
@@ -517,8 +661,10 @@ void orte_plm_base_launch_apps(int fd, short args, void *cbdata)
                          ORTE_NAME_PRINT(ORTE_PROC_MY_NAME),
                          ORTE_JOBID_PRINT(jdata->jobid)));
 
+    profile_launch(jdata);
+
     /* setup the buffer */
-    buffer = OBJ_NEW(opal_buffer_t);
+    buffer = opal_dss.lease(&launch_lease);
 
     /* pack the appropriate add_local_procs command */
     if (orte_get_attribute(&jdata->attributes, ORTE_JOB_FIXED_DVM, NULL, OPAL_BOOL)) {
@@ -1108,6 +1254,16 @@ void orte_plm_base_daemon_callback(int status, orte_process_name_t* sender,
                 uint32_t key;
                 void *nptr;
                 jdatorted->state = ORTE_JOB_STATE_DAEMONS_REPORTED;
+                if (0 != orte_plm_globals.daemonlaunchstart.tv_sec) {
+                    struct timeval now;
+                    gettimeofday(&now, NULL);
+                    opal_output_verbose(1, orte_plm_base_framework.framework_output,
+                                        "%s plm:base:orted_report_launch all %d daemons reported %.3f sec after launch start",
+                                        ORTE_NAME_PRINT(ORTE_PROC_MY_NAME), (int)jdatorted->num_procs,
+                                        (double)(now.tv_sec - orte_plm_globals.daemonlaunchstart.tv_sec) +
+                                        (double)(now.tv_usec - orte_plm_globals.daemonlaunchstart.tv_usec) / 1000000.0);
+                    orte_plm_globals.daemonlaunchstart.tv_sec = 0;
+                }
                 /* activate the daemons_reported state for all jobs
                  * whose daemons were launched
                  */
@@ -58,6 +58,8 @@ typedef struct {
     opal_buffer_t tree_spawn_cmd;
     /* daemon nodes assigned at launch */
     bool daemon_nodes_assigned_at_launch;
+    /* file to append launch profiles to */
+    char *profile;
 } orte_plm_globals_t;
 /**
  * Global instance of PLM framework data
@@ -58,6 +58,8 @@ struct orte_plm_rsh_component_t {
     int priority;
     bool no_tree_spawn;
     int num_concurrent;
+    bool adaptive;
+    int min_concurrent;
     char *agent;
     char *agent_path;
     char **agent_argv;
@@ -114,6 +114,21 @@ static int rsh_component_register(void)
                                             OPAL_INFO_LVL_5,
                                             MCA_BASE_VAR_SCOPE_READONLY,
                                             &mca_plm_rsh_component.num_concurrent);
+    mca_plm_rsh_component.adaptive = false;
+    (void) mca_base_component_var_register (c, "adaptive",
+                                            "Size the number of concurrent plm_rsh_agent instances from the observed agent completion time, "
+                                            "using num_concurrent as the upper bound",
+                                            MCA_BASE_VAR_TYPE_BOOL, NULL, 0, 0,
+                                            OPAL_INFO_LVL_5,
+                                            MCA_BASE_VAR_SCOPE_READONLY,
+                                            &mca_plm_rsh_component.adaptive);
+    mca_plm_rsh_component.min_concurrent = 8;
+    (void) mca_base_component_var_register (c, "min_concurrent",
+                                            "Initial and minimum number of concurrent plm_rsh_agent instances when plm_rsh_adaptive is set (must be > 0)",
+                                            MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                                            OPAL_INFO_LVL_5,
+                                            MCA_BASE_VAR_SCOPE_READONLY,
+                                            &mca_plm_rsh_component.min_concurrent);
 
     mca_plm_rsh_component.force_rsh = false;
     (void) mca_base_component_var_register (c, "force_rsh", "Force the launcher to always use rsh",
@@ -238,6 +253,12 @@ static int rsh_component_open(void)
                        true, mca_plm_rsh_component.num_concurrent);
         mca_plm_rsh_component.num_concurrent = 1;
     }
+    if (mca_plm_rsh_component.min_concurrent <= 0) {
+        mca_plm_rsh_component.min_concurrent = 1;
+    }
+    if (mca_plm_rsh_component.min_concurrent > mca_plm_rsh_component.num_concurrent) {
+        mca_plm_rsh_component.min_concurrent = mca_plm_rsh_component.num_concurrent;
+    }
 
     if (NULL != mca_plm_rsh_delay_string) {
         mca_plm_rsh_component.delay.tv_sec = strtol(mca_plm_rsh_delay_string, &ctmp, 10);
@@ -119,6 +119,7 @@ typedef struct {
     int argc;
     char **argv;
     orte_proc_t *daemon;
+    struct timeval launched;
 } orte_plm_rsh_caddy_t;
 static void caddy_const(orte_plm_rsh_caddy_t *ptr)
 {
@@ -178,6 +179,101 @@ static int num_in_progress=0;
 static opal_list_t launch_list;
 static opal_event_t launch_event;
 
+/* adaptive metering - the number of concurrent agents is sized
+ * from the time each agent takes to complete, i.e., for the remote
+ * daemon to start and daemonize
+ */
+static bool agents_detach=false;
+static int launch_window=0;
+static int num_since_shrink=0;
+static double base_latency=0.0;
+static double avg_latency=0.0;
+
+/* launch stage timing */
+static struct timeval launch_start;
+static int num_launched=0;
+static int num_completed=0;
+static double total_latency=0.0;
+
+static double elapsed_usec(struct timeval *start)
+{
+    struct timeval now;
+
+    gettimeofday(&now, NULL);
+    return (double)(now.tv_sec - start->tv_sec) * 1000000.0 +
+           (double)(now.tv_usec - start->tv_usec);
+}
+
+static int launch_limit(void)
+{
+    /* agents that stay attached to their daemon never complete,
+     * so there is nothing to adapt to
+     */
+    if (mca_plm_rsh_component.adaptive && agents_detach) {
+        return launch_window;
+    }
+    return mca_plm_rsh_component.num_concurrent;
+}
+
+static void start_launch_timing(void)
+{
+    /* if a prior launch is still draining, keep accumulating
+     * into the same stage counters
+     */
+    if (0 < num_in_progress || !opal_list_is_empty(&launch_list)) {
+        return;
+    }
+    gettimeofday(&launch_start, NULL);
+    num_launched = 0;
+    num_completed = 0;
+    total_latency = 0.0;
+}
+
+/* Grow the window by one for each agent that completes in about
+ * the fastest time we have seen, and halve it once the smoothed
+ * completion time doubles - at that point the agents are contending
+ * for something (local cpu, the network, the remote sshd) and more
+ * of them just makes each one slower. Only shrink once per window's
+ * worth of completions so we react to launches issued under the
+ * current window rather than the previous one.
+ */
+static void update_launch_window(double latency)
+{
+    if (0.0 == base_latency || latency < base_latency) {
+        base_latency = latency;
+    }
+    if (0.0 == avg_latency) {
+        avg_latency = latency;
+    } else {
+        avg_latency = 0.875 * avg_latency + 0.125 * latency;
+    }
+    ++num_since_shrink;
+
+    if (avg_latency > 2.0 * base_latency) {
+        if (num_since_shrink >= launch_window &&
+            launch_window > mca_plm_rsh_component.min_concurrent) {
+            launch_window /= 2;
+            if (launch_window < mca_plm_rsh_component.min_concurrent) {
+                launch_window = mca_plm_rsh_component.min_concurrent;
+            }
+            num_since_shrink = 0;
+        } else if (launch_window == mca_plm_rsh_component.min_concurrent) {
+            /* this is as gentle as we get, so whatever we see
+             * here is the uncontended time for this cluster
+             */
+            base_latency = avg_latency;
+        }
+    } else if (avg_latency < 1.5 * base_latency &&
+               launch_window < mca_plm_rsh_component.num_concurrent) {
+        ++launch_window;
+    }
+
+    OPAL_OUTPUT_VERBOSE((2, orte_plm_base_framework.framework_output,
+                         "%s plm:rsh: agent completed in %.3f msec (avg %.3f base %.3f) window %d",
+                         ORTE_NAME_PRINT(ORTE_PROC_MY_NAME), latency / 1000.0,
+                         avg_latency / 1000.0, base_latency / 1000.0, launch_window));
+}
+
 /**
  * Init the module
  */
@@ -193,6 +289,7 @@ static int rsh_init(void)
     }
 
     /* setup the event for metering the launch */
+    launch_window = mca_plm_rsh_component.min_concurrent;
     OBJ_CONSTRUCT(&launch_list, opal_list_t);
     opal_event_set(orte_event_base, &launch_event, -1, 0, process_launch_list, NULL);
     opal_event_set_priority(&launch_event, ORTE_SYS_PRI);
@@ -215,6 +312,7 @@ static void rsh_wait_daemon(orte_proc_t *daemon, void* cbdata)
 {
     orte_job_t *jdata;
     orte_plm_rsh_caddy_t *caddy=(orte_plm_rsh_caddy_t*)cbdata;
+    double latency;
 
     if (orte_orteds_term_ordered || orte_abnormal_term_ordered) {
         /* ignore any such report - it will occur if we left the
@@ -263,11 +361,26 @@ static void rsh_wait_daemon(orte_proc_t *daemon, void* cbdata)
             /* report that the daemon has failed so we can exit */
             ORTE_ACTIVATE_PROC_STATE(&daemon->name, ORTE_PROC_STATE_FAILED_TO_START);
         }
+    } else {
+        latency = elapsed_usec(&caddy->launched);
+        total_latency += latency;
+        if (mca_plm_rsh_component.adaptive) {
+            update_launch_window(latency);
+        }
+    }
+
+    ++num_completed;
+    if (num_completed == num_launched && opal_list_is_empty(&launch_list)) {
+        opal_output_verbose(1, orte_plm_base_framework.framework_output,
+                            "%s plm:rsh: %d agents completed %.3f sec after launch start (mean agent time %.3f msec)",
+                            ORTE_NAME_PRINT(ORTE_PROC_MY_NAME), num_completed,
+                            elapsed_usec(&launch_start) / 1000000.0,
+                            total_latency / 1000.0 / (double)num_completed);
     }
 
     /* release any delay */
     --num_in_progress;
-    if (num_in_progress < mca_plm_rsh_component.num_concurrent) {
+    if (num_in_progress < launch_limit()) {
         /* trigger continuation of the launch */
         opal_event_active(&launch_event, EV_WRITE, 1);
     }
@@ -554,6 +667,7 @@ static int setup_launch(int *argcptr, char ***argvptr,
         ((!mca_plm_rsh_component.using_llspawn) ||
          (mca_plm_rsh_component.using_llspawn && mca_plm_rsh_component.daemonize_llspawn))) {
         opal_argv_append(&argc, &argv, "--daemonize");
+        agents_detach = true;
     }
 
     /*
@@ -747,6 +861,7 @@ static int remote_spawn(opal_buffer_t *launch)
     OPAL_OUTPUT_VERBOSE((1, orte_plm_base_framework.framework_output,
                          "%s plm:rsh: remote spawn called",
                          ORTE_NAME_PRINT(ORTE_PROC_MY_NAME)));
+    start_launch_timing();
 
     /* if we hit any errors, tell the HNP it was us */
     target.vpid = ORTE_PROC_MY_NAME->vpid;
@@ -895,8 +1010,9 @@ static void process_launch_list(int fd, short args, void *cbdata)
     opal_list_item_t *item;
     pid_t pid;
     orte_plm_rsh_caddy_t *caddy;
+    int nstarted = 0;
 
-    while (num_in_progress < mca_plm_rsh_component.num_concurrent) {
+    while (num_in_progress < launch_limit()) {
         item = opal_list_remove_first(&launch_list);
         if (NULL == item) {
             /* we are done */
@@ -907,6 +1023,7 @@ static void process_launch_list(int fd, short args, void *cbdata)
         ORTE_FLAG_SET(caddy->daemon, ORTE_PROC_FLAG_ALIVE);
         orte_wait_cb(caddy->daemon, rsh_wait_daemon, (void*)caddy);
 
+        gettimeofday(&caddy->launched, NULL);
         /* fork a child to exec the rsh/ssh session */
         pid = fork();
         if (pid < 0) {
@@ -930,8 +1047,17 @@ static void process_launch_list(int fd, short args, void *cbdata)
                                  ORTE_NAME_PRINT(ORTE_PROC_MY_NAME),
                                  ORTE_NAME_PRINT(&(caddy->daemon->name))));
             num_in_progress++;
+            num_launched++;
+            nstarted++;
         }
     }
+
+    if (0 < nstarted && opal_list_is_empty(&launch_list)) {
+        opal_output_verbose(1, orte_plm_base_framework.framework_output,
+                            "%s plm:rsh: all %d agents started %.3f sec after launch start",
+                            ORTE_NAME_PRINT(ORTE_PROC_MY_NAME), num_launched,
+                            elapsed_usec(&launch_start) / 1000000.0);
+    }
 }
 
 static void launch_daemons(int fd, short args, void *cbdata)
@@ -1006,6 +1132,8 @@ static void launch_daemons(int fd, short args, void *cbdata)
     OPAL_OUTPUT_VERBOSE((1, orte_plm_base_framework.framework_output,
                          "%s plm:rsh: launching vm",
                          ORTE_NAME_PRINT(ORTE_PROC_MY_NAME)));
+    start_launch_timing();
+    orte_plm_globals.daemonlaunchstart = launch_start;
 
     if ((0 < opal_output_get_verbosity(orte_plm_base_framework.framework_output) ||
          orte_leave_session_attached) &&
@@ -1211,6 +1339,12 @@ static void launch_daemons(int fd, short args, void *cbdata)
     /* set the job state to indicate the daemons are launched */
     state->jdata->state = ORTE_JOB_STATE_DAEMONS_LAUNCHED;
 
+    opal_output_verbose(1, orte_plm_base_framework.framework_output,
+                        "%s plm:rsh: launch list of %d agents built in %.3f sec",
+                        ORTE_NAME_PRINT(ORTE_PROC_MY_NAME),
+                        (int)opal_list_get_size(&launch_list),
+                        elapsed_usec(&launch_start) / 1000000.0);
+
     /* trigger the event to start processing the launch list */
     OPAL_OUTPUT_VERBOSE((1, orte_plm_base_framework.framework_output,
                          "%s plm:rsh: activating launch event",
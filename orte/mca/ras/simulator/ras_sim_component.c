@@ -66,9 +66,9 @@ static int ras_sim_register(void)
 {
     mca_base_component_t *component = &mca_ras_simulator_component.super.base_version;
 
-    mca_ras_simulator_component.slots = "1";
+    mca_ras_simulator_component.slots = "0";
     (void) mca_base_component_var_register (component, "slots",
-                                            "Comma-separated list of number of slots on each node to simulate",
+                                            "Comma-separated list of number of slots on each node to simulate (0 = number of pus in the topology)",
                                             MCA_BASE_VAR_TYPE_STRING, NULL, 0, 0,
                                             OPAL_INFO_LVL_9,
                                             MCA_BASE_VAR_SCOPE_READONLY,
@@ -76,7 +76,7 @@ static int ras_sim_register(void)
 
     mca_ras_simulator_component.slots_max = "0";
     (void) mca_base_component_var_register (component, "max_slots",
-                                            "Comma-separated list of number of max slots on each node to simulate",
+                                            "Comma-separated list of number of max slots on each node to simulate (0 = unlimited)",
                                             MCA_BASE_VAR_TYPE_STRING, NULL, 0, 0,
                                             OPAL_INFO_LVL_9,
                                             MCA_BASE_VAR_SCOPE_READONLY,
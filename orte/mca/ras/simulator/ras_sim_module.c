@@ -76,8 +76,8 @@ static int allocate(orte_job_t *jdata, opal_list_t *nodes)
     if (NULL != mca_ras_simulator_component.slots_max) {
         max_slot_cnt = opal_argv_split(mca_ras_simulator_component.slots_max, ',');
         /* backfill the max_slot_cnt as reqd */
-        tmp = max_slot_cnt[opal_argv_count(slot_cnt)-1];
-        for (n=opal_argv_count(max_slot_cnt); n < opal_argv_count(max_slot_cnt); n++) {
+        tmp = max_slot_cnt[opal_argv_count(max_slot_cnt)-1];
+        for (n=opal_argv_count(max_slot_cnt); n < opal_argv_count(node_cnt); n++) {
             opal_argv_append_nosize(&max_slot_cnt, tmp);
         }
     }
@@ -254,15 +254,16 @@ static int allocate(orte_job_t *jdata, opal_list_t *nodes)
             asprintf(&node->name, "%s%0*d", prefix, dig, i);
             node->state = ORTE_NODE_STATE_UP;
             node->slots_inuse = 0;
+            /* a max of zero means unlimited, and a slot count of
+             * zero means use the number of pus in the topology */
             if (NULL == max_slot_cnt || NULL == max_slot_cnt[n]) {
                 node->slots_max = 0;
             } else {
-                obj = hwloc_get_root_obj(topo);
-                node->slots_max = opal_hwloc_base_get_npus(topo, obj);
+                node->slots_max = strtol(max_slot_cnt[n], NULL, 10);
             }
             if (NULL == slot_cnt || NULL == slot_cnt[n]) {
                 node->slots = 0;
-            } else {
+            } else if (0 == (node->slots = strtol(slot_cnt[n], NULL, 10))) {
                 obj = hwloc_get_root_obj(topo);
                 node->slots = opal_hwloc_base_get_npus(topo, obj);
             }
@@ -46,6 +46,7 @@
 #include "orte/mca/mca.h"
 #include "opal/util/timings.h"
 #include "opal/class/opal_pointer_array.h"
+#include "opal/class/opal_hash_table.h"
 
 #include "orte/runtime/orte_globals.h"
 
@@ -99,8 +100,7 @@ OBJ_CLASS_DECLARATION(orte_rml_base_active_t);
 /* a global struct containing framework-level values */
 typedef struct {
     opal_list_t actives;  /* list to hold the active plugins */
-    opal_list_t posted_recvs;
-    opal_list_t unmatched_msgs;
+    opal_hash_table_t recvs;  /* orte_rml_tag_index_t for each tag */
 #if OPAL_ENABLE_TIMING
     bool timing;
 #endif
@@ -170,6 +170,7 @@ typedef struct {
     orte_rml_tag_t tag;          // targeted tag
     uint32_t seq_num;             //sequence number
     struct iovec iov;            // the recvd data
+    opal_buffer_t *shared;       // buffer holding the data if it is shared with other users
 } orte_rml_recv_t;
 OBJ_CLASS_DECLARATION(orte_rml_recv_t);
 
@@ -187,6 +188,20 @@ typedef struct {
 } orte_rml_posted_recv_t;
 OBJ_CLASS_DECLARATION(orte_rml_posted_recv_t);
 
+/* posted recvs and unmatched msgs for a given tag. Matching only
+ * ever considers a single tag, so indexing by tag confines the
+ * search to the few recvs posted on it, and the per-sender count
+ * lets a recv for a specific peer skip the unmatched msgs when
+ * nothing from that peer is waiting */
+typedef struct {
+    opal_object_t super;
+    orte_rml_tag_t tag;
+    opal_list_t posted_recvs;
+    opal_list_t unmatched_msgs;
+    opal_hash_table_t senders;  // number of unmatched msgs from each sender
+} orte_rml_tag_index_t;
+OBJ_CLASS_DECLARATION(orte_rml_tag_index_t);
+
 /* define an object for transferring recv requests to the list of posted recvs */
 typedef struct {
     opal_object_t super;
@@ -218,6 +233,36 @@ OBJ_CLASS_DECLARATION(orte_rml_recv_request_t);
         opal_event_active(&msg->ev, OPAL_EV_WRITE, 1);                  \
     } while(0);
 
+/* post a message for local delivery whose data lives in a buffer
+ * that is also in use elsewhere - e.g., being relayed to other procs.
+ * The message retains the buffer rather than copying the data, and
+ * is delivered starting at the given location within it. As the
+ * recipient must never be able to take ownership of the shared
+ * memory, the location must lie beyond the start of the buffer */
+#define ORTE_RML_POST_SHARED_MESSAGE(p, t, s, b, ptr)                   \
+    do {                                                                \
+        orte_rml_recv_t *msg;                                           \
+        opal_output_verbose(5, orte_rml_base_framework.framework_output, \
+                            "%s Shared message posted at %s:%d",        \
+                            ORTE_NAME_PRINT(ORTE_PROC_MY_NAME),         \
+                            __FILE__, __LINE__);                        \
+        msg = OBJ_NEW(orte_rml_recv_t);                                 \
+        msg->sender.jobid = (p)->jobid;                                 \
+        msg->sender.vpid = (p)->vpid;                                   \
+        msg->tag = (t);                                                 \
+        msg->seq_num = (s);                                             \
+        OBJ_RETAIN((b));                                                \
+        msg->shared = (b);                                              \
+        msg->iov.iov_base = (IOVBASE_TYPE*)(ptr);                       \
+        msg->iov.iov_len = (b)->bytes_used - ((char*)(ptr) - (b)->base_ptr); \
+        /* setup the event */                                           \
+        opal_event_set(orte_event_base, &msg->ev, -1,                   \
+                       OPAL_EV_WRITE,                                   \
+                       orte_rml_base_process_msg, msg);                 \
+        opal_event_set_priority(&msg->ev, ORTE_MSG_PRI);                \
+        opal_event_active(&msg->ev, OPAL_EV_WRITE, 1);                  \
+    } while(0);
+
 #define ORTE_RML_ACTIVATE_MESSAGE(m)                            \
     do {                                                        \
         /* setup the event */                                   \
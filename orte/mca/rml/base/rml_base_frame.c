@@ -82,8 +82,19 @@ static int orte_rml_base_register(mca_base_register_flag_t flags)
 static void cleanup(int sd, short args, void *cbdata)
 {
     volatile bool *active = (volatile bool*)cbdata;
-
-    OPAL_LIST_DESTRUCT(&orte_rml_base.posted_recvs);
+    orte_rml_tag_index_t *idx;
+    uint32_t key;
+    void *node;
+    int rc;
+
+    rc = opal_hash_table_get_first_key_uint32(&orte_rml_base.recvs, &key,
+                                              (void**)&idx, &node);
+    while (OPAL_SUCCESS == rc) {
+        OBJ_RELEASE(idx);
+        rc = opal_hash_table_get_next_key_uint32(&orte_rml_base.recvs, &key,
+                                                 (void**)&idx, node, &node);
+    }
+    OBJ_DESTRUCT(&orte_rml_base.recvs);
     if (NULL != active) {
         *active = false;
     }
@@ -131,8 +142,8 @@ static int orte_rml_base_open(mca_base_open_flag_t flags)
     /* Initialize globals */
     /* construct object for holding the active plugin modules */
     OBJ_CONSTRUCT(&orte_rml_base.actives, opal_list_t);
-    OBJ_CONSTRUCT(&orte_rml_base.posted_recvs, opal_list_t);
-    OBJ_CONSTRUCT(&orte_rml_base.unmatched_msgs, opal_list_t);
+    OBJ_CONSTRUCT(&orte_rml_base.recvs, opal_hash_table_t);
+    opal_hash_table_init(&orte_rml_base.recvs, 64);
 
     OPAL_TIMING_INIT(&tm_rml);
     /* Open up all available components */
@@ -275,10 +286,14 @@ static void recv_cons(orte_rml_recv_t *ptr)
 {
     ptr->iov.iov_base = NULL;
     ptr->iov.iov_len = 0;
+    ptr->shared = NULL;
 }
 static void recv_des(orte_rml_recv_t *ptr)
 {
-    if (NULL != ptr->iov.iov_base) {
+    if (NULL != ptr->shared) {
+        /* the data belongs to the shared buffer */
+        OBJ_RELEASE(ptr->shared);
+    } else if (NULL != ptr->iov.iov_base) {
         free(ptr->iov.iov_base);
     }
 }
@@ -306,6 +321,24 @@ OBJ_CLASS_INSTANCE(orte_rml_posted_recv_t,
                    opal_list_item_t,
                    prcv_cons, NULL);
 
+static void tidx_cons(orte_rml_tag_index_t *ptr)
+{
+    ptr->tag = ORTE_RML_TAG_INVALID;
+    OBJ_CONSTRUCT(&ptr->posted_recvs, opal_list_t);
+    OBJ_CONSTRUCT(&ptr->unmatched_msgs, opal_list_t);
+    OBJ_CONSTRUCT(&ptr->senders, opal_hash_table_t);
+    opal_hash_table_init(&ptr->senders, 32);
+}
+static void tidx_des(orte_rml_tag_index_t *ptr)
+{
+    OPAL_LIST_DESTRUCT(&ptr->posted_recvs);
+    OPAL_LIST_DESTRUCT(&ptr->unmatched_msgs);
+    OBJ_DESTRUCT(&ptr->senders);
+}
+OBJ_CLASS_INSTANCE(orte_rml_tag_index_t,
+                   opal_object_t,
+                   tidx_cons, tidx_des);
+
 static void prq_cons(orte_rml_recv_request_t *ptr)
 {
     ptr->cancel = false;
@@ -37,6 +37,7 @@
 #include "opal/util/output.h"
 #include "opal/util/timings.h"
 #include "opal/class/opal_list.h"
+#include "opal/class/opal_hash_table.h"
 
 #include "orte/mca/errmgr/errmgr.h"
 #include "orte/runtime/orte_globals.h"
@@ -48,7 +49,52 @@
 #include "orte/mca/rml/base/rml_contact.h"
 
 
-static void msg_match_recv(orte_rml_posted_recv_t *rcv, bool get_all);
+static void msg_match_recv(orte_rml_tag_index_t *idx,
+                           orte_rml_posted_recv_t *rcv, bool get_all);
+
+/* return the index of recvs/msgs for the given tag, creating
+ * it if requested */
+static orte_rml_tag_index_t* get_tag_index(orte_rml_tag_t tag, bool create)
+{
+    orte_rml_tag_index_t *idx;
+
+    if (OPAL_SUCCESS == opal_hash_table_get_value_uint32(&orte_rml_base.recvs,
+                                                         tag, (void**)&idx)) {
+        return idx;
+    }
+    if (!create) {
+        return NULL;
+    }
+    idx = OBJ_NEW(orte_rml_tag_index_t);
+    idx->tag = tag;
+    opal_hash_table_set_value_uint32(&orte_rml_base.recvs, tag, idx);
+    return idx;
+}
+
+/* track the number of unmatched msgs from a sender */
+static size_t adjust_sender_count(orte_rml_tag_index_t *idx,
+                                  orte_process_name_t *sender,
+                                  int delta)
+{
+    uint64_t key;
+    void *value;
+    size_t count = 0;
+
+    memcpy(&key, sender, sizeof(key));
+    if (OPAL_SUCCESS == opal_hash_table_get_value_uint64(&idx->senders, key, &value)) {
+        count = (size_t)(uintptr_t)value;
+    }
+    if (0 == delta) {
+        return count;
+    }
+    count += delta;
+    if (0 == count) {
+        opal_hash_table_remove_value_uint64(&idx->senders, key);
+    } else {
+        opal_hash_table_set_value_uint64(&idx->senders, key, (void*)(uintptr_t)count);
+    }
+    return count;
+}
 
 
 void orte_rml_base_post_recv(int sd, short args, void *cbdata)
@@ -56,6 +102,7 @@ void orte_rml_base_post_recv(int sd, short args, void *cbdata)
     orte_rml_recv_request_t *req = (orte_rml_recv_request_t*)cbdata;
     orte_rml_posted_recv_t *post, *recv;
     orte_ns_cmp_bitmask_t mask = ORTE_NS_CMP_ALL | ORTE_NS_CMP_WILD;
+    orte_rml_tag_index_t *idx;
 
     opal_output_verbose(5, orte_rml_base_framework.framework_output,
                         "%s posting recv",
@@ -74,7 +121,11 @@ void orte_rml_base_post_recv(int sd, short args, void *cbdata)
      * and remove it from our list
      */
     if (req->cancel) {
-        OPAL_LIST_FOREACH(recv, &orte_rml_base.posted_recvs, orte_rml_posted_recv_t) {
+        if (NULL == (idx = get_tag_index(post->tag, false))) {
+            OBJ_RELEASE(req);
+            return;
+        }
+        OPAL_LIST_FOREACH(recv, &idx->posted_recvs, orte_rml_posted_recv_t) {
             if (OPAL_EQUAL == orte_util_compare_name_fields(mask, &post->peer, &recv->peer) &&
                 post->tag == recv->tag) {
                 opal_output_verbose(5, orte_rml_base_framework.framework_output,
@@ -82,7 +133,7 @@ void orte_rml_base_post_recv(int sd, short args, void *cbdata)
                                     ORTE_NAME_PRINT(ORTE_PROC_MY_NAME),
                                     post->tag, ORTE_NAME_PRINT(&recv->peer));
                 /* got a match - remove it */
-                opal_list_remove_item(&orte_rml_base.posted_recvs, &recv->super);
+                opal_list_remove_item(&idx->posted_recvs, &recv->super);
                 OBJ_RELEASE(recv);
                 break;
             }
@@ -92,7 +143,8 @@ void orte_rml_base_post_recv(int sd, short args, void *cbdata)
     }
 
     /* bozo check - cannot have two receives for the same peer/tag combination */
-    OPAL_LIST_FOREACH(recv, &orte_rml_base.posted_recvs, orte_rml_posted_recv_t) {
+    idx = get_tag_index(post->tag, true);
+    OPAL_LIST_FOREACH(recv, &idx->posted_recvs, orte_rml_posted_recv_t) {
         if (OPAL_EQUAL == orte_util_compare_name_fields(mask, &post->peer, &recv->peer) &&
             post->tag == recv->tag) {
             opal_output(0, "%s TWO RECEIVES WITH SAME PEER %s AND TAG %d - ABORTING",
@@ -108,10 +160,10 @@ void orte_rml_base_post_recv(int sd, short args, void *cbdata)
                         (post->persistent) ? "persistent" : "non-persistent",
                         post->tag, ORTE_NAME_PRINT(&post->peer));
     /* add it to the list of recvs */
-    opal_list_append(&orte_rml_base.posted_recvs, &post->super);
+    opal_list_append(&idx->posted_recvs, &post->super);
     req->post = NULL;
     /* handle any messages that may have already arrived for this recv */
-    msg_match_recv(post, post->persistent);
+    msg_match_recv(idx, post, post->persistent);
 
     /* cleanup */
     OBJ_RELEASE(req);
@@ -123,15 +175,44 @@ void orte_rml_base_complete_recv_msg (orte_rml_recv_t **recv_msg)
     orte_ns_cmp_bitmask_t mask = ORTE_NS_CMP_ALL | ORTE_NS_CMP_WILD;
     opal_buffer_t buf;
     orte_rml_recv_t *msg = *recv_msg;
-    /* see if we have a waiting recv for this message */
-    OPAL_LIST_FOREACH(post, &orte_rml_base.posted_recvs, orte_rml_posted_recv_t) {
+    orte_rml_tag_index_t *idx;
+    opal_buffer_t *shared;
+    void *ptr;
+
+    /* see if we have a waiting recv for this message - only
+     * those posted on its tag need be considered */
+    idx = get_tag_index(msg->tag, true);
+    OPAL_LIST_FOREACH(post, &idx->posted_recvs, orte_rml_posted_recv_t) {
         /* since names could include wildcards, must use
          * the more generalized comparison function
          */
-        if (OPAL_EQUAL == orte_util_compare_name_fields(mask, &msg->sender, &post->peer) &&
-            msg->tag == post->tag) {
+        if (OPAL_EQUAL == orte_util_compare_name_fields(mask, &msg->sender, &post->peer)) {
             /* deliver the data to this location */
-            if (post->buffer_data) {
+            if (NULL != msg->shared && !post->buffer_data) {
+                /* the recipient of an iovec may take ownership of
+                 * the data, so give it a private copy */
+                shared = msg->shared;
+                msg->shared = NULL;
+                ptr = msg->iov.iov_base;
+                msg->iov.iov_base = NULL;
+                if (0 < msg->iov.iov_len) {
+                    msg->iov.iov_base = (IOVBASE_TYPE*)malloc(msg->iov.iov_len);
+                    memcpy(msg->iov.iov_base, ptr, msg->iov.iov_len);
+                }
+                OBJ_RELEASE(shared);
+            }
+            if (post->buffer_data && NULL != msg->shared) {
+                /* deliver the shared data in place - the buffer starts
+                 * before the data, so the recipient can only copy it */
+                OBJ_CONSTRUCT(&buf, opal_buffer_t);
+                opal_dss.load(&buf, msg->shared->base_ptr, msg->shared->bytes_used);
+                buf.unpack_ptr = (char*)msg->iov.iov_base;
+                msg->iov.iov_base = NULL;
+                post->cbfunc.buffer(ORTE_SUCCESS, &msg->sender, &buf, msg->tag, post->cbdata);
+                /* protect the shared data */
+                buf.base_ptr = NULL;
+                OBJ_DESTRUCT(&buf);
+            } else if (post->buffer_data) {
                 /* deliver it in a buffer */
                 OBJ_CONSTRUCT(&buf, opal_buffer_t);
                 opal_dss.load(&buf, msg->iov.iov_base, msg->iov.iov_len);
@@ -163,7 +244,7 @@ void orte_rml_base_complete_recv_msg (orte_rml_recv_t **recv_msg)
                                  post->tag));
             /* if the recv is non-persistent, remove it */
             if (!post->persistent) {
-                opal_list_remove_item(&orte_rml_base.posted_recvs, &post->super);
+                opal_list_remove_item(&idx->posted_recvs, &post->super);
                 /*OPAL_OUTPUT_VERBOSE((5, orte_rml_base_framework.framework_output,
                                      "%s non persistent recv %p remove success releasing now",
                                      ORTE_NAME_PRINT(ORTE_PROC_MY_NAME),
@@ -182,21 +263,31 @@ void orte_rml_base_complete_recv_msg (orte_rml_recv_t **recv_msg)
                             ORTE_NAME_PRINT(ORTE_PROC_MY_NAME),
                             ORTE_NAME_PRINT(&msg->sender),
                             msg->tag));
-     opal_list_append(&orte_rml_base.unmatched_msgs, &msg->super);
+     opal_list_append(&idx->unmatched_msgs, &msg->super);
+     adjust_sender_count(idx, &msg->sender, 1);
 }
 
-static void msg_match_recv(orte_rml_posted_recv_t *rcv, bool get_all)
+static void msg_match_recv(orte_rml_tag_index_t *idx,
+                           orte_rml_posted_recv_t *rcv, bool get_all)
 {
     opal_list_item_t *item, *next;
     orte_rml_recv_t *msg;
     orte_ns_cmp_bitmask_t mask = ORTE_NS_CMP_ALL | ORTE_NS_CMP_WILD;
 
+    /* if the recv names a specific peer and nothing from that
+     * peer is waiting, then there is nothing to scan */
+    if (ORTE_JOBID_WILDCARD != rcv->peer.jobid &&
+        ORTE_VPID_WILDCARD != rcv->peer.vpid &&
+        0 == adjust_sender_count(idx, &rcv->peer, 0)) {
+        return;
+    }
+
     /* scan thru the list of unmatched recvd messages and
      * see if any matches this spec - if so, push the first
      * into the recvd msg queue and look no further
      */
-    item = opal_list_get_first(&orte_rml_base.unmatched_msgs);
-    while (item != opal_list_get_end(&orte_rml_base.unmatched_msgs)) {
+    item = opal_list_get_first(&idx->unmatched_msgs);
+    while (item != opal_list_get_end(&idx->unmatched_msgs)) {
         next = opal_list_get_next(item);
         msg = (orte_rml_recv_t*)item;
         opal_output_verbose(5, orte_rml_base_framework.framework_output,
@@ -208,10 +299,10 @@ static void msg_match_recv(orte_rml_posted_recv_t *rcv, bool get_all)
         /* since names could include wildcards, must use
          * the more generalized comparison function
          */
-        if (OPAL_EQUAL == orte_util_compare_name_fields(mask, &msg->sender, &rcv->peer) &&
-            msg->tag == rcv->tag) {
+        if (OPAL_EQUAL == orte_util_compare_name_fields(mask, &msg->sender, &rcv->peer)) {
+            opal_list_remove_item(&idx->unmatched_msgs, item);
+            adjust_sender_count(idx, &msg->sender, -1);
             ORTE_RML_REACTIVATE_MESSAGE(msg);
-            opal_list_remove_item(&orte_rml_base.unmatched_msgs, item);
             if (!get_all) {
                 break;
             }
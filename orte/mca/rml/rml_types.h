@@ -163,6 +163,12 @@ BEGIN_C_DECLS
 /* error notifications */
 #define ORTE_RML_TAG_NOTIFICATION           59
 
+/* scalable overlay networks */
+#define ORTE_RML_TAG_SCON                   60
+
+/* pipelined xcast of large messages */
+#define ORTE_RML_TAG_XCAST_CHUNK            61
+
 #define ORTE_RML_TAG_MAX                   100
 
 /*** RML OFI keys ***/
@@ -13,7 +13,10 @@
 #include "orte_config.h"
 #include "orte/constants.h"
 
+#include <limits.h>
+
 #include "opal/class/opal_list.h"
+#include "opal/class/opal_pointer_array.h"
 #include "opal/mca/event/event.h"
 #include "opal/mca/pmix/pmix.h"
 
@@ -28,78 +31,145 @@
 #include "orte/mca/state/base/base.h"
 #include "orte/mca/state/base/state_private.h"
 
-void orte_state_base_activate_job_state(orte_job_t *jdata,
-                                        orte_job_state_t state)
+/* The state machines are kept in the orte_job_states and
+ * orte_proc_states lists so they can be printed and torn
+ * down by the components, but activations look up their
+ * entry directly by state value. Each index holds its own
+ * reference to the entries it points at */
+static bool index_init = false;
+static opal_pointer_array_t job_index;
+static opal_pointer_array_t proc_index;
+static orte_state_t *job_any = NULL;
+static orte_state_t *proc_any = NULL;
+
+static void index_setup(void)
 {
-    opal_list_item_t *itm, *any=NULL, *error=NULL;
-    orte_state_t *s;
-    orte_state_caddy_t *caddy;
+    if (index_init) {
+        return;
+    }
+    OBJ_CONSTRUCT(&job_index, opal_pointer_array_t);
+    opal_pointer_array_init(&job_index, ORTE_JOB_STATE_DYNAMIC, INT_MAX, 16);
+    OBJ_CONSTRUCT(&proc_index, opal_pointer_array_t);
+    opal_pointer_array_init(&proc_index, ORTE_PROC_STATE_DYNAMIC, INT_MAX, 16);
+    index_init = true;
+}
 
-    for (itm = opal_list_get_first(&orte_job_states);
-         itm != opal_list_get_end(&orte_job_states);
-         itm = opal_list_get_next(itm)) {
-        s = (orte_state_t*)itm;
-        if (s->job_state == ORTE_JOB_STATE_ANY) {
-            /* save this place */
-            any = itm;
-        }
-        if (s->job_state == ORTE_JOB_STATE_ERROR) {
-            error = itm;
+static void index_set(opal_pointer_array_t *idx, orte_state_t **any,
+                      bool is_any, int state, orte_state_t *st)
+{
+    orte_state_t *old;
+
+    index_setup();
+    if (is_any) {
+        old = *any;
+        *any = st;
+    } else {
+        old = (orte_state_t*)opal_pointer_array_get_item(idx, state);
+        opal_pointer_array_set_item(idx, state, st);
+    }
+    if (NULL != st) {
+        OBJ_RETAIN(st);
+    }
+    if (NULL != old) {
+        OBJ_RELEASE(old);
+    }
+}
+
+static orte_state_t* index_get(opal_pointer_array_t *idx, int state)
+{
+    if (!index_init || state < 0) {
+        return NULL;
+    }
+    return (orte_state_t*)opal_pointer_array_get_item(idx, state);
+}
+
+void orte_state_base_clear_index(void)
+{
+    int i;
+    orte_state_t *st;
+
+    if (!index_init) {
+        return;
+    }
+    for (i=0; i < job_index.size; i++) {
+        if (NULL != (st = (orte_state_t*)opal_pointer_array_get_item(&job_index, i))) {
+            OBJ_RELEASE(st);
         }
-        if (s->job_state == state) {
-            OPAL_OUTPUT_VERBOSE((1, orte_state_base_framework.framework_output,
-                                 "%s ACTIVATING JOB %s STATE %s PRI %d",
-                                 ORTE_NAME_PRINT(ORTE_PROC_MY_NAME),
-                                 (NULL == jdata) ? "NULL" : ORTE_JOBID_PRINT(jdata->jobid),
-                                 orte_job_state_to_str(state), s->priority));
-            if (NULL == s->cbfunc) {
-                OPAL_OUTPUT_VERBOSE((1, orte_state_base_framework.framework_output,
-                                     "%s NULL CBFUNC FOR JOB %s STATE %s",
-                                     ORTE_NAME_PRINT(ORTE_PROC_MY_NAME),
-                                     (NULL == jdata) ? "ALL" : ORTE_JOBID_PRINT(jdata->jobid),
-                                     orte_job_state_to_str(state)));
-                return;
-            }
-            caddy = OBJ_NEW(orte_state_caddy_t);
-            if (NULL != jdata) {
-                caddy->jdata = jdata;
-                caddy->job_state = state;
-                OBJ_RETAIN(jdata);
-            }
-            opal_event_set(orte_event_base, &caddy->ev, -1, OPAL_EV_WRITE, s->cbfunc, caddy);
-            opal_event_set_priority(&caddy->ev, s->priority);
-            opal_event_active(&caddy->ev, OPAL_EV_WRITE, 1);
-            return;
+    }
+    OBJ_DESTRUCT(&job_index);
+    for (i=0; i < proc_index.size; i++) {
+        if (NULL != (st = (orte_state_t*)opal_pointer_array_get_item(&proc_index, i))) {
+            OBJ_RELEASE(st);
         }
     }
-    /* if we get here, then the state wasn't found, so execute
-     * the default handler if it is defined
-     */
-    if (ORTE_JOB_STATE_ERROR < state && NULL != error) {
-        s = (orte_state_t*)error;
-    } else if (NULL != any) {
-        s = (orte_state_t*)any;
+    OBJ_DESTRUCT(&proc_index);
+    if (NULL != job_any) {
+        OBJ_RELEASE(job_any);
+        job_any = NULL;
+    }
+    if (NULL != proc_any) {
+        OBJ_RELEASE(proc_any);
+        proc_any = NULL;
+    }
+    index_init = false;
+}
+
+#define JOB_INDEX_SET(s, st)                                            \
+    index_set(&job_index, &job_any, ORTE_JOB_STATE_ANY == (s), (int)(s), (st))
+#define PROC_INDEX_SET(s, st)                                           \
+    index_set(&proc_index, &proc_any, ORTE_PROC_STATE_ANY == (s), (int)(s), (st))
+
+orte_state_t* orte_state_base_lookup_job_state(orte_job_state_t state)
+{
+    orte_state_t *s;
+
+    if (ORTE_JOB_STATE_ANY == state) {
+        s = job_any;
     } else {
+        s = index_get(&job_index, state);
+    }
+    if (NULL != s) {
+        return s;
+    }
+    /* the state wasn't found, so use the default
+     * handler if it is defined */
+    if (ORTE_JOB_STATE_ERROR < state &&
+        NULL != (s = index_get(&job_index, ORTE_JOB_STATE_ERROR))) {
+        return s;
+    }
+    return job_any;
+}
+
+void orte_state_base_activate_job_state(orte_job_t *jdata,
+                                        orte_job_state_t state)
+{
+    orte_state_t *s;
+    orte_state_caddy_t *caddy;
+
+    if (NULL == (s = orte_state_base_lookup_job_state(state))) {
         OPAL_OUTPUT_VERBOSE((1, orte_state_base_framework.framework_output,
                              "ACTIVATE: ANY STATE NOT FOUND"));
         return;
     }
     if (NULL == s->cbfunc) {
         OPAL_OUTPUT_VERBOSE((1, orte_state_base_framework.framework_output,
-                             "ACTIVATE: ANY STATE HANDLER NOT DEFINED"));
+                             "%s NULL CBFUNC FOR JOB %s STATE %s",
+                             ORTE_NAME_PRINT(ORTE_PROC_MY_NAME),
+                             (NULL == jdata) ? "ALL" : ORTE_JOBID_PRINT(jdata->jobid),
+                             orte_job_state_to_str(state)));
         return;
     }
+    OPAL_OUTPUT_VERBOSE((1, orte_state_base_framework.framework_output,
+                         "%s ACTIVATING JOB %s STATE %s PRI %d",
+                         ORTE_NAME_PRINT(ORTE_PROC_MY_NAME),
+                         (NULL == jdata) ? "NULL" : ORTE_JOBID_PRINT(jdata->jobid),
+                         orte_job_state_to_str(state), s->priority));
     caddy = OBJ_NEW(orte_state_caddy_t);
     if (NULL != jdata) {
         caddy->jdata = jdata;
         caddy->job_state = state;
         OBJ_RETAIN(jdata);
     }
-            OPAL_OUTPUT_VERBOSE((1, orte_state_base_framework.framework_output,
-                                 "%s ACTIVATING JOB %s STATE %s PRI %d",
-                                 ORTE_NAME_PRINT(ORTE_PROC_MY_NAME),
-                                 (NULL == jdata) ? "NULL" : ORTE_JOBID_PRINT(jdata->jobid),
-                                 orte_job_state_to_str(state), s->priority));
     opal_event_set(orte_event_base, &caddy->ev, -1, OPAL_EV_WRITE, s->cbfunc, caddy);
     opal_event_set_priority(&caddy->ev, s->priority);
     opal_event_active(&caddy->ev, OPAL_EV_WRITE, 1);
@@ -110,20 +180,16 @@ int orte_state_base_add_job_state(orte_job_state_t state,
                                   orte_state_cbfunc_t cbfunc,
                                   int priority)
 {
-    opal_list_item_t *item;
     orte_state_t *st;
 
     /* check for uniqueness */
-    for (item = opal_list_get_first(&orte_job_states);
-         item != opal_list_get_end(&orte_job_states);
-         item = opal_list_get_next(item)) {
-        st = (orte_state_t*)item;
-        if (st->job_state == state) {
-            OPAL_OUTPUT_VERBOSE((1, orte_state_base_framework.framework_output,
-                                 "DUPLICATE STATE DEFINED: %s",
-                                 orte_job_state_to_str(state)));
-            return ORTE_ERR_BAD_PARAM;
-        }
+    index_setup();
+    if ((ORTE_JOB_STATE_ANY == state && NULL != job_any) ||
+        NULL != index_get(&job_index, state)) {
+        OPAL_OUTPUT_VERBOSE((1, orte_state_base_framework.framework_output,
+                             "DUPLICATE STATE DEFINED: %s",
+                             orte_job_state_to_str(state)));
+        return ORTE_ERR_BAD_PARAM;
     }
 
     st = OBJ_NEW(orte_state_t);
@@ -131,6 +197,7 @@ int orte_state_base_add_job_state(orte_job_state_t state,
     st->cbfunc = cbfunc;
     st->priority = priority;
     opal_list_append(&orte_job_states, &(st->super));
+    JOB_INDEX_SET(state, st);
 
     return ORTE_SUCCESS;
 }
@@ -138,17 +205,12 @@ int orte_state_base_add_job_state(orte_job_state_t state,
 int orte_state_base_set_job_state_callback(orte_job_state_t state,
                                            orte_state_cbfunc_t cbfunc)
 {
-    opal_list_item_t *item;
     orte_state_t *st;
 
-    for (item = opal_list_get_first(&orte_job_states);
-         item != opal_list_get_end(&orte_job_states);
-         item = opal_list_get_next(item)) {
-        st = (orte_state_t*)item;
-        if (st->job_state == state) {
-            st->cbfunc = cbfunc;
-            return ORTE_SUCCESS;
-        }
+    st = (ORTE_JOB_STATE_ANY == state) ? job_any : index_get(&job_index, state);
+    if (NULL != st) {
+        st->cbfunc = cbfunc;
+        return ORTE_SUCCESS;
     }
 
     /* if not found, assume SYS priority and install it */
@@ -157,6 +219,7 @@ int orte_state_base_set_job_state_callback(orte_job_state_t state,
     st->cbfunc = cbfunc;
     st->priority = ORTE_SYS_PRI;
     opal_list_append(&orte_job_states, &(st->super));
+    JOB_INDEX_SET(state, st);
 
     return ORTE_SUCCESS;
 }
@@ -164,35 +227,26 @@ int orte_state_base_set_job_state_callback(orte_job_state_t state,
 int orte_state_base_set_job_state_priority(orte_job_state_t state,
                                            int priority)
 {
-    opal_list_item_t *item;
     orte_state_t *st;
 
-    for (item = opal_list_get_first(&orte_job_states);
-         item != opal_list_get_end(&orte_job_states);
-         item = opal_list_get_next(item)) {
-        st = (orte_state_t*)item;
-        if (st->job_state == state) {
-            st->priority = priority;
-            return ORTE_SUCCESS;
-        }
+    st = (ORTE_JOB_STATE_ANY == state) ? job_any : index_get(&job_index, state);
+    if (NULL != st) {
+        st->priority = priority;
+        return ORTE_SUCCESS;
     }
     return ORTE_ERR_NOT_FOUND;
 }
 
 int orte_state_base_remove_job_state(orte_job_state_t state)
 {
-    opal_list_item_t *item;
     orte_state_t *st;
 
-    for (item = opal_list_get_first(&orte_job_states);
-         item != opal_list_get_end(&orte_job_states);
-         item = opal_list_get_next(item)) {
-        st = (orte_state_t*)item;
-        if (st->job_state == state) {
-            opal_list_remove_item(&orte_job_states, item);
-            OBJ_RELEASE(item);
-            return ORTE_SUCCESS;
-        }
+    st = (ORTE_JOB_STATE_ANY == state) ? job_any : index_get(&job_index, state);
+    if (NULL != st) {
+        opal_list_remove_item(&orte_job_states, &st->super);
+        JOB_INDEX_SET(state, NULL);
+        OBJ_RELEASE(st);
+        return ORTE_SUCCESS;
     }
     return ORTE_ERR_NOT_FOUND;
 }
@@ -215,72 +269,54 @@ void orte_state_base_print_job_state_machine(void)
 
 
 /****    PROC STATE MACHINE    ****/
+orte_state_t* orte_state_base_lookup_proc_state(orte_proc_state_t state)
+{
+    orte_state_t *s;
+
+    if (ORTE_PROC_STATE_ANY == state) {
+        s = proc_any;
+    } else {
+        s = index_get(&proc_index, state);
+    }
+    if (NULL != s) {
+        return s;
+    }
+    /* the state wasn't found, so use the default
+     * handler if it is defined */
+    if (ORTE_PROC_STATE_ERROR < state &&
+        NULL != (s = index_get(&proc_index, ORTE_PROC_STATE_ERROR))) {
+        return s;
+    }
+    return proc_any;
+}
+
 void orte_state_base_activate_proc_state(orte_process_name_t *proc,
                                          orte_proc_state_t state)
 {
-    opal_list_item_t *itm, *any=NULL, *error=NULL;
     orte_state_t *s;
     orte_state_caddy_t *caddy;
 
-    for (itm = opal_list_get_first(&orte_proc_states);
-         itm != opal_list_get_end(&orte_proc_states);
-         itm = opal_list_get_next(itm)) {
-        s = (orte_state_t*)itm;
-        if (s->proc_state == ORTE_PROC_STATE_ANY) {
-            /* save this place */
-            any = itm;
-        }
-        if (s->proc_state == ORTE_PROC_STATE_ERROR) {
-            error = itm;
-        }
-        if (s->proc_state == state) {
-            OPAL_OUTPUT_VERBOSE((1, orte_state_base_framework.framework_output,
-                                 "%s ACTIVATING PROC %s STATE %s PRI %d",
-                                 ORTE_NAME_PRINT(ORTE_PROC_MY_NAME),
-                                 ORTE_NAME_PRINT(proc),
-                                 orte_proc_state_to_str(state), s->priority));
-            if (NULL == s->cbfunc) {
-                OPAL_OUTPUT_VERBOSE((1, orte_state_base_framework.framework_output,
-                                     "%s NULL CBFUNC FOR PROC %s STATE %s",
-                                     ORTE_NAME_PRINT(ORTE_PROC_MY_NAME),
-                                     ORTE_NAME_PRINT(proc),
-                                     orte_proc_state_to_str(state)));
-                return;
-            }
-            caddy = OBJ_NEW(orte_state_caddy_t);
-            caddy->name = *proc;
-            caddy->proc_state = state;
-            opal_event_set(orte_event_base, &caddy->ev, -1, OPAL_EV_WRITE, s->cbfunc, caddy);
-            opal_event_set_priority(&caddy->ev, s->priority);
-            opal_event_active(&caddy->ev, OPAL_EV_WRITE, 1);
-            return;
-        }
-    }
-    /* if we get here, then the state wasn't found, so execute
-     * the default handler if it is defined
-     */
-    if (ORTE_PROC_STATE_ERROR < state && NULL != error) {
-        s = (orte_state_t*)error;
-    } else if (NULL != any) {
-        s = (orte_state_t*)any;
-    } else {
+    if (NULL == (s = orte_state_base_lookup_proc_state(state))) {
         OPAL_OUTPUT_VERBOSE((1, orte_state_base_framework.framework_output,
                              "INCREMENT: ANY STATE NOT FOUND"));
         return;
     }
     if (NULL == s->cbfunc) {
         OPAL_OUTPUT_VERBOSE((1, orte_state_base_framework.framework_output,
-                             "ACTIVATE: ANY STATE HANDLER NOT DEFINED"));
+                             "%s NULL CBFUNC FOR PROC %s STATE %s",
+                             ORTE_NAME_PRINT(ORTE_PROC_MY_NAME),
+                             ORTE_NAME_PRINT(proc),
+                             orte_proc_state_to_str(state)));
         return;
     }
+    OPAL_OUTPUT_VERBOSE((1, orte_state_base_framework.framework_output,
+                         "%s ACTIVATING PROC %s STATE %s PRI %d",
+                         ORTE_NAME_PRINT(ORTE_PROC_MY_NAME),
+                         ORTE_NAME_PRINT(proc),
+                         orte_proc_state_to_str(state), s->priority));
     caddy = OBJ_NEW(orte_state_caddy_t);
     caddy->name = *proc;
     caddy->proc_state = state;
-            OPAL_OUTPUT_VERBOSE((1, orte_state_base_framework.framework_output,
-                                 "%s ACTIVATING PROC %s STATE %s PRI %d",
-                                 ORTE_NAME_PRINT(ORTE_PROC_MY_NAME),
-                                 ORTE_NAME_PRINT(proc),
-                                 orte_proc_state_to_str(state), s->priority));
     opal_event_set(orte_event_base, &caddy->ev, -1, OPAL_EV_WRITE, s->cbfunc, caddy);
     opal_event_set_priority(&caddy->ev, s->priority);
     opal_event_active(&caddy->ev, OPAL_EV_WRITE, 1);
@@ -290,20 +326,16 @@ int orte_state_base_add_proc_state(orte_proc_state_t state,
                                    orte_state_cbfunc_t cbfunc,
                                    int priority)
 {
-    opal_list_item_t *item;
     orte_state_t *st;
 
     /* check for uniqueness */
-    for (item = opal_list_get_first(&orte_proc_states);
-         item != opal_list_get_end(&orte_proc_states);
-         item = opal_list_get_next(item)) {
-        st = (orte_state_t*)item;
-        if (st->proc_state == state) {
-            OPAL_OUTPUT_VERBOSE((1, orte_state_base_framework.framework_output,
-                                 "DUPLICATE STATE DEFINED: %s",
-                                 orte_proc_state_to_str(state)));
-            return ORTE_ERR_BAD_PARAM;
-        }
+    index_setup();
+    if ((ORTE_PROC_STATE_ANY == state && NULL != proc_any) ||
+        NULL != index_get(&proc_index, state)) {
+        OPAL_OUTPUT_VERBOSE((1, orte_state_base_framework.framework_output,
+                             "DUPLICATE STATE DEFINED: %s",
+                             orte_proc_state_to_str(state)));
+        return ORTE_ERR_BAD_PARAM;
     }
 
     st = OBJ_NEW(orte_state_t);
@@ -311,6 +343,7 @@ int orte_state_base_add_proc_state(orte_proc_state_t state,
     st->cbfunc = cbfunc;
     st->priority = priority;
     opal_list_append(&orte_proc_states, &(st->super));
+    PROC_INDEX_SET(state, st);
 
     return ORTE_SUCCESS;
 }
@@ -318,17 +351,12 @@ int orte_state_base_add_proc_state(orte_proc_state_t state,
 int orte_state_base_set_proc_state_callback(orte_proc_state_t state,
                                             orte_state_cbfunc_t cbfunc)
 {
-    opal_list_item_t *item;
     orte_state_t *st;
 
-    for (item = opal_list_get_first(&orte_proc_states);
-         item != opal_list_get_end(&orte_proc_states);
-         item = opal_list_get_next(item)) {
-        st = (orte_state_t*)item;
-        if (st->proc_state == state) {
-            st->cbfunc = cbfunc;
-            return ORTE_SUCCESS;
-        }
+    st = (ORTE_PROC_STATE_ANY == state) ? proc_any : index_get(&proc_index, state);
+    if (NULL != st) {
+        st->cbfunc = cbfunc;
+        return ORTE_SUCCESS;
     }
     return ORTE_ERR_NOT_FOUND;
 }
@@ -336,35 +364,26 @@ int orte_state_base_set_proc_state_callback(orte_proc_state_t state,
 int orte_state_base_set_proc_state_priority(orte_proc_state_t state,
                                             int priority)
 {
-    opal_list_item_t *item;
     orte_state_t *st;
 
-    for (item = opal_list_get_first(&orte_proc_states);
-         item != opal_list_get_end(&orte_proc_states);
-         item = opal_list_get_next(item)) {
-        st = (orte_state_t*)item;
-        if (st->proc_state == state) {
-            st->priority = priority;
-            return ORTE_SUCCESS;
-        }
+    st = (ORTE_PROC_STATE_ANY == state) ? proc_any : index_get(&proc_index, state);
+    if (NULL != st) {
+        st->priority = priority;
+        return ORTE_SUCCESS;
     }
     return ORTE_ERR_NOT_FOUND;
 }
 
 int orte_state_base_remove_proc_state(orte_proc_state_t state)
 {
-    opal_list_item_t *item;
     orte_state_t *st;
 
-    for (item = opal_list_get_first(&orte_proc_states);
-         item != opal_list_get_end(&orte_proc_states);
-         item = opal_list_get_next(item)) {
-        st = (orte_state_t*)item;
-        if (st->proc_state == state) {
-            opal_list_remove_item(&orte_proc_states, item);
-            OBJ_RELEASE(item);
-            return ORTE_SUCCESS;
-        }
+    st = (ORTE_PROC_STATE_ANY == state) ? proc_any : index_get(&proc_index, state);
+    if (NULL != st) {
+        opal_list_remove_item(&orte_proc_states, &st->super);
+        PROC_INDEX_SET(state, NULL);
+        OBJ_RELEASE(st);
+        return ORTE_SUCCESS;
     }
     return ORTE_ERR_NOT_FOUND;
 }
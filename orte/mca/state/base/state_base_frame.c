@@ -48,6 +48,7 @@ static int orte_state_base_close(void)
     if (NULL != orte_state.finalize) {
         orte_state.finalize();
     }
+    orte_state_base_clear_index();
 
     return mca_base_framework_components_close(&orte_state_base_framework, NULL);
 }
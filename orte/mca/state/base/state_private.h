@@ -69,6 +69,14 @@ ORTE_DECLSPEC int orte_state_base_remove_proc_state(orte_proc_state_t state);
 
 ORTE_DECLSPEC void orte_util_print_proc_state_machine(void);
 
+/* the entry an activation of the given state is dispatched to,
+ * including the ERROR and ANY fallbacks - NULL if there is none */
+ORTE_DECLSPEC orte_state_t* orte_state_base_lookup_job_state(orte_job_state_t state);
+ORTE_DECLSPEC orte_state_t* orte_state_base_lookup_proc_state(orte_proc_state_t state);
+
+/* release the direct-indexed lookup of the state machines */
+ORTE_DECLSPEC void orte_state_base_clear_index(void);
+
 /* common state processing functions */
 ORTE_DECLSPEC void orte_state_base_local_launch_complete(int fd, short argc, void *cbdata);
 ORTE_DECLSPEC void orte_state_base_cleanup_job(int fd, short argc, void *cbdata);
@@ -78,13 +78,15 @@ ORTE_DECLSPEC extern mca_base_framework_t orte_state_base_framework;
 #define ORTE_ACTIVATE_JOB_STATE(j, s)                                   \
     do {                                                                \
         orte_job_t *shadow=(j);                                         \
-        opal_output_verbose(1, orte_state_base_framework.framework_output, \
-                            "%s ACTIVATE JOB %s STATE %s AT %s:%d",	\
-                            ORTE_NAME_PRINT(ORTE_PROC_MY_NAME),         \
-                            (NULL == shadow) ? "NULL" :                 \
-                            ORTE_JOBID_PRINT(shadow->jobid),		\
-                            orte_job_state_to_str((s)),                 \
-                            __FILE__, __LINE__);			\
+        if (0 < opal_output_get_verbosity(orte_state_base_framework.framework_output)) { \
+            opal_output_verbose(1, orte_state_base_framework.framework_output, \
+                                "%s ACTIVATE JOB %s STATE %s AT %s:%d", \
+                                ORTE_NAME_PRINT(ORTE_PROC_MY_NAME),     \
+                                (NULL == shadow) ? "NULL" :             \
+                                ORTE_JOBID_PRINT(shadow->jobid),        \
+                                orte_job_state_to_str((s)),             \
+                                __FILE__, __LINE__);                    \
+        }                                                               \
         /* sanity check */                                              \
         if ((s) < 0) {                                                  \
             assert(0);                                                  \
@@ -95,13 +97,15 @@ ORTE_DECLSPEC extern mca_base_framework_t orte_state_base_framework;
 #define ORTE_ACTIVATE_PROC_STATE(p, s)                                  \
     do {                                                                \
         orte_process_name_t *shadow=(p);                                \
-	opal_output_verbose(1, orte_state_base_framework.framework_output, \
-                            "%s ACTIVATE PROC %s STATE %s AT %s:%d",	\
-                            ORTE_NAME_PRINT(ORTE_PROC_MY_NAME),         \
-                            (NULL == shadow) ? "NULL" :                 \
-                            ORTE_NAME_PRINT(shadow),			\
-                            orte_proc_state_to_str((s)),		\
-                            __FILE__, __LINE__);			\
+        if (0 < opal_output_get_verbosity(orte_state_base_framework.framework_output)) { \
+            opal_output_verbose(1, orte_state_base_framework.framework_output, \
+                                "%s ACTIVATE PROC %s STATE %s AT %s:%d", \
+                                ORTE_NAME_PRINT(ORTE_PROC_MY_NAME),     \
+                                (NULL == shadow) ? "NULL" :             \
+                                ORTE_NAME_PRINT(shadow),                \
+                                orte_proc_state_to_str((s)),            \
+                                __FILE__, __LINE__);                    \
+        }                                                               \
         /* sanity check */                                              \
         if ((s) < 0) {                                                  \
             assert(0);                                                  \
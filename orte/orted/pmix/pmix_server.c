@@ -163,6 +163,9 @@ static void eviction_cbfunc(struct opal_hotel_t *hotel,
         /* fall thru and return an error so the caller doesn't hang */
     }
     /* don't let the caller hang */
+    if (NULL != req->mdxcbfunc) {
+        pmix_server_dmdx_untrack(req);
+    }
     if (NULL != req->opcbfunc) {
         req->opcbfunc(OPAL_ERR_TIMEOUT, req->cbdata);
     } else if (NULL != req->mdxcbfunc) {
@@ -198,6 +201,12 @@ int pmix_server_init(void)
         return rc;
     }
     OBJ_CONSTRUCT(&orte_pmix_server_globals.notifications, opal_list_t);
+    OBJ_CONSTRUCT(&orte_pmix_server_globals.dmx_reqs, opal_proc_table_t);
+    opal_proc_table_init(&orte_pmix_server_globals.dmx_reqs, 16, 256);
+    OBJ_CONSTRUCT(&orte_pmix_server_globals.dmx_batches, opal_list_t);
+    orte_pmix_server_globals.dmx_flush_active = false;
+    OBJ_CONSTRUCT(&orte_pmix_server_globals.pub_batches, opal_list_t);
+    orte_pmix_server_globals.pub_flush_active = false;
 
    /* setup recv for direct modex requests */
     orte_rml.recv_buffer_nb(ORTE_NAME_WILDCARD, ORTE_RML_TAG_DIRECT_MODEX,
@@ -345,6 +354,11 @@ int pmix_server_init(void)
 
 void pmix_server_finalize(void)
 {
+    pmix_server_dmx_t *dmx;
+    opal_process_name_t key;
+    void *node1, *node2;
+    int rc;
+
     if (!orte_pmix_server_globals.initialized) {
         return;
     }
@@ -366,6 +380,26 @@ void pmix_server_finalize(void)
     /* cleanup collectives */
     OBJ_DESTRUCT(&orte_pmix_server_globals.reqs);
     OPAL_LIST_DESTRUCT(&orte_pmix_server_globals.notifications);
+    if (orte_pmix_server_globals.dmx_flush_active) {
+        opal_event_del(&orte_pmix_server_globals.dmx_flush);
+    }
+    OPAL_LIST_DESTRUCT(&orte_pmix_server_globals.dmx_batches);
+    if (orte_pmix_server_globals.pub_flush_active) {
+        opal_event_del(&orte_pmix_server_globals.pub_flush);
+    }
+    OPAL_LIST_DESTRUCT(&orte_pmix_server_globals.pub_batches);
+    /* release the direct modex requests still waiting on a target */
+    rc = opal_proc_table_get_first_key(&orte_pmix_server_globals.dmx_reqs, &key,
+                                       (void**)&dmx, &node1, &node2);
+    while (OPAL_SUCCESS == rc) {
+        if (NULL != dmx) {
+            OBJ_RELEASE(dmx);
+        }
+        rc = opal_proc_table_get_next_key(&orte_pmix_server_globals.dmx_reqs, &key,
+                                          (void**)&dmx, node1, &node1, node2, &node2);
+    }
+    opal_proc_table_remove_all(&orte_pmix_server_globals.dmx_reqs);
+    OBJ_DESTRUCT(&orte_pmix_server_globals.dmx_reqs);
 }
 
 static void send_error(int status, opal_process_name_t *idreq,
@@ -464,38 +498,22 @@ static void modex_resp(int status,
     opal_event_set_priority(&(req->ev), ORTE_MSG_PRI);
     opal_event_active(&(req->ev), OPAL_EV_WRITE, 1);
 }
-static void pmix_server_dmdx_recv(int status, orte_process_name_t* sender,
-                                  opal_buffer_t *buffer,
-                                  orte_rml_tag_t tg, void *cbdata)
+static void dmdx_request(orte_process_name_t *sender,
+                         opal_process_name_t *idreq, int room_num)
 {
-    int rc, room_num;
-    int32_t cnt;
-    opal_process_name_t idreq;
+    int rc;
     orte_process_name_t name;
     orte_job_t *jdata;
     orte_proc_t *proc;
     pmix_server_req_t *req;
 
-
-    /* unpack the id of the proc whose data is being requested */
-    cnt = 1;
-    if (OPAL_SUCCESS != (rc = opal_dss.unpack(buffer, &idreq, &cnt, OPAL_NAME))) {
-        ORTE_ERROR_LOG(rc);
-        return;
-    }
     opal_output_verbose(2, orte_pmix_server_globals.output,
                         "%s dmdx:recv request from proc %s for proc %s",
                         ORTE_NAME_PRINT(ORTE_PROC_MY_NAME),
                         ORTE_NAME_PRINT(sender),
-                        ORTE_NAME_PRINT(&idreq));
-    /* and the remote daemon's tracking room number */
-    cnt = 1;
-    if (OPAL_SUCCESS != (rc = opal_dss.unpack(buffer, &room_num, &cnt, OPAL_INT))) {
-        ORTE_ERROR_LOG(rc);
-        return;
-    }
+                        ORTE_NAME_PRINT(idreq));
     /* is this proc one of mine? */
-    memcpy((char*)&name, (char*)&idreq, sizeof(orte_process_name_t));
+    memcpy((char*)&name, (char*)idreq, sizeof(orte_process_name_t));
     if (NULL == (jdata = orte_get_job_data_object(name.jobid))) {
         /* not having the jdata means that we haven't unpacked the
          * the launch message for this job yet - this is a race
@@ -503,45 +521,75 @@ static void pmix_server_dmdx_recv(int status, orte_process_name_t* sender,
          * it later */
         req = OBJ_NEW(pmix_server_req_t);
         req->proxy = *sender;
-        req->target = idreq;
+        req->target = *idreq;
         req->remote_room_num = room_num;
         if (OPAL_SUCCESS != (rc = opal_hotel_checkin(&orte_pmix_server_globals.reqs, req, &req->room_num))) {
             OBJ_RELEASE(req);
-            send_error(rc, &idreq, sender);
+            send_error(rc, idreq, sender);
         }
         return;
     }
     if (NULL == (proc = (orte_proc_t*)opal_pointer_array_get_item(jdata->procs, name.vpid))) {
         /* this is truly an error, so notify the sender */
-        send_error(ORTE_ERR_NOT_FOUND, &idreq, sender);
+        send_error(ORTE_ERR_NOT_FOUND, idreq, sender);
         return;
     }
     if (!ORTE_FLAG_TEST(proc, ORTE_PROC_FLAG_LOCAL)) {
         /* send back an error - they obviously have made a mistake */
-        send_error(ORTE_ERR_NOT_FOUND, &idreq, sender);
+        send_error(ORTE_ERR_NOT_FOUND, idreq, sender);
         return;
     }
     /* track the request since the call down to the PMIx server
      * is asynchronous */
     req = OBJ_NEW(pmix_server_req_t);
     req->proxy = *sender;
-    req->target = idreq;
+    req->target = *idreq;
     req->remote_room_num = room_num;
     if (OPAL_SUCCESS != (rc = opal_hotel_checkin(&orte_pmix_server_globals.reqs, req, &req->room_num))) {
         OBJ_RELEASE(req);
-        send_error(rc, &idreq, sender);
+        send_error(rc, idreq, sender);
         return;
     }
 
     /* ask our local pmix server for the data */
-    if (OPAL_SUCCESS != (rc = opal_pmix.server_dmodex_request(&idreq, modex_resp, req))) {
+    if (OPAL_SUCCESS != (rc = opal_pmix.server_dmodex_request(idreq, modex_resp, req))) {
         ORTE_ERROR_LOG(rc);
         opal_hotel_checkout(&orte_pmix_server_globals.reqs, req->room_num);
         OBJ_RELEASE(req);
-        send_error(rc, &idreq, sender);
+        send_error(rc, idreq, sender);
         return;
     }
-    return;
+}
+
+static void pmix_server_dmdx_recv(int status, orte_process_name_t* sender,
+                                  opal_buffer_t *buffer,
+                                  orte_rml_tag_t tg, void *cbdata)
+{
+    int rc, room_num;
+    int32_t cnt, n, nreqs;
+    opal_process_name_t idreq;
+
+    /* the requesting daemon batches all its requests for our procs */
+    cnt = 1;
+    if (OPAL_SUCCESS != (rc = opal_dss.unpack(buffer, &nreqs, &cnt, OPAL_INT32))) {
+        ORTE_ERROR_LOG(rc);
+        return;
+    }
+    for (n=0; n < nreqs; n++) {
+        /* unpack the id of the proc whose data is being requested */
+        cnt = 1;
+        if (OPAL_SUCCESS != (rc = opal_dss.unpack(buffer, &idreq, &cnt, OPAL_NAME))) {
+            ORTE_ERROR_LOG(rc);
+            return;
+        }
+        /* and the remote daemon's tracking room number */
+        cnt = 1;
+        if (OPAL_SUCCESS != (rc = opal_dss.unpack(buffer, &room_num, &cnt, OPAL_INT))) {
+            ORTE_ERROR_LOG(rc);
+            return;
+        }
+        dmdx_request(sender, &idreq, room_num);
+    }
 }
 
 typedef struct {
@@ -574,10 +622,11 @@ static void pmix_server_dmdx_resp(int status, orte_process_name_t* sender,
                                   opal_buffer_t *buffer,
                                   orte_rml_tag_t tg, void *cbdata)
 {
-    int rc, ret, room_num, rnum;
+    int rc, ret, room_num;
     int32_t cnt;
     opal_process_name_t target;
     pmix_server_req_t *req;
+    pmix_server_dmx_t *dmx = NULL;
     datacaddy_t *d;
 
     opal_output_verbose(2, orte_pmix_server_globals.output,
@@ -613,32 +662,21 @@ static void pmix_server_dmdx_resp(int status, orte_process_name_t* sender,
         return;
     }
 
-    /* check the request out of the tracking hotel */
-    opal_hotel_checkout_and_return_occupant(&orte_pmix_server_globals.reqs, room_num, (void**)&req);
-    /* return the returned data to the requestor */
-    if (NULL != req) {
-        if (NULL != req->mdxcbfunc) {
-            OBJ_RETAIN(d);
-            req->mdxcbfunc(ret, d->data, d->ndata, req->cbdata, relcbfunc, d);
-        }
-        OBJ_RELEASE(req);
-    }
-
-    /* now see if anyone else was waiting for data from this target */
-    for (rnum=0; rnum < orte_pmix_server_globals.reqs.num_rooms; rnum++) {
-        opal_hotel_knock(&orte_pmix_server_globals.reqs, rnum, (void**)&req);
-        if (NULL == req) {
-            continue;
-        }
-        if (req->target.jobid == target.jobid &&
-            req->target.vpid == target.vpid) {
+    /* return the data to everyone waiting on this target - the room
+     * number we sent may since have been reused if that request timed
+     * out, so go by the target instead */
+    if (OPAL_SUCCESS == opal_proc_table_get_value(&orte_pmix_server_globals.dmx_reqs,
+                                                  target, (void**)&dmx) && NULL != dmx) {
+        opal_proc_table_remove_value(&orte_pmix_server_globals.dmx_reqs, target);
+        while (NULL != (req = (pmix_server_req_t*)opal_list_remove_first(&dmx->reqs))) {
+            opal_hotel_checkout(&orte_pmix_server_globals.reqs, req->room_num);
             if (NULL != req->mdxcbfunc) {
                 OBJ_RETAIN(d);
                 req->mdxcbfunc(ret, d->data, d->ndata, req->cbdata, relcbfunc, d);
             }
-            opal_hotel_checkout(&orte_pmix_server_globals.reqs, rnum);
             OBJ_RELEASE(req);
         }
+        OBJ_RELEASE(dmx);
     }
     OBJ_RELEASE(d);  // maintain accounting
 }
@@ -676,9 +714,56 @@ static void rqdes(pmix_server_req_t *p)
     OBJ_DESTRUCT(&p->msg);
 }
 OBJ_CLASS_INSTANCE(pmix_server_req_t,
-                   opal_object_t,
+                   opal_list_item_t,
                    rqcon, rqdes);
 
+static void dmxcon(pmix_server_dmx_t *p)
+{
+    p->target = *ORTE_NAME_INVALID;
+    OBJ_CONSTRUCT(&p->reqs, opal_list_t);
+}
+static void dmxdes(pmix_server_dmx_t *p)
+{
+    /* the requests are owned by the hotel */
+    while (NULL != opal_list_remove_first(&p->reqs));
+    OBJ_DESTRUCT(&p->reqs);
+}
+OBJ_CLASS_INSTANCE(pmix_server_dmx_t,
+                   opal_object_t,
+                   dmxcon, dmxdes);
+
+static void dbcon(pmix_server_dmx_batch_t *p)
+{
+    p->daemon = *ORTE_NAME_INVALID;
+    p->nreqs = 0;
+    p->buf = OBJ_NEW(opal_buffer_t);
+}
+static void dbdes(pmix_server_dmx_batch_t *p)
+{
+    if (NULL != p->buf) {
+        OBJ_RELEASE(p->buf);
+    }
+}
+OBJ_CLASS_INSTANCE(pmix_server_dmx_batch_t,
+                   opal_list_item_t,
+                   dbcon, dbdes);
+
+static void pbcon(pmix_server_pub_batch_t *p)
+{
+    p->target = *ORTE_NAME_INVALID;
+    p->nreqs = 0;
+    p->buf = OBJ_NEW(opal_buffer_t);
+}
+static void pbdes(pmix_server_pub_batch_t *p)
+{
+    if (NULL != p->buf) {
+        OBJ_RELEASE(p->buf);
+    }
+}
+OBJ_CLASS_INSTANCE(pmix_server_pub_batch_t,
+                   opal_list_item_t,
+                   pbcon, pbdes);
+
 static void mdcon(orte_pmix_mdx_caddy_t *p)
 {
     p->sig = NULL;
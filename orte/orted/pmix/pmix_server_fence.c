@@ -121,16 +121,167 @@ int pmix_server_fencenb_fn(opal_list_t *procs, opal_list_t *info,
     return ORTE_SUCCESS;
 }
 
+int pmix_server_dmdx_track(pmix_server_req_t *req, bool *first)
+{
+    pmix_server_dmx_t *dmx = NULL;
+    int rc;
+
+    *first = false;
+    if (OPAL_SUCCESS != opal_proc_table_get_value(&orte_pmix_server_globals.dmx_reqs,
+                                                  req->target, (void**)&dmx) || NULL == dmx) {
+        dmx = OBJ_NEW(pmix_server_dmx_t);
+        dmx->target = req->target;
+        if (OPAL_SUCCESS != (rc = opal_proc_table_set_value(&orte_pmix_server_globals.dmx_reqs,
+                                                            req->target, dmx))) {
+            OBJ_RELEASE(dmx);
+            return rc;
+        }
+        *first = true;
+    }
+    opal_list_append(&dmx->reqs, &req->super);
+    return ORTE_SUCCESS;
+}
+
+void pmix_server_dmdx_untrack(pmix_server_req_t *req)
+{
+    pmix_server_dmx_t *dmx = NULL;
+    pmix_server_req_t *r;
+
+    if (OPAL_SUCCESS != opal_proc_table_get_value(&orte_pmix_server_globals.dmx_reqs,
+                                                  req->target, (void**)&dmx) || NULL == dmx) {
+        return;
+    }
+    OPAL_LIST_FOREACH(r, &dmx->reqs, pmix_server_req_t) {
+        if (r == req) {
+            opal_list_remove_item(&dmx->reqs, &req->super);
+            break;
+        }
+    }
+    if (0 == opal_list_get_size(&dmx->reqs)) {
+        opal_proc_table_remove_value(&orte_pmix_server_globals.dmx_reqs, req->target);
+        OBJ_RELEASE(dmx);
+    }
+}
+
+/* error out everyone waiting on data for the given target */
+static void dmdx_fail(opal_process_name_t *target, int status)
+{
+    pmix_server_dmx_t *dmx = NULL;
+    pmix_server_req_t *req;
+
+    if (OPAL_SUCCESS != opal_proc_table_get_value(&orte_pmix_server_globals.dmx_reqs,
+                                                  *target, (void**)&dmx) || NULL == dmx) {
+        return;
+    }
+    opal_proc_table_remove_value(&orte_pmix_server_globals.dmx_reqs, *target);
+    while (NULL != (req = (pmix_server_req_t*)opal_list_remove_first(&dmx->reqs))) {
+        opal_hotel_checkout(&orte_pmix_server_globals.reqs, req->room_num);
+        if (NULL != req->mdxcbfunc) {
+            req->mdxcbfunc(status, NULL, 0, req->cbdata, NULL, NULL);
+        }
+        OBJ_RELEASE(req);
+    }
+    OBJ_RELEASE(dmx);
+}
+
+/* send each host daemon a single message covering all the
+ * requests we collected for it during this pass thru the
+ * event library */
+static void dmdx_flush(int sd, short args, void *cbdata)
+{
+    pmix_server_dmx_batch_t *batch;
+    opal_buffer_t *buf;
+    opal_process_name_t target;
+    int rc, room_num;
+    int32_t cnt;
+
+    orte_pmix_server_globals.dmx_flush_active = false;
+
+    while (NULL != (batch = (pmix_server_dmx_batch_t*)opal_list_remove_first(&orte_pmix_server_globals.dmx_batches))) {
+        opal_output_verbose(2, orte_pmix_server_globals.output,
+                            "%s dmdx:flush sending %d requests to %s",
+                            ORTE_NAME_PRINT(ORTE_PROC_MY_NAME), batch->nreqs,
+                            ORTE_NAME_PRINT(&batch->daemon));
+        buf = OBJ_NEW(opal_buffer_t);
+        if (OPAL_SUCCESS != (rc = opal_dss.pack(buf, &batch->nreqs, 1, OPAL_INT32))) {
+            ORTE_ERROR_LOG(rc);
+            OBJ_RELEASE(buf);
+            goto error;
+        }
+        if (OPAL_SUCCESS != (rc = opal_dss.copy_payload(buf, batch->buf))) {
+            ORTE_ERROR_LOG(rc);
+            OBJ_RELEASE(buf);
+            goto error;
+        }
+        if (ORTE_SUCCESS != (rc = orte_rml.send_buffer_nb(&batch->daemon, buf, ORTE_RML_TAG_DIRECT_MODEX,
+                                                          orte_rml_send_callback, NULL))) {
+            ORTE_ERROR_LOG(rc);
+            OBJ_RELEASE(buf);
+            goto error;
+        }
+        OBJ_RELEASE(batch);
+        continue;
+
+      error:
+        /* don't leave any of the requestors hanging */
+        cnt = 1;
+        while (OPAL_SUCCESS == opal_dss.unpack(batch->buf, &target, &cnt, OPAL_NAME)) {
+            if (OPAL_SUCCESS != opal_dss.unpack(batch->buf, &room_num, &cnt, OPAL_INT)) {
+                break;
+            }
+            dmdx_fail(&target, rc);
+        }
+        OBJ_RELEASE(batch);
+    }
+}
+
+static int dmdx_batch(orte_process_name_t *daemon, pmix_server_req_t *req)
+{
+    pmix_server_dmx_batch_t *batch;
+    int rc;
+
+    OPAL_LIST_FOREACH(batch, &orte_pmix_server_globals.dmx_batches, pmix_server_dmx_batch_t) {
+        if (batch->daemon.vpid == daemon->vpid) {
+            goto pack;
+        }
+    }
+    batch = OBJ_NEW(pmix_server_dmx_batch_t);
+    batch->daemon = *daemon;
+    opal_list_append(&orte_pmix_server_globals.dmx_batches, &batch->super);
+
+  pack:
+    if (OPAL_SUCCESS != (rc = opal_dss.pack(batch->buf, &req->target, 1, OPAL_NAME))) {
+        ORTE_ERROR_LOG(rc);
+        return rc;
+    }
+    /* include the request room number for quick retrieval */
+    if (OPAL_SUCCESS != (rc = opal_dss.pack(batch->buf, &req->room_num, 1, OPAL_INT))) {
+        ORTE_ERROR_LOG(rc);
+        return rc;
+    }
+    batch->nreqs++;
+
+    /* requests already queued behind us will be processed
+     * before the flush, and so will join this batch */
+    if (!orte_pmix_server_globals.dmx_flush_active) {
+        orte_pmix_server_globals.dmx_flush_active = true;
+        opal_event_set(orte_event_base, &orte_pmix_server_globals.dmx_flush,
+                       -1, OPAL_EV_WRITE, dmdx_flush, NULL);
+        opal_event_set_priority(&orte_pmix_server_globals.dmx_flush, ORTE_MSG_PRI);
+        opal_event_active(&orte_pmix_server_globals.dmx_flush, OPAL_EV_WRITE, 1);
+    }
+    return ORTE_SUCCESS;
+}
+
 static void dmodex_req(int sd, short args, void *cbdata)
 {
     pmix_server_req_t *req = (pmix_server_req_t*)cbdata;
-    pmix_server_req_t *r;
     orte_job_t *jdata;
     orte_proc_t *proct, *dmn;
-    int rc, rnum;
-    opal_buffer_t *buf;
+    int rc;
     uint8_t *data=NULL;
     int32_t sz=0;
+    bool first;
 
     /* a race condition exists here because of the thread-shift - it is
      * possible that data for the specified proc arrived while we were
@@ -146,25 +297,23 @@ static void dmodex_req(int sd, short args, void *cbdata)
         return;
     }
 
+    /* save the request in the hotel until the data is returned */
+    if (OPAL_SUCCESS != (rc = opal_hotel_checkin(&orte_pmix_server_globals.reqs, req, &req->room_num))) {
+        ORTE_ERROR_LOG(rc);
+        /* can't just return as that would cause the requestor
+         * to hang, so instead execute the callback */
+        goto callback;
+    }
+    if (ORTE_SUCCESS != (rc = pmix_server_dmdx_track(req, &first))) {
+        ORTE_ERROR_LOG(rc);
+        opal_hotel_checkout(&orte_pmix_server_globals.reqs, req->room_num);
+        goto callback;
+    }
+
     /* has anyone already requested data for this target? If so,
      * then the data is already on its way */
-    for (rnum=0; rnum < orte_pmix_server_globals.reqs.num_rooms; rnum++) {
-        opal_hotel_knock(&orte_pmix_server_globals.reqs, rnum, (void**)&r);
-        if (NULL == r) {
-            continue;
-        }
-        if (r->target.jobid == req->target.jobid &&
-            r->target.vpid == req->target.vpid) {
-            /* save the request in the hotel until the
-             * data is returned */
-            if (OPAL_SUCCESS != (rc = opal_hotel_checkin(&orte_pmix_server_globals.reqs, req, &req->room_num))) {
-                ORTE_ERROR_LOG(rc);
-                /* can't just return as that would cause the requestor
-                 * to hang, so instead execute the callback */
-                goto callback;
-            }
-            return;
-        }
+    if (!first) {
+        return;
     }
 
     /* lookup who is hosting this proc */
@@ -173,19 +322,13 @@ static void dmodex_req(int sd, short args, void *cbdata)
          * condition where we are being asked about a process
          * that we don't know about yet. In this case, just
          * record the request and we will process it later */
-        if (OPAL_SUCCESS != (rc = opal_hotel_checkin(&orte_pmix_server_globals.reqs, req, &req->room_num))) {
-            ORTE_ERROR_LOG(rc);
-            /* can't just return as that would cause the requestor
-             * to hang, so instead execute the callback */
-            goto callback;
-        }
         return;
     }
     if (NULL == (proct = (orte_proc_t*)opal_pointer_array_get_item(jdata->procs, req->target.vpid))) {
         /* if we find the job, but not the process, then that is an error */
         ORTE_ERROR_LOG(ORTE_ERR_NOT_FOUND);
         rc = ORTE_ERR_NOT_FOUND;
-        goto callback;
+        goto error;
     }
 
     if (NULL == (dmn = proct->node->daemon)) {
@@ -194,51 +337,28 @@ static void dmodex_req(int sd, short args, void *cbdata)
          * must be an error */
         ORTE_ERROR_LOG(ORTE_ERR_NOT_FOUND);
         rc = ORTE_ERR_NOT_FOUND;
-        goto callback;
+        goto error;
     }
     /* point the request to the daemon that is hosting the
      * target process */
     req->proxy.vpid = dmn->name.vpid;
 
-    /* track the request so we know the function and cbdata
-     * to callback upon completion */
-    if (OPAL_SUCCESS != (rc = opal_hotel_checkin(&orte_pmix_server_globals.reqs, req, &req->room_num))) {
-        ORTE_ERROR_LOG(rc);
-        goto callback;
-    }
-
     /* if we are the host daemon, then this is a local request, so
      * just wait for the data to come in */
     if (ORTE_PROC_MY_NAME->vpid == dmn->name.vpid) {
         return;
     }
 
-    /* construct a request message */
-    buf = OBJ_NEW(opal_buffer_t);
-    if (OPAL_SUCCESS != (rc = opal_dss.pack(buf, &req->target, 1, OPAL_NAME))) {
-        ORTE_ERROR_LOG(rc);
-        opal_hotel_checkout(&orte_pmix_server_globals.reqs, req->room_num);
-        OBJ_RELEASE(buf);
-        goto callback;
-    }
-    /* include the request room number for quick retrieval */
-    if (OPAL_SUCCESS != (rc = opal_dss.pack(buf, &req->room_num, 1, OPAL_INT))) {
-        ORTE_ERROR_LOG(rc);
-        opal_hotel_checkout(&orte_pmix_server_globals.reqs, req->room_num);
-        OBJ_RELEASE(buf);
-        goto callback;
-    }
-
-    /* send it to the host daemon */
-    if (ORTE_SUCCESS != (rc = orte_rml.send_buffer_nb(&dmn->name, buf, ORTE_RML_TAG_DIRECT_MODEX,
-                                                      orte_rml_send_callback, NULL))) {
-        ORTE_ERROR_LOG(rc);
-        opal_hotel_checkout(&orte_pmix_server_globals.reqs, req->room_num);
-        OBJ_RELEASE(buf);
-        goto callback;
+    /* add it to the next request sent to the host daemon */
+    if (ORTE_SUCCESS != (rc = dmdx_batch(&dmn->name, req))) {
+        goto error;
     }
     return;
 
+  error:
+    opal_hotel_checkout(&orte_pmix_server_globals.reqs, req->room_num);
+    pmix_server_dmdx_untrack(req);
+
   callback:
     /* this section gets executed solely upon an error */
     if (NULL != req->mdxcbfunc) {
@@ -38,7 +38,9 @@
 #endif
 
 #include "opal/types.h"
+#include "opal/class/opal_hash_table.h"
 #include "opal/class/opal_hotel.h"
+#include "opal/class/opal_list.h"
 #include "opal/mca/base/base.h"
 #include "opal/mca/event/event.h"
 #include "opal/mca/pmix/pmix.h"
@@ -51,7 +53,7 @@
 /* object for tracking requests so we can
  * correctly route the eventual reply */
  typedef struct {
-    opal_object_t super;
+    opal_list_item_t super;
     opal_event_t ev;
     int status;
     int timeout;
@@ -70,6 +72,36 @@
 } pmix_server_req_t;
 OBJ_CLASS_DECLARATION(pmix_server_req_t);
 
+/* the local direct modex requests outstanding for
+ * a given target proc - the first one in the list
+ * is the one that was forwarded to the host daemon */
+typedef struct {
+    opal_object_t super;
+    opal_process_name_t target;
+    opal_list_t reqs;
+} pmix_server_dmx_t;
+OBJ_CLASS_DECLARATION(pmix_server_dmx_t);
+
+/* direct modex requests bound for the same host daemon
+ * are collected and sent as a single message */
+typedef struct {
+    opal_list_item_t super;
+    orte_process_name_t daemon;
+    int32_t nreqs;
+    opal_buffer_t *buf;
+} pmix_server_dmx_batch_t;
+OBJ_CLASS_DECLARATION(pmix_server_dmx_batch_t);
+
+/* publish/lookup/unpublish requests bound for the same
+ * data server are collected and sent as a single message */
+typedef struct {
+    opal_list_item_t super;
+    orte_process_name_t target;
+    int32_t nreqs;
+    opal_buffer_t *buf;
+} pmix_server_pub_batch_t;
+OBJ_CLASS_DECLARATION(pmix_server_pub_batch_t);
+
 /* object for thread-shifting server operations */
 typedef struct {
     opal_object_t super;
@@ -167,6 +199,10 @@ extern int pmix_server_deregister_events_fn(opal_list_t *info,
                                             opal_pmix_op_cbfunc_t cbfunc,
                                             void *cbdata);
 
+/* track/untrack local direct modex requests by target */
+extern int pmix_server_dmdx_track(pmix_server_req_t *req, bool *first);
+extern void pmix_server_dmdx_untrack(pmix_server_req_t *req);
+
 /* declare the RML recv functions for responses */
 extern void pmix_server_launch_resp(int status, orte_process_name_t* sender,
                                     opal_buffer_t *buffer,
@@ -186,6 +222,13 @@ typedef struct {
     int verbosity;
     int output;
     opal_hotel_t reqs;
+    opal_proc_table_t dmx_reqs;
+    opal_list_t dmx_batches;
+    opal_event_t dmx_flush;
+    bool dmx_flush_active;
+    opal_list_t pub_batches;
+    opal_event_t pub_flush;
+    bool pub_flush_active;
     int num_rooms;
     int timeout;
     char *server_uri;
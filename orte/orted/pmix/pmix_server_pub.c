@@ -44,9 +44,97 @@
 
 #include "pmix_server_internal.h"
 
+/* tell a requestor its operation could not be completed */
+static void pub_fail(int room_num, int status)
+{
+    pmix_server_req_t *req = NULL;
+
+    opal_hotel_checkout_and_return_occupant(&orte_pmix_server_globals.reqs, room_num, (void**)&req);
+    if (NULL == req) {
+        return;
+    }
+    if (NULL != req->opcbfunc) {
+        req->opcbfunc(status, req->cbdata);
+    } else if (NULL != req->lkcbfunc) {
+        req->lkcbfunc(status, NULL, req->cbdata);
+    }
+    OBJ_RELEASE(req);
+}
+
+/* send each data server a single message covering all the
+ * requests we collected for it during this pass thru the
+ * event library */
+static void pub_flush(int sd, short args, void *cbdata)
+{
+    pmix_server_pub_batch_t *batch;
+    opal_buffer_t *buf;
+    int rc, room_num;
+    int32_t cnt;
+    uint8_t cmd = ORTE_PMIX_BULK_CMD;
+
+    orte_pmix_server_globals.pub_flush_active = false;
+
+    while (NULL != (batch = (pmix_server_pub_batch_t*)opal_list_remove_first(&orte_pmix_server_globals.pub_batches))) {
+        opal_output_verbose(2, orte_pmix_server_globals.output,
+                            "%s pub:flush sending %d requests to %s",
+                            ORTE_NAME_PRINT(ORTE_PROC_MY_NAME), batch->nreqs,
+                            ORTE_NAME_PRINT(&batch->target));
+        if (1 == batch->nreqs) {
+            /* nothing to gain from wrapping it */
+            cnt = 1;
+            if (OPAL_SUCCESS != (rc = opal_dss.unpack(batch->buf, &buf, &cnt, OPAL_BUFFER))) {
+                ORTE_ERROR_LOG(rc);
+                OBJ_RELEASE(batch);
+                continue;
+            }
+        } else {
+            buf = OBJ_NEW(opal_buffer_t);
+            /* the room number is ignored for bulk requests */
+            room_num = -1;
+            if (OPAL_SUCCESS != (rc = opal_dss.pack(buf, &room_num, 1, OPAL_INT)) ||
+                OPAL_SUCCESS != (rc = opal_dss.pack(buf, &cmd, 1, OPAL_UINT8)) ||
+                OPAL_SUCCESS != (rc = opal_dss.pack(buf, &batch->nreqs, 1, OPAL_INT32)) ||
+                OPAL_SUCCESS != (rc = opal_dss.copy_payload(buf, batch->buf))) {
+                ORTE_ERROR_LOG(rc);
+                OBJ_RELEASE(buf);
+                goto error;
+            }
+        }
+        if (ORTE_SUCCESS != (rc = orte_rml.send_buffer_nb(&batch->target, buf,
+                                                          ORTE_RML_TAG_DATA_SERVER,
+                                                          orte_rml_send_callback, NULL))) {
+            ORTE_ERROR_LOG(rc);
+            if (1 < batch->nreqs) {
+                OBJ_RELEASE(buf);
+                goto error;
+            }
+            /* recover the room number from the lone request */
+            cnt = 1;
+            if (OPAL_SUCCESS == opal_dss.unpack(buf, &room_num, &cnt, OPAL_INT)) {
+                pub_fail(room_num, rc);
+            }
+            OBJ_RELEASE(buf);
+        }
+        OBJ_RELEASE(batch);
+        continue;
+
+      error:
+        /* don't leave any of the requestors hanging */
+        cnt = 1;
+        while (OPAL_SUCCESS == opal_dss.unpack(batch->buf, &buf, &cnt, OPAL_BUFFER)) {
+            if (OPAL_SUCCESS == opal_dss.unpack(buf, &room_num, &cnt, OPAL_INT)) {
+                pub_fail(room_num, rc);
+            }
+            OBJ_RELEASE(buf);
+        }
+        OBJ_RELEASE(batch);
+    }
+}
+
 static void execute(int sd, short args, void *cbdata)
 {
     pmix_server_req_t *req = (pmix_server_req_t*)cbdata;
+    pmix_server_pub_batch_t *batch;
     int rc;
     opal_buffer_t *xfer;
 
@@ -59,21 +147,45 @@ static void execute(int sd, short args, void *cbdata)
     /* setup the xfer */
     xfer = OBJ_NEW(opal_buffer_t);
     /* pack the room number */
-    if (OPAL_SUCCESS != (rc = opal_dss.pack(xfer, &req->room_num, 1, OPAL_INT))) {
+    if (OPAL_SUCCESS != (rc = opal_dss.pack(xfer, &req->room_num, 1, OPAL_INT)) ||
+        OPAL_SUCCESS != (rc = opal_dss.copy_payload(xfer, &req->msg))) {
         ORTE_ERROR_LOG(rc);
         OBJ_RELEASE(xfer);
-        goto callback;
+        goto checkout;
     }
-    opal_dss.copy_payload(xfer, &req->msg);
 
-    /* send the request to the target */
-    rc = orte_rml.send_buffer_nb(&req->target, xfer,
-                                 ORTE_RML_TAG_DATA_SERVER,
-                                 orte_rml_send_callback, NULL);
-    if (ORTE_SUCCESS == rc) {
-        return;
+    /* add it to the batch for the target */
+    OPAL_LIST_FOREACH(batch, &orte_pmix_server_globals.pub_batches, pmix_server_pub_batch_t) {
+        if (OPAL_EQUAL == orte_util_compare_name_fields(ORTE_NS_CMP_ALL, &batch->target, &req->target)) {
+            goto pack;
+        }
+    }
+    batch = OBJ_NEW(pmix_server_pub_batch_t);
+    batch->target = req->target;
+    opal_list_append(&orte_pmix_server_globals.pub_batches, &batch->super);
+
+  pack:
+    rc = opal_dss.pack(batch->buf, &xfer, 1, OPAL_BUFFER);
+    OBJ_RELEASE(xfer);
+    if (OPAL_SUCCESS != rc) {
+        ORTE_ERROR_LOG(rc);
+        goto checkout;
+    }
+    batch->nreqs++;
+
+    /* requests already queued behind us will be processed
+     * before the flush, and so will join this batch */
+    if (!orte_pmix_server_globals.pub_flush_active) {
+        orte_pmix_server_globals.pub_flush_active = true;
+        opal_event_set(orte_event_base, &orte_pmix_server_globals.pub_flush,
+                       -1, OPAL_EV_WRITE, pub_flush, NULL);
+        opal_event_set_priority(&orte_pmix_server_globals.pub_flush, ORTE_MSG_PRI);
+        opal_event_active(&orte_pmix_server_globals.pub_flush, OPAL_EV_WRITE, 1);
     }
+    return;
 
+  checkout:
+    opal_hotel_checkout(&orte_pmix_server_globals.reqs, req->room_num);
   callback:
     /* execute the callback to avoid having the client hang */
     if (NULL != req->opcbfunc) {
@@ -81,7 +193,6 @@ static void execute(int sd, short args, void *cbdata)
     } else if (NULL != req->lkcbfunc) {
         req->lkcbfunc(rc, NULL, req->cbdata);
     }
-    opal_hotel_checkout(&orte_pmix_server_globals.reqs, req->room_num);
     OBJ_RELEASE(req);
 }
 
@@ -366,7 +477,8 @@ void pmix_server_keyval_client(int status, orte_process_name_t* sender,
                                orte_rml_tag_t tg, void *cbdata)
 {
     int rc, ret, room_num = -1;
-    int32_t cnt;
+    int32_t cnt, n, nans;
+    opal_buffer_t *ans;
     pmix_server_req_t *req=NULL;
     opal_list_t info;
     opal_value_t *iptr;
@@ -385,6 +497,27 @@ void pmix_server_keyval_client(int status, orte_process_name_t* sender,
         return;
     }
 
+    if (ORTE_PMIX_BULK_ROOM == room_num) {
+        /* the answers to a bulk request - each is laid
+         * out as if it had been sent on its own */
+        OBJ_DESTRUCT(&info);
+        cnt = 1;
+        if (OPAL_SUCCESS != (rc = opal_dss.unpack(buffer, &nans, &cnt, OPAL_INT32))) {
+            ORTE_ERROR_LOG(rc);
+            return;
+        }
+        for (n=0; n < nans; n++) {
+            cnt = 1;
+            if (OPAL_SUCCESS != (rc = opal_dss.unpack(buffer, &ans, &cnt, OPAL_BUFFER))) {
+                ORTE_ERROR_LOG(rc);
+                return;
+            }
+            pmix_server_keyval_client(status, sender, ans, tg, cbdata);
+            OBJ_RELEASE(ans);
+        }
+        return;
+    }
+
     /* unpack the status */
     cnt = 1;
     if (OPAL_SUCCESS != (rc = opal_dss.unpack(buffer, &ret, &cnt, OPAL_INT))) {
@@ -67,16 +67,16 @@ int orte_dt_pack_job(opal_buffer_t *buffer, const void *src,
     int32_t i, j, count;
     orte_job_t **jobs;
     orte_app_context_t *app;
-    orte_proc_t *proc;
+    orte_proc_t *proc, **procs;
     orte_attribute_t *kv;
 
     /* array of pointers to orte_job_t objects - need to pack the objects a set of fields at a time */
     jobs = (orte_job_t**) src;
 
     for (i=0; i < num_vals; i++) {
-        /* pack the jobid */
-        if (ORTE_SUCCESS != (rc = opal_dss_pack_buffer(buffer,
-                        (void*)(&(jobs[i]->jobid)), 1, ORTE_JOBID))) {
+        /* pack the fixed-size fields */
+        if (ORTE_SUCCESS != (rc = orte_dt_pack_record(buffer, &orte_dt_job_schema, jobs[i],
+                                                      (0 < i) ? jobs[i-1] : NULL))) {
             ORTE_ERROR_LOG(rc);
             return rc;
         }
@@ -93,13 +93,6 @@ int orte_dt_pack_job(opal_buffer_t *buffer, const void *src,
             }
         }
 
-        /* pack the number of apps */
-        if (ORTE_SUCCESS != (rc = opal_dss_pack_buffer(buffer,
-                         (void*)(&(jobs[i]->num_apps)), 1, ORTE_APP_IDX))) {
-            ORTE_ERROR_LOG(rc);
-            return rc;
-        }
-
         /* if there are apps, pack the app_contexts */
         if (0 < jobs[i]->num_apps) {
             for (j=0; j < jobs[i]->apps->size; j++) {
@@ -113,42 +106,26 @@ int orte_dt_pack_job(opal_buffer_t *buffer, const void *src,
             }
         }
 
-        /* pack the number of procs and offset */
-        if (ORTE_SUCCESS != (rc = opal_dss_pack_buffer(buffer,
-                         (void*)(&(jobs[i]->num_procs)), 1, ORTE_VPID))) {
-            ORTE_ERROR_LOG(rc);
-            return rc;
-        }
-        if (ORTE_SUCCESS != (rc = opal_dss_pack_buffer(buffer,
-                         (void*)(&(jobs[i]->offset)), 1, ORTE_VPID))) {
-            ORTE_ERROR_LOG(rc);
-            return rc;
-        }
-        /* and the procs, if we have them */
+        /* and the procs, if we have them - all at once, so
+         * each can be sent as the changes from the one before */
         if (0 < jobs[i]->num_procs) {
+            procs = (orte_proc_t**)malloc(jobs[i]->procs->size * sizeof(orte_proc_t*));
+            if (NULL == procs) {
+                ORTE_ERROR_LOG(ORTE_ERR_OUT_OF_RESOURCE);
+                return ORTE_ERR_OUT_OF_RESOURCE;
+            }
+            count = 0;
             for (j=0; j < jobs[i]->procs->size; j++) {
-                if (NULL == (proc = (orte_proc_t*)opal_pointer_array_get_item(jobs[i]->procs, j))) {
-                    continue;
-                }
-                if (ORTE_SUCCESS != (rc = opal_dss_pack_buffer(buffer, (void*)&proc, 1, ORTE_PROC))) {
-                    ORTE_ERROR_LOG(rc);
-                    return rc;
+                if (NULL != (proc = (orte_proc_t*)opal_pointer_array_get_item(jobs[i]->procs, j))) {
+                    procs[count++] = proc;
                 }
             }
-        }
-
-        /* pack the stdin target */
-        if (ORTE_SUCCESS != (rc = opal_dss_pack_buffer(buffer,
-                         (void*)(&(jobs[i]->stdin_target)), 1, ORTE_VPID))) {
-            ORTE_ERROR_LOG(rc);
-            return rc;
-        }
-
-        /* pack the total slots allocated to the job */
-        if (ORTE_SUCCESS != (rc = opal_dss_pack_buffer(buffer,
-                         (void*)(&(jobs[i]->total_slots_alloc)), 1, ORTE_STD_CNTR))) {
-            ORTE_ERROR_LOG(rc);
-            return rc;
+            rc = opal_dss_pack_buffer(buffer, (void*)procs, count, ORTE_PROC);
+            free(procs);
+            if (ORTE_SUCCESS != rc) {
+                ORTE_ERROR_LOG(rc);
+                return rc;
+            }
         }
 
         /* if the map is NULL, then we cannot pack it as there is
@@ -182,20 +159,6 @@ int orte_dt_pack_job(opal_buffer_t *buffer, const void *src,
 
         /* do not pack the bookmark or oversubscribe_override flags */
 
-        /* pack the job state */
-        if (ORTE_SUCCESS != (rc = opal_dss_pack_buffer(buffer,
-                         (void*)(&(jobs[i]->state)), 1, ORTE_JOB_STATE))) {
-            ORTE_ERROR_LOG(rc);
-            return rc;
-        }
-
-        /* pack the flags */
-        if (ORTE_SUCCESS != (rc = opal_dss_pack_buffer(buffer,
-                        (void*)(&(jobs[i]->flags)), 1, ORTE_JOB_FLAGS_T))) {
-            ORTE_ERROR_LOG(rc);
-            return rc;
-        }
-
         /* pack the attributes that need to be sent */
         count = 0;
         OPAL_LIST_FOREACH(kv, &jobs[i]->attributes, orte_attribute_t) {
@@ -228,7 +191,6 @@ int orte_dt_pack_node(opal_buffer_t *buffer, const void *src,
     int rc;
     int32_t i, count;
     orte_node_t **nodes;
-    uint8_t flag;
     orte_attribute_t *kv;
 
     /* array of pointers to orte_node_t objects - need to pack the objects a set of fields at a time */
@@ -237,34 +199,21 @@ int orte_dt_pack_node(opal_buffer_t *buffer, const void *src,
     for (i=0; i < num_vals; i++) {
         /* do not pack the index - it is meaningless on the other end */
 
-        /* pack the node name */
-        if (ORTE_SUCCESS != (rc = opal_dss_pack_buffer(buffer, (void*)(&(nodes[i]->name)), 1, OPAL_STRING))) {
-            ORTE_ERROR_LOG(rc);
-            return rc;
-        }
-
-        /* do not pack the daemon name or launch id */
-
-        /* pack the number of procs on the node */
-        if (ORTE_SUCCESS != (rc = opal_dss_pack_buffer(buffer, (void*)(&(nodes[i]->num_procs)), 1, ORTE_VPID))) {
+        /* pack the number of procs on the node, whether we are
+         * oversubscribed or not, and the state */
+        if (ORTE_SUCCESS != (rc = orte_dt_pack_record(buffer, &orte_dt_node_schema, nodes[i],
+                                                      (0 < i) ? nodes[i-1] : NULL))) {
             ORTE_ERROR_LOG(rc);
             return rc;
         }
 
-        /* do not pack the procs */
-
-        /* pack whether we are oversubscribed or not */
-        flag = ORTE_FLAG_TEST(nodes[i], ORTE_NODE_FLAG_OVERSUBSCRIBED);
-        if (ORTE_SUCCESS != (rc = opal_dss_pack_buffer(buffer, (void*)(&flag), 1, OPAL_UINT8))) {
+        /* pack the node name */
+        if (ORTE_SUCCESS != (rc = opal_dss_pack_buffer(buffer, (void*)(&(nodes[i]->name)), 1, OPAL_STRING))) {
             ORTE_ERROR_LOG(rc);
             return rc;
         }
 
-        /* pack the state */
-        if (ORTE_SUCCESS != (rc = opal_dss_pack_buffer(buffer, (void*)(&(nodes[i]->state)), 1, ORTE_NODE_STATE))) {
-            ORTE_ERROR_LOG(rc);
-            return rc;
-        }
+        /* do not pack the daemon name or launch id, or the procs */
 
         /* pack any shared attributes */
         count = 0;
@@ -304,44 +253,10 @@ int orte_dt_pack_proc(opal_buffer_t *buffer, const void *src,
     procs = (orte_proc_t**) src;
 
     for (i=0; i < num_vals; i++) {
-        /* pack the name */
-        if (ORTE_SUCCESS != (rc = opal_dss_pack_buffer(buffer,
-                         (void*)(&(procs[i]->name)), 1, ORTE_NAME))) {
-            ORTE_ERROR_LOG(rc);
-            return rc;
-        }
-
-        /* pack the daemon/node it is on */
-        if (ORTE_SUCCESS != (rc = opal_dss_pack_buffer(buffer,
-                         (void*)(&(procs[i]->parent)), 1, ORTE_VPID))) {
-            ORTE_ERROR_LOG(rc);
-            return rc;
-        }
-
-        /* pack the local rank */
-        if (ORTE_SUCCESS != (rc = opal_dss_pack_buffer(buffer,
-                         (void*)(&(procs[i]->local_rank)), 1, ORTE_LOCAL_RANK))) {
-            ORTE_ERROR_LOG(rc);
-            return rc;
-        }
-
-        /* pack the node rank */
-        if (ORTE_SUCCESS != (rc = opal_dss_pack_buffer(buffer,
-                         (void*)(&(procs[i]->node_rank)), 1, ORTE_NODE_RANK))) {
-            ORTE_ERROR_LOG(rc);
-            return rc;
-        }
-
-        /* pack the state */
-        if (ORTE_SUCCESS != (rc = opal_dss_pack_buffer(buffer,
-                         (void*)(&(procs[i]->state)), 1, ORTE_PROC_STATE))) {
-            ORTE_ERROR_LOG(rc);
-            return rc;
-        }
-
-        /* pack the app context index */
-        if (ORTE_SUCCESS != (rc = opal_dss_pack_buffer(buffer,
-                         (void*)(&(procs[i]->app_idx)), 1, ORTE_STD_CNTR))) {
+        /* pack the name, the daemon/node it is on, the local and
+         * node ranks, the state and the app context index */
+        if (ORTE_SUCCESS != (rc = orte_dt_pack_record(buffer, &orte_dt_proc_schema, procs[i],
+                                                      (0 < i) ? procs[i-1] : NULL))) {
             ORTE_ERROR_LOG(rc);
             return rc;
         }
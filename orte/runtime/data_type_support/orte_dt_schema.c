@@ -0,0 +1,309 @@
+/*
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+/*
+ * Table-driven packing of the fixed-size fields of ORTE objects. Each
+ * schema lists the fields of an object that get sent, in wire order.
+ * A non-described buffer gets all of a record in one pass - room for
+ * it is reserved once and each field is stored in network byte order
+ * directly, instead of going through the DSS type lookup per field.
+ * Other buffer types encode fields their own way (type tags, varints)
+ * so there each field is still handed to the DSS.
+ *
+ * If orte_pack_changed_fields is set, each record starts with a mask
+ * of the fields it carries, and a field equal to that of the previous
+ * record in the same array is left out - the receiver takes it from
+ * the record it unpacked just before. Arrays of procs are mostly the
+ * same jobid, state and app over and over.
+ */
+
+#include "orte_config.h"
+#include "orte/types.h"
+
+#include <string.h>
+
+#include "opal/dss/dss.h"
+#include "opal/dss/dss_internal.h"
+
+#include "orte/mca/errmgr/errmgr.h"
+#include "orte/runtime/orte_globals.h"
+#include "orte/runtime/data_type_support/orte_dt_support.h"
+
+/* the most fields a schema can have */
+#define ORTE_DT_MAX_FIELDS  16
+
+static const orte_dt_field_t job_fields[] = {
+    ORTE_DT_FIELD(orte_job_t, jobid, ORTE_JOBID),
+    ORTE_DT_FIELD(orte_job_t, num_apps, ORTE_APP_IDX),
+    ORTE_DT_FIELD(orte_job_t, num_procs, ORTE_VPID),
+    ORTE_DT_FIELD(orte_job_t, offset, ORTE_VPID),
+    ORTE_DT_FIELD(orte_job_t, stdin_target, ORTE_VPID),
+    ORTE_DT_FIELD(orte_job_t, total_slots_alloc, ORTE_STD_CNTR),
+    ORTE_DT_FIELD(orte_job_t, state, ORTE_JOB_STATE),
+    ORTE_DT_FIELD(orte_job_t, flags, ORTE_JOB_FLAGS_T)
+};
+const orte_dt_schema_t orte_dt_job_schema = {
+    job_fields, sizeof(job_fields) / sizeof(job_fields[0])
+};
+
+static const orte_dt_field_t node_fields[] = {
+    ORTE_DT_FIELD(orte_node_t, num_procs, ORTE_VPID),
+    ORTE_DT_FLAG(orte_node_t, flags, ORTE_NODE_FLAG_OVERSUBSCRIBED),
+    ORTE_DT_FIELD(orte_node_t, state, ORTE_NODE_STATE)
+};
+const orte_dt_schema_t orte_dt_node_schema = {
+    node_fields, sizeof(node_fields) / sizeof(node_fields[0])
+};
+
+/* the name goes as its two halves so the jobid can be left out */
+static const orte_dt_field_t proc_fields[] = {
+    ORTE_DT_FIELD(orte_proc_t, name.jobid, ORTE_JOBID),
+    ORTE_DT_FIELD(orte_proc_t, name.vpid, ORTE_VPID),
+    ORTE_DT_FIELD(orte_proc_t, parent, ORTE_VPID),
+    ORTE_DT_FIELD(orte_proc_t, local_rank, ORTE_LOCAL_RANK),
+    ORTE_DT_FIELD(orte_proc_t, node_rank, ORTE_NODE_RANK),
+    ORTE_DT_FIELD(orte_proc_t, state, ORTE_PROC_STATE),
+    ORTE_DT_FIELD(orte_proc_t, app_idx, ORTE_STD_CNTR)
+};
+const orte_dt_schema_t orte_dt_proc_schema = {
+    proc_fields, sizeof(proc_fields) / sizeof(proc_fields[0])
+};
+
+#define IS_SENT(m, n, i)  (0 == (n) || ((m)[(i) / 8] & (1 << ((i) % 8))))
+
+static inline bool field_changed(const orte_dt_field_t *f,
+                                 const char *obj, const char *prev)
+{
+    if (0 != f->flag) {
+        return (obj[f->offset] & f->flag) != (prev[f->offset] & f->flag);
+    }
+    return 0 != memcmp(obj + f->offset, prev + f->offset, f->width);
+}
+
+static inline char *put_field(char *dst, const orte_dt_field_t *f, const char *obj)
+{
+    uint16_t v16;
+    uint32_t v32;
+    uint64_t v64;
+
+    if (0 != f->flag) {
+        *dst = obj[f->offset] & f->flag;
+        return dst + 1;
+    }
+    switch (f->width) {
+    case 1:
+        *dst = obj[f->offset];
+        break;
+    case 2:
+        memcpy(&v16, obj + f->offset, sizeof(v16));
+        v16 = htons(v16);
+        memcpy(dst, &v16, sizeof(v16));
+        break;
+    case 4:
+        memcpy(&v32, obj + f->offset, sizeof(v32));
+        v32 = htonl(v32);
+        memcpy(dst, &v32, sizeof(v32));
+        break;
+    default:
+        memcpy(&v64, obj + f->offset, sizeof(v64));
+        v64 = hton64(v64);
+        memcpy(dst, &v64, sizeof(v64));
+        break;
+    }
+    return dst + f->width;
+}
+
+static inline const char *get_field(const char *src, const orte_dt_field_t *f, char *obj)
+{
+    uint16_t v16;
+    uint32_t v32;
+    uint64_t v64;
+
+    if (0 != f->flag) {
+        if (0 != *src) {
+            obj[f->offset] |= f->flag;
+        } else {
+            obj[f->offset] &= ~f->flag;
+        }
+        return src + 1;
+    }
+    switch (f->width) {
+    case 1:
+        obj[f->offset] = *src;
+        break;
+    case 2:
+        memcpy(&v16, src, sizeof(v16));
+        v16 = ntohs(v16);
+        memcpy(obj + f->offset, &v16, sizeof(v16));
+        break;
+    case 4:
+        memcpy(&v32, src, sizeof(v32));
+        v32 = ntohl(v32);
+        memcpy(obj + f->offset, &v32, sizeof(v32));
+        break;
+    default:
+        memcpy(&v64, src, sizeof(v64));
+        v64 = ntoh64(v64);
+        memcpy(obj + f->offset, &v64, sizeof(v64));
+        break;
+    }
+    return src + f->width;
+}
+
+int orte_dt_pack_record(opal_buffer_t *buffer, const orte_dt_schema_t *schema,
+                        const void *obj, const void *prev)
+{
+    const orte_dt_field_t *f;
+    const char *src = (const char*)obj;
+    uint8_t mask[ORTE_DT_MAX_FIELDS / 8], flag;
+    size_t nmask = 0, len = 0;
+    char *dst;
+    int i, rc;
+
+    if (orte_pack_changed_fields) {
+        nmask = (schema->nfields + 7) / 8;
+        memset(mask, 0, sizeof(mask));
+    }
+    for (i=0; i < schema->nfields; i++) {
+        f = &schema->fields[i];
+        if (0 < nmask) {
+            if (NULL != prev && !field_changed(f, src, (const char*)prev)) {
+                continue;
+            }
+            mask[i / 8] |= 1 << (i % 8);
+        }
+        len += f->width;
+    }
+
+    if (OPAL_DSS_BUFFER_NON_DESC == buffer->type) {
+        if (NULL == (dst = opal_dss_buffer_extend(buffer, nmask + len))) {
+            ORTE_ERROR_LOG(ORTE_ERR_OUT_OF_RESOURCE);
+            return ORTE_ERR_OUT_OF_RESOURCE;
+        }
+        memcpy(dst, mask, nmask);
+        dst += nmask;
+        for (i=0; i < schema->nfields; i++) {
+            if (IS_SENT(mask, nmask, i)) {
+                dst = put_field(dst, &schema->fields[i], src);
+            }
+        }
+        buffer->bytes_used += dst - buffer->pack_ptr;
+        buffer->pack_ptr = dst;
+        return ORTE_SUCCESS;
+    }
+
+    /* described and compact buffers encode each value their own way */
+    if (0 < nmask &&
+        ORTE_SUCCESS != (rc = opal_dss_pack_buffer(buffer, mask, nmask, OPAL_UINT8))) {
+        ORTE_ERROR_LOG(rc);
+        return rc;
+    }
+    for (i=0; i < schema->nfields; i++) {
+        if (!IS_SENT(mask, nmask, i)) {
+            continue;
+        }
+        f = &schema->fields[i];
+        if (0 != f->flag) {
+            flag = src[f->offset] & f->flag;
+            rc = opal_dss_pack_buffer(buffer, &flag, 1, OPAL_UINT8);
+        } else {
+            rc = opal_dss_pack_buffer(buffer, src + f->offset, 1, f->type);
+        }
+        if (ORTE_SUCCESS != rc) {
+            ORTE_ERROR_LOG(rc);
+            return rc;
+        }
+    }
+    return ORTE_SUCCESS;
+}
+
+int orte_dt_unpack_record(opal_buffer_t *buffer, const orte_dt_schema_t *schema,
+                          void *obj, const void *prev)
+{
+    const orte_dt_field_t *f;
+    char *dst = (char*)obj;
+    const char *src;
+    uint8_t mask[ORTE_DT_MAX_FIELDS / 8], flag;
+    size_t nmask = 0, len = 0;
+    int32_t n;
+    int i, rc;
+
+    if (orte_pack_changed_fields) {
+        nmask = (schema->nfields + 7) / 8;
+    }
+
+    if (OPAL_DSS_BUFFER_NON_DESC == buffer->type) {
+        if (opal_dss_too_small(buffer, nmask)) {
+            return ORTE_ERR_UNPACK_READ_PAST_END_OF_BUFFER;
+        }
+        memcpy(mask, buffer->unpack_ptr, nmask);
+        for (i=0; i < schema->nfields; i++) {
+            if (IS_SENT(mask, nmask, i)) {
+                len += schema->fields[i].width;
+            }
+        }
+        if (opal_dss_too_small(buffer, nmask + len)) {
+            return ORTE_ERR_UNPACK_READ_PAST_END_OF_BUFFER;
+        }
+        src = buffer->unpack_ptr + nmask;
+        for (i=0; i < schema->nfields; i++) {
+            if (IS_SENT(mask, nmask, i)) {
+                src = get_field(src, &schema->fields[i], dst);
+            }
+        }
+        buffer->unpack_ptr = (char*)src;
+    } else {
+        n = nmask;
+        if (0 < nmask &&
+            ORTE_SUCCESS != (rc = opal_dss_unpack_buffer(buffer, mask, &n, OPAL_UINT8))) {
+            ORTE_ERROR_LOG(rc);
+            return rc;
+        }
+        for (i=0; i < schema->nfields; i++) {
+            if (!IS_SENT(mask, nmask, i)) {
+                continue;
+            }
+            f = &schema->fields[i];
+            n = 1;
+            if (0 != f->flag) {
+                if (ORTE_SUCCESS == (rc = opal_dss_unpack_buffer(buffer, &flag, &n, OPAL_UINT8))) {
+                    if (0 != flag) {
+                        dst[f->offset] |= f->flag;
+                    } else {
+                        dst[f->offset] &= ~f->flag;
+                    }
+                }
+            } else {
+                rc = opal_dss_unpack_buffer(buffer, dst + f->offset, &n, f->type);
+            }
+            if (ORTE_SUCCESS != rc) {
+                ORTE_ERROR_LOG(rc);
+                return rc;
+            }
+        }
+    }
+
+    /* whatever was left out is the same as in the previous record */
+    for (i=0; i < schema->nfields; i++) {
+        if (IS_SENT(mask, nmask, i)) {
+            continue;
+        }
+        if (NULL == prev) {
+            ORTE_ERROR_LOG(ORTE_ERR_UNPACK_FAILURE);
+            return ORTE_ERR_UNPACK_FAILURE;
+        }
+        f = &schema->fields[i];
+        if (0 != f->flag) {
+            dst[f->offset] = (dst[f->offset] & ~f->flag) |
+                             (((const char*)prev)[f->offset] & f->flag);
+        } else {
+            memcpy(dst + f->offset, (const char*)prev + f->offset, f->width);
+        }
+    }
+    return ORTE_SUCCESS;
+}
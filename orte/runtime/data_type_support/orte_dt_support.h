@@ -28,6 +28,9 @@
  * includes
  */
 #include "orte_config.h"
+
+#include <stddef.h>
+
 #include "orte/constants.h"
 #include "orte/types.h"
 
@@ -168,6 +171,37 @@ int orte_dt_unpack_attr(opal_buffer_t *buffer, void *dest, int32_t *num_vals,
 int orte_dt_unpack_sig(opal_buffer_t *buffer, void *dest, int32_t *num_vals,
                        opal_data_type_t type);
 
+/** Schemas for the fixed-size fields of objects - each field is
+ * sent as the given type, and the member must be the same size */
+typedef struct {
+    opal_data_type_t type;
+    size_t offset;
+    size_t width;
+    /* non-zero if the field is just this bit of a flags byte */
+    uint8_t flag;
+} orte_dt_field_t;
+
+typedef struct {
+    const orte_dt_field_t *fields;
+    int nfields;
+} orte_dt_schema_t;
+
+#define ORTE_DT_FIELD(t, m, typ) \
+    { (typ), offsetof(t, m), sizeof(((t*)0)->m), 0 }
+#define ORTE_DT_FLAG(t, m, f) \
+    { OPAL_UINT8, offsetof(t, m), 1, (f) }
+
+extern const orte_dt_schema_t orte_dt_job_schema;
+extern const orte_dt_schema_t orte_dt_node_schema;
+extern const orte_dt_schema_t orte_dt_proc_schema;
+
+/* pack/unpack the schema fields of one object - prev is the object
+ * before it in the same array, if any */
+int orte_dt_pack_record(opal_buffer_t *buffer, const orte_dt_schema_t *schema,
+                        const void *obj, const void *prev);
+int orte_dt_unpack_record(opal_buffer_t *buffer, const orte_dt_schema_t *schema,
+                          void *obj, const void *prev);
+
 END_C_DECLS
 
 #endif
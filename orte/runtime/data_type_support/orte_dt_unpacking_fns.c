@@ -75,40 +75,32 @@ int orte_dt_unpack_job(opal_buffer_t *buffer, void *dest,
         jobs[i] = OBJ_NEW(orte_job_t);
         if (NULL == jobs[i]) {
             ORTE_ERROR_LOG(ORTE_ERR_OUT_OF_RESOURCE);
-            return ORTE_ERR_OUT_OF_RESOURCE;
+            rc = ORTE_ERR_OUT_OF_RESOURCE;
+            goto error;
         }
 
-        /* unpack the jobid */
-        n = 1;
-        if (ORTE_SUCCESS != (rc = opal_dss_unpack_buffer(buffer,
-                                &(jobs[i]->jobid), &n, ORTE_JOBID))) {
+        /* unpack the fixed-size fields */
+        if (ORTE_SUCCESS != (rc = orte_dt_unpack_record(buffer, &orte_dt_job_schema, jobs[i],
+                                                        (0 < i) ? jobs[i-1] : NULL))) {
             ORTE_ERROR_LOG(rc);
-            return rc;
+            goto error;
         }
         /* unpack the personality */
         n=1;
         if (ORTE_SUCCESS != (rc = opal_dss_unpack_buffer(buffer, &count, &n, OPAL_INT32))) {
             ORTE_ERROR_LOG(rc);
-            return rc;
+            goto error;
         }
         for (k=0; k < count; k++) {
             n=1;
             if (ORTE_SUCCESS != (rc = opal_dss_unpack_buffer(buffer, &tmp, &n, OPAL_STRING))) {
                 ORTE_ERROR_LOG(rc);
-                return rc;
+                goto error;
             }
             opal_argv_append_nosize(&jobs[i]->personality, tmp);
             free(tmp);
         }
 
-        /* unpack the num apps */
-        n = 1;
-        if (ORTE_SUCCESS != (rc = opal_dss_unpack_buffer(buffer,
-                                (&(jobs[i]->num_apps)), &n, ORTE_APP_IDX))) {
-            ORTE_ERROR_LOG(rc);
-            return rc;
-        }
-
         /* if there are apps, unpack them */
         if (0 < jobs[i]->num_apps) {
             orte_app_context_t *app;
@@ -117,53 +109,32 @@ int orte_dt_unpack_job(opal_buffer_t *buffer, void *dest,
                 if (ORTE_SUCCESS != (rc = opal_dss_unpack_buffer(buffer,
                                &app, &n, ORTE_APP_CONTEXT))) {
                     ORTE_ERROR_LOG(rc);
-                    return rc;
+                    goto error;
                 }
                 opal_pointer_array_add(jobs[i]->apps, app);
             }
         }
 
-        /* unpack num procs and offset */
-        n = 1;
-        if (ORTE_SUCCESS != (rc = opal_dss_unpack_buffer(buffer,
-                                (&(jobs[i]->num_procs)), &n, ORTE_VPID))) {
-            ORTE_ERROR_LOG(rc);
-            return rc;
-        }
-        n = 1;
-        if (ORTE_SUCCESS != (rc = opal_dss_unpack_buffer(buffer,
-                                (&(jobs[i]->offset)), &n, ORTE_VPID))) {
-            ORTE_ERROR_LOG(rc);
-            return rc;
-        }
         /* and the procs, if provided */
         if (0 < jobs[i]->num_procs) {
-            orte_proc_t *proc;
-            for (j=0; j < jobs[i]->num_procs; j++) {
-                n = 1;
-                if (ORTE_SUCCESS != (rc = opal_dss_unpack_buffer(buffer,
-                               &proc, &n, ORTE_PROC))) {
-                    ORTE_ERROR_LOG(rc);
-                    return rc;
-                }
-                opal_pointer_array_add(jobs[i]->procs, proc);
+            orte_proc_t **procs;
+            procs = (orte_proc_t**)calloc(jobs[i]->num_procs, sizeof(orte_proc_t*));
+            if (NULL == procs) {
+                ORTE_ERROR_LOG(ORTE_ERR_OUT_OF_RESOURCE);
+                rc = ORTE_ERR_OUT_OF_RESOURCE;
+                goto error;
+            }
+            n = jobs[i]->num_procs;
+            rc = opal_dss_unpack_buffer(buffer, procs, &n, ORTE_PROC);
+            /* a failed unpack releases the procs it made itself */
+            for (k=0; k < (int32_t)jobs[i]->num_procs && NULL != procs[k]; k++) {
+                opal_pointer_array_add(jobs[i]->procs, procs[k]);
+            }
+            free(procs);
+            if (ORTE_SUCCESS != rc) {
+                ORTE_ERROR_LOG(rc);
+                goto error;
             }
-        }
-
-        /* unpack stdin target */
-        n = 1;
-        if (ORTE_SUCCESS != (rc = opal_dss_unpack_buffer(buffer,
-                            (&(jobs[i]->stdin_target)), &n, ORTE_VPID))) {
-            ORTE_ERROR_LOG(rc);
-            return rc;
-        }
-
-        /* unpack the total slots allocated to the job */
-        n = 1;
-        if (ORTE_SUCCESS != (rc = opal_dss_unpack_buffer(buffer,
-                         (&(jobs[i]->total_slots_alloc)), &n, ORTE_STD_CNTR))) {
-            ORTE_ERROR_LOG(rc);
-            return rc;
         }
 
         /* if the map is NULL, then we din't pack it as there was
@@ -173,7 +144,7 @@ int orte_dt_unpack_job(opal_buffer_t *buffer, void *dest,
         if (ORTE_SUCCESS != (rc = opal_dss_unpack_buffer(buffer,
                                             &j, &n, ORTE_STD_CNTR))) {
             ORTE_ERROR_LOG(rc);
-            return rc;
+            goto error;
         }
         if (0 < j) {
             /* unpack the map */
@@ -181,41 +152,25 @@ int orte_dt_unpack_job(opal_buffer_t *buffer, void *dest,
             if (ORTE_SUCCESS != (rc = opal_dss_unpack_buffer(buffer,
                                             (&(jobs[i]->map)), &n, ORTE_JOB_MAP))) {
                 ORTE_ERROR_LOG(rc);
-                return rc;
+                goto error;
             }
         }
 
         /* no bookmark of oversubscribe_override flags to unpack */
 
-        /* unpack the job state */
-        n = 1;
-        if (ORTE_SUCCESS != (rc = opal_dss_unpack_buffer(buffer,
-                         (&(jobs[i]->state)), &n, ORTE_JOB_STATE))) {
-            ORTE_ERROR_LOG(rc);
-            return rc;
-        }
-
-        /* unpack the flags */
-        n = 1;
-        if (ORTE_SUCCESS != (rc = opal_dss_unpack_buffer(buffer,
-                         (&(jobs[i]->flags)), &n, ORTE_JOB_FLAGS_T))) {
-            ORTE_ERROR_LOG(rc);
-            return rc;
-        }
-
         /* unpack the attributes */
         n=1;
         if (ORTE_SUCCESS != (rc = opal_dss_unpack_buffer(buffer, &count,
                                                          &n, ORTE_STD_CNTR))) {
             ORTE_ERROR_LOG(rc);
-            return rc;
+            goto error;
         }
         for (k=0; k < count; k++) {
             n=1;
             if (ORTE_SUCCESS != (rc = opal_dss_unpack_buffer(buffer, &kv,
                                                              &n, ORTE_ATTRIBUTE))) {
                 ORTE_ERROR_LOG(rc);
-                return rc;
+                goto error;
             }
             kv->local = ORTE_ATTR_GLOBAL;  // obviously not a local value
             opal_list_append(&jobs[i]->attributes, &kv->super);
@@ -223,6 +178,18 @@ int orte_dt_unpack_job(opal_buffer_t *buffer, void *dest,
     }
 
     return ORTE_SUCCESS;
+
+  error:
+    /* don't hand back a partly unpacked array */
+    for (k=0; k <= i; k++) {
+        if (NULL != jobs[k]) {
+            /* it never made it into orte_job_data */
+            jobs[k]->jobid = ORTE_JOBID_INVALID;
+            OBJ_RELEASE(jobs[k]);
+            jobs[k] = NULL;
+        }
+    }
+    return rc;
 }
 
 /*
@@ -234,7 +201,6 @@ int orte_dt_unpack_node(opal_buffer_t *buffer, void *dest,
     int rc;
     int32_t i, n, k, count;
     orte_node_t **nodes;
-    uint8_t flag;
     orte_attribute_t *kv;
 
     /* unpack into array of orte_node_t objects */
@@ -245,69 +211,59 @@ int orte_dt_unpack_node(opal_buffer_t *buffer, void *dest,
         nodes[i] = OBJ_NEW(orte_node_t);
         if (NULL == nodes[i]) {
             ORTE_ERROR_LOG(ORTE_ERR_OUT_OF_RESOURCE);
-            return ORTE_ERR_OUT_OF_RESOURCE;
+            rc = ORTE_ERR_OUT_OF_RESOURCE;
+            goto error;
         }
 
         /* do not unpack the index - meaningless here */
 
-        /* unpack the node name */
-        n = 1;
-        if (ORTE_SUCCESS != (rc = opal_dss_unpack_buffer(buffer,
-                         &(nodes[i]->name), &n, OPAL_STRING))) {
+        /* unpack the number of procs on the node, whether we are
+         * oversubscribed, and the state */
+        if (ORTE_SUCCESS != (rc = orte_dt_unpack_record(buffer, &orte_dt_node_schema, nodes[i],
+                                                        (0 < i) ? nodes[i-1] : NULL))) {
             ORTE_ERROR_LOG(rc);
-            return rc;
+            goto error;
         }
 
-        /* do not unpack the daemon name or launch id */
-
-        /* unpack the number of procs on the node */
+        /* unpack the node name */
         n = 1;
         if (ORTE_SUCCESS != (rc = opal_dss_unpack_buffer(buffer,
-                         (&(nodes[i]->num_procs)), &n, ORTE_VPID))) {
+                         &(nodes[i]->name), &n, OPAL_STRING))) {
             ORTE_ERROR_LOG(rc);
-            return rc;
+            goto error;
         }
 
-        /* do not unpack the proc info */
-
-        /* unpack whether we are oversubscribed */
-        n = 1;
-        if (ORTE_SUCCESS != (rc = opal_dss_unpack_buffer(buffer,
-                         (&flag), &n, OPAL_UINT8))) {
-            ORTE_ERROR_LOG(rc);
-            return rc;
-        }
-        if (flag) {
-            ORTE_FLAG_SET(nodes[i], ORTE_NODE_FLAG_OVERSUBSCRIBED);
-        }
-
-        /* unpack the state */
-        n = 1;
-        if (ORTE_SUCCESS != (rc = opal_dss_unpack_buffer(buffer,
-                         (&(nodes[i]->state)), &n, ORTE_NODE_STATE))) {
-            ORTE_ERROR_LOG(rc);
-            return rc;
-        }
+        /* do not unpack the daemon name or launch id, or the proc info */
 
         /* unpack the attributes */
         n=1;
         if (ORTE_SUCCESS != (rc = opal_dss_unpack_buffer(buffer, &count,
                                                          &n, ORTE_STD_CNTR))) {
             ORTE_ERROR_LOG(rc);
-            return rc;
+            goto error;
         }
         for (k=0; k < count; k++) {
             n=1;
             if (ORTE_SUCCESS != (rc = opal_dss_unpack_buffer(buffer, &kv,
                                                              &n, ORTE_ATTRIBUTE))) {
                 ORTE_ERROR_LOG(rc);
-                return rc;
+                goto error;
             }
             kv->local = ORTE_ATTR_GLOBAL;  // obviously not a local value
             opal_list_append(&nodes[i]->attributes, &kv->super);
         }
     }
     return ORTE_SUCCESS;
+
+  error:
+    /* don't hand back a partly unpacked array */
+    for (k=0; k <= i; k++) {
+        if (NULL != nodes[k]) {
+            OBJ_RELEASE(nodes[k]);
+            nodes[k] = NULL;
+        }
+    }
+    return rc;
 }
 
 /*
@@ -329,55 +285,16 @@ int orte_dt_unpack_proc(opal_buffer_t *buffer, void *dest,
         procs[i] = OBJ_NEW(orte_proc_t);
         if (NULL == procs[i]) {
             ORTE_ERROR_LOG(ORTE_ERR_OUT_OF_RESOURCE);
-            return ORTE_ERR_OUT_OF_RESOURCE;
+            rc = ORTE_ERR_OUT_OF_RESOURCE;
+            goto error;
         }
 
-        /* unpack the name */
-        n = 1;
-        if (ORTE_SUCCESS != (rc = opal_dss_unpack_buffer(buffer,
-                         &(procs[i]->name), &n, ORTE_NAME))) {
+        /* unpack the name, the node it is on, the local and node
+         * ranks, the state and the app context index */
+        if (ORTE_SUCCESS != (rc = orte_dt_unpack_record(buffer, &orte_dt_proc_schema, procs[i],
+                                                        (0 < i) ? procs[i-1] : NULL))) {
             ORTE_ERROR_LOG(rc);
-            return rc;
-        }
-
-        /* unpack the node it is on */
-        n = 1;
-        if (ORTE_SUCCESS != (rc = opal_dss_unpack_buffer(buffer,
-                         (&(procs[i]->parent)), &n, ORTE_VPID))) {
-            ORTE_ERROR_LOG(rc);
-            return rc;
-        }
-
-       /* unpack the local rank */
-        n = 1;
-        if (ORTE_SUCCESS != (rc = opal_dss_unpack_buffer(buffer,
-                         (&(procs[i]->local_rank)), &n, ORTE_LOCAL_RANK))) {
-            ORTE_ERROR_LOG(rc);
-            return rc;
-        }
-
-        /* unpack the node rank */
-        n = 1;
-        if (ORTE_SUCCESS != (rc = opal_dss_unpack_buffer(buffer,
-                          (&(procs[i]->node_rank)), &n, ORTE_NODE_RANK))) {
-            ORTE_ERROR_LOG(rc);
-            return rc;
-        }
-
-        /* unpack the state */
-        n = 1;
-        if (ORTE_SUCCESS != (rc = opal_dss_unpack_buffer(buffer,
-                         (&(procs[i]->state)), &n, ORTE_PROC_STATE))) {
-            ORTE_ERROR_LOG(rc);
-            return rc;
-        }
-
-        /* unpack the app context index */
-        n = 1;
-        if (ORTE_SUCCESS != (rc = opal_dss_unpack_buffer(buffer,
-                         (&(procs[i]->app_idx)), &n, ORTE_STD_CNTR))) {
-            ORTE_ERROR_LOG(rc);
-            return rc;
+            goto error;
         }
 
         /* unpack the attributes */
@@ -385,20 +302,30 @@ int orte_dt_unpack_proc(opal_buffer_t *buffer, void *dest,
         if (ORTE_SUCCESS != (rc = opal_dss_unpack_buffer(buffer, &count,
                                                          &n, ORTE_STD_CNTR))) {
             ORTE_ERROR_LOG(rc);
-            return rc;
+            goto error;
         }
         for (k=0; k < count; k++) {
             n=1;
             if (ORTE_SUCCESS != (rc = opal_dss_unpack_buffer(buffer, &kv,
                                                              &n, ORTE_ATTRIBUTE))) {
                 ORTE_ERROR_LOG(rc);
-                return rc;
+                goto error;
             }
             kv->local = ORTE_ATTR_GLOBAL;  // obviously not a local value
             opal_list_append(&procs[i]->attributes, &kv->super);
         }
     }
     return ORTE_SUCCESS;
+
+  error:
+    /* don't hand back a partly unpacked array */
+    for (k=0; k <= i; k++) {
+        if (NULL != procs[k]) {
+            OBJ_RELEASE(procs[k]);
+            procs[k] = NULL;
+        }
+    }
+    return rc;
 }
 
 /*
@@ -24,6 +24,7 @@
 #include "orte/constants.h"
 #include "orte/types.h"
 
+#include <stdio.h>
 #include <string.h>
 
 #ifdef HAVE_SYS_TIME_H
@@ -33,6 +34,7 @@
 #include "opal/util/argv.h"
 #include "opal/util/output.h"
 #include "opal/class/opal_pointer_array.h"
+#include "opal/class/opal_hash_table.h"
 #include "opal/dss/dss.h"
 #include "opal/mca/pmix/pmix_types.h"
 
@@ -69,6 +71,7 @@ typedef struct {
 static void construct(orte_data_object_t *ptr)
 {
     ptr->index = -1;
+    ptr->uid = UINT32_MAX;
     OBJ_CONSTRUCT(&ptr->values, opal_list_t);
 }
 
@@ -102,8 +105,55 @@ OBJ_CLASS_INSTANCE(orte_data_req_t,
                    opal_list_item_t,
                    rqcon, rqdes);
 
+/* reference to either a stored value or a waiting request. The
+ * referenced objects are owned by the store and the pending
+ * list, respectively */
+typedef struct {
+    opal_list_item_t super;
+    orte_data_object_t *data;
+    opal_value_t *value;
+    orte_data_req_t *req;
+} orte_data_ref_t;
+static void rfcon(orte_data_ref_t *p)
+{
+    p->data = NULL;
+    p->value = NULL;
+    p->req = NULL;
+}
+OBJ_CLASS_INSTANCE(orte_data_ref_t,
+                   opal_list_item_t,
+                   rfcon, NULL);
+
+/* everything known about a given key within a uid/range
+ * scope - the values published under it in the order they
+ * were published, and the requests waiting for it */
+typedef struct {
+    opal_object_t super;
+    char *key;
+    opal_list_t data;
+    opal_list_t waiters;
+} orte_data_bucket_t;
+static void bkcon(orte_data_bucket_t *p)
+{
+    p->key = NULL;
+    OBJ_CONSTRUCT(&p->data, opal_list_t);
+    OBJ_CONSTRUCT(&p->waiters, opal_list_t);
+}
+static void bkdes(orte_data_bucket_t *p)
+{
+    if (NULL != p->key) {
+        free(p->key);
+    }
+    OPAL_LIST_DESTRUCT(&p->data);
+    OPAL_LIST_DESTRUCT(&p->waiters);
+}
+OBJ_CLASS_INSTANCE(orte_data_bucket_t,
+                   opal_object_t,
+                   bkcon, bkdes);
+
 /* local globals */
 static opal_pointer_array_t orte_data_server_store;
+static opal_hash_table_t orte_data_server_index;
 static opal_list_t pending;
 static bool initialized = false;
 
@@ -125,6 +175,12 @@ int orte_data_server_init(void)
         return rc;
     }
 
+    OBJ_CONSTRUCT(&orte_data_server_index, opal_hash_table_t);
+    if (ORTE_SUCCESS != (rc = opal_hash_table_init(&orte_data_server_index, 256))) {
+        ORTE_ERROR_LOG(rc);
+        return rc;
+    }
+
     OBJ_CONSTRUCT(&pending, opal_list_t);
 
     orte_rml.recv_buffer_nb(ORTE_NAME_WILDCARD,
@@ -140,6 +196,10 @@ void orte_data_server_finalize(void)
 {
     orte_std_cntr_t i;
     orte_data_object_t *data;
+    orte_data_bucket_t *bkt;
+    void *key, *node;
+    size_t keylen;
+    int rc;
 
     if (!initialized) {
         return;
@@ -148,6 +208,15 @@ void orte_data_server_finalize(void)
 
     orte_rml.recv_cancel(ORTE_NAME_WILDCARD, ORTE_RML_TAG_DATA_SERVER);
 
+    rc = opal_hash_table_get_first_key_ptr(&orte_data_server_index, &key, &keylen,
+                                           (void**)&bkt, &node);
+    while (OPAL_SUCCESS == rc) {
+        OBJ_RELEASE(bkt);
+        rc = opal_hash_table_get_next_key_ptr(&orte_data_server_index, &key, &keylen,
+                                              (void**)&bkt, node, &node);
+    }
+    OBJ_DESTRUCT(&orte_data_server_index);
+
     for (i=0; i < orte_data_server_store.size; i++) {
         if (NULL != (data = (orte_data_object_t*)opal_pointer_array_get_item(&orte_data_server_store, i))) {
             OBJ_RELEASE(data);
@@ -157,447 +226,628 @@ void orte_data_server_finalize(void)
     OPAL_LIST_DESTRUCT(&pending);
 }
 
-void orte_data_server(int status, orte_process_name_t* sender,
-                      opal_buffer_t* buffer, orte_rml_tag_t tag,
-                      void* cbdata)
+/* data is only visible to requests from the same uid and
+ * for the same range, so both are folded into the index key */
+static orte_data_bucket_t* get_bucket(uint32_t uid, opal_pmix_data_range_t range,
+                                      const char *key, bool create)
 {
-    uint8_t command;
-    orte_std_cntr_t count;
-    opal_process_name_t requestor;
-    orte_data_object_t *data;
-    opal_buffer_t *answer, *reply;
-    int rc, ret, k;
-    opal_value_t *iptr, *inext;
-    uint32_t ninfo, i;
-    char **keys = NULL, *str;
-    bool ret_packed = false, wait = false, data_added;
-    int room_number;
-    uint32_t uid;
-    opal_pmix_data_range_t range;
-    orte_data_req_t *req, *rqnext;
+    orte_data_bucket_t *bkt = NULL;
+    char *ikey;
 
-    OPAL_OUTPUT_VERBOSE((1, orte_debug_output,
-                         "%s data server got message from %s",
-                         ORTE_NAME_PRINT(ORTE_PROC_MY_NAME),
-                         ORTE_NAME_PRINT(sender)));
+    if (0 > asprintf(&ikey, "%u:%d:%s", uid, (int)range, key)) {
+        return NULL;
+    }
+    if (OPAL_SUCCESS == opal_hash_table_get_value_ptr(&orte_data_server_index, ikey,
+                                                      strlen(ikey), (void**)&bkt)) {
+        free(ikey);
+        return bkt;
+    }
+    if (!create) {
+        free(ikey);
+        return NULL;
+    }
+    bkt = OBJ_NEW(orte_data_bucket_t);
+    bkt->key = ikey;
+    opal_hash_table_set_value_ptr(&orte_data_server_index, ikey, strlen(ikey), bkt);
+    return bkt;
+}
 
-    /* unpack the room number of the caller's request */
-    count = 1;
-    if (ORTE_SUCCESS != (rc = opal_dss.unpack(buffer, &room_number, &count, OPAL_INT))) {
-        ORTE_ERROR_LOG(rc);
+/* drop a bucket from the index once nothing refers to it */
+static void put_bucket(orte_data_bucket_t *bkt)
+{
+    if (0 < opal_list_get_size(&bkt->data) ||
+        0 < opal_list_get_size(&bkt->waiters)) {
         return;
     }
+    opal_hash_table_remove_value_ptr(&orte_data_server_index, bkt->key, strlen(bkt->key));
+    OBJ_RELEASE(bkt);
+}
 
-    /* unpack the command */
-    count = 1;
-    if (ORTE_SUCCESS != (rc = opal_dss.unpack(buffer, &command, &count, OPAL_UINT8))) {
-        ORTE_ERROR_LOG(rc);
-        return;
+static void index_data(orte_data_object_t *data)
+{
+    orte_data_bucket_t *bkt;
+    orte_data_ref_t *ref;
+    opal_value_t *iptr;
+
+    OPAL_LIST_FOREACH(iptr, &data->values, opal_value_t) {
+        if (NULL == (bkt = get_bucket(data->uid, data->range, iptr->key, true))) {
+            ORTE_ERROR_LOG(ORTE_ERR_OUT_OF_RESOURCE);
+            continue;
+        }
+        ref = OBJ_NEW(orte_data_ref_t);
+        ref->data = data;
+        ref->value = iptr;
+        opal_list_append(&bkt->data, &ref->super);
     }
+}
 
-    answer = OBJ_NEW(opal_buffer_t);
-    /* pack the room number as this must lead any response */
-    if (ORTE_SUCCESS != (rc = opal_dss.pack(answer, &room_number, 1, OPAL_INT))) {
-        ORTE_ERROR_LOG(rc);
-        OBJ_RELEASE(answer);
+static void unindex_value(orte_data_object_t *data, opal_value_t *value)
+{
+    orte_data_bucket_t *bkt;
+    orte_data_ref_t *ref, *rnext;
+
+    if (NULL == (bkt = get_bucket(data->uid, data->range, value->key, false))) {
         return;
     }
-
-    switch(command) {
-    case ORTE_PMIX_PUBLISH_CMD:
-        data = OBJ_NEW(orte_data_object_t);
-        /* unpack the requestor */
-        count = 1;
-        if (ORTE_SUCCESS != (rc = opal_dss.unpack(buffer, &data->owner, &count, OPAL_NAME))) {
-            ORTE_ERROR_LOG(rc);
-            OBJ_RELEASE(data);
-            goto SEND_ERROR;
+    OPAL_LIST_FOREACH_SAFE(ref, rnext, &bkt->data, orte_data_ref_t) {
+        if (ref->value == value) {
+            opal_list_remove_item(&bkt->data, &ref->super);
+            OBJ_RELEASE(ref);
         }
+    }
+    put_bucket(bkt);
+}
 
-        OPAL_OUTPUT_VERBOSE((1, orte_debug_output,
-                             "%s data server: publishing data from %s",
-                             ORTE_NAME_PRINT(ORTE_PROC_MY_NAME),
-                             ORTE_NAME_PRINT(&data->owner)));
+static void remove_data(orte_data_object_t *data)
+{
+    opal_value_t *iptr;
 
-        /* unpack the range */
-        count = 1;
-        if (ORTE_SUCCESS != (rc = opal_dss.unpack(buffer, &data->range, &count, OPAL_INT))) {
-            ORTE_ERROR_LOG(rc);
-            OBJ_RELEASE(data);
-            goto SEND_ERROR;
-        }
-        /* unpack the persistence */
-        count = 1;
-        if (ORTE_SUCCESS != (rc = opal_dss.unpack(buffer, &data->persistence, &count, OPAL_INT))) {
-            ORTE_ERROR_LOG(rc);
-            OBJ_RELEASE(data);
-            goto SEND_ERROR;
+    OPAL_LIST_FOREACH(iptr, &data->values, opal_value_t) {
+        unindex_value(data, iptr);
+    }
+    opal_pointer_array_set_item(&orte_data_server_store, data->index, NULL);
+    OBJ_RELEASE(data);
+}
+
+static void add_waiter(orte_data_req_t *req)
+{
+    orte_data_bucket_t *bkt;
+    orte_data_ref_t *ref;
+    int i;
+
+    for (i=0; NULL != req->keys[i]; i++) {
+        if (NULL == (bkt = get_bucket(req->uid, req->range, req->keys[i], true))) {
+            ORTE_ERROR_LOG(ORTE_ERR_OUT_OF_RESOURCE);
+            continue;
         }
+        ref = OBJ_NEW(orte_data_ref_t);
+        ref->req = req;
+        opal_list_append(&bkt->waiters, &ref->super);
+    }
+    opal_list_append(&pending, &req->super);
+}
 
-        count = 1;
-        while (ORTE_SUCCESS == (rc = opal_dss.unpack(buffer, &iptr, &count, OPAL_VALUE))) {
-            /* if this is the userid, separate it out */
-            if (0 == strcmp(iptr->key, OPAL_PMIX_USERID)) {
-                data->uid = iptr->data.uint32;
-                OBJ_RELEASE(iptr);
-            } else {
-                OPAL_OUTPUT_VERBOSE((1, orte_debug_output,
-                                     "%s data server: adding %s to data from %s",
-                                     ORTE_NAME_PRINT(ORTE_PROC_MY_NAME), iptr->key,
-                                     ORTE_NAME_PRINT(&data->owner)));
-                opal_list_append(&data->values, &iptr->super);
+static void remove_waiter(orte_data_req_t *req)
+{
+    orte_data_bucket_t *bkt;
+    orte_data_ref_t *ref, *rnext;
+    int i;
+
+    for (i=0; NULL != req->keys[i]; i++) {
+        if (NULL == (bkt = get_bucket(req->uid, req->range, req->keys[i], false))) {
+            continue;
+        }
+        OPAL_LIST_FOREACH_SAFE(ref, rnext, &bkt->waiters, orte_data_ref_t) {
+            if (ref->req == req) {
+                opal_list_remove_item(&bkt->waiters, &ref->super);
+                OBJ_RELEASE(ref);
             }
         }
+        put_bucket(bkt);
+    }
+    opal_list_remove_item(&pending, &req->super);
+    OBJ_RELEASE(req);
+}
 
-        data->index = opal_pointer_array_add(&orte_data_server_store, data);
-
-        OPAL_OUTPUT_VERBOSE((1, orte_debug_output,
-                             "%s data server: checking for pending requests",
-                             ORTE_NAME_PRINT(ORTE_PROC_MY_NAME)));
+/* answer a waiting request with whatever it asked
+ * for from the given data object */
+static void satisfy(orte_data_req_t *req, orte_data_object_t *data)
+{
+    opal_buffer_t *reply;
+    opal_value_t *iptr;
+    int i, rc, ret = ORTE_SUCCESS;
 
-        /* check for pending requests that match this data */
-        reply = NULL;
-        OPAL_LIST_FOREACH_SAFE(req, rqnext, &pending, orte_data_req_t) {
-            if (req->uid != data->uid) {
-                continue;
-            }
-            if (req->range != data->range) {
+    reply = OBJ_NEW(opal_buffer_t);
+    /* start with their room number */
+    if (ORTE_SUCCESS != (rc = opal_dss.pack(reply, &req->room_number, 1, OPAL_INT))) {
+        ORTE_ERROR_LOG(rc);
+        OBJ_RELEASE(reply);
+        return;
+    }
+    /* then the status */
+    if (ORTE_SUCCESS != (rc = opal_dss.pack(reply, &ret, 1, OPAL_INT))) {
+        ORTE_ERROR_LOG(rc);
+        OBJ_RELEASE(reply);
+        return;
+    }
+    for (i=0; NULL != req->keys[i]; i++) {
+        OPAL_LIST_FOREACH(iptr, &data->values, opal_value_t) {
+            if (0 != strcmp(iptr->key, req->keys[i])) {
                 continue;
             }
-            for (i=0; NULL != req->keys[i]; i++) {
-                /* cycle thru the data keys for matches */
-                OPAL_LIST_FOREACH(iptr, &data->values, opal_value_t) {
-                    if (0 == strcmp(iptr->key, req->keys[i])) {
-                        /* found it - package it for return */
-                        if (NULL == reply) {
-                            reply = OBJ_NEW(opal_buffer_t);
-                            /* start with their room number */
-                            if (ORTE_SUCCESS != (rc = opal_dss.pack(reply, &req->room_number, 1, OPAL_INT))) {
-                                ORTE_ERROR_LOG(rc);
-                                break;
-                            }
-                            /* then the status */
-                            ret = ORTE_SUCCESS;
-                            if (ORTE_SUCCESS != (rc = opal_dss.pack(reply, &ret, 1, OPAL_INT))) {
-                                ORTE_ERROR_LOG(rc);
-                                break;
-                            }
-                        }
-                        if (ORTE_SUCCESS != (rc = opal_dss.pack(reply, &data->owner, 1, OPAL_NAME))) {
-                            ORTE_ERROR_LOG(rc);
-                            break;
-                        }
-                        OPAL_OUTPUT_VERBOSE((1, orte_debug_output,
-                                             "%s data server: adding %s data from %s to response",
-                                             ORTE_NAME_PRINT(ORTE_PROC_MY_NAME), iptr->key,
-                                             ORTE_NAME_PRINT(&data->owner)));
-                        if (ORTE_SUCCESS != (rc = opal_dss.pack(reply, &iptr, 1, OPAL_VALUE))) {
-                            ORTE_ERROR_LOG(rc);
-                            break;
-                        }
-                    }
-                }
+            if (ORTE_SUCCESS != (rc = opal_dss.pack(reply, &data->owner, 1, OPAL_NAME))) {
+                ORTE_ERROR_LOG(rc);
+                break;
             }
-            if (NULL != reply) {
-                /* send it back to the requestor */
-                OPAL_OUTPUT_VERBOSE((1, orte_debug_output,
-                                     "%s data server: returning data to %s",
-                                     ORTE_NAME_PRINT(ORTE_PROC_MY_NAME),
-                                     ORTE_NAME_PRINT(&req->requestor)));
-
-                if (0 > (rc = orte_rml.send_buffer_nb(&req->requestor, reply, ORTE_RML_TAG_DATA_CLIENT,
-                                                      orte_rml_send_callback, NULL))) {
-                    ORTE_ERROR_LOG(rc);
-                    OBJ_RELEASE(reply);
-                }
-                /* remove this request */
-                opal_list_remove_item(&pending, &req->super);
-                OBJ_RELEASE(req);
-                reply = NULL;
-                /* if the persistence is "first_read", then delete this data */
-                if (OPAL_PMIX_PERSIST_FIRST_READ == data->persistence) {
-                    OPAL_OUTPUT_VERBOSE((1, orte_debug_output,
-                                        "%s NOT STORING DATA FROM %s AT INDEX %d",
-                                        ORTE_NAME_PRINT(ORTE_PROC_MY_NAME),
-                                        ORTE_NAME_PRINT(&data->owner), data->index));
-                    opal_pointer_array_set_item(&orte_data_server_store, data->index, NULL);
-                    OBJ_RELEASE(data);
-                    goto release;
-                }
+            OPAL_OUTPUT_VERBOSE((1, orte_debug_output,
+                                 "%s data server: adding %s data from %s to response",
+                                 ORTE_NAME_PRINT(ORTE_PROC_MY_NAME), iptr->key,
+                                 ORTE_NAME_PRINT(&data->owner)));
+            if (ORTE_SUCCESS != (rc = opal_dss.pack(reply, &iptr, 1, OPAL_VALUE))) {
+                ORTE_ERROR_LOG(rc);
+                break;
             }
         }
+    }
 
-      release:
-        /* tell the user it was wonderful... */
-        ret = ORTE_SUCCESS;
-        if (ORTE_SUCCESS != (rc = opal_dss.pack(answer, &ret, 1, OPAL_INT))) {
-            ORTE_ERROR_LOG(rc);
-            /* if we can't pack it, we probably can't pack the
-             * rc value either, so just send whatever is there */
+    /* send it back to the requestor */
+    OPAL_OUTPUT_VERBOSE((1, orte_debug_output,
+                         "%s data server: returning data to %s",
+                         ORTE_NAME_PRINT(ORTE_PROC_MY_NAME),
+                         ORTE_NAME_PRINT(&req->requestor)));
+
+    if (0 > (rc = orte_rml.send_buffer_nb(&req->requestor, reply, ORTE_RML_TAG_DATA_CLIENT,
+                                          orte_rml_send_callback, NULL))) {
+        ORTE_ERROR_LOG(rc);
+        OBJ_RELEASE(reply);
+    }
+}
+
+static int publish(opal_buffer_t *buffer, opal_buffer_t *answer)
+{
+    orte_data_object_t *data;
+    orte_data_bucket_t *bkt;
+    orte_data_ref_t *ref;
+    opal_value_t *iptr;
+    orte_std_cntr_t count;
+    int rc, ret;
+
+    data = OBJ_NEW(orte_data_object_t);
+    /* unpack the requestor */
+    count = 1;
+    if (ORTE_SUCCESS != (rc = opal_dss.unpack(buffer, &data->owner, &count, OPAL_NAME))) {
+        ORTE_ERROR_LOG(rc);
+        OBJ_RELEASE(data);
+        return rc;
+    }
+
+    OPAL_OUTPUT_VERBOSE((1, orte_debug_output,
+                         "%s data server: publishing data from %s",
+                         ORTE_NAME_PRINT(ORTE_PROC_MY_NAME),
+                         ORTE_NAME_PRINT(&data->owner)));
+
+    /* unpack the range */
+    count = 1;
+    if (ORTE_SUCCESS != (rc = opal_dss.unpack(buffer, &data->range, &count, OPAL_INT))) {
+        ORTE_ERROR_LOG(rc);
+        OBJ_RELEASE(data);
+        return rc;
+    }
+    /* unpack the persistence */
+    count = 1;
+    if (ORTE_SUCCESS != (rc = opal_dss.unpack(buffer, &data->persistence, &count, OPAL_INT))) {
+        ORTE_ERROR_LOG(rc);
+        OBJ_RELEASE(data);
+        return rc;
+    }
+
+    count = 1;
+    while (ORTE_SUCCESS == (rc = opal_dss.unpack(buffer, &iptr, &count, OPAL_VALUE))) {
+        /* if this is the userid, separate it out */
+        if (0 == strcmp(iptr->key, OPAL_PMIX_USERID)) {
+            data->uid = iptr->data.uint32;
+            OBJ_RELEASE(iptr);
+        } else {
+            OPAL_OUTPUT_VERBOSE((1, orte_debug_output,
+                                 "%s data server: adding %s to data from %s",
+                                 ORTE_NAME_PRINT(ORTE_PROC_MY_NAME), iptr->key,
+                                 ORTE_NAME_PRINT(&data->owner)));
+            opal_list_append(&data->values, &iptr->super);
         }
-        goto SEND_ANSWER;
-        break;
+    }
 
-    case ORTE_PMIX_LOOKUP_CMD:
-        OPAL_OUTPUT_VERBOSE((1, orte_debug_output,
-                             "%s data server: lookup data from %s",
-                             ORTE_NAME_PRINT(ORTE_PROC_MY_NAME),
-                             ORTE_NAME_PRINT(sender)));
+    data->index = opal_pointer_array_add(&orte_data_server_store, data);
+    index_data(data);
 
-        /* unpack the range - this sets some constraints on the range of data to be considered */
-        count = 1;
-        if (ORTE_SUCCESS != (rc = opal_dss.unpack(buffer, &range, &count, OPAL_INT))) {
-            ORTE_ERROR_LOG(rc);
-            goto SEND_ERROR;
+    OPAL_OUTPUT_VERBOSE((1, orte_debug_output,
+                         "%s data server: checking for pending requests",
+                         ORTE_NAME_PRINT(ORTE_PROC_MY_NAME)));
+
+    /* only the requests waiting on one of the keys we just
+     * stored can be satisfied by this data. The bucket cannot
+     * go away underneath us as it holds a reference to it */
+    OPAL_LIST_FOREACH(iptr, &data->values, opal_value_t) {
+        if (NULL == (bkt = get_bucket(data->uid, data->range, iptr->key, false))) {
+            continue;
+        }
+        while (0 < opal_list_get_size(&bkt->waiters)) {
+            ref = (orte_data_ref_t*)opal_list_get_first(&bkt->waiters);
+            satisfy(ref->req, data);
+            remove_waiter(ref->req);
+            /* if the persistence is "first_read", then delete this data */
+            if (OPAL_PMIX_PERSIST_FIRST_READ == data->persistence) {
+                OPAL_OUTPUT_VERBOSE((1, orte_debug_output,
+                                    "%s NOT STORING DATA FROM %s AT INDEX %d",
+                                    ORTE_NAME_PRINT(ORTE_PROC_MY_NAME),
+                                    ORTE_NAME_PRINT(&data->owner), data->index));
+                remove_data(data);
+                goto release;
+            }
         }
+    }
+
+  release:
+    /* tell the user it was wonderful... */
+    ret = ORTE_SUCCESS;
+    if (ORTE_SUCCESS != (rc = opal_dss.pack(answer, &ret, 1, OPAL_INT))) {
+        ORTE_ERROR_LOG(rc);
+        /* if we can't pack it, we probably can't pack the
+         * rc value either, so just send whatever is there */
+    }
+    return ORTE_SUCCESS;
+}
+
+/* unpack the keys and info that trail a lookup or unpublish */
+static int unpack_keys(opal_buffer_t *buffer, char ***keys,
+                       uint32_t *uid, bool *wait)
+{
+    orte_std_cntr_t count;
+    opal_value_t *iptr;
+    uint32_t ninfo, i;
+    char *str;
+    int rc;
+
+    /* unpack the number of keys */
+    count = 1;
+    if (ORTE_SUCCESS != (rc = opal_dss.unpack(buffer, &ninfo, &count, OPAL_UINT32))) {
+        ORTE_ERROR_LOG(rc);
+        return rc;
+    }
+    if (0 == ninfo) {
+        /* they forgot to send us the keys?? */
+        ORTE_ERROR_LOG(ORTE_ERR_BAD_PARAM);
+        return ORTE_ERR_BAD_PARAM;
+    }
 
-        /* unpack the number of keys */
+    /* unpack the keys */
+    for (i=0; i < ninfo; i++) {
         count = 1;
-        if (ORTE_SUCCESS != (rc = opal_dss.unpack(buffer, &ninfo, &count, OPAL_UINT32))) {
+        if (ORTE_SUCCESS != (rc = opal_dss.unpack(buffer, &str, &count, OPAL_STRING))) {
             ORTE_ERROR_LOG(rc);
-            goto SEND_ERROR;
+            opal_argv_free(*keys);
+            *keys = NULL;
+            return rc;
         }
-        if (0 == ninfo) {
-            /* they forgot to send us the keys?? */
-            ORTE_ERROR_LOG(ORTE_ERR_BAD_PARAM);
-            rc = ORTE_ERR_BAD_PARAM;
-            goto SEND_ERROR;
+        opal_argv_append_nosize(keys, str);
+        free(str);
+    }
+
+    /* unpack any info elements */
+    count = 1;
+    *uid = UINT32_MAX;
+    while (ORTE_SUCCESS == (rc = opal_dss.unpack(buffer, &iptr, &count, OPAL_VALUE))) {
+        /* if this is the userid, separate it out */
+        if (0 == strcmp(iptr->key, OPAL_PMIX_USERID)) {
+            *uid = iptr->data.uint32;
+        } else if (NULL != wait && 0 == strcmp(iptr->key, OPAL_PMIX_WAIT)) {
+            /* flag that we wait until the data is present */
+            *wait = true;
         }
+        /* ignore anything else for now */
+        OBJ_RELEASE(iptr);
+    }
+    if (ORTE_ERR_UNPACK_READ_PAST_END_OF_BUFFER != rc || UINT32_MAX == *uid) {
+        ORTE_ERROR_LOG(rc);
+        opal_argv_free(*keys);
+        *keys = NULL;
+        return rc;
+    }
+    return ORTE_SUCCESS;
+}
 
-        /* unpack the keys */
-        for (i=0; i < ninfo; i++) {
-            count = 1;
-            if (ORTE_SUCCESS != (rc = opal_dss.unpack(buffer, &str, &count, OPAL_STRING))) {
+static int lookup(orte_process_name_t *sender, int room_number,
+                  opal_buffer_t *buffer, opal_buffer_t *answer)
+{
+    orte_std_cntr_t count;
+    orte_data_object_t *data;
+    orte_data_bucket_t *bkt;
+    orte_data_ref_t *ref;
+    orte_data_req_t *req;
+    opal_pmix_data_range_t range;
+    char **keys = NULL;
+    uint32_t uid;
+    bool ret_packed = false, wait = false;
+    int rc, ret, i;
+
+    OPAL_OUTPUT_VERBOSE((1, orte_debug_output,
+                         "%s data server: lookup data from %s",
+                         ORTE_NAME_PRINT(ORTE_PROC_MY_NAME),
+                         ORTE_NAME_PRINT(sender)));
+
+    /* unpack the range - this sets some constraints on the range of data to be considered */
+    count = 1;
+    if (ORTE_SUCCESS != (rc = opal_dss.unpack(buffer, &range, &count, OPAL_INT))) {
+        ORTE_ERROR_LOG(rc);
+        return rc;
+    }
+
+    if (ORTE_SUCCESS != (rc = unpack_keys(buffer, &keys, &uid, &wait))) {
+        return rc;
+    }
+
+    /* cycle across the provided keys */
+    for (i=0; NULL != keys[i]; i++) {
+        OPAL_OUTPUT_VERBOSE((1, orte_debug_output,
+                             "%s data server: looking for %s",
+                             ORTE_NAME_PRINT(ORTE_PROC_MY_NAME), keys[i]));
+        if (NULL == (bkt = get_bucket(uid, range, keys[i], false))) {
+            continue;
+        }
+        OPAL_LIST_FOREACH(ref, &bkt->data, orte_data_ref_t) {
+            /* found it - package it for return */
+            if (!ret_packed) {
+                ret = ORTE_SUCCESS;
+                if (ORTE_SUCCESS != (rc = opal_dss.pack(answer, &ret, 1, OPAL_INT))) {
+                    ORTE_ERROR_LOG(rc);
+                    opal_argv_free(keys);
+                    return rc;
+                }
+                ret_packed = true;
+            }
+            if (ORTE_SUCCESS != (rc = opal_dss.pack(answer, &ref->data->owner, 1, OPAL_NAME))) {
                 ORTE_ERROR_LOG(rc);
                 opal_argv_free(keys);
-                goto SEND_ERROR;
+                return rc;
             }
-            opal_argv_append_nosize(&keys, str);
-            free(str);
-        }
-
-        /* unpack any info elements */
-        count = 1;
-        uid = UINT32_MAX;
-        while (ORTE_SUCCESS == (rc = opal_dss.unpack(buffer, &iptr, &count, OPAL_VALUE))) {
-            /* if this is the userid, separate it out */
-            if (0 == strcmp(iptr->key, OPAL_PMIX_USERID)) {
-                uid = iptr->data.uint32;
-            } else if (0 == strcmp(iptr->key, OPAL_PMIX_WAIT)) {
-                /* flag that we wait until the data is present */
-                wait = true;
+            OPAL_OUTPUT_VERBOSE((1, orte_debug_output,
+                                 "%s data server: adding %s to data from %s",
+                                 ORTE_NAME_PRINT(ORTE_PROC_MY_NAME), ref->value->key,
+                                 ORTE_NAME_PRINT(&ref->data->owner)));
+            if (ORTE_SUCCESS != (rc = opal_dss.pack(answer, &ref->value, 1, OPAL_VALUE))) {
+                ORTE_ERROR_LOG(rc);
+                opal_argv_free(keys);
+                return rc;
             }
-            /* ignore anything else for now */
-            OBJ_RELEASE(iptr);
-        }
-        if (ORTE_ERR_UNPACK_READ_PAST_END_OF_BUFFER != rc || UINT32_MAX == uid) {
-            ORTE_ERROR_LOG(rc);
-            opal_argv_free(keys);
-            goto SEND_ERROR;
         }
-
-        /* cycle across the provided keys */
-        ret_packed = false;
-        for (i=0; NULL != keys[i]; i++) {
-            OPAL_OUTPUT_VERBOSE((1, orte_debug_output,
-                                 "%s data server: looking for %s",
-                                 ORTE_NAME_PRINT(ORTE_PROC_MY_NAME), keys[i]));
-            /* cycle across the stored data, looking for a match */
-            for (k=0; k < orte_data_server_store.size; k++) {
-                data_added = false;
-                data = (orte_data_object_t*)opal_pointer_array_get_item(&orte_data_server_store, k);
-                if (NULL == data) {
-                    continue;
-                }
-                /* can only access data posted by the same user id */
-                if (uid != data->uid) {
-                    continue;
-                }
-                /* if the range doesn't match, then we cannot consider it */
-                if (range != data->range) {
-                    continue;
-                }
-                /* see if we have this key */
-                OPAL_LIST_FOREACH(iptr, &data->values, opal_value_t) {
-                    OPAL_OUTPUT_VERBOSE((1, orte_debug_output,
-                                        "%s COMPARING %s %s",
-                                        ORTE_NAME_PRINT(ORTE_PROC_MY_NAME),
-                                        keys[i], iptr->key));
-                    if (0 == strcmp(iptr->key, keys[i])) {
-                        /* found it - package it for return */
-                        if (!ret_packed) {
-                            ret = ORTE_SUCCESS;
-                            if (ORTE_SUCCESS != (rc = opal_dss.pack(answer, &ret, 1, OPAL_INT))) {
-                                ORTE_ERROR_LOG(rc);
-                                opal_argv_free(keys);
-                                goto SEND_ERROR;
-                            }
-                            ret_packed = true;
-                        }
-                        data_added = true;
-                        if (ORTE_SUCCESS != (rc = opal_dss.pack(answer, &data->owner, 1, OPAL_NAME))) {
-                            ORTE_ERROR_LOG(rc);
-                            opal_argv_free(keys);
-                            goto SEND_ERROR;
-                        }
-                        OPAL_OUTPUT_VERBOSE((1, orte_debug_output,
-                                             "%s data server: adding %s to data from %s",
-                                             ORTE_NAME_PRINT(ORTE_PROC_MY_NAME), iptr->key,
-                                             ORTE_NAME_PRINT(&data->owner)));
-                        if (ORTE_SUCCESS != (rc = opal_dss.pack(answer, &iptr, 1, OPAL_VALUE))) {
-                            ORTE_ERROR_LOG(rc);
-                            opal_argv_free(keys);
-                            goto SEND_ERROR;
-                        }
-                    }
-                }
-                if (data_added && OPAL_PMIX_PERSIST_FIRST_READ == data->persistence) {
-                    OPAL_OUTPUT_VERBOSE((1, orte_debug_output,
-                                        "%s REMOVING DATA FROM %s AT INDEX %d",
-                                        ORTE_NAME_PRINT(ORTE_PROC_MY_NAME),
-                                        ORTE_NAME_PRINT(&data->owner), data->index));
-                    opal_pointer_array_set_item(&orte_data_server_store, data->index, NULL);
-                    OBJ_RELEASE(data);
+        /* remove anything that was only to be read once - this
+         * may release the bucket, so look it up again each time */
+        do {
+            data = NULL;
+            if (NULL == (bkt = get_bucket(uid, range, keys[i], false))) {
+                break;
+            }
+            OPAL_LIST_FOREACH(ref, &bkt->data, orte_data_ref_t) {
+                if (OPAL_PMIX_PERSIST_FIRST_READ == ref->data->persistence) {
+                    data = ref->data;
+                    break;
                 }
             }
-        }
-        if (!ret_packed) {
+            if (NULL != data) {
+                OPAL_OUTPUT_VERBOSE((1, orte_debug_output,
+                                    "%s REMOVING DATA FROM %s AT INDEX %d",
+                                    ORTE_NAME_PRINT(ORTE_PROC_MY_NAME),
+                                    ORTE_NAME_PRINT(&data->owner), data->index));
+                remove_data(data);
+            }
+        } while (NULL != data);
+    }
+    if (!ret_packed) {
+        OPAL_OUTPUT_VERBOSE((1, orte_debug_output,
+                             "%s data server:lookup: data not found",
+                             ORTE_NAME_PRINT(ORTE_PROC_MY_NAME)));
+
+        /* if we were told to wait for the data, then queue this up
+         * for later processing */
+        if (wait) {
             OPAL_OUTPUT_VERBOSE((1, orte_debug_output,
-                                 "%s data server:lookup: data not found",
+                                 "%s data server:lookup: pushing request to wait",
                                  ORTE_NAME_PRINT(ORTE_PROC_MY_NAME)));
+            req = OBJ_NEW(orte_data_req_t);
+            req->room_number = room_number;
+            req->requestor = *sender;
+            req->uid = uid;
+            req->range = range;
+            req->keys = keys;
+            add_waiter(req);
+            return ORTE_ERR_OP_IN_PROGRESS;
+        }
+        /* nothing was found - indicate that situation */
+        opal_argv_free(keys);
+        return ORTE_ERR_NOT_FOUND;
+    }
 
-            /* if we were told to wait for the data, then queue this up
-             * for later processing */
-            if (wait) {
-                OPAL_OUTPUT_VERBOSE((1, orte_debug_output,
-                                     "%s data server:lookup: pushing request to wait",
-                                     ORTE_NAME_PRINT(ORTE_PROC_MY_NAME)));
-                req = OBJ_NEW(orte_data_req_t);
-                req->room_number = room_number;
-                req->requestor = *sender;
-                req->uid = uid;
-                req->range = range;
-                req->keys = keys;
-                opal_list_append(&pending, &req->super);
-                return;
+    opal_argv_free(keys);
+    OPAL_OUTPUT_VERBOSE((1, orte_debug_output,
+                         "%s data server:lookup: data found",
+                         ORTE_NAME_PRINT(ORTE_PROC_MY_NAME)));
+    return ORTE_SUCCESS;
+}
+
+static int unpublish(opal_buffer_t *buffer, opal_buffer_t *answer)
+{
+    orte_std_cntr_t count;
+    opal_process_name_t requestor;
+    orte_data_object_t *data;
+    orte_data_bucket_t *bkt;
+    orte_data_ref_t *ref, *rnext;
+    opal_pmix_data_range_t range;
+    char **keys = NULL;
+    uint32_t uid;
+    int rc, ret, i;
+
+    /* unpack the requestor */
+    count = 1;
+    if (ORTE_SUCCESS != (rc = opal_dss.unpack(buffer, &requestor, &count, OPAL_NAME))) {
+        ORTE_ERROR_LOG(rc);
+        return rc;
+    }
+
+    OPAL_OUTPUT_VERBOSE((1, orte_debug_output,
+                         "%s data server: unpublish data from %s",
+                         ORTE_NAME_PRINT(ORTE_PROC_MY_NAME),
+                         ORTE_NAME_PRINT(&requestor)));
+
+    /* unpack the range - this sets some constraints on the range of data to be considered */
+    count = 1;
+    if (ORTE_SUCCESS != (rc = opal_dss.unpack(buffer, &range, &count, OPAL_INT))) {
+        ORTE_ERROR_LOG(rc);
+        return rc;
+    }
+
+    if (ORTE_SUCCESS != (rc = unpack_keys(buffer, &keys, &uid, NULL))) {
+        return rc;
+    }
+
+    /* cycle across the provided keys */
+    for (i=0; NULL != keys[i]; i++) {
+        if (NULL == (bkt = get_bucket(uid, range, keys[i], false))) {
+            continue;
+        }
+        OPAL_LIST_FOREACH_SAFE(ref, rnext, &bkt->data, orte_data_ref_t) {
+            /* can only access data posted by the same process */
+            if (OPAL_EQUAL != orte_util_compare_name_fields(ORTE_NS_CMP_ALL, &ref->data->owner, &requestor)) {
+                continue;
+            }
+            /* found it -  delete the object from the data store */
+            data = ref->data;
+            opal_list_remove_item(&bkt->data, &ref->super);
+            opal_list_remove_item(&data->values, &ref->value->super);
+            OBJ_RELEASE(ref->value);
+            OBJ_RELEASE(ref);
+            /* if all the data has been removed, then remove the object */
+            if (0 == opal_list_get_size(&data->values)) {
+                opal_pointer_array_set_item(&orte_data_server_store, data->index, NULL);
+                OBJ_RELEASE(data);
             }
-            /* nothing was found - indicate that situation */
-            rc = ORTE_ERR_NOT_FOUND;
-            opal_argv_free(keys);
-            goto SEND_ERROR;
         }
+        put_bucket(bkt);
+    }
+    opal_argv_free(keys);
 
-        opal_argv_free(keys);
-        OPAL_OUTPUT_VERBOSE((1, orte_debug_output,
-                             "%s data server:lookup: data found",
-                             ORTE_NAME_PRINT(ORTE_PROC_MY_NAME)));
-        goto SEND_ANSWER;
-        break;
+    /* tell the sender this succeeded */
+    ret = ORTE_SUCCESS;
+    if (ORTE_SUCCESS != (rc = opal_dss.pack(answer, &ret, 1, OPAL_INT))) {
+        ORTE_ERROR_LOG(rc);
+    }
+    return ORTE_SUCCESS;
+}
 
-    case ORTE_PMIX_UNPUBLISH_CMD:
-        /* unpack the requestor */
-        count = 1;
-        if (ORTE_SUCCESS != (rc = opal_dss.unpack(buffer, &requestor, &count, OPAL_NAME))) {
-            ORTE_ERROR_LOG(rc);
-            goto SEND_ERROR;
-        }
+/* process a single request, returning the answer to be sent
+ * back to the sender - or NULL if there is nothing to send */
+static opal_buffer_t* process(orte_process_name_t *sender,
+                              opal_buffer_t *buffer, bool nested)
+{
+    uint8_t command;
+    orte_std_cntr_t count;
+    opal_buffer_t *answer, *xfer, *ans, bulk;
+    int rc, ret, room_number;
+    int32_t n, nreqs, nans;
 
-        OPAL_OUTPUT_VERBOSE((1, orte_debug_output,
-                             "%s data server: unpublish data from %s",
-                             ORTE_NAME_PRINT(ORTE_PROC_MY_NAME),
-                             ORTE_NAME_PRINT(&requestor)));
+    /* unpack the room number of the caller's request */
+    count = 1;
+    if (ORTE_SUCCESS != (rc = opal_dss.unpack(buffer, &room_number, &count, OPAL_INT))) {
+        ORTE_ERROR_LOG(rc);
+        return NULL;
+    }
 
-        /* unpack the range - this sets some constraints on the range of data to be considered */
-        count = 1;
-        if (ORTE_SUCCESS != (rc = opal_dss.unpack(buffer, &range, &count, OPAL_INT))) {
+    /* unpack the command */
+    count = 1;
+    if (ORTE_SUCCESS != (rc = opal_dss.unpack(buffer, &command, &count, OPAL_UINT8))) {
+        ORTE_ERROR_LOG(rc);
+        return NULL;
+    }
+
+    answer = OBJ_NEW(opal_buffer_t);
+
+    if (ORTE_PMIX_BULK_CMD == command && !nested) {
+        /* the answers to the individual requests are
+         * returned in a single message */
+        room_number = ORTE_PMIX_BULK_ROOM;
+        if (ORTE_SUCCESS != (rc = opal_dss.pack(answer, &room_number, 1, OPAL_INT))) {
             ORTE_ERROR_LOG(rc);
-            goto SEND_ERROR;
+            OBJ_RELEASE(answer);
+            return NULL;
         }
-
-        /* unpack the number of keys */
         count = 1;
-        if (ORTE_SUCCESS != (rc = opal_dss.unpack(buffer, &ninfo, &count, OPAL_UINT32))) {
+        if (ORTE_SUCCESS != (rc = opal_dss.unpack(buffer, &nreqs, &count, OPAL_INT32))) {
             ORTE_ERROR_LOG(rc);
-            goto SEND_ERROR;
-        }
-        if (0 == ninfo) {
-            /* they forgot to send us the keys?? */
-            rc = ORTE_ERR_BAD_PARAM;
-            goto SEND_ERROR;
+            OBJ_RELEASE(answer);
+            return NULL;
         }
-
-        /* unpack the keys */
-        for (i=0; i < ninfo; i++) {
+        OPAL_OUTPUT_VERBOSE((1, orte_debug_output,
+                             "%s data server: processing %d requests from %s",
+                             ORTE_NAME_PRINT(ORTE_PROC_MY_NAME), nreqs,
+                             ORTE_NAME_PRINT(sender)));
+        OBJ_CONSTRUCT(&bulk, opal_buffer_t);
+        nans = 0;
+        for (n=0; n < nreqs; n++) {
             count = 1;
-            if (ORTE_SUCCESS != (rc = opal_dss.unpack(buffer, &str, &count, OPAL_STRING))) {
+            if (ORTE_SUCCESS != (rc = opal_dss.unpack(buffer, &xfer, &count, OPAL_BUFFER))) {
                 ORTE_ERROR_LOG(rc);
-                opal_argv_free(keys);
-                goto SEND_ERROR;
+                break;
             }
-            opal_argv_append_nosize(&keys, str);
-            free(str);
-        }
-
-        /* unpack any info elements */
-        count = 1;
-        uid = UINT32_MAX;
-        while (ORTE_SUCCESS == (rc = opal_dss.unpack(buffer, &iptr, &count, OPAL_VALUE))) {
-            /* if this is the userid, separate it out */
-            if (0 == strcmp(iptr->key, OPAL_PMIX_USERID)) {
-                uid = iptr->data.uint32;
+            ans = process(sender, xfer, true);
+            OBJ_RELEASE(xfer);
+            if (NULL == ans) {
+                continue;
             }
-            /* ignore anything else for now */
-            OBJ_RELEASE(iptr);
+            if (ORTE_SUCCESS != (rc = opal_dss.pack(&bulk, &ans, 1, OPAL_BUFFER))) {
+                ORTE_ERROR_LOG(rc);
+                OBJ_RELEASE(ans);
+                break;
+            }
+            OBJ_RELEASE(ans);
+            nans++;
+        }
+        if (0 == nans ||
+            ORTE_SUCCESS != (rc = opal_dss.pack(answer, &nans, 1, OPAL_INT32))) {
+            OBJ_DESTRUCT(&bulk);
+            OBJ_RELEASE(answer);
+            return NULL;
         }
-        if (ORTE_ERR_UNPACK_READ_PAST_END_OF_BUFFER != rc || UINT32_MAX == uid) {
+        rc = opal_dss.copy_payload(answer, &bulk);
+        OBJ_DESTRUCT(&bulk);
+        if (ORTE_SUCCESS != rc) {
             ORTE_ERROR_LOG(rc);
-            opal_argv_free(keys);
-            goto SEND_ERROR;
+            OBJ_RELEASE(answer);
+            return NULL;
         }
+        return answer;
+    }
 
-        /* cycle across the provided keys */
-        for (i=0; NULL != keys[i]; i++) {
-            /* cycle across the stored data, looking for a match */
-            for (k=0; k < orte_data_server_store.size; k++) {
-                data = (orte_data_object_t*)opal_pointer_array_get_item(&orte_data_server_store, k);
-                if (NULL == data) {
-                    continue;
-                }
-                /* can only access data posted by the same user id */
-                if (uid != data->uid) {
-                    continue;
-                }
-                /* can only access data posted by the same process */
-                if (OPAL_EQUAL != orte_util_compare_name_fields(ORTE_NS_CMP_ALL, &data->owner, &requestor)) {
-                    continue;
-                }
-                /* can only access data posted for the same range */
-                if (range != data->range) {
-                    continue;
-                }
-                /* see if we have this key */
-                OPAL_LIST_FOREACH_SAFE(iptr, inext, &data->values, opal_value_t) {
-                    if (0 == strcmp(iptr->key, keys[i])) {
-                        /* found it -  delete the object from the data store */
-                        opal_list_remove_item(&data->values, &iptr->super);
-                        OBJ_RELEASE(iptr);
-                    }
-                }
-                /* if all the data has been removed, then remove the object */
-                if (0 == opal_list_get_size(&data->values)) {
-                    opal_pointer_array_set_item(&orte_data_server_store, k, NULL);
-                    OBJ_RELEASE(data);
-                }
-            }
-        }
-        opal_argv_free(keys);
+    /* pack the room number as this must lead any response */
+    if (ORTE_SUCCESS != (rc = opal_dss.pack(answer, &room_number, 1, OPAL_INT))) {
+        ORTE_ERROR_LOG(rc);
+        OBJ_RELEASE(answer);
+        return NULL;
+    }
 
-        /* tell the sender this succeeded */
-        ret = ORTE_SUCCESS;
-        if (ORTE_SUCCESS != (rc = opal_dss.pack(answer, &ret, 1, OPAL_INT))) {
-            ORTE_ERROR_LOG(rc);
+    switch(command) {
+    case ORTE_PMIX_PUBLISH_CMD:
+        rc = publish(buffer, answer);
+        break;
+
+    case ORTE_PMIX_LOOKUP_CMD:
+        rc = lookup(sender, room_number, buffer, answer);
+        if (ORTE_ERR_OP_IN_PROGRESS == rc) {
+            /* the answer will come when the data does */
+            OBJ_RELEASE(answer);
+            return NULL;
         }
-        goto SEND_ANSWER;
+        break;
+
+    case ORTE_PMIX_UNPUBLISH_CMD:
+        rc = unpublish(buffer, answer);
         break;
 
     default:
@@ -606,17 +856,35 @@ void orte_data_server(int status, orte_process_name_t* sender,
         break;
     }
 
- SEND_ERROR:
+    if (ORTE_SUCCESS != rc) {
+        OPAL_OUTPUT_VERBOSE((1, orte_debug_output,
+                             "%s data server: sending error %s",
+                             ORTE_NAME_PRINT(ORTE_PROC_MY_NAME),
+                             ORTE_ERROR_NAME(rc)));
+        /* pack the error code */
+        if (ORTE_SUCCESS != (ret = opal_dss.pack(answer, &rc, 1, OPAL_INT))) {
+            ORTE_ERROR_LOG(ret);
+        }
+    }
+    return answer;
+}
+
+void orte_data_server(int status, orte_process_name_t* sender,
+                      opal_buffer_t* buffer, orte_rml_tag_t tag,
+                      void* cbdata)
+{
+    opal_buffer_t *answer;
+    int rc;
+
     OPAL_OUTPUT_VERBOSE((1, orte_debug_output,
-                         "%s data server: sending error %s",
+                         "%s data server got message from %s",
                          ORTE_NAME_PRINT(ORTE_PROC_MY_NAME),
-                         ORTE_ERROR_NAME(rc)));
-    /* pack the error code */
-    if (ORTE_SUCCESS != (ret = opal_dss.pack(answer, &rc, 1, OPAL_INT))) {
-        ORTE_ERROR_LOG(ret);
+                         ORTE_NAME_PRINT(sender)));
+
+    if (NULL == (answer = process(sender, buffer, false))) {
+        return;
     }
 
- SEND_ANSWER:
     if (0 > (rc = orte_rml.send_buffer_nb(sender, answer, ORTE_RML_TAG_DATA_CLIENT,
                                           orte_rml_send_callback, NULL))) {
         ORTE_ERROR_LOG(rc);
@@ -624,4 +892,3 @@ void orte_data_server(int status, orte_process_name_t* sender,
     }
 }
 
-
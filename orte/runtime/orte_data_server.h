@@ -38,6 +38,14 @@ BEGIN_C_DECLS
 #define ORTE_PMIX_PUBLISH_CMD    0x01
 #define ORTE_PMIX_LOOKUP_CMD     0x02
 #define ORTE_PMIX_UNPUBLISH_CMD  0x03
+/* a count followed by that many packed requests, each
+ * laid out exactly as if it had been sent on its own. The
+ * answers come back in a single message that carries
+ * ORTE_PMIX_BULK_ROOM in place of a room number, followed
+ * by the count and the individual answers */
+#define ORTE_PMIX_BULK_CMD       0x04
+
+#define ORTE_PMIX_BULK_ROOM      -2
 
 
 /* provide hooks to startup and finalize the data server */
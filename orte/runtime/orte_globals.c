@@ -77,6 +77,8 @@ bool orte_static_ports = false;
 char *orte_oob_static_ports = NULL;
 bool orte_standalone_operation = false;
 
+bool orte_pack_changed_fields = false;
+
 bool orte_keep_fqdn_hostnames = false;
 bool orte_have_fqdn_allocation = false;
 bool orte_show_resolved_nodenames = false;
@@ -189,6 +191,10 @@ bool orte_map_stddiag_to_stderr = false;
 /* maximum size of virtual machine - used to subdivide allocation */
 int orte_max_vm_size = -1;
 
+/* compress large launch-related messages */
+bool orte_compress_xcast = true;
+bool orte_compress_nodemap = true;
+
 /* user debugger */
 char *orte_base_user_debugger = NULL;
 
@@ -459,6 +459,9 @@ ORTE_DECLSPEC extern bool orte_static_ports;
 ORTE_DECLSPEC extern char *orte_oob_static_ports;
 ORTE_DECLSPEC extern bool orte_standalone_operation;
 
+/* send only the fields of jobs/nodes/procs that differ from the previous one */
+ORTE_DECLSPEC extern bool orte_pack_changed_fields;
+
 /* nodename flags */
 ORTE_DECLSPEC extern bool orte_keep_fqdn_hostnames;
 ORTE_DECLSPEC extern bool orte_have_fqdn_allocation;
@@ -573,6 +576,10 @@ ORTE_DECLSPEC extern bool orte_map_stddiag_to_stderr;
 /* maximum size of virtual machine - used to subdivide allocation */
 ORTE_DECLSPEC extern int orte_max_vm_size;
 
+/* compress large launch-related messages */
+ORTE_DECLSPEC extern bool orte_compress_xcast;
+ORTE_DECLSPEC extern bool orte_compress_nodemap;
+
 /* user debugger */
 ORTE_DECLSPEC extern char *orte_base_user_debugger;
 
@@ -383,6 +383,23 @@ int orte_register_params(void)
                                   OPAL_INFO_LVL_9, MCA_BASE_VAR_SCOPE_READONLY,
                                   &orte_node_regex);
 
+    /* whether or not to compress large messages */
+    orte_compress_xcast = true;
+    (void) mca_base_var_register ("orte", "orte", NULL, "compress_xcast",
+                                  "Compress xcast payloads larger than compress_base_limit bytes, "
+                                  "if supported by the compress framework [default: yes]",
+                                  MCA_BASE_VAR_TYPE_BOOL, NULL, 0, 0,
+                                  OPAL_INFO_LVL_9, MCA_BASE_VAR_SCOPE_READONLY,
+                                  &orte_compress_xcast);
+
+    orte_compress_nodemap = true;
+    (void) mca_base_var_register ("orte", "orte", NULL, "compress_nodemap",
+                                  "Compress nodemaps larger than compress_base_limit bytes, "
+                                  "if supported by the compress framework [default: yes]",
+                                  MCA_BASE_VAR_TYPE_BOOL, NULL, 0, 0,
+                                  OPAL_INFO_LVL_9, MCA_BASE_VAR_SCOPE_READONLY,
+                                  &orte_compress_nodemap);
+
     /* whether or not to keep FQDN hostnames */
     orte_keep_fqdn_hostnames = false;
     (void) mca_base_var_register ("orte", "orte", NULL, "keep_fqdn_hostnames",
@@ -661,6 +678,13 @@ int orte_register_params(void)
                                   OPAL_INFO_LVL_9, MCA_BASE_VAR_SCOPE_READONLY,
                                   &orte_stat_history_size);
 
+    orte_pack_changed_fields = false;
+    (void) mca_base_var_register ("orte", "orte", NULL, "pack_changed_fields",
+                                  "When sending arrays of jobs, nodes or procs, leave out the fields that are the same as in the previous entry (must be the same on all nodes)",
+                                  MCA_BASE_VAR_TYPE_BOOL, NULL, 0, 0,
+                                  OPAL_INFO_LVL_9, MCA_BASE_VAR_SCOPE_ALL_EQ,
+                                  &orte_pack_changed_fields);
+
     orte_max_vm_size = -1;
     (void) mca_base_var_register ("orte", "orte", NULL, "max_vm_size",
                                   "Maximum size of virtual machine - used to subdivide allocation",
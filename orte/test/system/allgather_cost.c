@@ -0,0 +1,109 @@
+/* -*- C -*-
+ *
+ * $HEADER$
+ *
+ * Check that every daemon arrives at the same allgather cost
+ * estimates, wherever it sits in the routing tree. Pretend to be
+ * the HNP, an interior daemon and a leaf of a radix tree in turn,
+ * have the routed module work out our children for each, and
+ * compare the cost every active grpcomm module gives from there.
+ * The routing tree must be the radix one, with the same fanout
+ * the cost model assumes:
+ *
+ *   orterun -np 1 --mca routed radix --mca routed_radix 4 \
+ *           --mca grpcomm_base_tree_radix 4 allgather_cost
+ */
+
+#include "orte_config.h"
+
+#include <stdio.h>
+
+#include "orte/util/name_fns.h"
+#include "orte/util/proc_info.h"
+#include "orte/runtime/orte_globals.h"
+#include "orte/mca/routed/routed.h"
+#include "orte/mca/grpcomm/base/base.h"
+
+#include "orte/runtime/runtime.h"
+
+/* daemons in the pretend job, and who we pretend to be in it */
+#define NDMNS   21
+static const orte_vpid_t vpids[] = {0, 1, NDMNS - 1};
+#define NPOS    (sizeof(vpids) / sizeof(vpids[0]))
+
+/* collective sizes to estimate */
+static const size_t sizes[] = {2, 16, 256, 4096, 65536};
+#define NSIZES  (sizeof(sizes) / sizeof(sizes[0]))
+
+int main(int argc, char* argv[])
+{
+    orte_grpcomm_base_active_t *active;
+    orte_proc_type_t type;
+    orte_vpid_t vpid, nprocs;
+    size_t p, s, nroutes[NPOS] = {0};
+    double cost, first[NSIZES];
+    int rc, errors = 0, ncompared = 0;
+
+    if (0 > (rc = orte_init(&argc, &argv, ORTE_PROC_NON_MPI))) {
+        fprintf(stderr, "allgather_cost: couldn't init orte - error code %d\n", rc);
+        return rc;
+    }
+    type = orte_process_info.proc_type;
+    vpid = ORTE_PROC_MY_NAME->vpid;
+    nprocs = orte_process_info.num_procs;
+
+    OPAL_LIST_FOREACH(active, &orte_grpcomm_base.actives, orte_grpcomm_base_active_t) {
+        if (NULL == active->module->allgather_cost) {
+            continue;
+        }
+        for (p=0; p < NPOS; p++) {
+            /* the routing plan is only computed for daemons */
+            orte_process_info.proc_type = ORTE_PROC_DAEMON;
+            orte_process_info.num_procs = NDMNS;
+            ORTE_PROC_MY_NAME->vpid = vpids[p];
+            orte_routed.update_routing_plan();
+            nroutes[p] = orte_routed.num_routes();
+            for (s=0; s < NSIZES; s++) {
+                cost = active->module->allgather_cost(sizes[s], orte_grpcomm_base.bucket_size,
+                                                      orte_grpcomm_base.latency,
+                                                      orte_grpcomm_base.bandwidth);
+                if (0 == p) {
+                    first[s] = cost;
+                } else if (cost != first[s]) {
+                    fprintf(stderr, "allgather_cost: %s: daemon %u (%lu children) gives %g for %lu daemons, daemon %u (%lu children) gives %g\n",
+                            active->component->mca_component_name,
+                            (unsigned)vpids[p], (unsigned long)nroutes[p], cost,
+                            (unsigned long)sizes[s], (unsigned)vpids[0],
+                            (unsigned long)nroutes[0], first[s]);
+                    errors++;
+                }
+            }
+        }
+        fprintf(stderr, "allgather_cost: %s: %s\n",
+                active->component->mca_component_name,
+                (0 == errors) ? "same everywhere" : "differs");
+        ncompared++;
+    }
+
+    /* put back who we are - as the only daemon, we have no children */
+    orte_process_info.num_procs = 1;
+    ORTE_PROC_MY_NAME->vpid = 0;
+    orte_routed.update_routing_plan();
+    orte_process_info.proc_type = type;
+    orte_process_info.num_procs = nprocs;
+    ORTE_PROC_MY_NAME->vpid = vpid;
+
+    /* the test means nothing unless the positions differ */
+    if (nroutes[0] == nroutes[NPOS-1] || nroutes[1] == nroutes[NPOS-1]) {
+        fprintf(stderr, "allgather_cost: routing tree is flat - run with the radix routed component\n");
+        errors++;
+    }
+    if (0 == ncompared) {
+        fprintf(stderr, "allgather_cost: no module estimates its cost\n");
+        errors++;
+    }
+
+    fprintf(stderr, "allgather_cost: %s\n", (0 == errors) ? "OK" : "FAILED");
+    orte_finalize();
+    return (0 == errors) ? 0 : 1;
+}
@@ -0,0 +1,309 @@
+/* -*- C -*-
+ *
+ * $HEADER$
+ *
+ * Exercise the data server in the HNP directly over the RML, in the
+ * format the daemons' PMIx server uses:
+ *
+ *  - a lookup of a key published earlier in the same bulk request
+ *  - an unpublish of a key that was never published, which must
+ *    succeed without touching anything else in the store
+ *  - a lookup told to wait for its key, answered when the key is
+ *    published later - by itself, or in the same bulk request
+ *
+ *   orterun -np 1 data_server
+ */
+
+#include "orte_config.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "opal/dss/dss.h"
+#include "opal/mca/pmix/pmix.h"
+#include "opal/sys/atomic.h"
+
+#include "orte/util/name_fns.h"
+#include "orte/runtime/orte_globals.h"
+#include "orte/runtime/orte_data_server.h"
+#include "orte/mca/rml/rml.h"
+#include "orte/mca/errmgr/errmgr.h"
+
+#include "orte/runtime/runtime.h"
+
+#define MAX_ANSWERS 32
+
+typedef struct {
+    int room;
+    int status;
+    bool found;
+    int value;
+} answer_t;
+
+static answer_t answers[MAX_ANSWERS];
+static volatile int nanswers = 0;
+static int errors = 0;
+
+static void store_answer(opal_buffer_t *buf, int room)
+{
+    answer_t *ans;
+    opal_process_name_t owner;
+    opal_value_t *kv;
+    int32_t cnt;
+
+    if (MAX_ANSWERS <= nanswers) {
+        return;
+    }
+    ans = &answers[nanswers];
+    ans->room = room;
+    ans->found = false;
+    cnt = 1;
+    if (OPAL_SUCCESS != opal_dss.unpack(buf, &ans->status, &cnt, OPAL_INT)) {
+        ans->status = ORTE_ERROR;
+    }
+    cnt = 1;
+    if (ORTE_SUCCESS == ans->status &&
+        OPAL_SUCCESS == opal_dss.unpack(buf, &owner, &cnt, OPAL_NAME) &&
+        OPAL_SUCCESS == opal_dss.unpack(buf, &kv, &cnt, OPAL_VALUE)) {
+        ans->found = true;
+        ans->value = kv->data.integer;
+        OBJ_RELEASE(kv);
+    }
+    opal_atomic_wmb();
+    nanswers++;
+}
+
+static void recv_answer(int status, orte_process_name_t* sender,
+                        opal_buffer_t *buffer, orte_rml_tag_t tag,
+                        void *cbdata)
+{
+    opal_buffer_t *xfer;
+    int32_t cnt, n, nans;
+    int room;
+
+    cnt = 1;
+    if (OPAL_SUCCESS != opal_dss.unpack(buffer, &room, &cnt, OPAL_INT)) {
+        return;
+    }
+    if (ORTE_PMIX_BULK_ROOM != room) {
+        store_answer(buffer, room);
+        return;
+    }
+    cnt = 1;
+    if (OPAL_SUCCESS != opal_dss.unpack(buffer, &nans, &cnt, OPAL_INT32)) {
+        return;
+    }
+    for (n=0; n < nans; n++) {
+        cnt = 1;
+        if (OPAL_SUCCESS != opal_dss.unpack(buffer, &xfer, &cnt, OPAL_BUFFER)) {
+            return;
+        }
+        cnt = 1;
+        if (OPAL_SUCCESS == opal_dss.unpack(xfer, &room, &cnt, OPAL_INT)) {
+            store_answer(xfer, room);
+        }
+        OBJ_RELEASE(xfer);
+    }
+}
+
+static void pack_uid(opal_buffer_t *buf)
+{
+    opal_value_t kv, *kp = &kv;
+
+    OBJ_CONSTRUCT(&kv, opal_value_t);
+    kv.key = strdup(OPAL_PMIX_USERID);
+    kv.type = OPAL_UINT32;
+    kv.data.uint32 = geteuid();
+    opal_dss.pack(buf, &kp, 1, OPAL_VALUE);
+    OBJ_DESTRUCT(&kv);
+}
+
+/* keys are per proc, so several can run at once */
+static char* pkey(const char *key)
+{
+    static char buf[8][64];
+    static int next = 0;
+    char *k = buf[next++ % 8];
+
+    snprintf(k, sizeof(buf[0]), "%s.%u", key, (unsigned)ORTE_PROC_MY_NAME->vpid);
+    return k;
+}
+
+static opal_buffer_t* publish_req(int room, const char *key, int value)
+{
+    opal_buffer_t *buf = OBJ_NEW(opal_buffer_t);
+    opal_value_t kv, *kp = &kv;
+    uint8_t cmd = ORTE_PMIX_PUBLISH_CMD;
+    opal_pmix_data_range_t range = OPAL_PMIX_SESSION;
+    opal_pmix_persistence_t persist = OPAL_PMIX_PERSIST_APP;
+
+    opal_dss.pack(buf, &room, 1, OPAL_INT);
+    opal_dss.pack(buf, &cmd, 1, OPAL_UINT8);
+    opal_dss.pack(buf, ORTE_PROC_MY_NAME, 1, OPAL_NAME);
+    opal_dss.pack(buf, &range, 1, OPAL_INT);
+    opal_dss.pack(buf, &persist, 1, OPAL_INT);
+    OBJ_CONSTRUCT(&kv, opal_value_t);
+    kv.key = strdup(pkey(key));
+    kv.type = OPAL_INT;
+    kv.data.integer = value;
+    opal_dss.pack(buf, &kp, 1, OPAL_VALUE);
+    OBJ_DESTRUCT(&kv);
+    pack_uid(buf);
+    return buf;
+}
+
+static opal_buffer_t* key_req(int room, uint8_t cmd, const char *name, bool wait)
+{
+    opal_buffer_t *buf = OBJ_NEW(opal_buffer_t);
+    char *key = pkey(name);
+    opal_value_t kv, *kp = &kv;
+    opal_pmix_data_range_t range = OPAL_PMIX_SESSION;
+    uint32_t nkeys = 1;
+
+    opal_dss.pack(buf, &room, 1, OPAL_INT);
+    opal_dss.pack(buf, &cmd, 1, OPAL_UINT8);
+    if (ORTE_PMIX_UNPUBLISH_CMD == cmd) {
+        opal_dss.pack(buf, ORTE_PROC_MY_NAME, 1, OPAL_NAME);
+    }
+    opal_dss.pack(buf, &range, 1, OPAL_INT);
+    opal_dss.pack(buf, &nkeys, 1, OPAL_UINT32);
+    opal_dss.pack(buf, &key, 1, OPAL_STRING);
+    pack_uid(buf);
+    if (wait) {
+        OBJ_CONSTRUCT(&kv, opal_value_t);
+        kv.key = strdup(OPAL_PMIX_WAIT);
+        kv.type = OPAL_BOOL;
+        kv.data.flag = true;
+        opal_dss.pack(buf, &kp, 1, OPAL_VALUE);
+        OBJ_DESTRUCT(&kv);
+    }
+    return buf;
+}
+
+static opal_buffer_t* bulk_req(opal_buffer_t **reqs, int32_t nreqs)
+{
+    opal_buffer_t *buf = OBJ_NEW(opal_buffer_t);
+    uint8_t cmd = ORTE_PMIX_BULK_CMD;
+    int room = -1;
+    int32_t n;
+
+    opal_dss.pack(buf, &room, 1, OPAL_INT);
+    opal_dss.pack(buf, &cmd, 1, OPAL_UINT8);
+    opal_dss.pack(buf, &nreqs, 1, OPAL_INT32);
+    for (n=0; n < nreqs; n++) {
+        opal_dss.pack(buf, &reqs[n], 1, OPAL_BUFFER);
+        OBJ_RELEASE(reqs[n]);
+    }
+    return buf;
+}
+
+static void send_req(opal_buffer_t *buf)
+{
+    int rc;
+
+    if (ORTE_SUCCESS != (rc = orte_rml.send_buffer_nb(ORTE_PROC_MY_HNP, buf,
+                                                      ORTE_RML_TAG_DATA_SERVER,
+                                                      orte_rml_send_callback, NULL))) {
+        ORTE_ERROR_LOG(rc);
+        OBJ_RELEASE(buf);
+        errors++;
+    }
+}
+
+/* the answer for the given room, waiting up to msec for it */
+static answer_t* get_answer(int room, int msec)
+{
+    int i, t;
+
+    for (t=0; t <= msec; t++) {
+        opal_atomic_rmb();
+        for (i=0; i < nanswers; i++) {
+            if (answers[i].room == room) {
+                return &answers[i];
+            }
+        }
+        usleep(1000);
+    }
+    return NULL;
+}
+
+static void expect(const char *what, int room, int status, bool found, int value)
+{
+    answer_t *ans = get_answer(room, 5000);
+
+    if (NULL == ans) {
+        fprintf(stderr, "data_server: %s: no answer\n", what);
+        errors++;
+    } else if (ans->status != status || ans->found != found ||
+               (found && ans->value != value)) {
+        fprintf(stderr, "data_server: %s: got status %d found %d value %d\n",
+                what, ans->status, (int)ans->found, ans->value);
+        errors++;
+    } else {
+        fprintf(stderr, "data_server: %s: OK\n", what);
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    opal_buffer_t *reqs[2];
+    int rc;
+
+    if (0 > (rc = orte_init(&argc, &argv, ORTE_PROC_NON_MPI))) {
+        fprintf(stderr, "data_server: couldn't init orte - error code %d\n", rc);
+        return rc;
+    }
+    orte_rml.recv_buffer_nb(ORTE_NAME_WILDCARD, ORTE_RML_TAG_DATA_CLIENT,
+                            ORTE_RML_PERSISTENT, recv_answer, NULL);
+
+    /* a lookup sees what was published ahead of it in the same batch */
+    reqs[0] = publish_req(1, "batch-key", 42);
+    reqs[1] = key_req(2, ORTE_PMIX_LOOKUP_CMD, "batch-key", false);
+    send_req(bulk_req(reqs, 2));
+    expect("publish in batch", 1, ORTE_SUCCESS, false, 0);
+    expect("lookup in same batch", 2, ORTE_SUCCESS, true, 42);
+
+    /* unpublishing a key nobody published succeeds and leaves the
+     * rest of the store alone */
+    send_req(key_req(3, ORTE_PMIX_UNPUBLISH_CMD, "no-such-key", false));
+    expect("unpublish of missing key", 3, ORTE_SUCCESS, false, 0);
+    send_req(key_req(4, ORTE_PMIX_LOOKUP_CMD, "batch-key", false));
+    expect("lookup after missing unpublish", 4, ORTE_SUCCESS, true, 42);
+    send_req(key_req(5, ORTE_PMIX_LOOKUP_CMD, "no-such-key", false));
+    expect("lookup of missing key", 5, ORTE_ERR_NOT_FOUND, false, 0);
+
+    /* a waiting lookup is answered by the publish of its key */
+    send_req(key_req(6, ORTE_PMIX_LOOKUP_CMD, "late-key", true));
+    if (NULL != get_answer(6, 200)) {
+        fprintf(stderr, "data_server: waiting lookup answered early\n");
+        errors++;
+    }
+    send_req(publish_req(7, "late-key", 7));
+    expect("publish of awaited key", 7, ORTE_SUCCESS, false, 0);
+    expect("waiting lookup", 6, ORTE_SUCCESS, true, 7);
+
+    /* ...also when both are in the same batch */
+    reqs[0] = key_req(8, ORTE_PMIX_LOOKUP_CMD, "batch-late-key", true);
+    reqs[1] = publish_req(9, "batch-late-key", 9);
+    send_req(bulk_req(reqs, 2));
+    expect("publish of awaited key in batch", 9, ORTE_SUCCESS, false, 0);
+    expect("waiting lookup in same batch", 8, ORTE_SUCCESS, true, 9);
+
+    /* and the waiter is gone once answered - unpublish, then a new
+     * waiting lookup must not be answered by the old data */
+    send_req(key_req(10, ORTE_PMIX_UNPUBLISH_CMD, "late-key", false));
+    expect("unpublish of awaited key", 10, ORTE_SUCCESS, false, 0);
+    send_req(key_req(11, ORTE_PMIX_LOOKUP_CMD, "late-key", true));
+    if (NULL != get_answer(11, 200)) {
+        fprintf(stderr, "data_server: lookup answered from unpublished data\n");
+        errors++;
+    }
+    send_req(publish_req(12, "late-key", 12));
+    expect("republish of awaited key", 12, ORTE_SUCCESS, false, 0);
+    expect("waiting lookup after republish", 11, ORTE_SUCCESS, true, 12);
+
+    fprintf(stderr, "data_server: %s\n", (0 == errors) ? "OK" : "FAILED");
+    orte_finalize();
+    return (0 == errors) ? 0 : 1;
+}
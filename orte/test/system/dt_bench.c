@@ -0,0 +1,167 @@
+/* -*- C -*-
+ *
+ * $HEADER$
+ *
+ * Measure packing and unpacking of a job carrying many procs, as in a
+ * launch message, for each buffer type with and without
+ * orte_pack_changed_fields, and check that what comes out matches what
+ * went in. Prints the results as a single JSON object.
+ *
+ *   orterun -np 1 dt_bench [nprocs] [procs-per-node] [iterations]
+ */
+
+#include "orte_config.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+
+#include "opal/dss/dss.h"
+
+#include "orte/runtime/orte_globals.h"
+#include "orte/mca/errmgr/errmgr.h"
+
+#include "orte/runtime/runtime.h"
+
+static double now_usec(void)
+{
+    struct timeval tv;
+
+    gettimeofday(&tv, NULL);
+    return tv.tv_sec * 1000000.0 + tv.tv_usec;
+}
+
+static orte_job_t *make_job(int nprocs, int ppn)
+{
+    orte_job_t *jdata;
+    orte_proc_t *proc;
+    int i;
+
+    jdata = OBJ_NEW(orte_job_t);
+    jdata->jobid = 0x12340001;
+    jdata->num_procs = nprocs;
+    jdata->state = ORTE_JOB_STATE_RUNNING;
+    jdata->stdin_target = 0;
+    for (i=0; i < nprocs; i++) {
+        proc = OBJ_NEW(orte_proc_t);
+        proc->name.jobid = jdata->jobid;
+        proc->name.vpid = i;
+        proc->parent = i / ppn;
+        proc->local_rank = i % ppn;
+        proc->node_rank = i % ppn;
+        proc->state = ORTE_PROC_STATE_RUNNING;
+        proc->app_idx = 0;
+        opal_pointer_array_set_item(jdata->procs, i, proc);
+    }
+    return jdata;
+}
+
+static bool same_job(orte_job_t *a, orte_job_t *b)
+{
+    orte_proc_t *p, *q;
+    int i;
+
+    if (a->jobid != b->jobid || a->num_procs != b->num_procs ||
+        a->state != b->state || a->stdin_target != b->stdin_target) {
+        return false;
+    }
+    for (i=0; i < (int)a->num_procs; i++) {
+        p = (orte_proc_t*)opal_pointer_array_get_item(a->procs, i);
+        q = (orte_proc_t*)opal_pointer_array_get_item(b->procs, i);
+        if (NULL == q ||
+            p->name.jobid != q->name.jobid || p->name.vpid != q->name.vpid ||
+            p->parent != q->parent || p->local_rank != q->local_rank ||
+            p->node_rank != q->node_rank || p->state != q->state ||
+            p->app_idx != q->app_idx) {
+            return false;
+        }
+    }
+    return true;
+}
+
+int main(int argc, char* argv[])
+{
+    static const struct {
+        opal_dss_buffer_type_t type;
+        const char *name;
+    } types[] = {
+        {OPAL_DSS_BUFFER_NON_DESC, "non-described"},
+        {OPAL_DSS_BUFFER_FULLY_DESC, "described"},
+        {OPAL_DSS_BUFFER_COMPACT, "compact"}
+    };
+    int nprocs = 10000, ppn = 16, iters = 20;
+    int t, c, n, rc, ret = 0;
+    int32_t cnt;
+    orte_job_t *jdata, *jout;
+    opal_buffer_t *buf;
+    double start, tpack, tunpack;
+    size_t bytes;
+    const char *sep = "";
+
+    if (1 < argc) {
+        nprocs = strtol(argv[1], NULL, 10);
+    }
+    if (2 < argc) {
+        ppn = strtol(argv[2], NULL, 10);
+    }
+    if (3 < argc) {
+        iters = strtol(argv[3], NULL, 10);
+    }
+
+    if (0 > (rc = orte_init(&argc, &argv, ORTE_PROC_NON_MPI))) {
+        fprintf(stderr, "dt_bench: couldn't init orte - error %d\n", rc);
+        return rc;
+    }
+
+    jdata = make_job(nprocs, ppn);
+
+    printf("{\"procs\": %d, \"procs_per_node\": %d, \"results\": [", nprocs, ppn);
+    for (t=0; t < (int)(sizeof(types) / sizeof(types[0])); t++) {
+        for (c=0; c < 2; c++) {
+            orte_pack_changed_fields = (1 == c);
+            tpack = tunpack = 0.0;
+            bytes = 0;
+            for (n=0; n < iters; n++) {
+                buf = OBJ_NEW(opal_buffer_t);
+                buf->type = types[t].type;
+                start = now_usec();
+                rc = opal_dss.pack(buf, &jdata, 1, ORTE_JOB);
+                tpack += now_usec() - start;
+                if (ORTE_SUCCESS != rc) {
+                    ORTE_ERROR_LOG(rc);
+                    ret = 1;
+                    OBJ_RELEASE(buf);
+                    break;
+                }
+                bytes = buf->bytes_used;
+                cnt = 1;
+                start = now_usec();
+                rc = opal_dss.unpack(buf, &jout, &cnt, ORTE_JOB);
+                tunpack += now_usec() - start;
+                OBJ_RELEASE(buf);
+                if (ORTE_SUCCESS != rc) {
+                    ORTE_ERROR_LOG(rc);
+                    ret = 1;
+                    break;
+                }
+                if (0 == n && !same_job(jdata, jout)) {
+                    fprintf(stderr, "dt_bench: %s buffer (changed fields %s) did not match\n",
+                            types[t].name, c ? "on" : "off");
+                    ret = 1;
+                }
+                OBJ_RELEASE(jout);
+            }
+            printf("%s\n    {\"buffer\": \"%s\", \"changed_fields\": %s, \"bytes\": %lu, "
+                   "\"pack_usec\": %.1f, \"unpack_usec\": %.1f}",
+                   sep, types[t].name, c ? "true" : "false", (unsigned long)bytes,
+                   tpack / iters, tunpack / iters);
+            sep = ",";
+        }
+    }
+    printf("]}\n");
+
+    OBJ_RELEASE(jdata);
+    orte_finalize();
+    return ret;
+}
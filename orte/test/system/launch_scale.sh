@@ -0,0 +1,55 @@
+#!/bin/sh
+#
+# Measure how the HNP side of a launch scales with the size of the
+# allocation. Each run uses the ras simulator to fake the nodes, so
+# nothing is actually launched. The HNP still allocates, builds the
+# virtual machine, maps the job, encodes the nodemap, builds the
+# launch msg and packs it for xcast. It appends one JSON record per
+# run to the plm_base_profile file.
+#
+# usage: launch_scale.sh [-p procs-per-node] [-o output] [nodes ...]
+#
+# The records are written to the output file (default: stdout) as a
+# JSON array, e.g.
+#
+#   ./launch_scale.sh -p 16 1000 10000 100000 > scale.json
+#
+# The launcher can be overridden with MPIRUN, and any extra options
+# passed in LAUNCH_SCALE_ARGS, e.g. LAUNCH_SCALE_ARGS="--map-by node".
+
+mpirun=${MPIRUN:-orterun}
+ppn=16
+out=
+while getopts "p:o:" opt; do
+    case $opt in
+        p) ppn=$OPTARG ;;
+        o) out=$OPTARG ;;
+        *) echo "usage: $0 [-p procs-per-node] [-o output] [nodes ...]" >&2; exit 1 ;;
+    esac
+done
+shift `expr $OPTIND - 1`
+if [ $# -eq 0 ]; then
+    set -- 1000 2000 5000 10000 20000 50000 100000
+fi
+
+profile=`mktemp ${TMPDIR:-/tmp}/launch_scale.XXXXXX`
+trap 'rm -f $profile' EXIT
+
+for nodes in "$@"; do
+    np=`expr $nodes \* $ppn`
+    echo "launch_scale: $nodes nodes, $np procs" >&2
+    if ! $mpirun --mca ras simulator \
+                --mca ras_simulator_num_nodes $nodes \
+                --mca ras_simulator_slots $ppn \
+                --mca plm_base_profile $profile \
+                $LAUNCH_SCALE_ARGS -np $np hostname > /dev/null; then
+        echo "launch_scale: run with $nodes nodes failed" >&2
+    fi
+done
+
+if [ -n "$out" ]; then
+    exec > $out
+fi
+echo "["
+sed -e '$!s/$/,/' -e 's/^/  /' $profile
+echo "]"
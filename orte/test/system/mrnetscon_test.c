@@ -0,0 +1,167 @@
+#include "orte_config.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "opal/dss/dss.h"
+#include "opal/mca/pmix/pmix.h"
+
+#include "orte/util/proc_info.h"
+#include "orte/util/name_fns.h"
+#include "orte/runtime/orte_globals.h"
+#include "orte/mca/errmgr/errmgr.h"
+
+#include "orte/runtime/runtime.h"
+#include "orte/runtime/orte_wait.h"
+
+#include "scon/scon.h"
+#include "scon/shims/mrnet/mrnetscon.h"
+
+#define NREDUCTIONS 10
+
+static volatile bool active;
+static opal_buffer_t result;
+
+static void reduce_cbfunc(int status, mrnetscon_stream_t stream,
+                          opal_buffer_t *buf, void *cbdata)
+{
+    if (ORTE_SUCCESS != status) {
+        opal_output(0, "%s stream %d reduction FAILED: %s",
+                    ORTE_NAME_PRINT(ORTE_PROC_MY_NAME), (int)stream,
+                    ORTE_ERROR_NAME(status));
+    }
+    if (NULL != buf) {
+        opal_dss.copy_payload(&result, buf);
+    }
+    active = false;
+}
+
+static int64_t reduce_array(mrnetscon_stream_t stream, int64_t val)
+{
+    opal_buffer_t buf;
+    opal_data_type_t type;
+    int64_t *vals, ans = -1;
+    int32_t n;
+
+    OBJ_CONSTRUCT(&buf, opal_buffer_t);
+    mrnetscon_pack_array(&buf, OPAL_INT64, &val, 1);
+    OBJ_CONSTRUCT(&result, opal_buffer_t);
+    active = true;
+    mrnetscon_reduce(stream, &buf, reduce_cbfunc, NULL);
+    ORTE_WAIT_FOR_COMPLETION(active);
+    OBJ_DESTRUCT(&buf);
+    if (0 < result.bytes_used &&
+        ORTE_SUCCESS == mrnetscon_unpack_array(&result, &type, (void**)&vals, &n)) {
+        ans = vals[0];
+        free(vals);
+    }
+    OBJ_DESTRUCT(&result);
+    return ans;
+}
+
+int main(int argc, char *argv[])
+{
+    scon_handle_t all;
+    mrnetscon_stream_t sum, min, max, concat, hist;
+    opal_buffer_t buf;
+    orte_vpid_t nprocs, v;
+    int64_t me, ans, expected;
+    int32_t i, cnt, nbins;
+    uint64_t *counts, total;
+    double lo, hi, val;
+    bool root;
+
+    if (ORTE_SUCCESS != orte_init(&argc, &argv, ORTE_PROC_NON_MPI)) {
+        fprintf(stderr, "orte_init failed\n");
+        exit(1);
+    }
+    mrnetscon_init();
+    nprocs = orte_process_info.num_procs;
+    root = (0 == ORTE_PROC_MY_NAME->vpid);
+    me = ORTE_PROC_MY_NAME->vpid;
+
+    all = scon_create(NULL);
+    sum = mrnetscon_stream_create(all, MRNETSCON_FILTER_SUM);
+    min = mrnetscon_stream_create(all, MRNETSCON_FILTER_MIN);
+    max = mrnetscon_stream_create(all, MRNETSCON_FILTER_MAX);
+    concat = mrnetscon_stream_create(all, MRNETSCON_FILTER_CONCAT);
+    hist = mrnetscon_stream_create(all, MRNETSCON_FILTER_HISTOGRAM);
+
+    /* repeated reductions on the same stream */
+    expected = (int64_t)nprocs * (nprocs - 1) / 2;
+    for (i=0; i < NREDUCTIONS; i++) {
+        ans = reduce_array(sum, me + i);
+        if (root && ans != expected + (int64_t)nprocs * i) {
+            opal_output(0, "sum FAILED: got %ld", (long)ans);
+        }
+    }
+    ans = reduce_array(min, me + 7);
+    if (root && 7 != ans) {
+        opal_output(0, "min FAILED: got %ld", (long)ans);
+    }
+    ans = reduce_array(max, me + 7);
+    if (root && (int64_t)nprocs + 6 != ans) {
+        opal_output(0, "max FAILED: got %ld", (long)ans);
+    }
+
+    /* concat - the root must see one entry from each proc */
+    OBJ_CONSTRUCT(&buf, opal_buffer_t);
+    opal_dss.pack(&buf, &ORTE_PROC_MY_NAME->vpid, 1, ORTE_VPID);
+    OBJ_CONSTRUCT(&result, opal_buffer_t);
+    active = true;
+    mrnetscon_reduce(concat, &buf, reduce_cbfunc, NULL);
+    ORTE_WAIT_FOR_COMPLETION(active);
+    OBJ_DESTRUCT(&buf);
+    if (root) {
+        total = 0;
+        cnt = 1;
+        while (OPAL_SUCCESS == opal_dss.unpack(&result, &v, &cnt, ORTE_VPID)) {
+            total++;
+        }
+        if (total != nprocs) {
+            opal_output(0, "concat FAILED: got %d entries", (int)total);
+        }
+    }
+    OBJ_DESTRUCT(&result);
+
+    /* histogram of vpids */
+    OBJ_CONSTRUCT(&buf, opal_buffer_t);
+    val = me;
+    mrnetscon_pack_histogram(&buf, 0.0, (double)nprocs, 4, &val, 1);
+    OBJ_CONSTRUCT(&result, opal_buffer_t);
+    active = true;
+    mrnetscon_reduce(hist, &buf, reduce_cbfunc, NULL);
+    ORTE_WAIT_FOR_COMPLETION(active);
+    OBJ_DESTRUCT(&buf);
+    if (root) {
+        if (ORTE_SUCCESS != mrnetscon_unpack_histogram(&result, &lo, &hi, &nbins, &counts)) {
+            opal_output(0, "histogram FAILED: no result");
+        } else {
+            total = 0;
+            for (i=0; i < nbins; i++) {
+                total += counts[i];
+            }
+            if (total != nprocs) {
+                opal_output(0, "histogram FAILED: counted %d", (int)total);
+            }
+            free(counts);
+        }
+        opal_output(0, "%s mrnetscon reductions over %d procs complete",
+                    ORTE_NAME_PRINT(ORTE_PROC_MY_NAME), (int)nprocs);
+    }
+    OBJ_DESTRUCT(&result);
+
+    /* ensure all forwarding is done before anyone leaves */
+    opal_pmix.fence(NULL, 0);
+
+    mrnetscon_stream_delete(hist);
+    mrnetscon_stream_delete(concat);
+    mrnetscon_stream_delete(max);
+    mrnetscon_stream_delete(min);
+    mrnetscon_stream_delete(sum);
+    scon_delete(all);
+    mrnetscon_finalize();
+    scon_finalize();
+    orte_finalize();
+    return 0;
+}
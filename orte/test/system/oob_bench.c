@@ -0,0 +1,246 @@
+/* -*- C -*-
+ *
+ * $HEADER$
+ *
+ * Measure the RML/OOB paths between the daemons of a job: point-to-point
+ * latency and message rate at a range of sizes, and allgather (fence)
+ * latency. Rank 0 prints the results as a single JSON object.
+ *
+ * An app proc has no way to start an xcast of its own, so xcast latency
+ * is not measured separately. The allgather figure is the time for the
+ * whole collective and is not an xcast measurement - with the direct
+ * component it does include the release sent back down the routing
+ * tree, but the other components finish without one.
+ *
+ * Run with one proc per daemon so every message crosses the OOB, e.g.
+ *
+ *   orterun --map-by node -np 8 oob_bench [iterations]
+ *
+ * and select the routing tree and allgather with the usual params, e.g.
+ * -mca routed binomial -mca grpcomm_base_allgather_table 0:brucks
+ */
+
+#include "orte_config.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sched.h>
+#include <sys/time.h>
+
+#include "opal/mca/base/mca_base_var.h"
+#include "opal/mca/pmix/pmix.h"
+#include "opal/dss/dss.h"
+
+#include "orte/util/proc_info.h"
+#include "orte/util/name_fns.h"
+#include "orte/runtime/orte_globals.h"
+#include "orte/mca/rml/rml.h"
+#include "orte/mca/errmgr/errmgr.h"
+
+#include "orte/runtime/runtime.h"
+
+#define BENCH_TAG   12345
+#define REPLY_TAG   12346
+
+#define RATE_WINDOW 64
+
+/* what the receiver of a benchmark msg should do with it */
+#define BENCH_NO_REPLY  0
+#define BENCH_ECHO      1
+#define BENCH_ACK       2
+
+static const int sizes[] = {1, 64, 1024, 16384, 262144, 1048576};
+#define NSIZES (int)(sizeof(sizes) / sizeof(sizes[0]))
+
+static volatile int nreplies = 0;
+
+static double now_usec(void)
+{
+    struct timeval tv;
+
+    gettimeofday(&tv, NULL);
+    return (double)tv.tv_sec * 1000000.0 + (double)tv.tv_usec;
+}
+
+static void wait_for(volatile int *counter, int target)
+{
+    /* the progress thread does the work - just stay out of its way */
+    while (*counter < target) {
+        sched_yield();
+    }
+}
+
+static void send_msg(orte_process_name_t *peer, int8_t mode,
+                     uint8_t *data, int32_t size, orte_rml_tag_t tag)
+{
+    opal_buffer_t *buf;
+    int rc;
+
+    buf = OBJ_NEW(opal_buffer_t);
+    opal_dss.pack(buf, &mode, 1, OPAL_INT8);
+    opal_dss.pack(buf, &size, 1, OPAL_INT32);
+    opal_dss.pack(buf, data, size, OPAL_BYTE);
+    if (0 > (rc = orte_rml.send_buffer_nb(peer, buf, tag, orte_rml_send_callback, NULL))) {
+        ORTE_ERROR_LOG(rc);
+        OBJ_RELEASE(buf);
+    }
+}
+
+static void bench_recv(int status, orte_process_name_t* sender,
+                       opal_buffer_t* buffer, orte_rml_tag_t tag,
+                       void* cbdata)
+{
+    int8_t mode;
+    int32_t size, cnt;
+    uint8_t *data, ack = 0;
+
+    cnt = 1;
+    opal_dss.unpack(buffer, &mode, &cnt, OPAL_INT8);
+    cnt = 1;
+    opal_dss.unpack(buffer, &size, &cnt, OPAL_INT32);
+    if (BENCH_ECHO == mode) {
+        data = (uint8_t*)malloc(size);
+        cnt = size;
+        opal_dss.unpack(buffer, data, &cnt, OPAL_BYTE);
+        send_msg(sender, BENCH_NO_REPLY, data, size, REPLY_TAG);
+        free(data);
+    } else if (BENCH_ACK == mode) {
+        send_msg(sender, BENCH_NO_REPLY, &ack, 1, REPLY_TAG);
+    }
+}
+
+static void reply_recv(int status, orte_process_name_t* sender,
+                       opal_buffer_t* buffer, orte_rml_tag_t tag,
+                       void* cbdata)
+{
+    nreplies++;
+}
+
+static const char* param_value(const char *framework, const char *component,
+                               const char *name)
+{
+    int idx;
+    char **value;
+
+    idx = mca_base_var_find("orte", framework, component, name);
+    if (0 > idx || OPAL_SUCCESS != mca_base_var_get_value(idx, &value, NULL, NULL) ||
+        NULL == value || NULL == *value) {
+        return "default";
+    }
+    return *value;
+}
+
+int main(int argc, char *argv[])
+{
+    int iters, n, i, j, p, npeers, target;
+    int32_t nbytes;
+    orte_process_name_t peers[2];
+    uint8_t *data;
+    double start, lat, rate, xlat;
+    opal_value_t kv;
+
+    orte_init(&argc, &argv, ORTE_PROC_NON_MPI);
+
+    iters = (1 < argc) ? atoi(argv[1]) : 100;
+    if (iters < 1) {
+        iters = 1;
+    }
+    if (orte_process_info.num_procs < 2) {
+        fprintf(stderr, "oob_bench: needs at least two procs\n");
+        orte_finalize();
+        return 1;
+    }
+
+    orte_rml.recv_buffer_nb(ORTE_NAME_WILDCARD, BENCH_TAG, ORTE_RML_PERSISTENT, bench_recv, NULL);
+    orte_rml.recv_buffer_nb(ORTE_NAME_WILDCARD, REPLY_TAG, ORTE_RML_PERSISTENT, reply_recv, NULL);
+    data = (uint8_t*)calloc(sizes[NSIZES-1], 1);
+
+    /* measure to the next daemon and to the one furthest from
+     * us in vpid, which typically sits deepest in the tree */
+    npeers = 0;
+    peers[npeers].jobid = ORTE_PROC_MY_NAME->jobid;
+    peers[npeers++].vpid = 1;
+    if (2 < orte_process_info.num_procs) {
+        peers[npeers].jobid = ORTE_PROC_MY_NAME->jobid;
+        peers[npeers++].vpid = orte_process_info.num_procs - 1;
+    }
+
+    opal_pmix.fence(NULL, 0);
+
+    if (0 == ORTE_PROC_MY_NAME->vpid) {
+        printf("{\"nprocs\": %d, \"iterations\": %d, \"routed\": \"%s\", \"allgather_table\": \"%s\",\n",
+               (int)orte_process_info.num_procs, iters,
+               param_value("routed", NULL, NULL),
+               param_value("grpcomm", "base", "allgather_table"));
+        printf(" \"p2p\": [");
+        for (p=0; p < npeers; p++) {
+            for (j=0; j < NSIZES; j++) {
+                /* keep the large sizes from dominating the run */
+                n = (sizes[j] <= 16384) ? iters : (iters + 9) / 10;
+                /* warm up the route */
+                target = nreplies + 1;
+                send_msg(&peers[p], BENCH_ECHO, data, sizes[j], BENCH_TAG);
+                wait_for(&nreplies, target);
+
+                start = now_usec();
+                for (i=0; i < n; i++) {
+                    target = nreplies + 1;
+                    send_msg(&peers[p], BENCH_ECHO, data, sizes[j], BENCH_TAG);
+                    wait_for(&nreplies, target);
+                }
+                lat = (now_usec() - start) / (2.0 * n);
+
+                start = now_usec();
+                for (i=0; i < n; i++) {
+                    for (nbytes=0; nbytes < RATE_WINDOW-1; nbytes++) {
+                        send_msg(&peers[p], BENCH_NO_REPLY, data, sizes[j], BENCH_TAG);
+                    }
+                    target = nreplies + 1;
+                    send_msg(&peers[p], BENCH_ACK, data, sizes[j], BENCH_TAG);
+                    wait_for(&nreplies, target);
+                }
+                rate = (double)(n * RATE_WINDOW) / ((now_usec() - start) / 1000000.0);
+
+                printf("%s\n    {\"peer\": %u, \"bytes\": %d, \"latency_usec\": %.2f, "
+                       "\"msgs_per_sec\": %.0f, \"mbytes_per_sec\": %.2f}",
+                       (0 == p && 0 == j) ? "" : ",", peers[p].vpid, sizes[j], lat,
+                       rate, rate * sizes[j] / 1000000.0);
+            }
+        }
+        printf("],\n");
+    }
+    opal_pmix.fence(NULL, 0);
+
+    /* allgather - with no data, and with 1k from each proc */
+    start = now_usec();
+    for (i=0; i < iters; i++) {
+        opal_pmix.fence(NULL, 0);
+    }
+    lat = (now_usec() - start) / iters;
+
+    OBJ_CONSTRUCT(&kv, opal_value_t);
+    kv.key = strdup("oob_bench.data");
+    kv.type = OPAL_BYTE_OBJECT;
+    kv.data.bo.bytes = (uint8_t*)malloc(1024);
+    memset(kv.data.bo.bytes, 0, 1024);
+    kv.data.bo.size = 1024;
+    opal_pmix.put(OPAL_PMIX_GLOBAL, &kv);
+    OBJ_DESTRUCT(&kv);
+    opal_pmix.commit();
+    start = now_usec();
+    for (i=0; i < iters; i++) {
+        opal_pmix.fence(NULL, 1);
+    }
+    xlat = (now_usec() - start) / iters;
+
+    if (0 == ORTE_PROC_MY_NAME->vpid) {
+        printf(" \"allgather\": [\n    {\"bytes\": 0, \"latency_usec\": %.2f},\n"
+               "    {\"bytes\": 1024, \"latency_usec\": %.2f}]}\n", lat, xlat);
+        fflush(stdout);
+    }
+
+    free(data);
+    orte_finalize();
+    return 0;
+}
@@ -0,0 +1,74 @@
+#!/bin/sh
+#
+# Run oob_bench across a set of daemons all started on the local host,
+# once for each combination of routing tree and allgather algorithm.
+# The "nodes" are fake: a local rsh agent ignores the hostname and
+# starts each orted here with its own session directory, so every
+# message still goes through the OOB.
+#
+# usage: oob_bench.sh [-n daemons] [-i iterations] [-o output]
+#
+# The results are written to the output file (default: stdout) as a
+# JSON array with one oob_bench record per run, e.g.
+#
+#   ./oob_bench.sh -n 16 -i 100 > oob.json
+#
+# The launcher can be overridden with MPIRUN, the routing trees and
+# allgather components with ROUTED and ALLGATHER, and any extra options
+# passed in OOB_BENCH_ARGS.
+
+mpirun=${MPIRUN:-orterun}
+routed=${ROUTED:-"radix binomial debruijn"}
+allgather=${ALLGATHER:-"direct brucks rcd"}
+ndaemons=8
+iters=100
+out=
+while getopts "n:i:o:" opt; do
+    case $opt in
+        n) ndaemons=$OPTARG ;;
+        i) iters=$OPTARG ;;
+        o) out=$OPTARG ;;
+        *) echo "usage: $0 [-n daemons] [-i iterations] [-o output]" >&2; exit 1 ;;
+    esac
+done
+
+bench=`dirname $0`/oob_bench
+tmp=`mktemp -d ${TMPDIR:-/tmp}/oob_bench.XXXXXX`
+trap 'rm -rf $tmp' EXIT
+
+cat > $tmp/agent <<EOF
+#!/bin/sh
+host=\$1
+shift
+while [ "\${1#-}" != "\$1" ]; do shift; done
+mkdir -p $tmp/\$host
+TMPDIR=$tmp/\$host
+export TMPDIR
+exec sh -c "\$*"
+EOF
+chmod +x $tmp/agent
+
+hosts=
+i=1
+while [ $i -le $ndaemons ]; do
+    hosts="${hosts:+$hosts,}node$i:1"
+    i=`expr $i + 1`
+done
+
+for r in $routed; do
+    for a in $allgather; do
+        echo "oob_bench: $ndaemons daemons, routed $r, allgather $a" >&2
+        if ! $mpirun --mca plm_rsh_agent $tmp/agent --host $hosts --map-by node \
+                    --mca routed $r --mca grpcomm_base_allgather_table 0:$a \
+                    $OOB_BENCH_ARGS -np $ndaemons $bench $iters >> $tmp/results; then
+            echo "oob_bench: run with routed $r, allgather $a failed" >&2
+        fi
+    done
+done
+
+if [ -n "$out" ]; then
+    exec > $out
+fi
+echo "["
+sed -e 's/^{/  {/' -e 's/]}$/]},/' -e '$s/]},$/]}/' $tmp/results
+echo "]"
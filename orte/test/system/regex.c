@@ -8,19 +8,87 @@
 #include "orte_config.h"
 
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 #include <unistd.h>
 
 #include "opal/util/argv.h"
 
+#include "orte/util/name_fns.h"
+#include "orte/util/nidmap.h"
 #include "orte/util/proc_info.h"
 #include "orte/util/regex.h"
+#include "orte/runtime/orte_globals.h"
 #include "orte/mca/errmgr/errmgr.h"
 #include "orte/runtime/runtime.h"
 
+/* encode a nodemap with a daemon on each of the given nodes,
+ * and look each daemon up in it again */
+static void check_nodemap(char **nodes)
+{
+    orte_job_t *daemons;
+    orte_proc_t *dmn;
+    opal_byte_object_t bo;
+    bool created = false;
+    char *name;
+    int32_t slots;
+    int i, rc;
+
+    if (NULL == orte_job_data) {
+        orte_job_data = OBJ_NEW(opal_hash_table_t);
+        opal_hash_table_init(orte_job_data, 128);
+        created = true;
+    }
+    daemons = OBJ_NEW(orte_job_t);
+    daemons->jobid = ORTE_PROC_MY_NAME->jobid;
+    opal_hash_table_set_value_uint32(orte_job_data, daemons->jobid, daemons);
+    /* number the daemons backwards so the lookup has to
+     * follow the vpids rather than the order of the nodes */
+    for (i=0; NULL != nodes[i]; i++) {
+        dmn = OBJ_NEW(orte_proc_t);
+        dmn->name.jobid = daemons->jobid;
+        dmn->name.vpid = opal_argv_count(nodes) - 1 - i;
+        dmn->node = OBJ_NEW(orte_node_t);
+        dmn->node->name = strdup(nodes[i]);
+        dmn->node->slots = i % 3 + 1;
+        opal_pointer_array_set_item(daemons->procs, dmn->name.vpid, dmn);
+        daemons->num_procs++;
+    }
+
+    if (ORTE_SUCCESS != (rc = orte_util_encode_nodemap(&bo, false))) {
+        ORTE_ERROR_LOG(rc);
+    } else {
+        for (i=0; NULL != nodes[i]; i++) {
+            dmn = (orte_proc_t*)opal_pointer_array_get_item(daemons->procs, i);
+            if (ORTE_SUCCESS != (rc = orte_util_nodemap_lookup(&bo, i, &name, &slots))) {
+                fprintf(stderr, "ERROR: daemon %d not found in nodemap\n", i);
+                continue;
+            }
+            if (0 != strcmp(name, dmn->node->name) || slots != dmn->node->slots) {
+                fprintf(stderr, "ERROR: daemon %d is on %s with %d slots, not %s with %d\n",
+                        i, name, (int)slots, dmn->node->name, (int)dmn->node->slots);
+            }
+            free(name);
+        }
+        if (ORTE_ERR_NOT_FOUND != orte_util_nodemap_lookup(&bo, i, &name, &slots)) {
+            fprintf(stderr, "ERROR: found daemon past the end of the nodemap\n");
+        }
+        fprintf(stderr, "NODEMAP LOOKUP CHECKED\n");
+        free(bo.bytes);
+    }
+
+    /* the job takes itself out of the job data */
+    OBJ_RELEASE(daemons);
+    if (created) {
+        OBJ_RELEASE(orte_job_data);
+        orte_job_data = NULL;
+    }
+}
+
 int main(int argc, char **argv)
 {
     int rc;
-    char *regex, *save;
+    char *regex, *save, *name;
     char **nodes=NULL;
     int i;
 
@@ -39,6 +107,18 @@ int main(int argc, char **argv)
         }
         for (i=0; NULL != nodes[i]; i++) {
             fprintf(stderr, "%s\n", nodes[i]);
+            /* the single-node lookup must agree with the expansion */
+            if (ORTE_SUCCESS != (rc = orte_regex_extract_node_name(argv[1], i, &name))) {
+                ORTE_ERROR_LOG(rc);
+            } else {
+                if (0 != strcmp(name, nodes[i])) {
+                    fprintf(stderr, "ERROR: node %d is %s\n", i, name);
+                }
+                free(name);
+            }
+        }
+        if (ORTE_ERR_NOT_FOUND != orte_regex_extract_node_name(argv[1], i, &name)) {
+            fprintf(stderr, "ERROR: found node past the end\n");
         }
         opal_argv_free(nodes);
         orte_finalize();
@@ -55,6 +135,7 @@ int main(int argc, char **argv)
         }
         free(regex);
         regex = opal_argv_join(nodes, ',');
+        check_nodemap(nodes);
         opal_argv_free(nodes);
         if (0 == strcmp(regex, argv[1])) {
             fprintf(stderr, "EXACT MATCH\n");
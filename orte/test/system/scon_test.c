@@ -0,0 +1,147 @@
+#include "orte_config.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "opal/dss/dss.h"
+#include "opal/mca/pmix/pmix.h"
+
+#include "orte/util/proc_info.h"
+#include "orte/util/name_fns.h"
+#include "orte/runtime/orte_globals.h"
+#include "orte/mca/grpcomm/grpcomm.h"
+#include "orte/mca/rml/rml.h"
+#include "orte/mca/errmgr/errmgr.h"
+
+#include "orte/runtime/runtime.h"
+#include "orte/runtime/orte_wait.h"
+
+#include "scon/scon.h"
+
+#define MY_TAG 12345
+
+static volatile bool active;
+static int32_t value;
+static int32_t nrecvd;
+
+static void recv_cbfunc(int status, scon_handle_t scon,
+                        orte_process_name_t *peer,
+                        opal_buffer_t *buf,
+                        orte_rml_tag_t tag,
+                        void *cbdata)
+{
+    int32_t cnt = 1;
+
+    opal_dss.unpack(buf, &value, &cnt, OPAL_INT32);
+    opal_output(0, "%s scon %d recvd %d from %s",
+                ORTE_NAME_PRINT(ORTE_PROC_MY_NAME), (int)scon,
+                (int)value, ORTE_NAME_PRINT(peer));
+    active = false;
+}
+
+static void allgather_cbfunc(int status, scon_handle_t scon,
+                             opal_buffer_t *buf, void *cbdata)
+{
+    int32_t cnt = 1;
+    orte_vpid_t vpid;
+    opal_buffer_t *contrib;
+
+    nrecvd = 0;
+    while (OPAL_SUCCESS == opal_dss.unpack(buf, &vpid, &cnt, ORTE_VPID)) {
+        cnt = 1;
+        if (OPAL_SUCCESS != opal_dss.unpack(buf, &contrib, &cnt, OPAL_BUFFER)) {
+            break;
+        }
+        OBJ_RELEASE(contrib);
+        nrecvd++;
+        cnt = 1;
+    }
+    active = false;
+}
+
+int main(int argc, char *argv[])
+{
+    scon_handle_t all, evens;
+    orte_grpcomm_signature_t *sig;
+    orte_process_name_t peer;
+    opal_buffer_t *buf;
+    orte_vpid_t n, nprocs;
+    int32_t i;
+
+    if (ORTE_SUCCESS != orte_init(&argc, &argv, ORTE_PROC_NON_MPI)) {
+        fprintf(stderr, "orte_init failed\n");
+        exit(1);
+    }
+    scon_init();
+    nprocs = orte_process_info.num_procs;
+
+    /* an overlay spanning the entire job */
+    all = scon_create(NULL);
+
+    /* point-to-point around a ring */
+    active = true;
+    scon_recv_nb(all, ORTE_NAME_WILDCARD, MY_TAG, ORTE_RML_NON_PERSISTENT,
+                 recv_cbfunc, NULL);
+    peer.jobid = ORTE_PROC_MY_NAME->jobid;
+    peer.vpid = (ORTE_PROC_MY_NAME->vpid + 1) % nprocs;
+    buf = OBJ_NEW(opal_buffer_t);
+    i = ORTE_PROC_MY_NAME->vpid;
+    opal_dss.pack(buf, &i, 1, OPAL_INT32);
+    scon_send_nb(all, &peer, buf, MY_TAG, NULL, NULL);
+    ORTE_WAIT_FOR_COMPLETION(active);
+    OBJ_RELEASE(buf);
+
+    /* xcast from the last rank */
+    active = true;
+    scon_recv_nb(all, ORTE_NAME_WILDCARD, MY_TAG+1, ORTE_RML_NON_PERSISTENT,
+                 recv_cbfunc, NULL);
+    if (ORTE_PROC_MY_NAME->vpid == nprocs - 1) {
+        buf = OBJ_NEW(opal_buffer_t);
+        i = 1000;
+        opal_dss.pack(buf, &i, 1, OPAL_INT32);
+        scon_xcast(all, MY_TAG+1, buf);
+        OBJ_RELEASE(buf);
+    }
+    ORTE_WAIT_FOR_COMPLETION(active);
+    if (1000 != value) {
+        opal_output(0, "%s xcast FAILED", ORTE_NAME_PRINT(ORTE_PROC_MY_NAME));
+    }
+
+    /* allgather across the job */
+    active = true;
+    buf = OBJ_NEW(opal_buffer_t);
+    scon_allgather(all, buf, allgather_cbfunc, NULL);
+    OBJ_RELEASE(buf);
+    ORTE_WAIT_FOR_COMPLETION(active);
+    opal_output(0, "%s allgather collected %d of %d contributions",
+                ORTE_NAME_PRINT(ORTE_PROC_MY_NAME), (int)nrecvd, (int)nprocs);
+
+    /* an overlay spanning only the even ranks */
+    sig = OBJ_NEW(orte_grpcomm_signature_t);
+    sig->sz = (nprocs + 1) / 2;
+    sig->signature = (orte_process_name_t*)malloc(sig->sz * sizeof(orte_process_name_t));
+    for (n=0; n < sig->sz; n++) {
+        sig->signature[n].jobid = ORTE_PROC_MY_NAME->jobid;
+        sig->signature[n].vpid = 2 * n;
+    }
+    evens = scon_create(sig);
+    OBJ_RELEASE(sig);
+    if (0 == ORTE_PROC_MY_NAME->vpid % 2) {
+        active = true;
+        buf = OBJ_NEW(opal_buffer_t);
+        scon_allgather(evens, buf, allgather_cbfunc, NULL);
+        OBJ_RELEASE(buf);
+        ORTE_WAIT_FOR_COMPLETION(active);
+        opal_output(0, "%s evens allgather collected %d contributions",
+                    ORTE_NAME_PRINT(ORTE_PROC_MY_NAME), (int)nrecvd);
+    }
+
+    /* ensure all relays are done before anyone leaves */
+    opal_pmix.fence(NULL, 0);
+
+    scon_delete(evens);
+    scon_delete(all);
+    scon_finalize();
+    orte_finalize();
+    return 0;
+}
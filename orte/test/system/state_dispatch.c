@@ -0,0 +1,246 @@
+/* -*- C -*-
+ *
+ * $HEADER$
+ *
+ * Check that the state machine dispatches each job and proc state to
+ * the same callback, at the same priority, as the walk of the
+ * orte_job_states and orte_proc_states lists it used to do. Covers
+ * the states registered by the framework, states added, changed and
+ * removed after the lookup table was built, dynamic states past the
+ * table's initial size, and the fallbacks to the ERROR and ANY
+ * entries. Each state that maps to one of our callbacks is also
+ * activated, to see that callback run.
+ *
+ *   orterun -np 1 state_dispatch
+ */
+
+#include "orte_config.h"
+
+#include <stdio.h>
+#include <unistd.h>
+
+#include "opal/class/opal_list.h"
+
+#include "orte/util/name_fns.h"
+#include "orte/runtime/orte_globals.h"
+#include "orte/mca/state/state.h"
+#include "orte/mca/state/base/state_private.h"
+
+#include "orte/runtime/runtime.h"
+
+/* how far past the dynamic states to look */
+#define MAX_STATE   (ORTE_JOB_STATE_DYNAMIC + 300)
+
+static volatile orte_state_cbfunc_t fired = NULL;
+static int errors = 0;
+
+#define STATE_CB(n)                                             \
+    static void cb##n(int fd, short args, void *cbdata)         \
+    {                                                           \
+        orte_state_caddy_t *caddy = (orte_state_caddy_t*)cbdata; \
+        OBJ_RELEASE(caddy);                                     \
+        fired = cb##n;                                          \
+    }
+STATE_CB(0)
+STATE_CB(1)
+STATE_CB(2)
+STATE_CB(3)
+
+static bool is_ours(orte_state_cbfunc_t cbfunc)
+{
+    return (cb0 == cbfunc || cb1 == cbfunc || cb2 == cbfunc || cb3 == cbfunc);
+}
+
+/* the lookup activations did before the table */
+static orte_state_t* walk_job(orte_job_state_t state)
+{
+    orte_state_t *s, *any = NULL, *error = NULL;
+
+    OPAL_LIST_FOREACH(s, &orte_job_states, orte_state_t) {
+        if (ORTE_JOB_STATE_ANY == s->job_state) {
+            any = s;
+        }
+        if (ORTE_JOB_STATE_ERROR == s->job_state) {
+            error = s;
+        }
+        if (state == s->job_state) {
+            return s;
+        }
+    }
+    if (ORTE_JOB_STATE_ERROR < state && NULL != error) {
+        return error;
+    }
+    return any;
+}
+
+static orte_state_t* walk_proc(orte_proc_state_t state)
+{
+    orte_state_t *s, *any = NULL, *error = NULL;
+
+    OPAL_LIST_FOREACH(s, &orte_proc_states, orte_state_t) {
+        if (ORTE_PROC_STATE_ANY == s->proc_state) {
+            any = s;
+        }
+        if (ORTE_PROC_STATE_ERROR == s->proc_state) {
+            error = s;
+        }
+        if (state == s->proc_state) {
+            return s;
+        }
+    }
+    if (ORTE_PROC_STATE_ERROR < state && NULL != error) {
+        return error;
+    }
+    return any;
+}
+
+static bool same(orte_state_t *a, orte_state_t *b)
+{
+    if (NULL == a || NULL == b) {
+        return (a == b);
+    }
+    return (a->cbfunc == b->cbfunc && a->priority == b->priority);
+}
+
+/* the callbacks run in the progress thread */
+static bool wait_fired(orte_state_cbfunc_t cbfunc)
+{
+    int i;
+
+    for (i=0; i < 2000 && NULL == fired; i++) {
+        usleep(1000);
+    }
+    return (fired == cbfunc);
+}
+
+static void check_job(const char *phase, int state)
+{
+    orte_state_t *want = walk_job(state);
+    orte_state_t *got = orte_state_base_lookup_job_state(state);
+
+    if (!same(want, got)) {
+        fprintf(stderr, "%s: job state %s (%d): table gives %s pri %d, list gives %s pri %d\n",
+                phase, orte_job_state_to_str(state), state,
+                (NULL == got) ? "NONE" : "a callback", (NULL == got) ? -1 : got->priority,
+                (NULL == want) ? "NONE" : "a callback", (NULL == want) ? -1 : want->priority);
+        errors++;
+        return;
+    }
+    if (NULL != want && is_ours(want->cbfunc)) {
+        fired = NULL;
+        ORTE_ACTIVATE_JOB_STATE(NULL, state);
+        if (!wait_fired(want->cbfunc)) {
+            fprintf(stderr, "%s: job state %s (%d) ran the wrong callback\n",
+                    phase, orte_job_state_to_str(state), state);
+            errors++;
+        }
+    }
+}
+
+static void check_proc(const char *phase, int state)
+{
+    orte_state_t *want = walk_proc(state);
+    orte_state_t *got = orte_state_base_lookup_proc_state(state);
+
+    if (!same(want, got)) {
+        fprintf(stderr, "%s: proc state %s (%d): table gives %s pri %d, list gives %s pri %d\n",
+                phase, orte_proc_state_to_str(state), state,
+                (NULL == got) ? "NONE" : "a callback", (NULL == got) ? -1 : got->priority,
+                (NULL == want) ? "NONE" : "a callback", (NULL == want) ? -1 : want->priority);
+        errors++;
+        return;
+    }
+    if (NULL != want && is_ours(want->cbfunc)) {
+        fired = NULL;
+        ORTE_ACTIVATE_PROC_STATE(ORTE_PROC_MY_NAME, state);
+        if (!wait_fired(want->cbfunc)) {
+            fprintf(stderr, "%s: proc state %s (%d) ran the wrong callback\n",
+                    phase, orte_proc_state_to_str(state), state);
+            errors++;
+        }
+    }
+}
+
+static void check_all(const char *phase)
+{
+    int state;
+
+    for (state=0; state < MAX_STATE; state++) {
+        check_job(phase, state);
+        check_proc(phase, state);
+    }
+    check_job(phase, ORTE_JOB_STATE_ANY);
+    check_proc(phase, ORTE_PROC_STATE_ANY);
+    fprintf(stderr, "state_dispatch: %s checked, %d errors so far\n", phase, errors);
+}
+
+int main(int argc, char* argv[])
+{
+    int rc;
+
+    if (0 > (rc = orte_init(&argc, &argv, ORTE_PROC_NON_MPI))) {
+        fprintf(stderr, "state_dispatch: couldn't init orte - error code %d\n", rc);
+        return rc;
+    }
+
+    /* whatever the framework set up */
+    check_all("initial");
+
+    /* the table is built by now - add to it, including a state
+     * well past its initial size and the error handlers */
+    orte_state.add_job_state(ORTE_JOB_STATE_RUNNING, cb0, ORTE_SYS_PRI);
+    orte_state.add_job_state(ORTE_JOB_STATE_TERMINATED, cb1, ORTE_ERROR_PRI);
+    orte_state.add_job_state(ORTE_JOB_STATE_DYNAMIC + 3, cb2, ORTE_MSG_PRI);
+    orte_state.add_job_state(ORTE_JOB_STATE_DYNAMIC + 250, cb3, ORTE_INFO_PRI);
+    orte_state.add_job_state(ORTE_JOB_STATE_ERROR, cb3, ORTE_ERROR_PRI);
+    orte_state.add_proc_state(ORTE_PROC_STATE_RUNNING, cb0, ORTE_SYS_PRI);
+    orte_state.add_proc_state(ORTE_PROC_STATE_TERMINATED, cb1, ORTE_ERROR_PRI);
+    orte_state.add_proc_state(ORTE_PROC_STATE_DYNAMIC + 250, cb2, ORTE_MSG_PRI);
+    orte_state.add_proc_state(ORTE_PROC_STATE_ERROR, cb3, ORTE_ERROR_PRI);
+    /* a duplicate must not replace the original */
+    if (ORTE_SUCCESS == orte_state.add_job_state(ORTE_JOB_STATE_RUNNING, cb3, ORTE_MSG_PRI) ||
+        ORTE_SUCCESS == orte_state.add_proc_state(ORTE_PROC_STATE_RUNNING, cb3, ORTE_MSG_PRI)) {
+        fprintf(stderr, "state_dispatch: duplicate state accepted\n");
+        errors++;
+    }
+    check_all("added");
+
+    /* the wildcards - setting a callback installs a missing state */
+    orte_state.set_job_state_callback(ORTE_JOB_STATE_ANY, cb2);
+    orte_state.set_proc_state_callback(ORTE_PROC_STATE_ANY, cb1);
+    check_all("any added");
+
+    /* change existing entries, and install a new one by callback */
+    orte_state.set_job_state_callback(ORTE_JOB_STATE_RUNNING, cb1);
+    orte_state.set_job_state_priority(ORTE_JOB_STATE_DYNAMIC + 3, ORTE_SYS_PRI);
+    orte_state.set_job_state_priority(ORTE_JOB_STATE_ANY, ORTE_INFO_PRI);
+    orte_state.set_job_state_callback(ORTE_JOB_STATE_DYNAMIC + 7, cb0);
+    orte_state.set_proc_state_callback(ORTE_PROC_STATE_TERMINATED, cb2);
+    orte_state.set_proc_state_priority(ORTE_PROC_STATE_ANY, ORTE_INFO_PRI);
+    check_all("changed");
+
+    /* without the error handlers, errors fall through to ANY */
+    orte_state.remove_job_state(ORTE_JOB_STATE_ERROR);
+    orte_state.remove_proc_state(ORTE_PROC_STATE_ERROR);
+    check_all("error removed");
+
+    /* and without ANY, to nothing */
+    orte_state.remove_job_state(ORTE_JOB_STATE_ANY);
+    orte_state.remove_proc_state(ORTE_PROC_STATE_ANY);
+    check_all("any removed");
+
+    /* leave the framework's own states as we found them */
+    orte_state.remove_job_state(ORTE_JOB_STATE_RUNNING);
+    orte_state.remove_job_state(ORTE_JOB_STATE_TERMINATED);
+    orte_state.remove_job_state(ORTE_JOB_STATE_DYNAMIC + 3);
+    orte_state.remove_job_state(ORTE_JOB_STATE_DYNAMIC + 7);
+    orte_state.remove_job_state(ORTE_JOB_STATE_DYNAMIC + 250);
+    orte_state.remove_proc_state(ORTE_PROC_STATE_RUNNING);
+    orte_state.remove_proc_state(ORTE_PROC_STATE_TERMINATED);
+    orte_state.remove_proc_state(ORTE_PROC_STATE_DYNAMIC + 250);
+    check_all("restored");
+
+    fprintf(stderr, "state_dispatch: %s\n", (0 == errors) ? "OK" : "FAILED");
+    orte_finalize();
+    return (0 == errors) ? 0 : 1;
+}
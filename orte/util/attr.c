@@ -277,6 +277,14 @@ const char *orte_attr_key_to_str(orte_attribute_key_t key)
             return "ORTE-JOB-TAG-OUTPUT";
         case ORTE_JOB_TIMESTAMP_OUTPUT:
             return "ORTE-JOB-TIMESTAMP-OUTPUT";
+        case ORTE_JOB_PROF_START:
+            return "JOB-PROF-START";
+        case ORTE_JOB_PROF_ALLOC:
+            return "JOB-PROF-ALLOC";
+        case ORTE_JOB_PROF_VM:
+            return "JOB-PROF-VM";
+        case ORTE_JOB_PROF_MAP:
+            return "JOB-PROF-MAP";
 
         case ORTE_PROC_NOBARRIER:
             return "PROC-NOBARRIER";
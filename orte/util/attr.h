@@ -138,6 +138,10 @@ typedef uint16_t orte_job_flags_t;
 #define ORTE_JOB_MERGE_STDERR_STDOUT    (ORTE_JOB_START_KEY + 46)    // bool - merge stderr into stdout stream
 #define ORTE_JOB_TAG_OUTPUT             (ORTE_JOB_START_KEY + 47)    // bool - tag stdout/stderr
 #define ORTE_JOB_TIMESTAMP_OUTPUT       (ORTE_JOB_START_KEY + 48)    // bool - timestamp stdout/stderr
+#define ORTE_JOB_PROF_START             (ORTE_JOB_START_KEY + 49)    // timeval - launch profiling: job setup started
+#define ORTE_JOB_PROF_ALLOC             (ORTE_JOB_START_KEY + 50)    // timeval - launch profiling: allocation complete
+#define ORTE_JOB_PROF_VM                (ORTE_JOB_START_KEY + 51)    // timeval - launch profiling: VM ready
+#define ORTE_JOB_PROF_MAP               (ORTE_JOB_START_KEY + 52)    // timeval - launch profiling: mapping complete
 
 #define ORTE_JOB_MAX_KEY   300
 
@@ -52,12 +52,14 @@
 #include "opal/dss/dss.h"
 #include "opal/runtime/opal.h"
 #include "opal/class/opal_pointer_array.h"
+#include "opal/class/opal_hash_table.h"
 #include "opal/mca/pmix/pmix.h"
 #include "opal/mca/hwloc/base/base.h"
 #include "opal/util/net.h"
 #include "opal/util/output.h"
 #include "opal/util/argv.h"
 #include "opal/datatype/opal_datatype.h"
+#include "opal/mca/compress/compress.h"
 
 #include "orte/mca/dfs/dfs.h"
 #include "orte/mca/errmgr/errmgr.h"
@@ -186,14 +188,163 @@ int orte_util_build_daemon_nidmap(char **nodes)
 }
 #endif
 
+/* pack an array of values as runs of equal deltas between
+ * successive entries - a block of nodes with the same slot
+ * count, or of consecutive vpids, collapses into one run */
+static int pack_runs(opal_buffer_t *buf, int32_t *vals, int32_t n)
+{
+    int32_t i, nruns, *runs, prev, delta;
+    int rc;
+
+    runs = (int32_t*)malloc(2 * n * sizeof(int32_t));
+    if (NULL == runs && 0 < n) {
+        return ORTE_ERR_OUT_OF_RESOURCE;
+    }
+    nruns = 0;
+    prev = 0;
+    for (i=0; i < n; i++) {
+        delta = vals[i] - prev;
+        prev = vals[i];
+        if (0 < nruns && runs[2*(nruns-1)] == delta) {
+            runs[2*(nruns-1)+1]++;
+            continue;
+        }
+        runs[2*nruns] = delta;
+        runs[2*nruns+1] = 1;
+        nruns++;
+    }
+    if (ORTE_SUCCESS == (rc = opal_dss.pack(buf, &nruns, 1, OPAL_INT32)) && 0 < nruns) {
+        rc = opal_dss.pack(buf, runs, 2*nruns, OPAL_INT32);
+    }
+    if (NULL != runs) {
+        free(runs);
+    }
+    return rc;
+}
+
+/* unpack a set of runs describing n values - if vals is NULL,
+ * then just return the value at the given index */
+static int unpack_runs(opal_buffer_t *buf, int32_t *vals, int32_t n,
+                       int32_t index, int32_t *val)
+{
+    int32_t i, j, k, nruns, *runs, prev;
+    int rc, cnt;
+
+    cnt = 1;
+    if (ORTE_SUCCESS != (rc = opal_dss.unpack(buf, &nruns, &cnt, OPAL_INT32))) {
+        return rc;
+    }
+    /* every run holds at least one value */
+    if (nruns <= 0 || n < nruns) {
+        return (0 == nruns && 0 == n && NULL != vals) ? ORTE_SUCCESS : ORTE_ERR_UNPACK_FAILURE;
+    }
+    if (NULL == (runs = (int32_t*)malloc(2 * nruns * sizeof(int32_t)))) {
+        return ORTE_ERR_OUT_OF_RESOURCE;
+    }
+    cnt = 2 * nruns;
+    if (ORTE_SUCCESS != (rc = opal_dss.unpack(buf, runs, &cnt, OPAL_INT32))) {
+        free(runs);
+        return rc;
+    }
+    prev = 0;
+    for (i=0, k=0; i < nruns; i++) {
+        if (runs[2*i+1] <= 0 || n - k < runs[2*i+1]) {
+            break;
+        }
+        if (NULL == vals) {
+            if (k <= index && index < k + runs[2*i+1]) {
+                *val = prev + (index - k + 1) * runs[2*i];
+            }
+            prev += runs[2*i+1] * runs[2*i];
+            k += runs[2*i+1];
+            continue;
+        }
+        for (j=0; j < runs[2*i+1]; j++, k++) {
+            prev += runs[2*i];
+            vals[k] = prev;
+        }
+    }
+    free(runs);
+    /* the runs must describe exactly the values we expect */
+    if (i < nruns || k != n) {
+        return ORTE_ERR_UNPACK_FAILURE;
+    }
+    if (NULL == vals && (index < 0 || n <= index)) {
+        return ORTE_ERR_NOT_FOUND;
+    }
+    return ORTE_SUCCESS;
+}
+
+/* find the position of the given value in a set of runs,
+ * along with the number of values the runs describe */
+static int find_in_runs(opal_buffer_t *buf, int32_t val, int32_t *index, int32_t *n)
+{
+    int32_t i, k, nruns, *runs;
+    int64_t prev, step;
+    int rc, cnt;
+
+    cnt = 1;
+    if (ORTE_SUCCESS != (rc = opal_dss.unpack(buf, &nruns, &cnt, OPAL_INT32))) {
+        return rc;
+    }
+    if (nruns <= 0) {
+        return (0 == nruns) ? ORTE_ERR_NOT_FOUND : ORTE_ERR_UNPACK_FAILURE;
+    }
+    if (NULL == (runs = (int32_t*)malloc(2 * nruns * sizeof(int32_t)))) {
+        return ORTE_ERR_OUT_OF_RESOURCE;
+    }
+    cnt = 2 * nruns;
+    if (ORTE_SUCCESS != (rc = opal_dss.unpack(buf, runs, &cnt, OPAL_INT32))) {
+        free(runs);
+        return rc;
+    }
+    *index = -1;
+    prev = 0;
+    for (i=0, k=0; i < nruns; i++) {
+        if (runs[2*i+1] <= 0 || INT32_MAX - k < runs[2*i+1]) {
+            free(runs);
+            return ORTE_ERR_UNPACK_FAILURE;
+        }
+        /* a run holds prev + step*d for d = 1..count */
+        if (0 <= *index) {
+            /* found - just counting the values now */
+        } else if (0 == runs[2*i]) {
+            if (val == prev) {
+                *index = k;
+            }
+        } else if (0 == (val - prev) % runs[2*i]) {
+            step = (val - prev) / runs[2*i];
+            if (0 < step && step <= runs[2*i+1]) {
+                *index = k + step - 1;
+            }
+        }
+        prev += (int64_t)runs[2*i] * runs[2*i+1];
+        k += runs[2*i+1];
+    }
+    free(runs);
+    *n = k;
+    return (0 <= *index) ? ORTE_SUCCESS : ORTE_ERR_NOT_FOUND;
+}
+
 int orte_util_encode_nodemap(opal_byte_object_t *boptr, bool update)
 {
     orte_node_t *node;
-    int32_t i;
+    int32_t i, k, n, nattr, *vals;
     int rc;
     opal_buffer_t buf;
     orte_job_t *daemons;
     orte_proc_t *dmn;
+    int8_t flag;
+    int32_t hdr;
+    size_t inlen, cmplen;
+    uint8_t *cmpdata;
+    opal_byte_object_t cbo, *cboptr;
+    char **names = NULL, **expanded = NULL, *list, *regex = NULL;
+    orte_proc_t **dmns = NULL, *dptr;
+    opal_hash_table_t byname;
+    bool unique;
+    orte_std_cntr_t count;
+    orte_attribute_t *kv;
 
     /* if the daemon job has not been updated, then there is
      * nothing to send
@@ -205,15 +356,11 @@ int orte_util_encode_nodemap(opal_byte_object_t *boptr, bool update)
         return ORTE_SUCCESS;
     }
 
-    /* setup a buffer for tmp use */
-    OBJ_CONSTRUCT(&buf, opal_buffer_t);
-
-    /* send the number of nodes */
-    if (ORTE_SUCCESS != (rc = opal_dss.pack(&buf, &daemons->num_procs, 1, ORTE_VPID))) {
-        ORTE_ERROR_LOG(rc);
-        return rc;
-    }
-
+    /* collect the names of the nodes hosting daemons */
+    OBJ_CONSTRUCT(&byname, opal_hash_table_t);
+    opal_hash_table_init(&byname, 1024);
+    n = 0;
+    unique = true;
     for (i=0; i < daemons->procs->size; i++) {
         if (NULL == (dmn = (orte_proc_t*)opal_pointer_array_get_item(daemons->procs, i))) {
             continue;
@@ -221,17 +368,210 @@ int orte_util_encode_nodemap(opal_byte_object_t *boptr, bool update)
         /* if the daemon doesn't have a node, that's an error */
         if (NULL == (node = dmn->node)) {
             ORTE_ERROR_LOG(ORTE_ERR_NOT_FOUND);
+            opal_argv_free(names);
+            OBJ_DESTRUCT(&byname);
             return ORTE_ERR_NOT_FOUND;
         }
-        if (ORTE_SUCCESS != (rc = opal_dss.pack(&buf, &dmn->name.vpid, 1, ORTE_VPID))) {
+        opal_argv_append_nosize(&names, node->name);
+        if (OPAL_SUCCESS == opal_hash_table_get_value_ptr(&byname, node->name,
+                                                          strlen(node->name), (void**)&dptr)) {
+            unique = false;
+        }
+        opal_hash_table_set_value_ptr(&byname, node->name, strlen(node->name), dmn);
+        n++;
+    }
+
+    /* describe the names with a regex. This may reorder the
+     * nodes, so take them in the order the regex produces - and
+     * if it cannot faithfully reproduce the list, just send the
+     * list itself */
+    if (0 < n) {
+        list = opal_argv_join(names, ',');
+        if (unique && ORTE_SUCCESS == orte_regex_create(list, &regex) &&
+            ORTE_SUCCESS == orte_regex_extract_node_names(regex, &expanded) &&
+            n == opal_argv_count(expanded) &&
+            NULL != (dmns = (orte_proc_t**)malloc(n * sizeof(orte_proc_t*)))) {
+            for (i=0; i < n; i++) {
+                if (OPAL_SUCCESS != opal_hash_table_get_value_ptr(&byname, expanded[i],
+                                                                  strlen(expanded[i]), (void**)&dmns[i])) {
+                    break;
+                }
+            }
+            if (i < n) {
+                free(dmns);
+                dmns = NULL;
+            }
+        }
+        free(list);
+        if (NULL == dmns) {
+            if (NULL != regex) {
+                free(regex);
+            }
+            regex = opal_argv_join(names, ',');
+            dmns = (orte_proc_t**)malloc(n * sizeof(orte_proc_t*));
+            for (i=0, k=0; NULL != dmns && i < daemons->procs->size; i++) {
+                if (NULL != (dmn = (orte_proc_t*)opal_pointer_array_get_item(daemons->procs, i))) {
+                    dmns[k++] = dmn;
+                }
+            }
+        }
+    }
+    opal_argv_free(names);
+    opal_argv_free(expanded);
+    OBJ_DESTRUCT(&byname);
+    if (0 < n && NULL == dmns) {
+        ORTE_ERROR_LOG(ORTE_ERR_OUT_OF_RESOURCE);
+        if (NULL != regex) {
+            free(regex);
+        }
+        return ORTE_ERR_OUT_OF_RESOURCE;
+    }
+
+    OPAL_OUTPUT_VERBOSE((5, orte_debug_output,
+                         "%s encode:nodemap %d nodes as %s",
+                         ORTE_NAME_PRINT(ORTE_PROC_MY_NAME), n,
+                         (NULL == regex) ? "NULL" : regex));
+
+    /* setup a buffer for tmp use */
+    OBJ_CONSTRUCT(&buf, opal_buffer_t);
+
+    /* flag that the map is not compressed */
+    flag = 0;
+    if (ORTE_SUCCESS != (rc = opal_dss.pack(&buf, &flag, 1, OPAL_INT8))) {
+        ORTE_ERROR_LOG(rc);
+        goto cleanup;
+    }
+    hdr = buf.bytes_used;
+
+    /* send the number of daemons */
+    if (ORTE_SUCCESS != (rc = opal_dss.pack(&buf, &daemons->num_procs, 1, ORTE_VPID))) {
+        ORTE_ERROR_LOG(rc);
+        goto cleanup;
+    }
+
+    /* the node names */
+    if (ORTE_SUCCESS != (rc = opal_dss.pack(&buf, &regex, 1, OPAL_STRING))) {
+        ORTE_ERROR_LOG(rc);
+        goto cleanup;
+    }
+
+    /* the per-node values, each collapsed into runs - the
+     * daemon vpids first as the lookup needs those */
+    if (NULL == (vals = (int32_t*)malloc((n + 1) * sizeof(int32_t)))) {
+        rc = ORTE_ERR_OUT_OF_RESOURCE;
+        ORTE_ERROR_LOG(rc);
+        goto cleanup;
+    }
+    for (i=0; i < n; i++) {
+        vals[i] = dmns[i]->name.vpid;
+    }
+    if (ORTE_SUCCESS != (rc = pack_runs(&buf, vals, n))) {
+        ORTE_ERROR_LOG(rc);
+        free(vals);
+        goto cleanup;
+    }
+    for (i=0; i < n; i++) {
+        vals[i] = dmns[i]->node->slots;
+    }
+    if (ORTE_SUCCESS != (rc = pack_runs(&buf, vals, n))) {
+        ORTE_ERROR_LOG(rc);
+        free(vals);
+        goto cleanup;
+    }
+    for (i=0; i < n; i++) {
+        vals[i] = dmns[i]->node->num_procs;
+    }
+    if (ORTE_SUCCESS != (rc = pack_runs(&buf, vals, n))) {
+        ORTE_ERROR_LOG(rc);
+        free(vals);
+        goto cleanup;
+    }
+    for (i=0; i < n; i++) {
+        vals[i] = dmns[i]->node->state;
+    }
+    if (ORTE_SUCCESS != (rc = pack_runs(&buf, vals, n))) {
+        ORTE_ERROR_LOG(rc);
+        free(vals);
+        goto cleanup;
+    }
+    nattr = 0;
+    for (i=0; i < n; i++) {
+        vals[i] = ORTE_FLAG_TEST(dmns[i]->node, ORTE_NODE_FLAG_OVERSUBSCRIBED) ? 1 : 0;
+        OPAL_LIST_FOREACH(kv, &dmns[i]->node->attributes, orte_attribute_t) {
+            if (ORTE_ATTR_GLOBAL == kv->local) {
+                ++nattr;
+                break;
+            }
+        }
+    }
+    if (ORTE_SUCCESS != (rc = pack_runs(&buf, vals, n))) {
+        ORTE_ERROR_LOG(rc);
+        free(vals);
+        goto cleanup;
+    }
+    free(vals);
+
+    /* finally, the shared attributes of the few nodes that have any */
+    if (ORTE_SUCCESS != (rc = opal_dss.pack(&buf, &nattr, 1, OPAL_INT32))) {
+        ORTE_ERROR_LOG(rc);
+        goto cleanup;
+    }
+    for (i=0; i < n && 0 < nattr; i++) {
+        count = 0;
+        OPAL_LIST_FOREACH(kv, &dmns[i]->node->attributes, orte_attribute_t) {
+            if (ORTE_ATTR_GLOBAL == kv->local) {
+                ++count;
+            }
+        }
+        if (0 == count) {
+            continue;
+        }
+        if (ORTE_SUCCESS != (rc = opal_dss.pack(&buf, &i, 1, OPAL_INT32)) ||
+            ORTE_SUCCESS != (rc = opal_dss.pack(&buf, &count, 1, ORTE_STD_CNTR))) {
             ORTE_ERROR_LOG(rc);
-            return rc;
+            goto cleanup;
+        }
+        OPAL_LIST_FOREACH(kv, &dmns[i]->node->attributes, orte_attribute_t) {
+            if (ORTE_ATTR_GLOBAL != kv->local) {
+                continue;
+            }
+            if (ORTE_SUCCESS != (rc = opal_dss.pack(&buf, &kv, 1, ORTE_ATTRIBUTE))) {
+                ORTE_ERROR_LOG(rc);
+                goto cleanup;
+            }
         }
-        /* pack the node */
-        if (ORTE_SUCCESS != (rc = opal_dss.pack(&buf, &node, 1, ORTE_NODE))) {
+        --nattr;
+    }
+    if (NULL != dmns) {
+        free(dmns);
+        dmns = NULL;
+    }
+    if (NULL != regex) {
+        free(regex);
+        regex = NULL;
+    }
+
+    /* the map can get large for large systems, but is also highly
+     * repetitive - so compress it if we can */
+    inlen = buf.bytes_used - hdr;
+    cboptr = &cbo;
+    if (orte_compress_nodemap &&
+        opal_compress.compress_block((uint8_t*)buf.base_ptr + hdr, inlen,
+                                     &cmpdata, &cmplen)) {
+        cbo.bytes = cmpdata;
+        cbo.size = cmplen;
+        OBJ_DESTRUCT(&buf);
+        OBJ_CONSTRUCT(&buf, opal_buffer_t);
+        flag = 1;
+        if (ORTE_SUCCESS != (rc = opal_dss.pack(&buf, &flag, 1, OPAL_INT8)) ||
+            ORTE_SUCCESS != (rc = opal_dss.pack(&buf, &inlen, 1, OPAL_SIZE)) ||
+            ORTE_SUCCESS != (rc = opal_dss.pack(&buf, &cboptr, 1, OPAL_BYTE_OBJECT))) {
             ORTE_ERROR_LOG(rc);
+            free(cmpdata);
+            OBJ_DESTRUCT(&buf);
             return rc;
         }
+        free(cmpdata);
     }
 
     /* transfer the payload to the byte object */
@@ -239,19 +579,77 @@ int orte_util_encode_nodemap(opal_byte_object_t *boptr, bool update)
     OBJ_DESTRUCT(&buf);
 
     return ORTE_SUCCESS;
+
+  cleanup:
+    OBJ_DESTRUCT(&buf);
+    if (NULL != dmns) {
+        free(dmns);
+    }
+    if (NULL != regex) {
+        free(regex);
+    }
+    return rc;
+}
+
+/* load an encoded nodemap into a buffer, expanding it if
+ * it was compressed - the buffer takes the bytes */
+static int load_nodemap(opal_byte_object_t *bo, opal_buffer_t *buf)
+{
+    int n, rc;
+    int8_t flag;
+    size_t inlen;
+    opal_byte_object_t *cbo;
+    uint8_t *data;
+
+    opal_dss.load(buf, bo->bytes, bo->size);
+
+    /* see if the map was compressed */
+    n=1;
+    if (ORTE_SUCCESS != (rc = opal_dss.unpack(buf, &flag, &n, OPAL_INT8))) {
+        ORTE_ERROR_LOG(rc);
+        return rc;
+    }
+    if (1 == flag) {
+        n=1;
+        if (ORTE_SUCCESS != (rc = opal_dss.unpack(buf, &inlen, &n, OPAL_SIZE))) {
+            ORTE_ERROR_LOG(rc);
+            return rc;
+        }
+        n=1;
+        if (ORTE_SUCCESS != (rc = opal_dss.unpack(buf, &cbo, &n, OPAL_BYTE_OBJECT))) {
+            ORTE_ERROR_LOG(rc);
+            return rc;
+        }
+        if (!opal_compress.decompress_block(&data, inlen, cbo->bytes, cbo->size)) {
+            ORTE_ERROR_LOG(ORTE_ERR_UNPACK_FAILURE);
+            free(cbo->bytes);
+            free(cbo);
+            return ORTE_ERR_UNPACK_FAILURE;
+        }
+        free(cbo->bytes);
+        free(cbo);
+        /* continue with the decompressed map */
+        OBJ_DESTRUCT(buf);
+        OBJ_CONSTRUCT(buf, opal_buffer_t);
+        opal_dss.load(buf, data, inlen);
+    }
+    return ORTE_SUCCESS;
 }
 
 /* decode a nodemap for a daemon */
 int orte_util_decode_daemon_nodemap(opal_byte_object_t *bo)
 {
     int n;
-    orte_vpid_t vpid;
-    orte_node_t *node, *nptr;
+    int32_t i, nnodes = 0, nattr, idx, *vpids = NULL, *vals = NULL;
+    orte_node_t *node, *nptr, **nodes = NULL;
     opal_buffer_t buf;
     int rc=ORTE_SUCCESS;
     orte_job_t *daemons;
     orte_proc_t *dptr;
     orte_vpid_t num_daemons;
+    char *regex = NULL, **names = NULL;
+    orte_std_cntr_t count, k;
+    orte_attribute_t *kv;
 
     if (NULL == bo->bytes || 0 == bo->size) {
         /* nothing to unpack */
@@ -260,35 +658,126 @@ int orte_util_decode_daemon_nodemap(opal_byte_object_t *bo)
 
     /* xfer the byte object to a buffer for unpacking */
     OBJ_CONSTRUCT(&buf, opal_buffer_t);
-    opal_dss.load(&buf, bo->bytes, bo->size);
+    if (ORTE_SUCCESS != (rc = load_nodemap(bo, &buf))) {
+        OBJ_DESTRUCT(&buf);
+        return rc;
+    }
 
     /* unpack the number of procs */
     n=1;
     if (ORTE_SUCCESS != (rc = opal_dss.unpack(&buf, &num_daemons, &n, ORTE_VPID))) {
         ORTE_ERROR_LOG(rc);
+        OBJ_DESTRUCT(&buf);
         return rc;
     }
 
-    /* transfer the data to the nodes */
-    daemons = orte_get_job_data_object(ORTE_PROC_MY_NAME->jobid);
-    daemons->num_procs = num_daemons;
+    /* unpack and expand the node names */
     n=1;
-    while (OPAL_SUCCESS == (rc = opal_dss.unpack(&buf, &vpid, &n, ORTE_VPID))) {
-        /* unpack and store the node */
+    if (ORTE_SUCCESS != (rc = opal_dss.unpack(&buf, &regex, &n, OPAL_STRING))) {
+        ORTE_ERROR_LOG(rc);
+        OBJ_DESTRUCT(&buf);
+        return rc;
+    }
+    if (ORTE_SUCCESS != (rc = orte_regex_extract_node_names(regex, &names))) {
+        ORTE_ERROR_LOG(rc);
+        goto cleanup;
+    }
+    nnodes = opal_argv_count(names);
+
+    /* build the nodes */
+    nodes = (orte_node_t**)calloc(nnodes + 1, sizeof(orte_node_t*));
+    vpids = (int32_t*)malloc((nnodes + 1) * sizeof(int32_t));
+    vals = (int32_t*)malloc((nnodes + 1) * sizeof(int32_t));
+    if (NULL == nodes || NULL == vpids || NULL == vals) {
+        rc = ORTE_ERR_OUT_OF_RESOURCE;
+        ORTE_ERROR_LOG(rc);
+        goto cleanup;
+    }
+    for (i=0; i < nnodes; i++) {
+        nodes[i] = OBJ_NEW(orte_node_t);
+        nodes[i]->name = strdup(names[i]);
+    }
+    if (ORTE_SUCCESS != (rc = unpack_runs(&buf, vpids, nnodes, -1, NULL))) {
+        ORTE_ERROR_LOG(rc);
+        goto cleanup;
+    }
+    if (ORTE_SUCCESS != (rc = unpack_runs(&buf, vals, nnodes, -1, NULL))) {
+        ORTE_ERROR_LOG(rc);
+        goto cleanup;
+    }
+    for (i=0; i < nnodes; i++) {
+        nodes[i]->slots = vals[i];
+    }
+    if (ORTE_SUCCESS != (rc = unpack_runs(&buf, vals, nnodes, -1, NULL))) {
+        ORTE_ERROR_LOG(rc);
+        goto cleanup;
+    }
+    for (i=0; i < nnodes; i++) {
+        nodes[i]->num_procs = vals[i];
+    }
+    if (ORTE_SUCCESS != (rc = unpack_runs(&buf, vals, nnodes, -1, NULL))) {
+        ORTE_ERROR_LOG(rc);
+        goto cleanup;
+    }
+    for (i=0; i < nnodes; i++) {
+        nodes[i]->state = vals[i];
+    }
+    if (ORTE_SUCCESS != (rc = unpack_runs(&buf, vals, nnodes, -1, NULL))) {
+        ORTE_ERROR_LOG(rc);
+        goto cleanup;
+    }
+    for (i=0; i < nnodes; i++) {
+        if (vals[i]) {
+            ORTE_FLAG_SET(nodes[i], ORTE_NODE_FLAG_OVERSUBSCRIBED);
+        }
+    }
+    n=1;
+    if (ORTE_SUCCESS != (rc = opal_dss.unpack(&buf, &nattr, &n, OPAL_INT32))) {
+        ORTE_ERROR_LOG(rc);
+        goto cleanup;
+    }
+    for (i=0; i < nattr; i++) {
         n=1;
-        if (ORTE_SUCCESS != (rc = opal_dss.unpack(&buf, &node, &n, ORTE_NODE))) {
+        if (ORTE_SUCCESS != (rc = opal_dss.unpack(&buf, &idx, &n, OPAL_INT32))) {
             ORTE_ERROR_LOG(rc);
-            return rc;
+            goto cleanup;
+        }
+        n=1;
+        if (ORTE_SUCCESS != (rc = opal_dss.unpack(&buf, &count, &n, ORTE_STD_CNTR))) {
+            ORTE_ERROR_LOG(rc);
+            goto cleanup;
+        }
+        if (idx < 0 || nnodes <= idx) {
+            rc = ORTE_ERR_UNPACK_FAILURE;
+            ORTE_ERROR_LOG(rc);
+            goto cleanup;
         }
+        for (k=0; k < count; k++) {
+            n=1;
+            if (ORTE_SUCCESS != (rc = opal_dss.unpack(&buf, &kv, &n, ORTE_ATTRIBUTE))) {
+                ORTE_ERROR_LOG(rc);
+                goto cleanup;
+            }
+            kv->local = ORTE_ATTR_GLOBAL;  // obviously not a local value
+            opal_list_append(&nodes[idx]->attributes, &kv->super);
+        }
+    }
+
+    /* transfer the data to the nodes */
+    daemons = orte_get_job_data_object(ORTE_PROC_MY_NAME->jobid);
+    daemons->num_procs = num_daemons;
+    for (i=0; i < nnodes; i++) {
+        node = nodes[i];
+        nodes[i] = NULL;
         /* do we already have this node? */
-        nptr = (orte_node_t*)opal_pointer_array_get_item(orte_node_pool, vpid);
+        nptr = (orte_node_t*)opal_pointer_array_get_item(orte_node_pool, vpids[i]);
         /* set the new node object into the array */
-        opal_pointer_array_set_item(orte_node_pool, vpid, node);
-        if (NULL == (dptr = (orte_proc_t*)opal_pointer_array_get_item(daemons->procs, vpid))) {
+        opal_pointer_array_set_item(orte_node_pool, vpids[i], node);
+        if (NULL == (dptr = (orte_proc_t*)opal_pointer_array_get_item(daemons->procs, vpids[i]))) {
             dptr = OBJ_NEW(orte_proc_t);
             dptr->name.jobid = ORTE_PROC_MY_NAME->jobid;
-            dptr->name.vpid = vpid;
-            opal_pointer_array_set_item(daemons->procs, vpid, dptr);
+            dptr->name.vpid = vpids[i];
+            opal_pointer_array_set_item(daemons->procs, vpids[i], dptr);
         }
         if (NULL != node->daemon) {
             OBJ_RELEASE(node->daemon);
@@ -304,11 +793,6 @@ int orte_util_decode_daemon_nodemap(opal_byte_object_t *bo)
         }
         dptr->node = node;
     }
-    if (ORTE_ERR_UNPACK_READ_PAST_END_OF_BUFFER != rc) {
-        ORTE_ERROR_LOG(rc);
-        OBJ_DESTRUCT(&buf);
-        return rc;
-    }
     rc = ORTE_SUCCESS;
 
     orte_process_info.num_procs = daemons->num_procs;
@@ -321,7 +805,6 @@ int orte_util_decode_daemon_nodemap(opal_byte_object_t *bo)
     orte_process_info.num_daemons = daemons->num_procs;
 
     if (0 < opal_output_get_verbosity(orte_debug_verbosity)) {
-        int i;
         for (i=0; i < orte_node_pool->size; i++) {
             if (NULL == (node = (orte_node_t*)opal_pointer_array_get_item(orte_node_pool, i))) {
                 continue;
@@ -333,6 +816,91 @@ int orte_util_decode_daemon_nodemap(opal_byte_object_t *bo)
         }
     }
 
+  cleanup:
+    if (NULL != nodes) {
+        for (i=0; i < nnodes; i++) {
+            if (NULL != nodes[i]) {
+                OBJ_RELEASE(nodes[i]);
+            }
+        }
+        free(nodes);
+    }
+    if (NULL != vpids) {
+        free(vpids);
+    }
+    if (NULL != vals) {
+        free(vals);
+    }
+    if (NULL != regex) {
+        free(regex);
+    }
+    opal_argv_free(names);
+    OBJ_DESTRUCT(&buf);
+    return rc;
+}
+
+/* find the node hosting the given daemon in an encoded nodemap
+ * without decoding the rest of the map */
+int orte_util_nodemap_lookup(opal_byte_object_t *bo, orte_vpid_t vpid,
+                             char **nodename, int32_t *slots)
+{
+    opal_buffer_t buf;
+    opal_byte_object_t copy;
+    orte_vpid_t num_daemons;
+    int32_t idx = -1, nnodes = 0, target = vpid;
+    char *regex = NULL;
+    int n, rc;
+
+    *nodename = NULL;
+    if (NULL == bo->bytes || 0 == bo->size) {
+        return ORTE_ERR_NOT_FOUND;
+    }
+
+    /* leave the caller's copy alone */
+    copy.size = bo->size;
+    if (NULL == (copy.bytes = (uint8_t*)malloc(bo->size))) {
+        return ORTE_ERR_OUT_OF_RESOURCE;
+    }
+    memcpy(copy.bytes, bo->bytes, bo->size);
+    OBJ_CONSTRUCT(&buf, opal_buffer_t);
+    if (ORTE_SUCCESS != (rc = load_nodemap(&copy, &buf))) {
+        OBJ_DESTRUCT(&buf);
+        return rc;
+    }
+
+    n=1;
+    if (ORTE_SUCCESS != (rc = opal_dss.unpack(&buf, &num_daemons, &n, ORTE_VPID))) {
+        ORTE_ERROR_LOG(rc);
+        goto cleanup;
+    }
+    n=1;
+    if (ORTE_SUCCESS != (rc = opal_dss.unpack(&buf, &regex, &n, OPAL_STRING))) {
+        ORTE_ERROR_LOG(rc);
+        goto cleanup;
+    }
+
+    /* find the position of the daemon by walking the vpid runs,
+     * which also tell us how many nodes the map holds */
+    if (ORTE_SUCCESS != (rc = find_in_runs(&buf, target, &idx, &nnodes))) {
+        if (ORTE_ERR_NOT_FOUND != rc) {
+            ORTE_ERROR_LOG(rc);
+        }
+        goto cleanup;
+    }
+
+    /* the slots are next */
+    if (NULL != slots &&
+        ORTE_SUCCESS != (rc = unpack_runs(&buf, NULL, nnodes, idx, slots))) {
+        ORTE_ERROR_LOG(rc);
+        goto cleanup;
+    }
+
+    rc = orte_regex_extract_node_name(regex, idx, nodename);
+
+  cleanup:
+    if (NULL != regex) {
+        free(regex);
+    }
     OBJ_DESTRUCT(&buf);
     return rc;
 }
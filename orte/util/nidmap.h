@@ -44,6 +44,11 @@ BEGIN_C_DECLS
 ORTE_DECLSPEC int orte_util_encode_nodemap(opal_byte_object_t *boptr, bool update);
 ORTE_DECLSPEC int orte_util_decode_daemon_nodemap(opal_byte_object_t *bo);
 
+/* find the name and slot count of the node hosting the given
+ * daemon in an encoded nodemap, without decoding the whole map */
+ORTE_DECLSPEC int orte_util_nodemap_lookup(opal_byte_object_t *bo, orte_vpid_t vpid,
+                                           char **nodename, int32_t *slots);
+
 #if ORTE_ENABLE_STATIC_PORTS
 ORTE_DECLSPEC int orte_util_build_daemon_nidmap(char **nodes);
 #endif
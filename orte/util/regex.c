@@ -427,6 +427,98 @@ int orte_regex_extract_node_names(char *regexp, char ***names)
     return ret;
 }
 
+/*
+ * Find the node at the given position of the list a regex
+ * describes, without expanding the rest of the list
+ */
+int orte_regex_extract_node_name(char *regexp, int index, char **name)
+{
+    char *orig, *base, *tok, *end, *digits, *ranges, *suffix, *rng, *dash;
+    int num_digits, start, stop, ret = ORTE_ERR_NOT_FOUND;
+
+    *name = NULL;
+    if (NULL == regexp || index < 0) {
+        return ORTE_ERR_BAD_PARAM;
+    }
+
+    orig = base = strdup(regexp);
+    if (NULL == base) {
+        ORTE_ERROR_LOG(ORTE_ERR_OUT_OF_RESOURCE);
+        return ORTE_ERR_OUT_OF_RESOURCE;
+    }
+
+    while (NULL != base && '\0' != *base) {
+        tok = base;
+        /* find the end of this entry - commas inside
+         * a range don't count */
+        end = tok;
+        while ('\0' != *end && ',' != *end && '[' != *end) {
+            end++;
+        }
+        if ('[' != *end) {
+            /* a solitary node */
+            base = ('\0' == *end) ? NULL : end + 1;
+            *end = '\0';
+            if (0 == index) {
+                *name = strdup(tok);
+                ret = ORTE_SUCCESS;
+                break;
+            }
+            index--;
+            continue;
+        }
+        /* terminate the prefix and get the number of digits */
+        *end = '\0';
+        digits = end + 1;
+        if (NULL == (ranges = strchr(digits, ':'))) {
+            ret = ORTE_ERR_BAD_PARAM;
+            break;
+        }
+        *ranges++ = '\0';
+        num_digits = strtol(digits, NULL, 10);
+        if (NULL == (suffix = strchr(ranges, ']'))) {
+            ret = ORTE_ERR_BAD_PARAM;
+            break;
+        }
+        *suffix++ = '\0';
+        /* the suffix runs to the next comma */
+        if (NULL != (end = strchr(suffix, ','))) {
+            *end = '\0';
+            base = end + 1;
+        } else {
+            base = NULL;
+        }
+        /* walk the ranges until we reach the index */
+        rng = ranges;
+        while (NULL != rng) {
+            if (NULL != (end = strchr(rng, ','))) {
+                *end++ = '\0';
+            }
+            start = strtol(rng, NULL, 10);
+            if (NULL != (dash = strchr(rng, '-'))) {
+                stop = strtol(dash + 1, NULL, 10);
+            } else {
+                stop = start;
+            }
+            if (index <= stop - start) {
+                if (0 > asprintf(name, "%s%0*d%s", tok, num_digits, start + index, suffix)) {
+                    *name = NULL;
+                    ret = ORTE_ERR_OUT_OF_RESOURCE;
+                } else {
+                    ret = ORTE_SUCCESS;
+                }
+                goto done;
+            }
+            index -= stop - start + 1;
+            rng = end;
+        }
+    }
+
+  done:
+    free(orig);
+    return ret;
+}
+
 
 /*
  * Parse one or more ranges in a set
@@ -57,6 +57,8 @@ ORTE_DECLSPEC int orte_regex_create(char *nodes, char **regexp);
 
 ORTE_DECLSPEC int orte_regex_extract_node_names(char *regexp, char ***names);
 
+ORTE_DECLSPEC int orte_regex_extract_node_name(char *regexp, int index, char **name);
+
 ORTE_DECLSPEC int orte_regex_extract_ppn(int num_nodes, char *regexp, int **ppn);
 
 ORTE_DECLSPEC int orte_regex_extract_name_range(char *regexp, char ***names);
@@ -9,15 +9,1122 @@
 
 #include "orte_config.h"
 #include "orte/constants.h"
+#include "orte/types.h"
+
+#include <string.h>
+#include <stdlib.h>
+#include <limits.h>
+
+#include "opal/dss/dss.h"
+#include "opal/class/opal_list.h"
+#include "opal/class/opal_pointer_array.h"
+#include "opal/mca/base/mca_base_var.h"
+#include "opal/mca/event/event.h"
+#include "opal/sys/atomic.h"
+#include "opal/util/output.h"
+
+#include "orte/mca/errmgr/errmgr.h"
+#include "orte/mca/rml/rml.h"
+#include "orte/util/name_fns.h"
+#include "orte/util/proc_info.h"
+#include "orte/runtime/orte_globals.h"
 
 #include "scon/scon.h"
 
+/* message types carried on ORTE_RML_TAG_SCON */
+typedef uint8_t scon_msg_type_t;
+#define SCON_MSG_TYPE_T       OPAL_UINT8
+#define SCON_MSG_P2P          1
+#define SCON_MSG_XCAST        2
+#define SCON_MSG_ALLGATHER    3
+#define SCON_MSG_RELEASE      4
+
+/* a receive posted on an overlay */
+typedef struct {
+    opal_list_item_t super;
+    orte_process_name_t peer;
+    orte_rml_tag_t tag;
+    bool persistent;
+    scon_recv_cbfunc_t cbfunc;
+    void *cbdata;
+} scon_posted_recv_t;
+static OBJ_CLASS_INSTANCE(scon_posted_recv_t,
+                          opal_list_item_t,
+                          NULL, NULL);
+
+/* a message that arrived before a matching receive was posted,
+ * or before the overlay it belongs to was created */
+typedef struct {
+    opal_list_item_t super;
+    scon_handle_t handle;
+    orte_process_name_t sender;
+    orte_rml_tag_t tag;
+    opal_buffer_t data;
+} scon_msg_t;
+static void msgcon(scon_msg_t *p)
+{
+    OBJ_CONSTRUCT(&p->data, opal_buffer_t);
+}
+static void msgdes(scon_msg_t *p)
+{
+    OBJ_DESTRUCT(&p->data);
+}
+static OBJ_CLASS_INSTANCE(scon_msg_t,
+                          opal_list_item_t,
+                          msgcon, msgdes);
+
+/* tracker for an ongoing allgather */
+typedef struct {
+    opal_list_item_t super;
+    uint32_t seq;
+    opal_buffer_t bucket;
+    size_t nexpected;
+    size_t nreported;
+    scon_allgather_cbfunc_t cbfunc;
+    void *cbdata;
+} scon_coll_t;
+static void collcon(scon_coll_t *p)
+{
+    p->seq = 0;
+    OBJ_CONSTRUCT(&p->bucket, opal_buffer_t);
+    p->nexpected = 0;
+    p->nreported = 0;
+    p->cbfunc = NULL;
+    p->cbdata = NULL;
+}
+static void colldes(scon_coll_t *p)
+{
+    OBJ_DESTRUCT(&p->bucket);
+}
+static OBJ_CLASS_INSTANCE(scon_coll_t,
+                          opal_list_item_t,
+                          collcon, colldes);
+
+/* the overlay itself */
+typedef struct {
+    opal_object_t super;
+    scon_handle_t handle;
+    orte_jobid_t jobid;
+    /* sorted array of member vpids - NULL if all
+     * procs in the job are members */
+    orte_vpid_t *members;
+    size_t nmembers;
+    /* our rank in the overlay, -1 if not a member */
+    int my_rank;
+    /* ORTE_SUCCESS, or why the overlay could not be built */
+    int status;
+    uint32_t allgather_seq;
+    opal_list_t posted;
+    opal_list_t unmatched;
+    opal_list_t colls;
+} scon_overlay_t;
+static void ovcon(scon_overlay_t *p)
+{
+    p->handle = SCON_HANDLE_INVALID;
+    p->jobid = ORTE_JOBID_INVALID;
+    p->members = NULL;
+    p->nmembers = 0;
+    p->my_rank = -1;
+    p->status = ORTE_SUCCESS;
+    p->allgather_seq = 0;
+    OBJ_CONSTRUCT(&p->posted, opal_list_t);
+    OBJ_CONSTRUCT(&p->unmatched, opal_list_t);
+    OBJ_CONSTRUCT(&p->colls, opal_list_t);
+}
+static void ovdes(scon_overlay_t *p)
+{
+    if (NULL != p->members) {
+        free(p->members);
+    }
+    OPAL_LIST_DESTRUCT(&p->posted);
+    OPAL_LIST_DESTRUCT(&p->unmatched);
+    OPAL_LIST_DESTRUCT(&p->colls);
+}
+static OBJ_CLASS_INSTANCE(scon_overlay_t,
+                          opal_object_t,
+                          ovcon, ovdes);
+
+/* object for shifting API requests into the event base */
+typedef struct {
+    opal_object_t super;
+    opal_event_t ev;
+    scon_handle_t handle;
+    orte_grpcomm_signature_t *sig;
+    orte_process_name_t peer;
+    orte_rml_tag_t tag;
+    bool persistent;
+    bool cancel;
+    opal_buffer_t *buf;
+    union {
+        scon_send_cbfunc_t send;
+        scon_recv_cbfunc_t recv;
+        scon_allgather_cbfunc_t allgather;
+    } cbfunc;
+    void *cbdata;
+} scon_caddy_t;
+static void cdcon(scon_caddy_t *p)
+{
+    p->handle = SCON_HANDLE_INVALID;
+    p->sig = NULL;
+    p->tag = ORTE_RML_TAG_INVALID;
+    p->persistent = false;
+    p->cancel = false;
+    p->buf = NULL;
+    p->cbfunc.send = NULL;
+    p->cbdata = NULL;
+}
+static void cddes(scon_caddy_t *p)
+{
+    if (NULL != p->sig) {
+        OBJ_RELEASE(p->sig);
+    }
+    if (NULL != p->buf) {
+        OBJ_RELEASE(p->buf);
+    }
+}
+static OBJ_CLASS_INSTANCE(scon_caddy_t,
+                          opal_object_t,
+                          cdcon, cddes);
+
+#define SCON_THREADSHIFT(c, fn)                                 \
+    do {                                                        \
+        opal_event_set(orte_event_base, &(c)->ev, -1,           \
+                       OPAL_EV_WRITE, (fn), (c));               \
+        opal_event_set_priority(&(c)->ev, ORTE_MSG_PRI);        \
+        opal_event_active(&(c)->ev, OPAL_EV_WRITE, 1);          \
+    } while(0);
+
+/* local variables */
+static bool initialized = false;
+static int scon_output = -1;
+static int scon_verbose = 0;
+static int scon_radix = 32;
+static volatile int32_t next_handle = 0;
+static opal_pointer_array_t overlays;
+static opal_list_t early_msgs;
+
+/* local functions */
+static void scon_recv(int status, orte_process_name_t* sender,
+                      opal_buffer_t* buffer, orte_rml_tag_t tag,
+                      void* cbdata);
+static void process_msg(scon_overlay_t *ov,
+                        orte_process_name_t *sender,
+                        opal_buffer_t *buffer);
+
 int scon_init(void)
 {
+    if (initialized) {
+        return ORTE_SUCCESS;
+    }
+
+    scon_verbose = 0;
+    (void) mca_base_var_register("orte", "scon", "base", "verbose",
+                                 "Verbosity level of the SCON library",
+                                 MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                                 OPAL_INFO_LVL_9, MCA_BASE_VAR_SCOPE_READONLY,
+                                 &scon_verbose);
+    scon_radix = 32;
+    (void) mca_base_var_register("orte", "scon", "base", "radix",
+                                 "Fan-out of the tree used for SCON collectives",
+                                 MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                                 OPAL_INFO_LVL_9, MCA_BASE_VAR_SCOPE_READONLY,
+                                 &scon_radix);
+    if (scon_radix < 2) {
+        scon_radix = 2;
+    }
+    if (0 < scon_verbose) {
+        scon_output = opal_output_open(NULL);
+        opal_output_set_verbosity(scon_output, scon_verbose);
+    }
+
+    OBJ_CONSTRUCT(&overlays, opal_pointer_array_t);
+    opal_pointer_array_init(&overlays, 8, INT_MAX, 8);
+    OBJ_CONSTRUCT(&early_msgs, opal_list_t);
+
+    orte_rml.recv_buffer_nb(ORTE_NAME_WILDCARD, ORTE_RML_TAG_SCON,
+                            ORTE_RML_PERSISTENT, scon_recv, NULL);
+
+    initialized = true;
     return ORTE_SUCCESS;
 }
 
 void scon_finalize(void)
 {
-    return;
+    int i;
+    scon_overlay_t *ov;
+
+    if (!initialized) {
+        return;
+    }
+    orte_rml.recv_cancel(ORTE_NAME_WILDCARD, ORTE_RML_TAG_SCON);
+
+    for (i=0; i < overlays.size; i++) {
+        if (NULL != (ov = (scon_overlay_t*)opal_pointer_array_get_item(&overlays, i))) {
+            OBJ_RELEASE(ov);
+        }
+    }
+    OBJ_DESTRUCT(&overlays);
+    OPAL_LIST_DESTRUCT(&early_msgs);
+    if (0 <= scon_output) {
+        opal_output_close(scon_output);
+        scon_output = -1;
+    }
+    initialized = false;
+}
+
+/****    TREE SUPPORT    ****/
+static inline orte_vpid_t rank_to_vpid(scon_overlay_t *ov, int rank)
+{
+    if (NULL == ov->members) {
+        return (orte_vpid_t)rank;
+    }
+    return ov->members[rank];
+}
+
+static int vpidcmp(const void *a, const void *b)
+{
+    orte_vpid_t va = *(const orte_vpid_t*)a;
+    orte_vpid_t vb = *(const orte_vpid_t*)b;
+
+    if (va < vb) {
+        return -1;
+    }
+    return (va > vb) ? 1 : 0;
+}
+
+static int vpid_to_rank(scon_overlay_t *ov, orte_vpid_t vpid)
+{
+    orte_vpid_t *v;
+
+    if (NULL == ov->members) {
+        return (vpid < ov->nmembers) ? (int)vpid : -1;
+    }
+    v = (orte_vpid_t*)bsearch(&vpid, ov->members, ov->nmembers,
+                              sizeof(orte_vpid_t), vpidcmp);
+    return (NULL == v) ? -1 : (int)(v - ov->members);
+}
+
+/* the tree is a k-ary tree over the overlay ranks, rotated
+ * so that it is rooted at the given rank */
+static int tree_parent(scon_overlay_t *ov, int root, int rank)
+{
+    int n = (int)ov->nmembers;
+    int rel = (rank - root + n) % n;
+
+    if (0 == rel) {
+        return -1;
+    }
+    return ((rel - 1) / scon_radix + root) % n;
+}
+
+static int tree_children(scon_overlay_t *ov, int root, int rank, int **children)
+{
+    int n = (int)ov->nmembers;
+    int rel = (rank - root + n) % n;
+    int first, i, nc;
+
+    *children = NULL;
+    first = rel * scon_radix + 1;
+    if (first >= n || first < 0) {
+        return 0;
+    }
+    nc = n - first;
+    if (nc > scon_radix) {
+        nc = scon_radix;
+    }
+    *children = (int*)malloc(nc * sizeof(int));
+    for (i=0; i < nc; i++) {
+        (*children)[i] = (first + i + root) % n;
+    }
+    return nc;
+}
+
+/* the overlay for a handle, whether or not it could be built */
+static scon_overlay_t* lookup_overlay(scon_handle_t scon)
+{
+    if (!initialized || scon < 0) {
+        return NULL;
+    }
+    return (scon_overlay_t*)opal_pointer_array_get_item(&overlays, scon);
+}
+
+/* the overlay for a handle if it is usable - otherwise NULL,
+ * with the reason in *status */
+static scon_overlay_t* get_overlay(scon_handle_t scon, int *status)
+{
+    scon_overlay_t *ov;
+
+    if (NULL == (ov = lookup_overlay(scon))) {
+        *status = ORTE_ERR_NOT_FOUND;
+        return NULL;
+    }
+    if (ORTE_SUCCESS != ov->status) {
+        *status = ov->status;
+        return NULL;
+    }
+    return ov;
+}
+
+static void purge_early_msgs(scon_handle_t scon)
+{
+    scon_msg_t *msg, *next;
+
+    OPAL_LIST_FOREACH_SAFE(msg, next, &early_msgs, scon_msg_t) {
+        if (msg->handle == scon) {
+            opal_list_remove_item(&early_msgs, &msg->super);
+            OBJ_RELEASE(msg);
+        }
+    }
+}
+
+/****    MESSAGE DELIVERY    ****/
+static bool match_recv(scon_posted_recv_t *post,
+                       orte_process_name_t *sender,
+                       orte_rml_tag_t tag)
+{
+    return (post->tag == tag &&
+            OPAL_EQUAL == orte_util_compare_name_fields(ORTE_NS_CMP_ALL | ORTE_NS_CMP_WILD,
+                                                        &post->peer, sender));
+}
+
+static void deliver(scon_overlay_t *ov,
+                    orte_process_name_t *sender,
+                    orte_rml_tag_t tag,
+                    opal_buffer_t *buffer)
+{
+    scon_posted_recv_t *post;
+    scon_msg_t *msg;
+
+    OPAL_LIST_FOREACH(post, &ov->posted, scon_posted_recv_t) {
+        if (match_recv(post, sender, tag)) {
+            opal_output_verbose(5, scon_output,
+                                "%s scon:%d delivering msg from %s on tag %d",
+                                ORTE_NAME_PRINT(ORTE_PROC_MY_NAME), (int)ov->handle,
+                                ORTE_NAME_PRINT(sender), (int)tag);
+            if (!post->persistent) {
+                opal_list_remove_item(&ov->posted, &post->super);
+            }
+            post->cbfunc(ORTE_SUCCESS, ov->handle, sender, buffer, tag, post->cbdata);
+            if (!post->persistent) {
+                OBJ_RELEASE(post);
+            }
+            return;
+        }
+    }
+
+    /* hold it until someone asks for it */
+    opal_output_verbose(5, scon_output,
+                        "%s scon:%d holding unmatched msg from %s on tag %d",
+                        ORTE_NAME_PRINT(ORTE_PROC_MY_NAME), (int)ov->handle,
+                        ORTE_NAME_PRINT(sender), (int)tag);
+    msg = OBJ_NEW(scon_msg_t);
+    msg->handle = ov->handle;
+    msg->sender = *sender;
+    msg->tag = tag;
+    opal_dss.copy_payload(&msg->data, buffer);
+    opal_list_append(&ov->unmatched, &msg->super);
+}
+
+static int pack_header(opal_buffer_t *buf, scon_handle_t scon,
+                       scon_msg_type_t type, orte_rml_tag_t tag)
+{
+    int rc;
+
+    if (OPAL_SUCCESS != (rc = opal_dss.pack(buf, &scon, 1, SCON_HANDLE_T))) {
+        ORTE_ERROR_LOG(rc);
+        return rc;
+    }
+    if (OPAL_SUCCESS != (rc = opal_dss.pack(buf, &type, 1, SCON_MSG_TYPE_T))) {
+        ORTE_ERROR_LOG(rc);
+        return rc;
+    }
+    if (OPAL_SUCCESS != (rc = opal_dss.pack(buf, &tag, 1, ORTE_RML_TAG))) {
+        ORTE_ERROR_LOG(rc);
+        return rc;
+    }
+    return ORTE_SUCCESS;
+}
+
+/* pass an xcast or allgather release down the tree. The relay
+ * buffer carries the complete header and is sent as-is to every
+ * child, so each level touches the payload only once */
+static void relay(scon_overlay_t *ov, int root, opal_buffer_t *rly)
+{
+    int *children, nc, i, rc;
+    orte_process_name_t peer;
+
+    if (0 > ov->my_rank) {
+        return;
+    }
+    nc = tree_children(ov, root, ov->my_rank, &children);
+    peer.jobid = ov->jobid;
+    for (i=0; i < nc; i++) {
+        peer.vpid = rank_to_vpid(ov, children[i]);
+        opal_output_verbose(5, scon_output,
+                            "%s scon:%d relaying %d bytes to %s",
+                            ORTE_NAME_PRINT(ORTE_PROC_MY_NAME), (int)ov->handle,
+                            (int)rly->bytes_used, ORTE_NAME_PRINT(&peer));
+        OBJ_RETAIN(rly);
+        if (0 > (rc = orte_rml.send_buffer_nb(&peer, rly, ORTE_RML_TAG_SCON,
+                                              orte_rml_send_callback, NULL))) {
+            ORTE_ERROR_LOG(rc);
+            OBJ_RELEASE(rly);
+        }
+    }
+    if (NULL != children) {
+        free(children);
+    }
+}
+
+static scon_coll_t* get_coll(scon_overlay_t *ov, uint32_t seq)
+{
+    scon_coll_t *coll;
+    int *children;
+
+    OPAL_LIST_FOREACH(coll, &ov->colls, scon_coll_t) {
+        if (seq == coll->seq) {
+            return coll;
+        }
+    }
+    coll = OBJ_NEW(scon_coll_t);
+    coll->seq = seq;
+    /* we expect one contribution from each child plus our own */
+    coll->nexpected = tree_children(ov, 0, ov->my_rank, &children) + 1;
+    if (NULL != children) {
+        free(children);
+    }
+    opal_list_append(&ov->colls, &coll->super);
+    return coll;
+}
+
+static void complete_release(scon_overlay_t *ov, uint32_t seq,
+                             int status, opal_buffer_t *buffer)
+{
+    scon_coll_t *coll;
+
+    OPAL_LIST_FOREACH(coll, &ov->colls, scon_coll_t) {
+        if (seq == coll->seq) {
+            opal_list_remove_item(&ov->colls, &coll->super);
+            if (NULL != coll->cbfunc) {
+                coll->cbfunc(status, ov->handle, buffer, coll->cbdata);
+            }
+            OBJ_RELEASE(coll);
+            return;
+        }
+    }
+    opal_output_verbose(2, scon_output,
+                        "%s scon:%d release for unknown allgather %u",
+                        ORTE_NAME_PRINT(ORTE_PROC_MY_NAME),
+                        (int)ov->handle, seq);
+}
+
+static void check_allgather(scon_overlay_t *ov, scon_coll_t *coll)
+{
+    opal_buffer_t *buf, result;
+    orte_process_name_t parent;
+    int rc, root = 0;
+
+    if (coll->nreported < coll->nexpected) {
+        return;
+    }
+
+    buf = OBJ_NEW(opal_buffer_t);
+    if (0 == ov->my_rank) {
+        /* everyone has reported - send the release */
+        if (ORTE_SUCCESS != pack_header(buf, ov->handle, SCON_MSG_RELEASE, ORTE_RML_TAG_INVALID) ||
+            OPAL_SUCCESS != (rc = opal_dss.pack(buf, &root, 1, OPAL_INT32)) ||
+            OPAL_SUCCESS != (rc = opal_dss.pack(buf, &coll->seq, 1, OPAL_UINT32))) {
+            OBJ_RELEASE(buf);
+            return;
+        }
+        opal_dss.copy_payload(buf, &coll->bucket);
+        relay(ov, root, buf);
+        OBJ_RELEASE(buf);
+        OBJ_CONSTRUCT(&result, opal_buffer_t);
+        opal_dss.copy_payload(&result, &coll->bucket);
+        complete_release(ov, coll->seq, ORTE_SUCCESS, &result);
+        OBJ_DESTRUCT(&result);
+        return;
+    }
+
+    /* roll our bucket up to our parent */
+    if (ORTE_SUCCESS != pack_header(buf, ov->handle, SCON_MSG_ALLGATHER, ORTE_RML_TAG_INVALID) ||
+        OPAL_SUCCESS != (rc = opal_dss.pack(buf, &coll->seq, 1, OPAL_UINT32))) {
+        OBJ_RELEASE(buf);
+        return;
+    }
+    opal_dss.copy_payload(buf, &coll->bucket);
+    parent.jobid = ov->jobid;
+    parent.vpid = rank_to_vpid(ov, tree_parent(ov, 0, ov->my_rank));
+    opal_output_verbose(5, scon_output,
+                        "%s scon:%d allgather %u rollup to %s",
+                        ORTE_NAME_PRINT(ORTE_PROC_MY_NAME), (int)ov->handle,
+                        coll->seq, ORTE_NAME_PRINT(&parent));
+    if (0 > (rc = orte_rml.send_buffer_nb(&parent, buf, ORTE_RML_TAG_SCON,
+                                          orte_rml_send_callback, NULL))) {
+        ORTE_ERROR_LOG(rc);
+        OBJ_RELEASE(buf);
+    }
+}
+
+static void process_msg(scon_overlay_t *ov,
+                        orte_process_name_t *sender,
+                        opal_buffer_t *buffer)
+{
+    int32_t cnt;
+    int rc, root;
+    scon_msg_type_t type;
+    orte_rml_tag_t tag;
+    uint32_t seq;
+    opal_buffer_t *rly;
+    orte_process_name_t origin;
+    scon_coll_t *coll;
+
+    cnt = 1;
+    if (OPAL_SUCCESS != (rc = opal_dss.unpack(buffer, &type, &cnt, SCON_MSG_TYPE_T))) {
+        ORTE_ERROR_LOG(rc);
+        return;
+    }
+    cnt = 1;
+    if (OPAL_SUCCESS != (rc = opal_dss.unpack(buffer, &tag, &cnt, ORTE_RML_TAG))) {
+        ORTE_ERROR_LOG(rc);
+        return;
+    }
+
+    switch (type) {
+    case SCON_MSG_P2P:
+        deliver(ov, sender, tag, buffer);
+        break;
+
+    case SCON_MSG_XCAST:
+    case SCON_MSG_RELEASE:
+        cnt = 1;
+        if (OPAL_SUCCESS != (rc = opal_dss.unpack(buffer, &root, &cnt, OPAL_INT32))) {
+            ORTE_ERROR_LOG(rc);
+            return;
+        }
+        cnt = 1;
+        if (SCON_MSG_RELEASE == type) {
+            rc = opal_dss.unpack(buffer, &seq, &cnt, OPAL_UINT32);
+        } else {
+            /* the originator need not be a member, so it
+             * travels with the message */
+            rc = opal_dss.unpack(buffer, &origin, &cnt, ORTE_NAME);
+        }
+        if (OPAL_SUCCESS != rc) {
+            ORTE_ERROR_LOG(rc);
+            return;
+        }
+        /* rebuild the header once and pass the remainder along */
+        rly = OBJ_NEW(opal_buffer_t);
+        if (ORTE_SUCCESS == pack_header(rly, ov->handle, type, tag) &&
+            OPAL_SUCCESS == opal_dss.pack(rly, &root, 1, OPAL_INT32) &&
+            (SCON_MSG_XCAST == type ?
+             OPAL_SUCCESS == opal_dss.pack(rly, &origin, 1, ORTE_NAME) :
+             OPAL_SUCCESS == opal_dss.pack(rly, &seq, 1, OPAL_UINT32)) &&
+            OPAL_SUCCESS == opal_dss.copy_payload(rly, buffer)) {
+            relay(ov, root, rly);
+        }
+        OBJ_RELEASE(rly);
+        if (SCON_MSG_XCAST == type) {
+            deliver(ov, &origin, tag, buffer);
+        } else {
+            complete_release(ov, seq, ORTE_SUCCESS, buffer);
+        }
+        break;
+
+    case SCON_MSG_ALLGATHER:
+        cnt = 1;
+        if (OPAL_SUCCESS != (rc = opal_dss.unpack(buffer, &seq, &cnt, OPAL_UINT32))) {
+            ORTE_ERROR_LOG(rc);
+            return;
+        }
+        if (0 > ov->my_rank) {
+            ORTE_ERROR_LOG(ORTE_ERR_BAD_PARAM);
+            return;
+        }
+        coll = get_coll(ov, seq);
+        opal_dss.copy_payload(&coll->bucket, buffer);
+        coll->nreported++;
+        check_allgather(ov, coll);
+        break;
+
+    default:
+        ORTE_ERROR_LOG(ORTE_ERR_BAD_PARAM);
+        break;
+    }
+}
+
+static void scon_recv(int status, orte_process_name_t* sender,
+                      opal_buffer_t* buffer, orte_rml_tag_t tg,
+                      void* cbdata)
+{
+    int32_t cnt;
+    int rc;
+    scon_handle_t scon;
+    scon_overlay_t *ov;
+    scon_msg_t *msg;
+
+    cnt = 1;
+    if (OPAL_SUCCESS != (rc = opal_dss.unpack(buffer, &scon, &cnt, SCON_HANDLE_T))) {
+        ORTE_ERROR_LOG(rc);
+        return;
+    }
+    opal_output_verbose(5, scon_output,
+                        "%s scon:%d recvd %d bytes from %s",
+                        ORTE_NAME_PRINT(ORTE_PROC_MY_NAME), (int)scon,
+                        (int)buffer->bytes_used, ORTE_NAME_PRINT(sender));
+
+    if (NULL != (ov = lookup_overlay(scon)) && ORTE_SUCCESS != ov->status) {
+        opal_output_verbose(2, scon_output,
+                            "%s scon:%d dropping msg from %s - overlay could not be built",
+                            ORTE_NAME_PRINT(ORTE_PROC_MY_NAME), (int)scon,
+                            ORTE_NAME_PRINT(sender));
+        return;
+    }
+    if (NULL == ov) {
+        /* the sender created this overlay before we did - hold
+         * the message until we catch up */
+        msg = OBJ_NEW(scon_msg_t);
+        msg->handle = scon;
+        msg->sender = *sender;
+        opal_dss.copy_payload(&msg->data, buffer);
+        opal_list_append(&early_msgs, &msg->super);
+        return;
+    }
+    process_msg(ov, sender, buffer);
+}
+
+/****    API FUNCTIONS    ****/
+static void create_overlay(int sd, short args, void *cbdata)
+{
+    scon_caddy_t *cd = (scon_caddy_t*)cbdata;
+    orte_grpcomm_signature_t *sig = cd->sig;
+    scon_overlay_t *ov;
+    orte_job_t *jdata;
+    scon_msg_t *msg, *next;
+    size_t n, m;
+
+    ov = OBJ_NEW(scon_overlay_t);
+    ov->handle = cd->handle;
+
+    if (NULL == sig || NULL == sig->signature || 0 == sig->sz ||
+        (1 == sig->sz && ORTE_VPID_WILDCARD == sig->signature[0].vpid)) {
+        /* all procs in the job are members */
+        if (NULL == sig || NULL == sig->signature || 0 == sig->sz) {
+            ov->jobid = ORTE_PROC_MY_NAME->jobid;
+        } else {
+            ov->jobid = sig->signature[0].jobid;
+        }
+        if (ov->jobid == ORTE_PROC_MY_NAME->jobid) {
+            ov->nmembers = orte_process_info.num_procs;
+        } else if (NULL != (jdata = orte_get_job_data_object(ov->jobid))) {
+            ov->nmembers = jdata->num_procs;
+        } else {
+            /* keep the handle taken so later ones still line up
+             * with the other members - using it reports the error */
+            ORTE_ERROR_LOG(ORTE_ERR_NOT_FOUND);
+            ov->status = ORTE_ERR_NOT_FOUND;
+            opal_pointer_array_set_item(&overlays, ov->handle, ov);
+            purge_early_msgs(ov->handle);
+            OBJ_RELEASE(cd);
+            return;
+        }
+    } else {
+        /* scon_create already checked the signature */
+        ov->jobid = sig->signature[0].jobid;
+        ov->members = (orte_vpid_t*)malloc(sig->sz * sizeof(orte_vpid_t));
+        for (n=0; n < sig->sz; n++) {
+            ov->members[n] = sig->signature[n].vpid;
+        }
+        /* sort and remove duplicates so every member sees the same tree */
+        qsort(ov->members, sig->sz, sizeof(orte_vpid_t), vpidcmp);
+        for (n=1, m=0; n < sig->sz; n++) {
+            if (ov->members[n] != ov->members[m]) {
+                ov->members[++m] = ov->members[n];
+            }
+        }
+        ov->nmembers = m + 1;
+    }
+    if (ov->jobid == ORTE_PROC_MY_NAME->jobid) {
+        ov->my_rank = vpid_to_rank(ov, ORTE_PROC_MY_NAME->vpid);
+    }
+    opal_output_verbose(2, scon_output,
+                        "%s scon:%d created with %d members - my rank %d",
+                        ORTE_NAME_PRINT(ORTE_PROC_MY_NAME), (int)ov->handle,
+                        (int)ov->nmembers, ov->my_rank);
+    opal_pointer_array_set_item(&overlays, ov->handle, ov);
+
+    /* process anything that arrived before we got here */
+    OPAL_LIST_FOREACH_SAFE(msg, next, &early_msgs, scon_msg_t) {
+        if (msg->handle == ov->handle) {
+            opal_list_remove_item(&early_msgs, &msg->super);
+            process_msg(ov, &msg->sender, &msg->data);
+            OBJ_RELEASE(msg);
+        }
+    }
+    OBJ_RELEASE(cd);
+}
+
+scon_handle_t scon_create(orte_grpcomm_signature_t *sig)
+{
+    scon_caddy_t *cd;
+    size_t n;
+
+    if (!initialized) {
+        return SCON_HANDLE_INVALID;
+    }
+    /* reject a bad signature before it uses up a handle - every
+     * member is given the same one, so they all fail alike */
+    if (NULL != sig && NULL != sig->signature && 1 < sig->sz) {
+        for (n=0; n < sig->sz; n++) {
+            if (sig->signature[0].jobid != sig->signature[n].jobid ||
+                ORTE_VPID_WILDCARD == sig->signature[n].vpid) {
+                ORTE_ERROR_LOG(ORTE_ERR_BAD_PARAM);
+                return SCON_HANDLE_INVALID;
+            }
+        }
+    }
+    cd = OBJ_NEW(scon_caddy_t);
+    /* the handle must be assigned in order of creation so that
+     * all members agree on it */
+    cd->handle = opal_atomic_add_32(&next_handle, 1) - 1;
+    if (NULL != sig) {
+        opal_dss.copy((void**)&cd->sig, sig, ORTE_SIGNATURE);
+    }
+    SCON_THREADSHIFT(cd, create_overlay);
+    return cd->handle;
+}
+
+static void delete_overlay(int sd, short args, void *cbdata)
+{
+    scon_caddy_t *cd = (scon_caddy_t*)cbdata;
+    scon_overlay_t *ov;
+
+    if (NULL != (ov = lookup_overlay(cd->handle))) {
+        opal_pointer_array_set_item(&overlays, cd->handle, NULL);
+        OBJ_RELEASE(ov);
+    }
+    /* nothing can claim these any more */
+    purge_early_msgs(cd->handle);
+    OBJ_RELEASE(cd);
+}
+
+int scon_delete(scon_handle_t scon)
+{
+    scon_caddy_t *cd;
+
+    if (!initialized) {
+        return ORTE_ERR_NOT_INITIALIZED;
+    }
+    cd = OBJ_NEW(scon_caddy_t);
+    cd->handle = scon;
+    SCON_THREADSHIFT(cd, delete_overlay);
+    return ORTE_SUCCESS;
+}
+
+/* track the user's buffer while the RML sends our copy */
+typedef struct {
+    opal_object_t super;
+    scon_handle_t handle;
+    opal_buffer_t *buf;
+    scon_send_cbfunc_t cbfunc;
+    void *cbdata;
+} scon_send_t;
+static OBJ_CLASS_INSTANCE(scon_send_t,
+                          opal_object_t,
+                          NULL, NULL);
+
+static void send_complete(int status, orte_process_name_t* peer,
+                          opal_buffer_t* buffer, orte_rml_tag_t tag,
+                          void* cbdata)
+{
+    scon_send_t *snd = (scon_send_t*)cbdata;
+
+    OBJ_RELEASE(buffer);
+    if (NULL != snd->cbfunc) {
+        snd->cbfunc(status, snd->handle, peer, snd->buf, tag, snd->cbdata);
+    }
+    OBJ_RELEASE(snd);
+}
+
+int scon_send_nb(scon_handle_t scon,
+                 orte_process_name_t *peer,
+                 opal_buffer_t *buf,
+                 orte_rml_tag_t tag,
+                 scon_send_cbfunc_t cbfunc,
+                 void *cbdata)
+{
+    opal_buffer_t *msg;
+    scon_send_t *snd;
+    int rc;
+
+    if (!initialized) {
+        return ORTE_ERR_NOT_INITIALIZED;
+    }
+    msg = OBJ_NEW(opal_buffer_t);
+    if (ORTE_SUCCESS != (rc = pack_header(msg, scon, SCON_MSG_P2P, tag))) {
+        OBJ_RELEASE(msg);
+        return rc;
+    }
+    opal_dss.copy_payload(msg, buf);
+
+    snd = OBJ_NEW(scon_send_t);
+    snd->handle = scon;
+    snd->buf = buf;
+    snd->cbfunc = cbfunc;
+    snd->cbdata = cbdata;
+    if (0 > (rc = orte_rml.send_buffer_nb(peer, msg, ORTE_RML_TAG_SCON,
+                                          send_complete, snd))) {
+        ORTE_ERROR_LOG(rc);
+        OBJ_RELEASE(msg);
+        OBJ_RELEASE(snd);
+        return rc;
+    }
+    return ORTE_SUCCESS;
+}
+
+static void post_recv(int sd, short args, void *cbdata)
+{
+    scon_caddy_t *cd = (scon_caddy_t*)cbdata;
+    scon_overlay_t *ov;
+    scon_posted_recv_t *post;
+    scon_msg_t *msg, *next;
+    int rc;
+
+    if (NULL == (ov = get_overlay(cd->handle, &rc))) {
+        ORTE_ERROR_LOG(rc);
+        OBJ_RELEASE(cd);
+        return;
+    }
+
+    if (cd->cancel) {
+        OPAL_LIST_FOREACH(post, &ov->posted, scon_posted_recv_t) {
+            if (post->tag == cd->tag &&
+                OPAL_EQUAL == orte_util_compare_name_fields(ORTE_NS_CMP_ALL | ORTE_NS_CMP_WILD,
+                                                            &post->peer, &cd->peer)) {
+                opal_list_remove_item(&ov->posted, &post->super);
+                OBJ_RELEASE(post);
+                break;
+            }
+        }
+        OBJ_RELEASE(cd);
+        return;
+    }
+
+    post = OBJ_NEW(scon_posted_recv_t);
+    post->peer = cd->peer;
+    post->tag = cd->tag;
+    post->persistent = cd->persistent;
+    post->cbfunc = cd->cbfunc.recv;
+    post->cbdata = cd->cbdata;
+
+    /* check for messages that already arrived */
+    OPAL_LIST_FOREACH_SAFE(msg, next, &ov->unmatched, scon_msg_t) {
+        if (match_recv(post, &msg->sender, msg->tag)) {
+            opal_list_remove_item(&ov->unmatched, &msg->super);
+            post->cbfunc(ORTE_SUCCESS, ov->handle, &msg->sender,
+                         &msg->data, msg->tag, post->cbdata);
+            OBJ_RELEASE(msg);
+            if (!post->persistent) {
+                OBJ_RELEASE(post);
+                OBJ_RELEASE(cd);
+                return;
+            }
+        }
+    }
+    opal_list_append(&ov->posted, &post->super);
+    OBJ_RELEASE(cd);
+}
+
+int scon_recv_nb(scon_handle_t scon,
+                 orte_process_name_t *peer,
+                 orte_rml_tag_t tag,
+                 bool persistent,
+                 scon_recv_cbfunc_t cbfunc,
+                 void *cbdata)
+{
+    scon_caddy_t *cd;
+
+    if (!initialized) {
+        return ORTE_ERR_NOT_INITIALIZED;
+    }
+    cd = OBJ_NEW(scon_caddy_t);
+    cd->handle = scon;
+    cd->peer = *peer;
+    cd->tag = tag;
+    cd->persistent = persistent;
+    cd->cbfunc.recv = cbfunc;
+    cd->cbdata = cbdata;
+    SCON_THREADSHIFT(cd, post_recv);
+    return ORTE_SUCCESS;
+}
+
+int scon_recv_cancel(scon_handle_t scon,
+                     orte_process_name_t *peer,
+                     orte_rml_tag_t tag)
+{
+    scon_caddy_t *cd;
+
+    if (!initialized) {
+        return ORTE_ERR_NOT_INITIALIZED;
+    }
+    cd = OBJ_NEW(scon_caddy_t);
+    cd->handle = scon;
+    cd->peer = *peer;
+    cd->tag = tag;
+    cd->cancel = true;
+    SCON_THREADSHIFT(cd, post_recv);
+    return ORTE_SUCCESS;
+}
+
+static void start_xcast(int sd, short args, void *cbdata)
+{
+    scon_caddy_t *cd = (scon_caddy_t*)cbdata;
+    scon_overlay_t *ov;
+    opal_buffer_t *buf;
+    int root, rc;
+
+    if (NULL == (ov = get_overlay(cd->handle, &rc))) {
+        ORTE_ERROR_LOG(rc);
+        OBJ_RELEASE(cd);
+        return;
+    }
+    if (0 > (root = ov->my_rank)) {
+        /* non-members inject the message at rank zero */
+        root = 0;
+    }
+    buf = OBJ_NEW(opal_buffer_t);
+    if (ORTE_SUCCESS != pack_header(buf, ov->handle, SCON_MSG_XCAST, cd->tag) ||
+        OPAL_SUCCESS != opal_dss.pack(buf, &root, 1, OPAL_INT32) ||
+        OPAL_SUCCESS != opal_dss.pack(buf, ORTE_PROC_MY_NAME, 1, ORTE_NAME) ||
+        OPAL_SUCCESS != opal_dss.copy_payload(buf, cd->buf)) {
+        OBJ_RELEASE(buf);
+        OBJ_RELEASE(cd);
+        return;
+    }
+
+    if (0 > ov->my_rank) {
+        orte_process_name_t peer;
+        peer.jobid = ov->jobid;
+        peer.vpid = rank_to_vpid(ov, 0);
+        if (0 > orte_rml.send_buffer_nb(&peer, buf, ORTE_RML_TAG_SCON,
+                                        orte_rml_send_callback, NULL)) {
+            OBJ_RELEASE(buf);
+        }
+        OBJ_RELEASE(cd);
+        return;
+    }
+    relay(ov, root, buf);
+    OBJ_RELEASE(buf);
+    /* deliver our own copy */
+    deliver(ov, ORTE_PROC_MY_NAME, cd->tag, cd->buf);
+    OBJ_RELEASE(cd);
+}
+
+int scon_xcast(scon_handle_t scon,
+               orte_rml_tag_t tag,
+               opal_buffer_t *buf)
+{
+    scon_caddy_t *cd;
+
+    if (!initialized) {
+        return ORTE_ERR_NOT_INITIALIZED;
+    }
+    cd = OBJ_NEW(scon_caddy_t);
+    cd->handle = scon;
+    cd->tag = tag;
+    /* take a snapshot so the caller can release their buffer */
+    cd->buf = OBJ_NEW(opal_buffer_t);
+    opal_dss.copy_payload(cd->buf, buf);
+    SCON_THREADSHIFT(cd, start_xcast);
+    return ORTE_SUCCESS;
+}
+
+static void start_allgather(int sd, short args, void *cbdata)
+{
+    scon_caddy_t *cd = (scon_caddy_t*)cbdata;
+    scon_overlay_t *ov;
+    scon_coll_t *coll;
+    orte_vpid_t vpid;
+    int rc;
+
+    if (NULL == (ov = get_overlay(cd->handle, &rc)) || 0 > ov->my_rank) {
+        if (NULL != ov) {
+            /* only members can take part */
+            rc = ORTE_ERR_NOT_FOUND;
+        }
+        ORTE_ERROR_LOG(rc);
+        if (NULL != cd->cbfunc.allgather) {
+            cd->cbfunc.allgather(rc, cd->handle, NULL, cd->cbdata);
+        }
+        OBJ_RELEASE(cd);
+        return;
+    }
+    coll = get_coll(ov, ov->allgather_seq++);
+    coll->cbfunc = cd->cbfunc.allgather;
+    coll->cbdata = cd->cbdata;
+    vpid = ORTE_PROC_MY_NAME->vpid;
+    opal_dss.pack(&coll->bucket, &vpid, 1, ORTE_VPID);
+    opal_dss.pack(&coll->bucket, &cd->buf, 1, OPAL_BUFFER);
+    coll->nreported++;
+    check_allgather(ov, coll);
+    OBJ_RELEASE(cd);
+}
+
+int scon_allgather(scon_handle_t scon,
+                   opal_buffer_t *buf,
+                   scon_allgather_cbfunc_t cbfunc,
+                   void *cbdata)
+{
+    scon_caddy_t *cd;
+
+    if (!initialized) {
+        return ORTE_ERR_NOT_INITIALIZED;
+    }
+    cd = OBJ_NEW(scon_caddy_t);
+    cd->handle = scon;
+    cd->buf = OBJ_NEW(opal_buffer_t);
+    opal_dss.copy_payload(cd->buf, buf);
+    cd->cbfunc.allgather = cbfunc;
+    cd->cbdata = cbdata;
+    SCON_THREADSHIFT(cd, start_allgather);
+    return ORTE_SUCCESS;
+}
+
+int scon_get_tree(scon_handle_t scon,
+                  size_t *nmembers, int *rank,
+                  orte_process_name_t *parent,
+                  orte_process_name_t **children,
+                  size_t *nchildren)
+{
+    scon_overlay_t *ov;
+    int *kids, nc, i, p, rc;
+
+    if (NULL == (ov = get_overlay(scon, &rc))) {
+        return rc;
+    }
+    *nmembers = ov->nmembers;
+    *rank = ov->my_rank;
+    parent->jobid = ov->jobid;
+    parent->vpid = ORTE_VPID_INVALID;
+    *children = NULL;
+    *nchildren = 0;
+    if (0 > ov->my_rank) {
+        return ORTE_SUCCESS;
+    }
+    if (0 <= (p = tree_parent(ov, 0, ov->my_rank))) {
+        parent->vpid = rank_to_vpid(ov, p);
+    }
+    nc = tree_children(ov, 0, ov->my_rank, &kids);
+    if (0 < nc) {
+        *children = (orte_process_name_t*)malloc(nc * sizeof(orte_process_name_t));
+        for (i=0; i < nc; i++) {
+            (*children)[i].jobid = ov->jobid;
+            (*children)[i].vpid = rank_to_vpid(ov, kids[i]);
+        }
+        *nchildren = nc;
+        free(kids);
+    }
+    return ORTE_SUCCESS;
 }
@@ -1,11 +1,27 @@
 /*
  * Copyright (c) 2014      Intel, Inc. All rights reserved.
  * $COPYRIGHT$
- * 
+ *
  * Additional copyrights may follow
- * 
+ *
  * $HEADER$
  */
+/** @file:
+ *
+ * The Scalable Overlay Network (SCON) library
+ *
+ * A SCON is an overlay network spanning a subset of the processes
+ * of a single ORTE job - typically the daemons of a DVM. Point-to-point
+ * messages are carried by the RML (and hence follow the routes provided
+ * by the active routed module), while collectives (xcast, allgather) are
+ * executed over a k-ary tree that only involves the members of the
+ * overlay. Thus, a tool operating on a few daemons doesn't pay for
+ * the entire daemon tree on every operation.
+ *
+ * All members of an overlay must create their overlays in the same
+ * order - an overlay is identified on the wire by the handle it was
+ * assigned at creation, much like an MPI communicator.
+ */
 
 #ifndef SCON_H
 #define SCON_H
@@ -20,14 +36,111 @@
 #include "opal/dss/dss_types.h"
 #include "opal/class/opal_pointer_array.h"
 #include "orte/mca/rml/rml_types.h"
+#include "orte/mca/grpcomm/grpcomm.h"
 
 BEGIN_C_DECLS
 
+/* handle identifying an overlay */
+typedef int32_t scon_handle_t;
+#define SCON_HANDLE_T               OPAL_INT32
+#define SCON_HANDLE_INVALID         -1
+
+/* callback for completion of a non-blocking send. The buffer
+ * is the one passed to scon_send_nb and is returned to the
+ * caller for release */
+typedef void (*scon_send_cbfunc_t)(int status, scon_handle_t scon,
+                                   orte_process_name_t *peer,
+                                   opal_buffer_t *buf,
+                                   orte_rml_tag_t tag,
+                                   void *cbdata);
+
+/* callback for a received message - the buffer belongs to
+ * the SCON library and will be released upon return */
+typedef void (*scon_recv_cbfunc_t)(int status, scon_handle_t scon,
+                                   orte_process_name_t *peer,
+                                   opal_buffer_t *buf,
+                                   orte_rml_tag_t tag,
+                                   void *cbdata);
+
+/* callback for completion of an allgather. The buffer contains
+ * one (ORTE_VPID, OPAL_BUFFER) pair for each member of the overlay,
+ * in no particular order, and belongs to the SCON library */
+typedef void (*scon_allgather_cbfunc_t)(int status, scon_handle_t scon,
+                                        opal_buffer_t *buf,
+                                        void *cbdata);
+
 /* Initialize the SCON library */
 ORTE_DECLSPEC int scon_init(void);
 
 ORTE_DECLSPEC void scon_finalize(void);
 
+/* Create an overlay spanning the procs in the given signature. All
+ * procs must belong to the same job. A NULL signature, or one whose
+ * only entry carries ORTE_VPID_WILDCARD, includes every proc in the
+ * caller's job. The caller need not be a member of the overlay, but
+ * only members can participate in its collectives. Returns
+ * SCON_HANDLE_INVALID if the signature is malformed. The overlay
+ * itself is built in the background - if that fails (e.g. the job
+ * is unknown), the handle stays taken so that later handles agree
+ * across members, and every operation on it reports the error:
+ * allgather callbacks and scon_get_tree return it as their status. */
+ORTE_DECLSPEC scon_handle_t scon_create(orte_grpcomm_signature_t *sig);
+
+/* Destroy an overlay. Posted receives are cancelled and any
+ * unmatched messages, including those that arrived before the
+ * overlay was created, are discarded */
+ORTE_DECLSPEC int scon_delete(scon_handle_t scon);
+
+/* Send a buffer to a member of the overlay. The message will be
+ * delivered to a receive posted on the same overlay and tag */
+ORTE_DECLSPEC int scon_send_nb(scon_handle_t scon,
+                               orte_process_name_t *peer,
+                               opal_buffer_t *buf,
+                               orte_rml_tag_t tag,
+                               scon_send_cbfunc_t cbfunc,
+                               void *cbdata);
+
+/* Post a receive on the overlay. Use ORTE_NAME_WILDCARD to
+ * receive from any member */
+ORTE_DECLSPEC int scon_recv_nb(scon_handle_t scon,
+                               orte_process_name_t *peer,
+                               orte_rml_tag_t tag,
+                               bool persistent,
+                               scon_recv_cbfunc_t cbfunc,
+                               void *cbdata);
+
+ORTE_DECLSPEC int scon_recv_cancel(scon_handle_t scon,
+                                   orte_process_name_t *peer,
+                                   orte_rml_tag_t tag);
+
+/* Broadcast a buffer to all members of the overlay, including
+ * ourselves. The caller retains ownership of the buffer. Members
+ * receive the message via a receive posted on the given tag, with
+ * the originator reported as the peer - also when the originator
+ * is not a member itself */
+ORTE_DECLSPEC int scon_xcast(scon_handle_t scon,
+                             orte_rml_tag_t tag,
+                             opal_buffer_t *buf);
+
+/* Gather a contribution from every member of the overlay and
+ * return the collected data to all of them. This is a non-blocking
+ * call - the callback is executed upon completion */
+ORTE_DECLSPEC int scon_allgather(scon_handle_t scon,
+                                 opal_buffer_t *buf,
+                                 scon_allgather_cbfunc_t cbfunc,
+                                 void *cbdata);
+
+/* Return our position in the overlay tree rooted at the member
+ * of rank zero: the number of members, our rank (-1 if not a
+ * member), our parent (ORTE_VPID_INVALID at the root), and a
+ * malloc'd array of our children that the caller must free.
+ * Must be called from within the ORTE event base */
+ORTE_DECLSPEC int scon_get_tree(scon_handle_t scon,
+                                size_t *nmembers, int *rank,
+                                orte_process_name_t *parent,
+                                orte_process_name_t **children,
+                                size_t *nchildren);
+
 END_C_DECLS
 
-#endif /* ORTED_H */
+#endif /* SCON_H */
@@ -9,15 +9,895 @@
 
 #include "orte_config.h"
 #include "orte/constants.h"
+#include "orte/types.h"
+
+#include <string.h>
+#include <stdlib.h>
+#include <limits.h>
+
+#include "opal/dss/dss.h"
+#include "opal/class/opal_list.h"
+#include "opal/class/opal_pointer_array.h"
+#include "opal/mca/base/mca_base_var.h"
+#include "opal/mca/event/event.h"
+#include "opal/sys/atomic.h"
+#include "opal/util/output.h"
+
+#include "orte/mca/errmgr/errmgr.h"
+#include "orte/util/name_fns.h"
+#include "orte/runtime/orte_globals.h"
 
 #include "mrnetscon.h"
 
+/* a registered filter */
+typedef struct {
+    opal_object_t super;
+    char *name;
+    mrnetscon_filter_fn_t fn;
+} mrnetscon_filter_t;
+static void fltcon(mrnetscon_filter_t *p)
+{
+    p->name = NULL;
+    p->fn = NULL;
+}
+static void fltdes(mrnetscon_filter_t *p)
+{
+    if (NULL != p->name) {
+        free(p->name);
+    }
+}
+static OBJ_CLASS_INSTANCE(mrnetscon_filter_t,
+                          opal_object_t,
+                          fltcon, fltdes);
+
+/* a reduction in progress at this node of the tree */
+typedef struct {
+    opal_list_item_t super;
+    uint32_t seq;
+    opal_buffer_t aggregate;
+    size_t nreported;
+    int status;
+    bool contributed;
+    mrnetscon_reduce_cbfunc_t cbfunc;
+    void *cbdata;
+} mrnetscon_wave_t;
+static void wvcon(mrnetscon_wave_t *p)
+{
+    OBJ_CONSTRUCT(&p->aggregate, opal_buffer_t);
+    p->nreported = 0;
+    p->status = ORTE_SUCCESS;
+    p->contributed = false;
+    p->cbfunc = NULL;
+    p->cbdata = NULL;
+}
+static void wvdes(mrnetscon_wave_t *p)
+{
+    OBJ_DESTRUCT(&p->aggregate);
+}
+static OBJ_CLASS_INSTANCE(mrnetscon_wave_t,
+                          opal_list_item_t,
+                          wvcon, wvdes);
+
+/* partial aggregate received for a stream we haven't created yet */
+typedef struct {
+    opal_list_item_t super;
+    mrnetscon_stream_t stream;
+    uint32_t seq;
+    opal_buffer_t data;
+} mrnetscon_early_t;
+static void elycon(mrnetscon_early_t *p)
+{
+    OBJ_CONSTRUCT(&p->data, opal_buffer_t);
+}
+static void elydes(mrnetscon_early_t *p)
+{
+    OBJ_DESTRUCT(&p->data);
+}
+static OBJ_CLASS_INSTANCE(mrnetscon_early_t,
+                          opal_list_item_t,
+                          elycon, elydes);
+
+typedef struct {
+    opal_object_t super;
+    mrnetscon_stream_t id;
+    scon_handle_t scon;
+    mrnetscon_filter_t *filter;
+    int rank;
+    orte_process_name_t parent;
+    size_t nchildren;
+    uint32_t seq;
+    opal_list_t waves;
+} mrnetscon_stream_obj_t;
+static void stcon(mrnetscon_stream_obj_t *p)
+{
+    p->id = MRNETSCON_STREAM_INVALID;
+    p->scon = SCON_HANDLE_INVALID;
+    p->filter = NULL;
+    p->rank = -1;
+    p->nchildren = 0;
+    p->seq = 0;
+    OBJ_CONSTRUCT(&p->waves, opal_list_t);
+}
+static void stdes(mrnetscon_stream_obj_t *p)
+{
+    OPAL_LIST_DESTRUCT(&p->waves);
+}
+static OBJ_CLASS_INSTANCE(mrnetscon_stream_obj_t,
+                          opal_object_t,
+                          stcon, stdes);
+
+/* object for shifting API requests into the event base */
+typedef struct {
+    opal_object_t super;
+    opal_event_t ev;
+    mrnetscon_stream_t stream;
+    scon_handle_t scon;
+    int filter;
+    opal_buffer_t *buf;
+    mrnetscon_reduce_cbfunc_t cbfunc;
+    void *cbdata;
+} mrnetscon_caddy_t;
+static void cdcon(mrnetscon_caddy_t *p)
+{
+    p->stream = MRNETSCON_STREAM_INVALID;
+    p->scon = SCON_HANDLE_INVALID;
+    p->filter = -1;
+    p->buf = NULL;
+    p->cbfunc = NULL;
+    p->cbdata = NULL;
+}
+static void cddes(mrnetscon_caddy_t *p)
+{
+    if (NULL != p->buf) {
+        OBJ_RELEASE(p->buf);
+    }
+}
+static OBJ_CLASS_INSTANCE(mrnetscon_caddy_t,
+                          opal_object_t,
+                          cdcon, cddes);
+
+#define MRNETSCON_THREADSHIFT(c, fn)                            \
+    do {                                                        \
+        opal_event_set(orte_event_base, &(c)->ev, -1,           \
+                       OPAL_EV_WRITE, (fn), (c));               \
+        opal_event_set_priority(&(c)->ev, ORTE_MSG_PRI);        \
+        opal_event_active(&(c)->ev, OPAL_EV_WRITE, 1);          \
+    } while(0);
+
+/* local variables */
+static bool initialized = false;
+static int mrnetscon_output = -1;
+static int mrnetscon_verbose = 0;
+static volatile int32_t next_stream = 0;
+static opal_pointer_array_t filters;
+static opal_pointer_array_t streams;
+static opal_list_t early_msgs;
+
+/* built-in filters */
+static int filter_sum(opal_buffer_t *aggregate, opal_buffer_t *contribution);
+static int filter_min(opal_buffer_t *aggregate, opal_buffer_t *contribution);
+static int filter_max(opal_buffer_t *aggregate, opal_buffer_t *contribution);
+static int filter_concat(opal_buffer_t *aggregate, opal_buffer_t *contribution);
+static int filter_histogram(opal_buffer_t *aggregate, opal_buffer_t *contribution);
+
+static void mrnetscon_recv(int status, scon_handle_t scon,
+                           orte_process_name_t *peer,
+                           opal_buffer_t *buf,
+                           orte_rml_tag_t tag,
+                           void *cbdata);
+
 int mrnetscon_init(void)
 {
+    int rc;
+
+    if (initialized) {
+        return ORTE_SUCCESS;
+    }
+    if (ORTE_SUCCESS != (rc = scon_init())) {
+        return rc;
+    }
+
+    mrnetscon_verbose = 0;
+    (void) mca_base_var_register("orte", "mrnetscon", "base", "verbose",
+                                 "Verbosity level of the MRNet SCON shim",
+                                 MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                                 OPAL_INFO_LVL_9, MCA_BASE_VAR_SCOPE_READONLY,
+                                 &mrnetscon_verbose);
+    if (0 < mrnetscon_verbose) {
+        mrnetscon_output = opal_output_open(NULL);
+        opal_output_set_verbosity(mrnetscon_output, mrnetscon_verbose);
+    }
+
+    OBJ_CONSTRUCT(&filters, opal_pointer_array_t);
+    opal_pointer_array_init(&filters, 8, INT_MAX, 8);
+    OBJ_CONSTRUCT(&streams, opal_pointer_array_t);
+    opal_pointer_array_init(&streams, 8, INT_MAX, 8);
+    OBJ_CONSTRUCT(&early_msgs, opal_list_t);
+    initialized = true;
+
+    /* register the built-in filters - their ids are fixed
+     * by the order of registration */
+    mrnetscon_register_filter("sum", filter_sum);
+    mrnetscon_register_filter("min", filter_min);
+    mrnetscon_register_filter("max", filter_max);
+    mrnetscon_register_filter("concat", filter_concat);
+    mrnetscon_register_filter("histogram", filter_histogram);
+
     return ORTE_SUCCESS;
 }
 
 void mrnetscon_finalize(void)
 {
-    return;
+    int i;
+    void *ptr;
+
+    if (!initialized) {
+        return;
+    }
+    for (i=0; i < streams.size; i++) {
+        if (NULL != (ptr = opal_pointer_array_get_item(&streams, i))) {
+            OBJ_RELEASE(ptr);
+        }
+    }
+    OBJ_DESTRUCT(&streams);
+    for (i=0; i < filters.size; i++) {
+        if (NULL != (ptr = opal_pointer_array_get_item(&filters, i))) {
+            OBJ_RELEASE(ptr);
+        }
+    }
+    OBJ_DESTRUCT(&filters);
+    OPAL_LIST_DESTRUCT(&early_msgs);
+    if (0 <= mrnetscon_output) {
+        opal_output_close(mrnetscon_output);
+        mrnetscon_output = -1;
+    }
+    initialized = false;
+}
+
+int mrnetscon_register_filter(const char *name,
+                              mrnetscon_filter_fn_t fn)
+{
+    mrnetscon_filter_t *flt;
+
+    if (!initialized) {
+        return ORTE_ERR_NOT_INITIALIZED;
+    }
+    if (NULL == name || NULL == fn) {
+        return ORTE_ERR_BAD_PARAM;
+    }
+    if (0 <= mrnetscon_lookup_filter(name)) {
+        return ORTE_ERR_BAD_PARAM;
+    }
+    flt = OBJ_NEW(mrnetscon_filter_t);
+    flt->name = strdup(name);
+    flt->fn = fn;
+    return opal_pointer_array_add(&filters, flt);
+}
+
+int mrnetscon_lookup_filter(const char *name)
+{
+    int i;
+    mrnetscon_filter_t *flt;
+
+    if (!initialized || NULL == name) {
+        return -1;
+    }
+    for (i=0; i < filters.size; i++) {
+        if (NULL != (flt = (mrnetscon_filter_t*)opal_pointer_array_get_item(&filters, i)) &&
+            0 == strcmp(flt->name, name)) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+/****    REDUCTION SUPPORT    ****/
+static mrnetscon_stream_obj_t* get_stream(mrnetscon_stream_t id)
+{
+    if (id < 0) {
+        return NULL;
+    }
+    return (mrnetscon_stream_obj_t*)opal_pointer_array_get_item(&streams, id);
+}
+
+static mrnetscon_wave_t* get_wave(mrnetscon_stream_obj_t *st, uint32_t seq)
+{
+    mrnetscon_wave_t *wave;
+
+    OPAL_LIST_FOREACH(wave, &st->waves, mrnetscon_wave_t) {
+        if (seq == wave->seq) {
+            return wave;
+        }
+    }
+    wave = OBJ_NEW(mrnetscon_wave_t);
+    wave->seq = seq;
+    opal_list_append(&st->waves, &wave->super);
+    return wave;
+}
+
+static void send_complete(int status, scon_handle_t scon,
+                          orte_process_name_t *peer,
+                          opal_buffer_t *buf,
+                          orte_rml_tag_t tag,
+                          void *cbdata)
+{
+    OBJ_RELEASE(buf);
+}
+
+static void check_wave(mrnetscon_stream_obj_t *st, mrnetscon_wave_t *wave)
+{
+    opal_buffer_t *msg;
+    int rc;
+
+    /* we need our own contribution plus one from each child */
+    if (!wave->contributed || wave->nreported < st->nchildren + 1) {
+        return;
+    }
+    opal_list_remove_item(&st->waves, &wave->super);
+
+    if (0 == st->rank) {
+        opal_output_verbose(2, mrnetscon_output,
+                            "%s mrnetscon:stream %d reduction %u complete",
+                            ORTE_NAME_PRINT(ORTE_PROC_MY_NAME),
+                            (int)st->id, wave->seq);
+        if (NULL != wave->cbfunc) {
+            wave->cbfunc(wave->status, st->id, &wave->aggregate, wave->cbdata);
+        }
+        OBJ_RELEASE(wave);
+        return;
+    }
+
+    /* pass our partial aggregate up the tree */
+    msg = OBJ_NEW(opal_buffer_t);
+    if (OPAL_SUCCESS != (rc = opal_dss.pack(msg, &st->id, 1, OPAL_INT32)) ||
+        OPAL_SUCCESS != (rc = opal_dss.pack(msg, &wave->seq, 1, OPAL_UINT32))) {
+        ORTE_ERROR_LOG(rc);
+        OBJ_RELEASE(msg);
+        wave->status = rc;
+    } else {
+        opal_dss.copy_payload(msg, &wave->aggregate);
+        opal_output_verbose(5, mrnetscon_output,
+                            "%s mrnetscon:stream %d forwarding reduction %u to %s",
+                            ORTE_NAME_PRINT(ORTE_PROC_MY_NAME), (int)st->id,
+                            wave->seq, ORTE_NAME_PRINT(&st->parent));
+        if (ORTE_SUCCESS != (rc = scon_send_nb(st->scon, &st->parent, msg,
+                                               MRNETSCON_TAG, send_complete, NULL))) {
+            ORTE_ERROR_LOG(rc);
+            OBJ_RELEASE(msg);
+            wave->status = rc;
+        }
+    }
+    if (NULL != wave->cbfunc) {
+        wave->cbfunc(wave->status, st->id, NULL, wave->cbdata);
+    }
+    OBJ_RELEASE(wave);
+}
+
+static void fold(mrnetscon_stream_obj_t *st, mrnetscon_wave_t *wave,
+                 opal_buffer_t *contribution)
+{
+    int rc;
+
+    if (ORTE_SUCCESS != (rc = st->filter->fn(&wave->aggregate, contribution))) {
+        opal_output(0, "%s mrnetscon:stream %d filter %s failed on reduction %u: %s",
+                    ORTE_NAME_PRINT(ORTE_PROC_MY_NAME), (int)st->id,
+                    st->filter->name, wave->seq, ORTE_ERROR_NAME(rc));
+        wave->status = rc;
+        /* filters only replace the aggregate on success, so
+         * rewind past whatever the failed attempt consumed */
+        wave->aggregate.unpack_ptr = wave->aggregate.base_ptr;
+    }
+    wave->nreported++;
+}
+
+static void process_partial(mrnetscon_stream_obj_t *st, uint32_t seq,
+                            opal_buffer_t *data)
+{
+    mrnetscon_wave_t *wave;
+
+    wave = get_wave(st, seq);
+    fold(st, wave, data);
+    check_wave(st, wave);
+}
+
+static void mrnetscon_recv(int status, scon_handle_t scon,
+                           orte_process_name_t *peer,
+                           opal_buffer_t *buf,
+                           orte_rml_tag_t tag,
+                           void *cbdata)
+{
+    mrnetscon_stream_t id;
+    uint32_t seq;
+    int32_t cnt;
+    int rc;
+    mrnetscon_stream_obj_t *st;
+    mrnetscon_early_t *ely;
+    opal_buffer_t data;
+
+    cnt = 1;
+    if (OPAL_SUCCESS != (rc = opal_dss.unpack(buf, &id, &cnt, OPAL_INT32))) {
+        ORTE_ERROR_LOG(rc);
+        return;
+    }
+    cnt = 1;
+    if (OPAL_SUCCESS != (rc = opal_dss.unpack(buf, &seq, &cnt, OPAL_UINT32))) {
+        ORTE_ERROR_LOG(rc);
+        return;
+    }
+    opal_output_verbose(5, mrnetscon_output,
+                        "%s mrnetscon:stream %d recvd reduction %u from %s",
+                        ORTE_NAME_PRINT(ORTE_PROC_MY_NAME), (int)id,
+                        seq, ORTE_NAME_PRINT(peer));
+
+    if (NULL == (st = get_stream(id))) {
+        /* the child created this stream before we did - hold
+         * the data until we catch up */
+        ely = OBJ_NEW(mrnetscon_early_t);
+        ely->stream = id;
+        ely->seq = seq;
+        opal_dss.copy_payload(&ely->data, buf);
+        opal_list_append(&early_msgs, &ely->super);
+        return;
+    }
+    OBJ_CONSTRUCT(&data, opal_buffer_t);
+    opal_dss.copy_payload(&data, buf);
+    process_partial(st, seq, &data);
+    OBJ_DESTRUCT(&data);
+}
+
+/****    API FUNCTIONS    ****/
+static bool scon_in_use(scon_handle_t scon, mrnetscon_stream_t skip)
+{
+    int i;
+    mrnetscon_stream_obj_t *st;
+
+    for (i=0; i < streams.size; i++) {
+        if (NULL != (st = (mrnetscon_stream_obj_t*)opal_pointer_array_get_item(&streams, i)) &&
+            st->id != skip && st->scon == scon) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static void create_stream(int sd, short args, void *cbdata)
+{
+    mrnetscon_caddy_t *cd = (mrnetscon_caddy_t*)cbdata;
+    mrnetscon_stream_obj_t *st;
+    mrnetscon_early_t *ely, *next;
+    orte_process_name_t *children;
+    size_t nmembers;
+    int rc;
+
+    st = OBJ_NEW(mrnetscon_stream_obj_t);
+    st->id = cd->stream;
+    st->scon = cd->scon;
+    st->filter = (mrnetscon_filter_t*)opal_pointer_array_get_item(&filters, cd->filter);
+    if (ORTE_SUCCESS != (rc = scon_get_tree(cd->scon, &nmembers, &st->rank,
+                                            &st->parent, &children,
+                                            &st->nchildren))) {
+        ORTE_ERROR_LOG(rc);
+        OBJ_RELEASE(st);
+        OBJ_RELEASE(cd);
+        return;
+    }
+    if (NULL != children) {
+        free(children);
+    }
+    opal_output_verbose(2, mrnetscon_output,
+                        "%s mrnetscon:stream %d created on scon %d filter %s rank %d children %d",
+                        ORTE_NAME_PRINT(ORTE_PROC_MY_NAME), (int)st->id,
+                        (int)st->scon, st->filter->name, st->rank,
+                        (int)st->nchildren);
+
+    /* the first stream on an overlay posts the receive
+     * for partial aggregates */
+    if (0 <= st->rank && !scon_in_use(st->scon, st->id)) {
+        scon_recv_nb(st->scon, ORTE_NAME_WILDCARD, MRNETSCON_TAG,
+                     ORTE_RML_PERSISTENT, mrnetscon_recv, NULL);
+    }
+    opal_pointer_array_set_item(&streams, st->id, st);
+
+    /* process any data that arrived before we got here */
+    OPAL_LIST_FOREACH_SAFE(ely, next, &early_msgs, mrnetscon_early_t) {
+        if (ely->stream == st->id) {
+            opal_list_remove_item(&early_msgs, &ely->super);
+            process_partial(st, ely->seq, &ely->data);
+            OBJ_RELEASE(ely);
+        }
+    }
+    OBJ_RELEASE(cd);
+}
+
+mrnetscon_stream_t mrnetscon_stream_create(scon_handle_t scon,
+                                           int filter)
+{
+    mrnetscon_caddy_t *cd;
+
+    if (!initialized || SCON_HANDLE_INVALID == scon ||
+        NULL == opal_pointer_array_get_item(&filters, filter)) {
+        return MRNETSCON_STREAM_INVALID;
+    }
+    cd = OBJ_NEW(mrnetscon_caddy_t);
+    cd->stream = opal_atomic_add_32(&next_stream, 1) - 1;
+    cd->scon = scon;
+    cd->filter = filter;
+    MRNETSCON_THREADSHIFT(cd, create_stream);
+    return cd->stream;
+}
+
+static void delete_stream(int sd, short args, void *cbdata)
+{
+    mrnetscon_caddy_t *cd = (mrnetscon_caddy_t*)cbdata;
+    mrnetscon_stream_obj_t *st;
+
+    if (NULL != (st = get_stream(cd->stream))) {
+        if (0 <= st->rank && !scon_in_use(st->scon, st->id)) {
+            scon_recv_cancel(st->scon, ORTE_NAME_WILDCARD, MRNETSCON_TAG);
+        }
+        opal_pointer_array_set_item(&streams, cd->stream, NULL);
+        OBJ_RELEASE(st);
+    }
+    OBJ_RELEASE(cd);
+}
+
+int mrnetscon_stream_delete(mrnetscon_stream_t stream)
+{
+    mrnetscon_caddy_t *cd;
+
+    if (!initialized) {
+        return ORTE_ERR_NOT_INITIALIZED;
+    }
+    cd = OBJ_NEW(mrnetscon_caddy_t);
+    cd->stream = stream;
+    MRNETSCON_THREADSHIFT(cd, delete_stream);
+    return ORTE_SUCCESS;
+}
+
+static void start_reduce(int sd, short args, void *cbdata)
+{
+    mrnetscon_caddy_t *cd = (mrnetscon_caddy_t*)cbdata;
+    mrnetscon_stream_obj_t *st;
+    mrnetscon_wave_t *wave;
+
+    if (NULL == (st = get_stream(cd->stream)) || st->rank < 0) {
+        /* only members can contribute */
+        if (NULL != cd->cbfunc) {
+            cd->cbfunc(ORTE_ERR_NOT_FOUND, cd->stream, NULL, cd->cbdata);
+        }
+        OBJ_RELEASE(cd);
+        return;
+    }
+    wave = get_wave(st, st->seq++);
+    wave->contributed = true;
+    wave->cbfunc = cd->cbfunc;
+    wave->cbdata = cd->cbdata;
+    fold(st, wave, cd->buf);
+    check_wave(st, wave);
+    OBJ_RELEASE(cd);
+}
+
+int mrnetscon_reduce(mrnetscon_stream_t stream,
+                     opal_buffer_t *contribution,
+                     mrnetscon_reduce_cbfunc_t cbfunc,
+                     void *cbdata)
+{
+    mrnetscon_caddy_t *cd;
+
+    if (!initialized) {
+        return ORTE_ERR_NOT_INITIALIZED;
+    }
+    cd = OBJ_NEW(mrnetscon_caddy_t);
+    cd->stream = stream;
+    cd->buf = OBJ_NEW(opal_buffer_t);
+    opal_dss.copy_payload(cd->buf, contribution);
+    cd->cbfunc = cbfunc;
+    cd->cbdata = cbdata;
+    MRNETSCON_THREADSHIFT(cd, start_reduce);
+    return ORTE_SUCCESS;
+}
+
+/****    DATA HELPERS    ****/
+static size_t type_size(opal_data_type_t type)
+{
+    switch (type) {
+    case OPAL_INT32:
+    case OPAL_UINT32:
+        return sizeof(int32_t);
+    case OPAL_INT64:
+    case OPAL_UINT64:
+        return sizeof(int64_t);
+    case OPAL_DOUBLE:
+        return sizeof(double);
+    default:
+        return 0;
+    }
+}
+
+int mrnetscon_pack_array(opal_buffer_t *buf,
+                         opal_data_type_t type,
+                         void *values, int32_t nvalues)
+{
+    int rc;
+
+    if (0 == type_size(type) || nvalues < 0) {
+        return ORTE_ERR_BAD_PARAM;
+    }
+    if (OPAL_SUCCESS != (rc = opal_dss.pack(buf, &type, 1, OPAL_DATA_TYPE)) ||
+        OPAL_SUCCESS != (rc = opal_dss.pack(buf, &nvalues, 1, OPAL_INT32))) {
+        return rc;
+    }
+    if (0 < nvalues) {
+        rc = opal_dss.pack(buf, values, nvalues, type);
+    }
+    return rc;
+}
+
+int mrnetscon_unpack_array(opal_buffer_t *buf,
+                           opal_data_type_t *type,
+                           void **values, int32_t *nvalues)
+{
+    int32_t cnt;
+    int rc;
+    size_t sz;
+
+    *values = NULL;
+    cnt = 1;
+    if (OPAL_SUCCESS != (rc = opal_dss.unpack(buf, type, &cnt, OPAL_DATA_TYPE))) {
+        return rc;
+    }
+    cnt = 1;
+    if (OPAL_SUCCESS != (rc = opal_dss.unpack(buf, nvalues, &cnt, OPAL_INT32))) {
+        return rc;
+    }
+    if (0 == (sz = type_size(*type)) || *nvalues < 0) {
+        return ORTE_ERR_UNPACK_FAILURE;
+    }
+    if (0 == *nvalues) {
+        return ORTE_SUCCESS;
+    }
+    *values = malloc(*nvalues * sz);
+    cnt = *nvalues;
+    if (OPAL_SUCCESS != (rc = opal_dss.unpack(buf, *values, &cnt, *type))) {
+        free(*values);
+        *values = NULL;
+    }
+    return rc;
+}
+
+int mrnetscon_pack_histogram(opal_buffer_t *buf,
+                             double lo, double hi,
+                             int32_t nbins,
+                             double *values, int32_t nvalues)
+{
+    uint64_t *counts;
+    int32_t i, bin;
+    int rc;
+
+    if (nbins <= 0 || hi <= lo) {
+        return ORTE_ERR_BAD_PARAM;
+    }
+    counts = (uint64_t*)calloc(nbins, sizeof(uint64_t));
+    for (i=0; i < nvalues; i++) {
+        if (values[i] < lo) {
+            bin = 0;
+        } else if (values[i] >= hi) {
+            bin = nbins - 1;
+        } else {
+            bin = (int32_t)((values[i] - lo) / (hi - lo) * nbins);
+            if (nbins <= bin) {
+                bin = nbins - 1;
+            }
+        }
+        counts[bin]++;
+    }
+    if (OPAL_SUCCESS != (rc = opal_dss.pack(buf, &nbins, 1, OPAL_INT32)) ||
+        OPAL_SUCCESS != (rc = opal_dss.pack(buf, &lo, 1, OPAL_DOUBLE)) ||
+        OPAL_SUCCESS != (rc = opal_dss.pack(buf, &hi, 1, OPAL_DOUBLE)) ||
+        OPAL_SUCCESS != (rc = opal_dss.pack(buf, counts, nbins, OPAL_UINT64))) {
+        ORTE_ERROR_LOG(rc);
+    }
+    free(counts);
+    return rc;
+}
+
+int mrnetscon_unpack_histogram(opal_buffer_t *buf,
+                               double *lo, double *hi,
+                               int32_t *nbins,
+                               uint64_t **counts)
+{
+    int32_t cnt;
+    int rc;
+
+    *counts = NULL;
+    cnt = 1;
+    if (OPAL_SUCCESS != (rc = opal_dss.unpack(buf, nbins, &cnt, OPAL_INT32))) {
+        return rc;
+    }
+    cnt = 1;
+    if (OPAL_SUCCESS != (rc = opal_dss.unpack(buf, lo, &cnt, OPAL_DOUBLE))) {
+        return rc;
+    }
+    cnt = 1;
+    if (OPAL_SUCCESS != (rc = opal_dss.unpack(buf, hi, &cnt, OPAL_DOUBLE))) {
+        return rc;
+    }
+    if (*nbins <= 0) {
+        return ORTE_ERR_UNPACK_FAILURE;
+    }
+    *counts = (uint64_t*)malloc(*nbins * sizeof(uint64_t));
+    cnt = *nbins;
+    if (OPAL_SUCCESS != (rc = opal_dss.unpack(buf, *counts, &cnt, OPAL_UINT64))) {
+        free(*counts);
+        *counts = NULL;
+    }
+    return rc;
+}
+
+/* replace the contents of the aggregate with those of the given buffer */
+static void reload(opal_buffer_t *aggregate, opal_buffer_t *src)
+{
+    void *payload;
+    int32_t sz;
+
+    opal_dss.unload(src, &payload, &sz);
+    opal_dss.load(aggregate, payload, sz);
+}
+
+/****    BUILT-IN FILTERS    ****/
+#define MRNETSCON_SUM(a, b)     (a) += (b)
+#define MRNETSCON_MIN(a, b)     if ((b) < (a)) (a) = (b)
+#define MRNETSCON_MAX(a, b)     if ((b) > (a)) (a) = (b)
+
+#define MRNETSCON_COMBINE(t, op, acc, in, n)                    \
+    do {                                                        \
+        t *_a = (t*)(acc);                                      \
+        t *_b = (t*)(in);                                       \
+        int32_t _i;                                             \
+        for (_i=0; _i < (n); _i++) {                            \
+            op(_a[_i], _b[_i]);                                 \
+        }                                                       \
+    } while(0)
+
+#define MRNETSCON_COMBINE_ALL(type, op, acc, in, n)             \
+    do {                                                        \
+        switch (type) {                                         \
+        case OPAL_INT32:                                        \
+            MRNETSCON_COMBINE(int32_t, op, acc, in, n);         \
+            break;                                              \
+        case OPAL_UINT32:                                       \
+            MRNETSCON_COMBINE(uint32_t, op, acc, in, n);        \
+            break;                                              \
+        case OPAL_INT64:                                        \
+            MRNETSCON_COMBINE(int64_t, op, acc, in, n);         \
+            break;                                              \
+        case OPAL_UINT64:                                       \
+            MRNETSCON_COMBINE(uint64_t, op, acc, in, n);        \
+            break;                                              \
+        case OPAL_DOUBLE:                                       \
+            MRNETSCON_COMBINE(double, op, acc, in, n);          \
+            break;                                              \
+        }                                                       \
+    } while(0)
+
+#define MRNETSCON_SUM_OP    0
+#define MRNETSCON_MIN_OP    1
+#define MRNETSCON_MAX_OP    2
+
+static int combine_arrays(opal_buffer_t *aggregate,
+                          opal_buffer_t *contribution,
+                          int op)
+{
+    opal_data_type_t atype, ctype;
+    void *avals, *cvals;
+    int32_t acnt, ccnt;
+    opal_buffer_t result;
+    int rc;
+
+    /* the first contribution simply becomes the aggregate */
+    if (0 == aggregate->bytes_used) {
+        opal_dss.copy_payload(aggregate, contribution);
+        return ORTE_SUCCESS;
+    }
+    if (ORTE_SUCCESS != (rc = mrnetscon_unpack_array(aggregate, &atype, &avals, &acnt))) {
+        return rc;
+    }
+    if (ORTE_SUCCESS != (rc = mrnetscon_unpack_array(contribution, &ctype, &cvals, &ccnt))) {
+        if (NULL != avals) {
+            free(avals);
+        }
+        return rc;
+    }
+    if (atype != ctype || acnt != ccnt) {
+        rc = ORTE_ERR_TYPE_MISMATCH;
+        goto cleanup;
+    }
+    switch (op) {
+    case MRNETSCON_SUM_OP:
+        MRNETSCON_COMBINE_ALL(atype, MRNETSCON_SUM, avals, cvals, acnt);
+        break;
+    case MRNETSCON_MIN_OP:
+        MRNETSCON_COMBINE_ALL(atype, MRNETSCON_MIN, avals, cvals, acnt);
+        break;
+    case MRNETSCON_MAX_OP:
+        MRNETSCON_COMBINE_ALL(atype, MRNETSCON_MAX, avals, cvals, acnt);
+        break;
+    }
+    OBJ_CONSTRUCT(&result, opal_buffer_t);
+    if (ORTE_SUCCESS == (rc = mrnetscon_pack_array(&result, atype, avals, acnt))) {
+        reload(aggregate, &result);
+    }
+    OBJ_DESTRUCT(&result);
+
+  cleanup:
+    if (NULL != avals) {
+        free(avals);
+    }
+    if (NULL != cvals) {
+        free(cvals);
+    }
+    return rc;
+}
+
+static int filter_sum(opal_buffer_t *aggregate, opal_buffer_t *contribution)
+{
+    return combine_arrays(aggregate, contribution, MRNETSCON_SUM_OP);
+}
+
+static int filter_min(opal_buffer_t *aggregate, opal_buffer_t *contribution)
+{
+    return combine_arrays(aggregate, contribution, MRNETSCON_MIN_OP);
+}
+
+static int filter_max(opal_buffer_t *aggregate, opal_buffer_t *contribution)
+{
+    return combine_arrays(aggregate, contribution, MRNETSCON_MAX_OP);
+}
+
+static int filter_concat(opal_buffer_t *aggregate, opal_buffer_t *contribution)
+{
+    return opal_dss.copy_payload(aggregate, contribution);
+}
+
+static int filter_histogram(opal_buffer_t *aggregate, opal_buffer_t *contribution)
+{
+    double alo, ahi, clo, chi;
+    int32_t anbins, cnbins, i;
+    uint64_t *acounts, *ccounts;
+    opal_buffer_t result;
+    int rc;
+
+    if (0 == aggregate->bytes_used) {
+        opal_dss.copy_payload(aggregate, contribution);
+        return ORTE_SUCCESS;
+    }
+    if (ORTE_SUCCESS != (rc = mrnetscon_unpack_histogram(aggregate, &alo, &ahi,
+                                                         &anbins, &acounts))) {
+        return rc;
+    }
+    if (ORTE_SUCCESS != (rc = mrnetscon_unpack_histogram(contribution, &clo, &chi,
+                                                         &cnbins, &ccounts))) {
+        free(acounts);
+        return rc;
+    }
+    if (anbins != cnbins || alo != clo || ahi != chi) {
+        rc = ORTE_ERR_TYPE_MISMATCH;
+        goto cleanup;
+    }
+    for (i=0; i < anbins; i++) {
+        acounts[i] += ccounts[i];
+    }
+    OBJ_CONSTRUCT(&result, opal_buffer_t);
+    if (OPAL_SUCCESS == (rc = opal_dss.pack(&result, &anbins, 1, OPAL_INT32)) &&
+        OPAL_SUCCESS == (rc = opal_dss.pack(&result, &alo, 1, OPAL_DOUBLE)) &&
+        OPAL_SUCCESS == (rc = opal_dss.pack(&result, &ahi, 1, OPAL_DOUBLE)) &&
+        OPAL_SUCCESS == (rc = opal_dss.pack(&result, acounts, anbins, OPAL_UINT64))) {
+        reload(aggregate, &result);
+    }
+    OBJ_DESTRUCT(&result);
+
+  cleanup:
+    free(acounts);
+    free(ccounts);
+    return rc;
 }
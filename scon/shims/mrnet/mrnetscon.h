@@ -1,11 +1,27 @@
 /*
  * Copyright (c) 2014      Intel, Inc. All rights reserved.
  * $COPYRIGHT$
- * 
+ *
  * Additional copyrights may follow
- * 
+ *
  * $HEADER$
  */
+/** @file:
+ *
+ * MRNet-style reductions over a SCON
+ *
+ * A stream binds a reduction filter to an overlay. Each member of the
+ * overlay contributes one buffer per reduction; every internal member
+ * of the overlay tree runs the filter over the contributions of its
+ * children and its own, and forwards a single aggregate to its parent.
+ * The root (rank zero of the overlay - the HNP for an overlay spanning
+ * the DVM) thus receives one message per reduction, and the cost of
+ * a reduction grows with the depth of the tree rather than the number
+ * of members.
+ *
+ * As with overlays, all members must create their streams in the
+ * same order.
+ */
 
 #ifndef MRNETSCON_H
 #define MRNETSCON_H
@@ -21,13 +37,98 @@
 #include "opal/class/opal_pointer_array.h"
 #include "orte/mca/rml/rml_types.h"
 
+#include "scon/scon.h"
+
 BEGIN_C_DECLS
 
+/* overlay tag reserved for the shim's traffic - overlay tags
+ * are private to the overlay, so this only needs to stay clear
+ * of the tags used by the application itself */
+#define MRNETSCON_TAG       0x7ffffffe
+
+typedef int32_t mrnetscon_stream_t;
+#define MRNETSCON_STREAM_INVALID    -1
+
+/* A filter folds one contribution into the running aggregate
+ * held by a tree node. The aggregate is empty when the first
+ * contribution arrives. Filters are executed in the ORTE event
+ * base and must not block */
+typedef int (*mrnetscon_filter_fn_t)(opal_buffer_t *aggregate,
+                                     opal_buffer_t *contribution);
+
+/* Built-in filters - always registered, in this order */
+#define MRNETSCON_FILTER_SUM         0
+#define MRNETSCON_FILTER_MIN         1
+#define MRNETSCON_FILTER_MAX         2
+#define MRNETSCON_FILTER_CONCAT      3
+#define MRNETSCON_FILTER_HISTOGRAM   4
+
+/* callback for completion of a reduction. Only the root
+ * receives the aggregate - all other members are called
+ * with a NULL buffer once their contribution has been
+ * passed up the tree. The aggregate belongs to the library
+ * and will be released upon return. Contributions are folded
+ * in the order they arrive, so filters such as concat do not
+ * preserve rank order */
+typedef void (*mrnetscon_reduce_cbfunc_t)(int status,
+                                          mrnetscon_stream_t stream,
+                                          opal_buffer_t *result,
+                                          void *cbdata);
+
 /* Initialize the MRNETSCON library */
 ORTE_DECLSPEC int mrnetscon_init(void);
 
 ORTE_DECLSPEC void mrnetscon_finalize(void);
 
+/* Register a filter under the given name, returning its id. A
+ * filter must be registered with the same id on every member */
+ORTE_DECLSPEC int mrnetscon_register_filter(const char *name,
+                                            mrnetscon_filter_fn_t fn);
+
+/* Return the id of a registered filter, or -1 if not found */
+ORTE_DECLSPEC int mrnetscon_lookup_filter(const char *name);
+
+/* Bind a filter to an overlay */
+ORTE_DECLSPEC mrnetscon_stream_t mrnetscon_stream_create(scon_handle_t scon,
+                                                         int filter);
+
+ORTE_DECLSPEC int mrnetscon_stream_delete(mrnetscon_stream_t stream);
+
+/* Contribute to the next reduction on the stream. The caller
+ * retains ownership of the buffer */
+ORTE_DECLSPEC int mrnetscon_reduce(mrnetscon_stream_t stream,
+                                   opal_buffer_t *contribution,
+                                   mrnetscon_reduce_cbfunc_t cbfunc,
+                                   void *cbdata);
+
+/* Pack an array of values for the sum, min and max filters.
+ * Supported types are OPAL_INT32, OPAL_UINT32, OPAL_INT64,
+ * OPAL_UINT64 and OPAL_DOUBLE */
+ORTE_DECLSPEC int mrnetscon_pack_array(opal_buffer_t *buf,
+                                       opal_data_type_t type,
+                                       void *values, int32_t nvalues);
+
+/* Unpack an array produced by the sum, min or max filters. The
+ * values array is malloc'd and must be released by the caller */
+ORTE_DECLSPEC int mrnetscon_unpack_array(opal_buffer_t *buf,
+                                         opal_data_type_t *type,
+                                         void **values, int32_t *nvalues);
+
+/* Bin the given values into a histogram of nbins equal-width
+ * bins spanning [lo, hi) and pack it for the histogram filter.
+ * Values outside the range are counted in the first/last bin */
+ORTE_DECLSPEC int mrnetscon_pack_histogram(opal_buffer_t *buf,
+                                           double lo, double hi,
+                                           int32_t nbins,
+                                           double *values, int32_t nvalues);
+
+/* Unpack a histogram. The counts array is malloc'd and must
+ * be released by the caller */
+ORTE_DECLSPEC int mrnetscon_unpack_histogram(opal_buffer_t *buf,
+                                             double *lo, double *hi,
+                                             int32_t *nbins,
+                                             uint64_t **counts);
+
 END_C_DECLS
 
 #endif /* MRNETSCON_H */
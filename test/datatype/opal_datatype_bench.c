@@ -0,0 +1,216 @@
+/* -*- Mode: C; c-basic-offset:4 ; -*- */
+/*
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+/*
+ * Measure the pack and unpack bandwidth of strided layouts, for each
+ * set of strided copy kernels this processor can run, next to a plain
+ * memcpy per block. Each layout is a number of equally sized blocks at a
+ * constant stride, described either as a vector or as a contiguous type
+ * resized to leave a gap after it. What gets packed and unpacked is
+ * checked against a copy made one block at a time.
+ *
+ *   opal_datatype_bench [packed KB] [iterations]
+ */
+
+#include "opal_config.h"
+#include "opal_ddt_lib.h"
+#include "opal/runtime/opal.h"
+#include "opal/datatype/opal_datatype.h"
+#include "opal/datatype/opal_datatype_internal.h"
+#include "opal/datatype/opal_datatype_strided.h"
+#include "opal/datatype/opal_convertor.h"
+#include <stdlib.h>
+#ifdef HAVE_SYS_TIME_H
+#include <sys/time.h>
+#endif
+#include <stdio.h>
+#include <string.h>
+
+#define TIMER_DATA_TYPE struct timeval
+#define GET_TIME(TV)   gettimeofday( &(TV), NULL )
+#define ELAPSED_TIME(TSTART, TEND)  (((TEND).tv_sec - (TSTART).tv_sec) * 1000000 + ((TEND).tv_usec - (TSTART).tv_usec))
+
+typedef struct {
+    const char* name;
+    const opal_datatype_t* base;
+    int blength;   /* elements per block */
+    int stride;    /* elements from one block to the next */
+    int resized;   /* a resized contiguous type instead of a vector */
+} pattern_t;
+
+static const pattern_t patterns[] = {
+    { "int4 vector 1/2",      &opal_datatype_int4,   1,  2, 0 },
+    { "int4 vector 1/16",     &opal_datatype_int4,   1, 16, 0 },
+    { "float8 vector 1/2",    &opal_datatype_float8, 1,  2, 0 },
+    { "float8 vector 1/8",    &opal_datatype_float8, 1,  8, 0 },
+    { "float8 vector 2/4",    &opal_datatype_float8, 2,  4, 0 },
+    { "float8 vector 4/8",    &opal_datatype_float8, 4,  8, 0 },
+    { "int4 vector 3/4",      &opal_datatype_int4,   3,  4, 0 },
+    { "float8 resized 1/3",   &opal_datatype_float8, 1,  3, 1 },
+    { "float8 resized 2/3",   &opal_datatype_float8, 2,  3, 1 },
+    { "float8 resized 4/5",   &opal_datatype_float8, 4,  5, 1 },
+};
+
+static opal_datatype_t* create_pattern( const pattern_t* p, size_t nblocks, int* count )
+{
+    opal_datatype_t *pdt;
+
+    if( !p->resized ) {
+        *count = 1;
+        return create_vector_type( p->base, (int)nblocks, p->blength, p->stride );
+    }
+    *count = (int)nblocks;
+    opal_datatype_create_contiguous( p->blength, p->base, &pdt );
+    opal_datatype_resize( pdt, 0, p->stride * p->base->size );
+    opal_datatype_commit( pdt );
+    return pdt;
+}
+
+/* what the datatype engine is expected to do, one block at a time */
+static void copy_blocks( unsigned char* dst, OPAL_PTRDIFF_TYPE dst_stride,
+                         const unsigned char* src, OPAL_PTRDIFF_TYPE src_stride,
+                         size_t blength, size_t nblocks )
+{
+    for( ; nblocks > 0; nblocks-- ) {
+        memcpy( dst, src, blength );
+        dst += dst_stride;
+        src += src_stride;
+    }
+}
+
+static int run_convertor( opal_datatype_t* pdt, int count, void* user, void* packed,
+                          size_t length, int pack )
+{
+    opal_convertor_t* conv;
+    struct iovec iov;
+    uint32_t iov_count = 1;
+    size_t max_data = length;
+    int rc;
+
+    conv = opal_convertor_create( opal_local_arch, 0 );
+    if( pack ) {
+        rc = opal_convertor_prepare_for_send( conv, pdt, count, user );
+    } else {
+        rc = opal_convertor_prepare_for_recv( conv, pdt, count, user );
+    }
+    if( OPAL_SUCCESS == rc ) {
+        iov.iov_base = packed;
+        iov.iov_len = length;
+        if( pack ) {
+            opal_convertor_pack( conv, &iov, &iov_count, &max_data );
+        } else {
+            opal_convertor_unpack( conv, &iov, &iov_count, &max_data );
+        }
+        rc = (max_data == length) ? OPAL_SUCCESS : OPAL_ERROR;
+    }
+    OBJ_RELEASE( conv );
+    return rc;
+}
+
+int main( int argc, char* argv[] )
+{
+    const char* kernels[2];
+    size_t packed_size = 1024 * 1024, nblocks, blength, extent, i;
+    unsigned char *user, *check, *packed, *expected, *scattered;
+    opal_datatype_t* pdt;
+    TIMER_DATA_TYPE start, end;
+    double t_pack, t_unpack;
+    int iters = 50, count, k, n, errors = 0;
+
+    if( 1 < argc ) {
+        packed_size = strtoul( argv[1], NULL, 10 ) * 1024;
+    }
+    if( 2 < argc ) {
+        iters = atoi( argv[2] );
+    }
+
+    opal_datatype_init();
+
+    kernels[0] = opal_datatype_strided_select( false );
+    kernels[1] = opal_datatype_strided_select( true );
+
+    printf( "%-20s %6s %6s %9s", "pattern", "block", "stride", "memcpy" );
+    for( k = 0; k < 2; k++ ) {
+        printf( " %8s p/u", kernels[k] );
+    }
+    printf( "   (GB/s)\n" );
+
+    for( n = 0; n < (int)(sizeof(patterns) / sizeof(patterns[0])); n++ ) {
+        const pattern_t* p = &patterns[n];
+
+        blength = p->blength * p->base->size;
+        extent = p->stride * p->base->size;
+        nblocks = packed_size / blength;
+        user = (unsigned char*)malloc( nblocks * extent );
+        check = (unsigned char*)malloc( nblocks * extent );
+        packed = (unsigned char*)malloc( nblocks * blength );
+        expected = (unsigned char*)malloc( nblocks * blength );
+        scattered = (unsigned char*)calloc( nblocks, extent );
+        for( i = 0; i < nblocks * extent; i++ ) {
+            user[i] = (unsigned char)(i * 7 + 1);
+        }
+        copy_blocks( expected, blength, user, extent, blength, nblocks );
+        copy_blocks( scattered, extent, expected, blength, blength, nblocks );
+        pdt = create_pattern( p, nblocks, &count );
+
+        printf( "%-20s %6lu %6lu", p->name, (unsigned long)blength, (unsigned long)extent );
+
+        /* a memcpy per block, as the engine did before */
+        GET_TIME( start );
+        for( i = 0; i < (size_t)iters; i++ ) {
+            copy_blocks( packed, blength, user, extent, blength, nblocks );
+        }
+        GET_TIME( end );
+        printf( " %9.2f", (double)nblocks * blength * iters / ELAPSED_TIME(start, end) / 1000.0 );
+
+        for( k = 0; k < 2; k++ ) {
+            opal_datatype_strided_select( 0 != k );
+
+            /* check before timing */
+            memset( packed, 0, nblocks * blength );
+            memset( check, 0, nblocks * extent );
+            if( OPAL_SUCCESS != run_convertor( pdt, count, user, packed, nblocks * blength, 1 ) ||
+                0 != memcmp( packed, expected, nblocks * blength ) ) {
+                printf( "\n%s: %s pack is wrong\n", p->name, kernels[k] );
+                errors++;
+            }
+            if( OPAL_SUCCESS != run_convertor( pdt, count, check, packed, nblocks * blength, 0 ) ||
+                0 != memcmp( check, scattered, nblocks * extent ) ) {
+                printf( "\n%s: %s unpack is wrong\n", p->name, kernels[k] );
+                errors++;
+            }
+
+            GET_TIME( start );
+            for( i = 0; i < (size_t)iters; i++ ) {
+                run_convertor( pdt, count, user, packed, nblocks * blength, 1 );
+            }
+            GET_TIME( end );
+            t_pack = ELAPSED_TIME( start, end );
+            GET_TIME( start );
+            for( i = 0; i < (size_t)iters; i++ ) {
+                run_convertor( pdt, count, check, packed, nblocks * blength, 0 );
+            }
+            GET_TIME( end );
+            t_unpack = ELAPSED_TIME( start, end );
+            printf( " %6.2f/%-6.2f", (double)nblocks * blength * iters / t_pack / 1000.0,
+                    (double)nblocks * blength * iters / t_unpack / 1000.0 );
+        }
+        printf( "\n" );
+
+        OBJ_RELEASE( pdt );
+        free( user );
+        free( check );
+        free( packed );
+        free( expected );
+        free( scattered );
+    }
+
+    opal_datatype_finalize();
+    return (0 == errors) ? 0 : 1;
+}
@@ -32,6 +32,7 @@
 
 #include "opal/runtime/opal.h"
 #include "opal/dss/dss.h"
+#include "opal/util/proc.h"
 
 #define NUM_ITERS 100
 #define NUM_ELEMS 1024
@@ -48,6 +49,9 @@ static bool test9(void);        /* verify composite (multiple types and element
 static bool test10(void);        /* verify KEYVAL */
 static bool test11(void);        /* verify int32_t */
 static bool test12(void);        /* verify pid_t */
+static bool test13(void);        /* verify NAME */
+static bool test14(void);        /* verify compact buffers */
+static bool test15(void);        /* verify buffer pool and leases */
 
 static FILE *test_out;
 
@@ -158,6 +162,30 @@ int main (int argc, char* argv[])
       ret = 12;
     }
 
+    fprintf(test_out, "executing test13\n");
+    if (test13()) {
+        fprintf(test_out, "Test13 succeeded\n");
+    } else {
+      fprintf(test_out, "opal_dss test13 failed\n");
+      ret = 13;
+    }
+
+    fprintf(test_out, "executing test14\n");
+    if (test14()) {
+        fprintf(test_out, "Test14 succeeded\n");
+    } else {
+      fprintf(test_out, "opal_dss test14 failed\n");
+      ret = 14;
+    }
+
+    fprintf(test_out, "executing test15\n");
+    if (test15()) {
+        fprintf(test_out, "Test15 succeeded\n");
+    } else {
+      fprintf(test_out, "opal_dss test15 failed\n");
+      ret = 15;
+    }
+
     fclose(test_out);
 
     opal_finalize();
@@ -975,3 +1003,331 @@ static bool test12(void)
 
     return (true);
 }
+
+/*
+ * OPAL_NAME pack/unpack - every count up to NUM_ITERS, at odd
+ * offsets in the buffer, in both buffer types
+ */
+static bool test13(void)
+{
+    opal_buffer_t *bufA;
+    int rc;
+    int32_t i, j, k;
+    uint8_t pad = 0x5a;
+    opal_process_name_t src[NUM_ITERS];
+    opal_process_name_t dst[NUM_ITERS];
+    const unsigned char wire[] = { 0, 0, 0, 1, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08 };
+
+    for(i=0; i<NUM_ITERS; i++) {
+        src[i].jobid = 0x01020304 + i;
+        src[i].vpid = 0x05060708 + i;
+    }
+
+    /* the count, the jobids, then the vpids - all in network byte order */
+    bufA = OBJ_NEW(opal_buffer_t);
+    bufA->type = OPAL_DSS_BUFFER_NON_DESC;
+    rc = opal_dss.pack(bufA, src, 1, OPAL_NAME);
+    if (OPAL_SUCCESS != rc || sizeof(wire) != bufA->bytes_used ||
+        0 != memcmp(bufA->base_ptr, wire, sizeof(wire))) {
+        fprintf(test_out, "test13: name not packed in network byte order\n");
+        return(false);
+    }
+    OBJ_RELEASE(bufA);
+
+    for (k=0; k<2; k++) {
+        bufA = OBJ_NEW(opal_buffer_t);
+        if (NULL == bufA) {
+            fprintf(test_out, "orte_buffer failed init in OBJ_NEW\n");
+            return false;
+        }
+        bufA->type = (0 == k) ? OPAL_DSS_BUFFER_NON_DESC : OPAL_DSS_BUFFER_FULLY_DESC;
+
+        for (i=1; i<=NUM_ITERS; i++) {
+            rc = opal_dss.pack(bufA, &pad, 1, OPAL_UINT8);
+            if (OPAL_SUCCESS == rc) {
+                rc = opal_dss.pack(bufA, src, i, OPAL_NAME);
+            }
+            if (OPAL_SUCCESS != rc) {
+                fprintf(test_out, "opal_dss.pack failed with return code %d\n", rc);
+                return(false);
+            }
+        }
+
+        for (i=1; i<=NUM_ITERS; i++) {
+            int32_t count = 1;
+
+            rc = opal_dss.unpack(bufA, &pad, &count, OPAL_UINT8);
+            if (OPAL_SUCCESS != rc || 0x5a != pad) {
+                fprintf(test_out, "opal_dss.unpack failed with return code %d\n", rc);
+                return(false);
+            }
+            memset(dst, 0, sizeof(dst));
+            count = i;
+            rc = opal_dss.unpack(bufA, dst, &count, OPAL_NAME);
+            if (OPAL_SUCCESS != rc || count != i) {
+                fprintf(test_out, "opal_dss.unpack failed with return code %d\n", rc);
+                return(false);
+            }
+            for(j=0; j<i; j++) {
+                if (src[j].jobid != dst[j].jobid || src[j].vpid != dst[j].vpid) {
+                    fprintf(test_out, "test13: invalid results from unpack\n");
+                    return(false);
+                }
+            }
+        }
+
+        OBJ_RELEASE(bufA);
+        if (NULL != bufA) {
+            fprintf(test_out, "OBJ_RELEASE did not NULL the buffer pointer\n");
+            return false;
+        }
+    }
+
+    return (true);
+}
+
+/*
+ * Compact buffers - extreme values of each width, mixed signedness,
+ * sorted and unsorted vpids, and a buffer cut short
+ */
+static bool test14(void)
+{
+    opal_buffer_t *bufA;
+    int rc;
+    int32_t i, count;
+    int16_t s16[] = { INT16_MIN, -1, 0, 1, INT16_MAX }, d16[5];
+    int32_t s32[] = { INT32_MIN, -64, -1, 0, 63, 64, INT32_MAX }, d32[7];
+    uint32_t u32[] = { 0, 127, 128, UINT32_MAX }, du32[4];
+    int64_t s64[] = { INT64_MIN, -1, 0, 1, INT64_MAX }, d64[5];
+    opal_vpid_t vpids[NUM_ELEMS], dvpids[NUM_ELEMS];
+    opal_process_name_t names[NUM_ELEMS], dnames[NUM_ELEMS];
+    char *str = "compact", *dstr;
+    size_t used;
+
+    for (i=0; i<NUM_ELEMS; i++) {
+        vpids[i] = (0 == i % 3) ? OPAL_VPID_INVALID : (opal_vpid_t)(i * 5);
+        names[i].jobid = 0x12340001;
+        names[i].vpid = i;
+    }
+
+    bufA = OBJ_NEW(opal_buffer_t);
+    bufA->type = OPAL_DSS_BUFFER_COMPACT;
+    if (OPAL_SUCCESS != (rc = opal_dss.pack(bufA, s16, 5, OPAL_INT16)) ||
+        OPAL_SUCCESS != (rc = opal_dss.pack(bufA, s32, 7, OPAL_INT32)) ||
+        OPAL_SUCCESS != (rc = opal_dss.pack(bufA, u32, 4, OPAL_UINT32)) ||
+        OPAL_SUCCESS != (rc = opal_dss.pack(bufA, s64, 5, OPAL_INT64)) ||
+        OPAL_SUCCESS != (rc = opal_dss.pack(bufA, &str, 1, OPAL_STRING)) ||
+        OPAL_SUCCESS != (rc = opal_dss.pack(bufA, vpids, NUM_ELEMS, OPAL_VPID))) {
+        fprintf(test_out, "opal_dss.pack failed with return code %d\n", rc);
+        return(false);
+    }
+    used = bufA->bytes_used;
+    if (OPAL_SUCCESS != (rc = opal_dss.pack(bufA, names, NUM_ELEMS, OPAL_NAME))) {
+        fprintf(test_out, "opal_dss.pack failed with return code %d\n", rc);
+        return(false);
+    }
+    /* a count, then a byte per jobid and one per vpid */
+    if (bufA->bytes_used - used != 2 + 2 * NUM_ELEMS + 4) {
+        fprintf(test_out, "test14: %d names took %lu bytes\n", NUM_ELEMS,
+                (unsigned long)(bufA->bytes_used - used));
+        return(false);
+    }
+
+    count = 5;
+    rc = opal_dss.unpack(bufA, d16, &count, OPAL_INT16);
+    if (OPAL_SUCCESS != rc || 5 != count || 0 != memcmp(s16, d16, sizeof(s16))) {
+        fprintf(test_out, "test14: int16 mismatch (%d)\n", rc);
+        return(false);
+    }
+    count = 7;
+    rc = opal_dss.unpack(bufA, d32, &count, OPAL_INT32);
+    if (OPAL_SUCCESS != rc || 7 != count || 0 != memcmp(s32, d32, sizeof(s32))) {
+        fprintf(test_out, "test14: int32 mismatch (%d)\n", rc);
+        return(false);
+    }
+    /* packed unsigned, unpacked signed - as a non-described buffer allows */
+    count = 4;
+    rc = opal_dss.unpack(bufA, du32, &count, OPAL_INT32);
+    if (OPAL_SUCCESS != rc || 4 != count || 0 != memcmp(u32, du32, sizeof(u32))) {
+        fprintf(test_out, "test14: uint32 mismatch (%d)\n", rc);
+        return(false);
+    }
+    count = 5;
+    rc = opal_dss.unpack(bufA, d64, &count, OPAL_INT64);
+    if (OPAL_SUCCESS != rc || 5 != count || 0 != memcmp(s64, d64, sizeof(s64))) {
+        fprintf(test_out, "test14: int64 mismatch (%d)\n", rc);
+        return(false);
+    }
+    count = 1;
+    rc = opal_dss.unpack(bufA, &dstr, &count, OPAL_STRING);
+    if (OPAL_SUCCESS != rc || 0 != strcmp(str, dstr)) {
+        fprintf(test_out, "test14: string mismatch (%d)\n", rc);
+        return(false);
+    }
+    free(dstr);
+    count = NUM_ELEMS;
+    rc = opal_dss.unpack(bufA, dvpids, &count, OPAL_VPID);
+    if (OPAL_SUCCESS != rc || NUM_ELEMS != count || 0 != memcmp(vpids, dvpids, sizeof(vpids))) {
+        fprintf(test_out, "test14: vpid mismatch (%d)\n", rc);
+        return(false);
+    }
+
+    /* lose the last byte of the names */
+    bufA->bytes_used--;
+    count = NUM_ELEMS;
+    rc = opal_dss.unpack(bufA, dnames, &count, OPAL_NAME);
+    if (OPAL_ERR_UNPACK_READ_PAST_END_OF_BUFFER != rc) {
+        fprintf(test_out, "test14: truncated names returned %d\n", rc);
+        return(false);
+    }
+    bufA->bytes_used++;
+    bufA->unpack_ptr = bufA->base_ptr + used;
+    count = NUM_ELEMS;
+    rc = opal_dss.unpack(bufA, dnames, &count, OPAL_NAME);
+    if (OPAL_SUCCESS != rc || NUM_ELEMS != count || 0 != memcmp(names, dnames, sizeof(names))) {
+        fprintf(test_out, "test14: name mismatch (%d)\n", rc);
+        return(false);
+    }
+    OBJ_RELEASE(bufA);
+
+    /* a count of one, then a 64-bit varint whose tenth byte may
+     * carry nothing but the top bit */
+    for (i=0; i < 3; i++) {
+        uint8_t raw[12] = { 0x01, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x01, 0x01 };
+        int32_t len = 11;
+
+        if (1 == i) {
+            raw[10] = 0x02;
+        } else if (2 == i) {
+            /* eleven bytes */
+            raw[10] = 0xff;
+            len = 12;
+        }
+        bufA = OBJ_NEW(opal_buffer_t);
+        bufA->type = OPAL_DSS_BUFFER_COMPACT;
+        if (OPAL_SUCCESS != (rc = opal_dss.pack(bufA, raw, len, OPAL_BYTE))) {
+            fprintf(test_out, "opal_dss.pack failed with return code %d\n", rc);
+            return(false);
+        }
+        /* step over the count of the bytes themselves */
+        bufA->unpack_ptr++;
+        count = 1;
+        rc = opal_dss.unpack(bufA, d64, &count, OPAL_INT64);
+        if (0 == i ? (OPAL_SUCCESS != rc || INT64_MIN != d64[0]) : OPAL_ERR_UNPACK_FAILURE != rc) {
+            fprintf(test_out, "test14: %s varint returned %d\n",
+                    (0 == i) ? "longest" : "overlong", rc);
+            return(false);
+        }
+        OBJ_RELEASE(bufA);
+    }
+
+    return (true);
+}
+
+static bool test15(void)
+{
+    static opal_dss_lease_t lease = OPAL_DSS_LEASE_STATIC_INIT;
+    opal_buffer_t *bufA;
+    int rc;
+    int32_t i, count;
+    int32_t src[NUM_ELEMS], dst[NUM_ELEMS];
+    char *base, *payload;
+    int32_t sz;
+    size_t used;
+
+    for (i=0; i<NUM_ELEMS; i++) {
+        src[i] = 1000 * i;
+    }
+
+    /* the first buffer from a lease grows as usual */
+    bufA = opal_dss.lease(&lease);
+    if (0 != bufA->bytes_allocated) {
+        fprintf(test_out, "test15: new lease has %lu bytes\n",
+                (unsigned long)bufA->bytes_allocated);
+        return(false);
+    }
+    if (OPAL_SUCCESS != (rc = opal_dss.pack(bufA, src, NUM_ELEMS, OPAL_INT32))) {
+        fprintf(test_out, "opal_dss.pack failed with return code %d\n", rc);
+        return(false);
+    }
+    used = bufA->bytes_used;
+    base = bufA->base_ptr;
+    OBJ_RELEASE(bufA);
+    if (lease.size != used) {
+        fprintf(test_out, "test15: lease has %lu bytes, not %lu\n",
+                (unsigned long)lease.size, (unsigned long)used);
+        return(false);
+    }
+
+    /* the next one starts out big enough - with the storage the
+     * last one just gave back */
+    bufA = opal_dss.lease(&lease);
+    if (bufA->bytes_allocated < used || bufA->base_ptr != base) {
+        fprintf(test_out, "test15: lease was not reused\n");
+        return(false);
+    }
+    if (OPAL_SUCCESS != (rc = opal_dss.pack(bufA, src, NUM_ELEMS, OPAL_INT32))) {
+        fprintf(test_out, "opal_dss.pack failed with return code %d\n", rc);
+        return(false);
+    }
+    if (bufA->base_ptr != base) {
+        fprintf(test_out, "test15: leased buffer was grown\n");
+        return(false);
+    }
+    count = NUM_ELEMS;
+    rc = opal_dss.unpack(bufA, dst, &count, OPAL_INT32);
+    if (OPAL_SUCCESS != rc || NUM_ELEMS != count || 0 != memcmp(src, dst, sizeof(src))) {
+        fprintf(test_out, "test15: int32 mismatch (%d)\n", rc);
+        return(false);
+    }
+
+    /* pooled storage can still be taken away and free'd */
+    bufA->unpack_ptr = bufA->base_ptr;
+    opal_dss.unload(bufA, (void**)&payload, &sz);
+    if ((size_t)sz != used || NULL != bufA->base_ptr) {
+        fprintf(test_out, "test15: unload returned %d bytes\n", sz);
+        return(false);
+    }
+    free(payload);
+    OBJ_RELEASE(bufA);
+    if (lease.size != used) {
+        fprintf(test_out, "test15: unloaded buffer changed the lease\n");
+        return(false);
+    }
+
+    /* and the lease comes down slowly when the messages get smaller */
+    bufA = opal_dss.lease(&lease);
+    if (OPAL_SUCCESS != (rc = opal_dss.pack(bufA, src, 1, OPAL_INT32))) {
+        fprintf(test_out, "opal_dss.pack failed with return code %d\n", rc);
+        return(false);
+    }
+    sz = bufA->bytes_used;
+    OBJ_RELEASE(bufA);
+    if (lease.size != used - (used - sz) / 8) {
+        fprintf(test_out, "test15: lease shrank to %lu bytes\n",
+                (unsigned long)lease.size);
+        return(false);
+    }
+
+    /* an odd-sized loaded payload is pooled and reused safely */
+    bufA = OBJ_NEW(opal_buffer_t);
+    payload = (char*)malloc(300);
+    memset(payload, 1, 300);
+    opal_dss.load(bufA, payload, 300);
+    OBJ_RELEASE(bufA);
+    bufA = OBJ_NEW(opal_buffer_t);
+    if (OPAL_SUCCESS != (rc = opal_dss.pack(bufA, src, 50, OPAL_INT32))) {
+        fprintf(test_out, "opal_dss.pack failed with return code %d\n", rc);
+        return(false);
+    }
+    memset(bufA->pack_ptr, 0, bufA->bytes_allocated - bufA->bytes_used);
+    count = 50;
+    rc = opal_dss.unpack(bufA, dst, &count, OPAL_INT32);
+    if (OPAL_SUCCESS != rc || 50 != count || 0 != memcmp(src, dst, 50 * sizeof(int32_t))) {
+        fprintf(test_out, "test15: int32 mismatch (%d)\n", rc);
+        return(false);
+    }
+    OBJ_RELEASE(bufA);
+
+    return (true);
+}